@@ -47,7 +47,7 @@ extern "C" {
 
 #define FX_APP_MEM_POOL_SIZE                     2048
 
-#define UX_HOST_APP_MEM_POOL_SIZE                32 * 1024
+#define UX_HOST_APP_MEM_POOL_SIZE                42 * 1024
 
 /* USER CODE BEGIN EC */
 
@@ -0,0 +1,48 @@
+/** ****************************************************************************************************
+ * @file            ExecutionProfile.h
+ * @brief           This is the Header file used to support ExecutionProfile.c
+ * ****************************************************************************************************
+ * @author original Hab Collector (habco) \n
+ *
+ * @version         See Main_Support.h: FIRMWARE_REV_MAJOR, FIRMWARE_REV_MINOR
+ *
+ * @param Development_Environment \n
+ * Hardware:        STM32L4R5VGTx\n
+ * IDE:             STMCubeIDE \n
+ * Compiler:        GCC \n
+ * Editor Settings: 1 Tab = 4 Spaces, Recommended Courier New 11
+ *
+ * @note            See source file for notes
+ *
+ *                  This is an embedded application
+ *                  It will be necessary to consult the reference documents to fully understand the code
+ *                  It is suggested that the documents be reviewed in the order shown.
+ *                    Schematic 002-5791-00
+ *                    Test_USB_MSC
+ *                    Design Document
+ *
+ * @copyright       Applied Concepts, Inc
+ ****************************************************************************************************** */
+#ifndef INC_APPLICATION_EXECUTIONPROFILE_H_
+#define INC_APPLICATION_EXECUTIONPROFILE_H_
+
+#ifdef __cplusplus
+extern"C" {
+#endif
+
+#include "tx_api.h"
+#include <stdint.h>
+
+
+// FUNCTION PROTOTYPES
+#if defined(TX_ENABLE_EXECUTION_CHANGE_NOTIFY)
+uint64_t ExecutionProfileIdleCycles(void);
+uint64_t ExecutionProfileThreadCycles(TX_THREAD *Thread);
+TX_THREAD * ExecutionProfileThreadNext(TX_THREAD *Thread);
+void ExecutionProfileReset(void);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* INC_APPLICATION_EXECUTIONPROFILE_H_ */
@@ -38,8 +38,8 @@ extern"C" {
 #define THREAD_STACK_SIZE           1024U
 // BLOCK POOLS: One over head per block
 #define BLOCK_POOL_OVERHEAD         sizeof(void *)
-// 1KB
-#define TOTAL_4KB_BLOCKS            1U
+// 4KB: File copy buffers - two for the pipelined drive to drive copy
+#define TOTAL_4KB_BLOCKS            2U
 #define BLOCK_4KB_SIZE              4096U
 #define BLOCK_4KB_POOL_SIZE         (BLOCK_4KB_SIZE + BLOCK_POOL_OVERHEAD) * TOTAL_4KB_BLOCKS
 
@@ -39,6 +39,19 @@ extern"C" {
 // DEFINES
 #define HARDWARE_INIT_OK                    (0U)
 #define TEST_FILE_NAME                      "Test_USB_MSC.txt"
+#define COPY_TEST_FILE_NAME                 "Copy_USB_MSC.txt"
+#define MSC_BENCH_BUFFER_SIZE               (16U * 1024U)
+#define MSC_BENCH_TOTAL_SIZE                (512U * 1024U)
+#define DRIVE_TEST_FILE_NAME                "Drive_USB_MSC.bin"
+#define DRIVE_TEST_SIZE                     (256U * 1024U)
+#define USB_EVENT_MSC_MAX_DRIVES            12
+#define USB_EVENT_ALL                       (0xFFFFFFFFUL)
+#define USB_ALLOC_BENCH_LOOPS               100U
+#define USB_FIFO_BENCH_READ_SIZE            (8U * 1024U)    // Below the MSC bench buffer size: the unaligned buffer starts at offset 1
+#define USB_FIFO_BENCH_TOTAL_SIZE           (256U * 1024U)
+#define DIR_BENCH_DIRECTORY                 "DirBench"
+#define DIR_BENCH_LOOKUPS                   20U
+#define DIR_LIST_BATCH                      16U
 
 
 // TYPEDEFS AND ENUMS
@@ -50,7 +63,9 @@ typedef enum
     USB_EVENT_CDC_RX = 0x04,
     USB_EVENT_CDC_TX = 0x08,
     USB_EVENT_MSC_INSERTED = 0x10,
-    USB_EVENT_MSC_REMOVED = 0x20
+    USB_EVENT_MSC_REMOVED = 0x20,
+    USB_EVENT_MSC_DRIVE_INSERTED = 0x00000100,  // Drive 0, one bit per drive up to USB_EVENT_MSC_MAX_DRIVES
+    USB_EVENT_MSC_DRIVE_REMOVED = 0x00100000    // Drive 0, one bit per drive up to USB_EVENT_MSC_MAX_DRIVES
 }Type_USB_Event;
 
 typedef struct
@@ -68,6 +83,8 @@ typedef struct
 // MACROS
 #define NOT_USED(x)             (void)(x)
 #define DO_NOTHING()            __NOP()
+#define USB_EVENT_MSC_DRIVE_INSERTED_FLAG(Drive)    ((ULONG)USB_EVENT_MSC_DRIVE_INSERTED << (Drive))
+#define USB_EVENT_MSC_DRIVE_REMOVED_FLAG(Drive)     ((ULONG)USB_EVENT_MSC_DRIVE_REMOVED << (Drive))
 
 
 // FUNCTION PROTOTYPES
@@ -0,0 +1,105 @@
+/** ****************************************************************************************************
+ * @file            USB_Drive.h
+ * @brief           This is the Header file used to support USB_Drive.c
+ * ****************************************************************************************************
+ * @author original Hab Collector (habco) \n
+ *
+ * @version         See Main_Support.h: FIRMWARE_REV_MAJOR, FIRMWARE_REV_MINOR
+ *
+ * @param Development_Environment \n
+ * Hardware:        STM32L4R5VGTx\n
+ * IDE:             STMCubeIDE \n
+ * Compiler:        GCC \n
+ * Editor Settings: 1 Tab = 4 Spaces, Recommended Courier New 11
+ *
+ * @note            See source file for notes
+ *
+ *                  This is an embedded application
+ *                  It will be necessary to consult the reference documents to fully understand the code
+ *                  It is suggested that the documents be reviewed in the order shown.
+ *                    Schematic 002-5791-00
+ *                    Test_USB_MSC
+ *                    Design Document
+ *
+ * @copyright       Applied Concepts, Inc
+ ****************************************************************************************************** */
+#ifndef INC_APPLICATION_USB_DRIVE_H_
+#define INC_APPLICATION_USB_DRIVE_H_
+
+#ifdef __cplusplus
+extern"C" {
+#endif
+
+#include "app_threadx.h"
+#include "fx_api.h"
+#include "ux_api.h"
+#include "ux_host_class_storage.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+// DEFINES
+// One drive per mounted media: a LUN of a USB flash drive or card reader on the root port or on a hub port
+#define USB_DRIVE_MAX                       (UX_MAX_DEVICES * UX_MAX_HOST_LUN)
+#define USB_DRIVE_NONE                      0xFFU
+#define USB_DRIVE_TASK_STACK_SIZE           2048U
+#define USB_DRIVE_TASK_PRIORITY             12U
+#define USB_DRIVE_QUEUE_DEPTH               4U
+#define USB_DRIVE_BUFFER_SIZE               4096U
+#define USB_DRIVE_REMOVE_WAIT               (TX_TIMER_TICKS_PER_SECOND / 2U)   // Removal waits this long for the request of the drive to abort
+
+
+// TYPEDEFS AND ENUMS
+typedef enum
+{
+    USB_DRIVE_FILE_READ = 0,
+    USB_DRIVE_FILE_WRITE
+}Type_USB_DriveOperation;
+
+// Request handed to the worker thread of a drive: the requester owns it until Complete is put
+typedef struct
+{
+    Type_USB_DriveOperation     Operation;
+    char *                      FileName;
+    uint32_t                    Size;               // Bytes to write, not used on read
+    uint32_t                    BytesTransfered;
+    ULONG                       ElapsedTicks;
+    UINT                        FileX_Status;
+    TX_SEMAPHORE *              Complete;
+}Type_USB_DriveRequest;
+
+typedef struct
+{
+    bool                            InUse;
+    UX_HOST_CLASS_STORAGE *         Storage;
+    UX_HOST_CLASS_STORAGE_MEDIA *   StorageMedia;
+    FX_MEDIA *                      Media;
+    ULONG                           Lun;
+    volatile bool                   Abort;              // Set on removal, the holder of the lock stops at the next chunk
+    TX_MUTEX                        Lock;               // Held by the worker for a request or by a console command, removal waits on it
+    TX_THREAD                       TaskHandler;
+    uint8_t                         TaskStack[USB_DRIVE_TASK_STACK_SIZE];
+    TX_QUEUE                        RequestQueue;
+    ULONG                           RequestQueueStorage[USB_DRIVE_QUEUE_DEPTH];
+    uint8_t                         Buffer[USB_DRIVE_BUFFER_SIZE] __attribute__((aligned(4)));
+    uint32_t                        BytesRead;
+    uint32_t                        BytesWritten;
+    ULONG                           BusyTicks;
+}Type_USB_Drive;
+
+
+// FUNCTION PROTOTYPES
+UINT Init_USB_Drive(void);
+uint8_t USB_DriveAdd(UX_HOST_CLASS_STORAGE_MEDIA *StorageMedia);
+uint8_t USB_DriveRemove(UX_HOST_CLASS_STORAGE_MEDIA *StorageMedia);
+uint32_t USB_DriveRemoveStorage(UX_HOST_CLASS_STORAGE *Storage);
+Type_USB_Drive * USB_DriveGet(uint8_t Drive);
+Type_USB_Drive * USB_DriveLock(uint8_t Drive);
+void USB_DriveUnlock(Type_USB_Drive *DriveHandle);
+uint8_t USB_DriveFirst(void);
+UINT USB_DriveRequest(uint8_t Drive, Type_USB_DriveRequest *Request);
+uint32_t USB_DriveBytesPerSecond(uint32_t Bytes, ULONG Ticks);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* INC_APPLICATION_USB_DRIVE_H_ */
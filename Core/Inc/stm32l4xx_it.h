@@ -58,6 +58,10 @@ void TIM6_DAC_IRQHandler(void);
 void DMA2_Channel1_IRQHandler(void);
 void OTG_FS_IRQHandler(void);
 /* USER CODE BEGIN EFP */
+extern volatile uint32_t OTG_FS_IRQ_Count;
+extern volatile uint64_t OTG_FS_IRQ_Cycles;
+extern volatile uint32_t OTG_FS_IRQ_CyclesMax;
+extern volatile uint32_t OTG_FS_IRQ_CyclesMin;
 
 /* USER CODE END EFP */
 
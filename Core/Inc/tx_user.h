@@ -270,6 +270,15 @@
 
 /* USER CODE BEGIN 2 */
 
+/* Defined, the scheduler calls the execution change functions of ExecutionProfile.c on each thread switch:
+   the DWT cycles of each thread are kept in the thread control block and the cycles with no thread ready
+   give the idle CPU load. The port assembler files do not include this file: the symbol is also given to
+   the assembler (-D) in .cproject, for the Debug and the Release configuration.
+*/
+
+#define TX_ENABLE_EXECUTION_CHANGE_NOTIFY
+#define TX_THREAD_USER_EXTENSION                unsigned long long tx_thread_execution_cycles;
+
 /* USER CODE END 2 */
 
 #endif
@@ -38,6 +38,7 @@
 * @author original: Hab Collector \n
 *
 * @note: Debug commands must be previously added - see function debugConsoleCommandAdd()
+* @note: The task blocks in UART_Receive until the debug port has received data
 *
 * @param InitValue a value passed on the creation of the task - not used
 *
@@ -47,18 +48,17 @@
 */
 VOID debugConsoleTask(ULONG InitValue)
 {
-    uint8_t DataBuffer[10];
+    uint8_t DataBuffer[UART_RX_BUFFER_SIZE];
     uint32_t DataSize = 0;
 
     // STEP 1: If Debug Port user input send the input to be parsed for a command from the list
     while(1)
     {
-    	UART_DMA_Receive(&TestApp.Hardware.UART_2, DataBuffer, &DataSize);
+        DataSize = UART_Receive(&TestApp.Hardware.UART_2, DataBuffer, sizeof(DataBuffer), TX_WAIT_FOREVER);
         if (DataSize)
         {
             debugConsoleCommandParse(TestApp.DebugConsole, (char *)DataBuffer, DataSize);
         }
-        tx_thread_sleep(1);  // Hab added for management
     }
 
 } // END OF debugConsoleTask
@@ -0,0 +1,248 @@
+/** ****************************************************************************************************
+ * @file            ExecutionProfile.c
+ * @brief           ThreadX execution profile: cycles spent in each thread and with no thread ready
+ * ****************************************************************************************************
+ * @author original Hab Collector (habco)\n
+ *
+ * @version         See Main_Support.h: FIRMWARE_REV_MAJOR, FIRMWARE_REV_MINOR
+ *
+ * @param Development_Environment \n
+ * Hardware:        STM32L4R5VGTx\n
+ * IDE:             STMCubeIDE \n
+ * Compiler:        GCC \n
+ * Editor Settings: 1 Tab = 4 Spaces, Recommended Courier New 11
+ *
+ * @note            With TX_ENABLE_EXECUTION_CHANGE_NOTIFY defined in tx_user.h the ThreadX scheduler calls
+ *                  the execution change functions below each time a thread is switched in or out.  The
+ *                  time is taken from the DWT cycle counter: a thread is charged from its switch in to its
+ *                  switch out, the idle time runs from a switch out to the next switch in.  The interrupts
+ *                  are charged to the thread or to the idle time they interrupt.
+ *
+ *                  This is an embedded application
+ *                  It will be necessary to consult the reference documents to fully understand the code
+ *                  It is suggested that the documents be reviewed in the order shown.
+ *                    Schematic 002-5791-00
+ *                    Test_USB_MSC
+ *                    Design Document
+ *
+ * @copyright       Applied Concepts, Inc
+ ********************************************************************************************************/
+#include "ExecutionProfile.h"
+#include "tx_thread.h"
+#include "main.h"
+#include <stdbool.h>
+
+#if defined(TX_ENABLE_EXECUTION_CHANGE_NOTIFY)
+
+// Updated by the scheduler from PendSV, read by the threads with the interrupts disabled
+static uint32_t ThreadStartCycle;
+static uint32_t IdleStartCycle;
+static uint64_t IdleCycles;
+static bool Idle;
+
+VOID _tx_execution_initialize(VOID);
+VOID _tx_execution_thread_enter(VOID);
+VOID _tx_execution_thread_exit(VOID);
+VOID _tx_execution_isr_enter(VOID);
+VOID _tx_execution_isr_exit(VOID);
+
+
+
+/*******************************************************************************************************
+* @brief Called by tx_kernel_enter before the scheduler starts.  No thread runs yet: the time is idle.
+*
+* @author original: Hab Collector \n
+*
+* @param void
+*
+* @return void
+********************************************************************************************************/
+VOID _tx_execution_initialize(VOID)
+{
+    IdleCycles = 0;
+    IdleStartCycle = DWT->CYCCNT;
+    Idle = true;
+
+} // END OF _tx_execution_initialize
+
+
+
+/*******************************************************************************************************
+* @brief Called by the scheduler when the thread in _tx_thread_current_ptr is switched in
+*
+* @author original: Hab Collector \n
+*
+* @param void
+*
+* @return void
+*
+* STEP 1: End the idle time
+* STEP 2: Start the time of the thread
+********************************************************************************************************/
+VOID _tx_execution_thread_enter(VOID)
+{
+    uint32_t Now = DWT->CYCCNT;
+
+    // STEP 1: End the idle time
+    if (Idle)
+    {
+        IdleCycles += (uint32_t)(Now - IdleStartCycle);
+        Idle = false;
+    }
+
+    // STEP 2: Start the time of the thread
+    ThreadStartCycle = Now;
+
+} // END OF _tx_execution_thread_enter
+
+
+
+/*******************************************************************************************************
+* @brief Called by the scheduler before the thread in _tx_thread_current_ptr, if any, is switched out
+*
+* @author original: Hab Collector \n
+*
+* @param void
+*
+* @return void
+*
+* STEP 1: Charge the thread its time
+* STEP 2: Start the idle time until a thread is switched in
+********************************************************************************************************/
+VOID _tx_execution_thread_exit(VOID)
+{
+    uint32_t Now = DWT->CYCCNT;
+    TX_THREAD *Thread = _tx_thread_current_ptr;
+
+    // STEP 1: Charge the thread its time
+    if ((Thread == TX_NULL) || Idle)
+        return;
+    Thread->tx_thread_execution_cycles += (uint32_t)(Now - ThreadStartCycle);
+
+    // STEP 2: Start the idle time until a thread is switched in
+    IdleStartCycle = Now;
+    Idle = true;
+
+} // END OF _tx_execution_thread_exit
+
+
+
+/*******************************************************************************************************
+* @brief Called by _tx_thread_context_save and _tx_thread_context_restore.  The HAL interrupt handlers do not
+* go through them, the interrupt time is charged to what it interrupts.  The OTG FS interrupt is timed in
+* OTG_FS_IRQHandler.
+*
+* @author original: Hab Collector \n
+*
+* @param void
+*
+* @return void
+********************************************************************************************************/
+VOID _tx_execution_isr_enter(VOID)
+{
+}
+
+VOID _tx_execution_isr_exit(VOID)
+{
+}
+
+
+
+/*******************************************************************************************************
+* @brief Cycles with no thread ready since the last reset
+*
+* @author original: Hab Collector \n
+*
+* @param void
+*
+* @return Idle cycles
+********************************************************************************************************/
+uint64_t ExecutionProfileIdleCycles(void)
+{
+    TX_INTERRUPT_SAVE_AREA
+
+    TX_DISABLE
+    uint64_t Cycles = IdleCycles;
+    TX_RESTORE
+    return(Cycles);
+
+} // END OF ExecutionProfileIdleCycles
+
+
+
+/*******************************************************************************************************
+* @brief Cycles charged to a thread since the last reset.  The calling thread is charged up to its last
+* switch in only.
+*
+* @author original: Hab Collector \n
+*
+* @param Thread: Thread to report
+*
+* @return Thread cycles
+********************************************************************************************************/
+uint64_t ExecutionProfileThreadCycles(TX_THREAD *Thread)
+{
+    TX_INTERRUPT_SAVE_AREA
+
+    TX_DISABLE
+    uint64_t Cycles = Thread->tx_thread_execution_cycles;
+    TX_RESTORE
+    return(Cycles);
+
+} // END OF ExecutionProfileThreadCycles
+
+
+
+/*******************************************************************************************************
+* @brief Walk the created threads
+*
+* @author original: Hab Collector \n
+*
+* @param Thread: NULL to get the first thread, else the thread returned by the previous call
+*
+* @return Next created thread, NULL after the last one
+********************************************************************************************************/
+TX_THREAD * ExecutionProfileThreadNext(TX_THREAD *Thread)
+{
+    // The created list is circular
+    if (Thread == NULL)
+        return(_tx_thread_created_ptr);
+    Thread = Thread->tx_thread_created_next;
+    return((Thread == _tx_thread_created_ptr) ? NULL : Thread);
+
+} // END OF ExecutionProfileThreadNext
+
+
+
+/*******************************************************************************************************
+* @brief Restart the idle and thread counts
+*
+* @author original: Hab Collector \n
+*
+* @param void
+*
+* @return void
+*
+* STEP 1: Restart the idle count
+* STEP 2: Restart the count of every created thread
+********************************************************************************************************/
+void ExecutionProfileReset(void)
+{
+    TX_INTERRUPT_SAVE_AREA
+
+    // STEP 1: Restart the idle count
+    TX_DISABLE
+    IdleCycles = 0;
+    TX_RESTORE
+
+    // STEP 2: Restart the count of every created thread
+    for (TX_THREAD *Thread = ExecutionProfileThreadNext(NULL); Thread != NULL; Thread = ExecutionProfileThreadNext(Thread))
+    {
+        TX_DISABLE
+        Thread->tx_thread_execution_cycles = 0;
+        TX_RESTORE
+    }
+
+} // END OF ExecutionProfileReset
+
+#endif
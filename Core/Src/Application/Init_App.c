@@ -28,6 +28,7 @@
 #include "UART.h"
 #include "DebugPort.h"
 #include "TerminalEmulatorSupport.h"
+#include "USB_Drive.h"
 #include <stdio.h>
 
 
@@ -39,6 +40,11 @@ TX_THREAD TestAppTaskHandler;
 uint8_t DebugConsoleTaskStack[4 * THREAD_STACK_SIZE];
 TX_THREAD DebugConsoleHandler;
 
+// BLOCK POOLS:
+// File copy block pool
+uint8_t Block4KB_PoolMemory[BLOCK_4KB_POOL_SIZE] __attribute__((aligned(4)));    // Word aligned blocks take the USB FIFO fast copy
+TX_BLOCK_POOL Block4KB_Pool;
+
 // TRACE X SUPPORT:
 #ifdef USE_TRACEX
 #define TRACEX_BUFFER_SIZE 40000
@@ -75,10 +81,13 @@ void startAppTasks(void)
     // STEP 2: Init Tasks
     InitStatus = (tx_thread_create(&TestAppTaskHandler, "TestApp", testAppMainTask, 0x0001, TestAppTaskStack, sizeof(TestAppTaskStack), 13, 13, 1, TX_AUTO_START) != TX_SUCCESS)? (InitStatus | 0x0002) : HARDWARE_INIT_OK;
     InitStatus = (tx_thread_create(&DebugConsoleHandler, "Debug Console", debugConsoleTask, 0x0002, DebugConsoleTaskStack, sizeof(DebugConsoleTaskStack), 15, 15, 1, TX_AUTO_START) != TX_SUCCESS)? (InitStatus | 0x0004) : HARDWARE_INIT_OK;
+    // USB drive registry: a worker thread and request queue per drive
+    InitStatus = (Init_USB_Drive() != TX_SUCCESS)? (InitStatus | 0x0010) : HARDWARE_INIT_OK;
 
     // STEP 3: Init Queues
 
     // STEP 4: Init Block Pools
+    InitStatus = (tx_block_pool_create(&Block4KB_Pool, "4KB Pool", BLOCK_4KB_SIZE, Block4KB_PoolMemory, sizeof(Block4KB_PoolMemory)) != TX_SUCCESS)? (InitStatus | 0x0008) : HARDWARE_INIT_OK;
 
     // STEP 5: Check for critical errors
     if (InitStatus != HARDWARE_INIT_OK)
@@ -99,6 +108,9 @@ void startAppTasks(void)
 * @author original: Hab Collector \n
 *
 * @note The full implementation is not used - hence file is ignored.  This is simply to use printf on UART
+* @note The message is queued in the UART Tx ring and sent by DMA, printf returns without waiting unless the
+* ring is full and the UART Tx policy is UART_TX_BLOCK.  Dropped bytes are counted by the UART, the full length
+* is always returned as newlib retries a short write.
 *
 * @param ptr: Pointer to the print message
 * @param len: Size of the print message
@@ -107,8 +119,7 @@ void startAppTasks(void)
 */
 int _write(int file, char *ptr, int len)
 {
-	UART_DMA_Transmit(&TestApp.Hardware.UART_2, (uint8_t *)ptr, (uint16_t)len);
-	tx_thread_sleep(1);
+    UART_Write(&TestApp.Hardware.UART_2, (uint8_t *)ptr, (uint32_t)len);
 
     return(len);
 
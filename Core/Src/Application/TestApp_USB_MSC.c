@@ -31,14 +31,29 @@
 #include "TerminalEmulatorSupport.h"
 #include "UART.h"
 #include "FileX_FS.h"
+#include "Init_App.h"
 #include "app_usbx_host.h"
+#include "USB_Drive.h"
+#include "ExecutionProfile.h"
+#include "usb_otg.h"
+#include "stm32l4xx_it.h"
 #include <stdio.h>
+#include <stdlib.h>
 
 
 // Global Vars
 Type_TestApp TestApp;
 extern TX_EVENT_FLAGS_GROUP USB_EventFlag;
-extern FX_MEDIA *USB_Media;
+extern TX_BLOCK_POOL Block4KB_Pool;
+static uint8_t MSC_BenchBuffer[MSC_BENCH_BUFFER_SIZE] __attribute__((aligned(4)));
+static Type_USB_DriveRequest DriveTestRequest[USB_DRIVE_MAX];
+static TX_SEMAPHORE DriveTestComplete;
+static ULONG USB_StatsStartTick;
+#if defined(FX_ENABLE_DIRECTORY_LIST)
+static FX_DIRECTORY_LIST_ENTRY DirListEntry[DIR_LIST_BATCH];
+static FX_LOCAL_PATH DirListPath;
+static CHAR DirListName[FX_MAX_LONG_NAME_LEN];
+#endif
 
 // DEBUG COMMANDS
 // Power toggle test commands
@@ -46,6 +61,25 @@ static void TPx_Toggle(void *TestPoint);
 static void LED_Toggle(void *NotUsed);
 static void massStorageClassDisable(void *NotUsed);
 static void massStorageClassEnable(void *NotUsed);
+static void massStorageClassBenchmark(void *NotUsed);
+static uint32_t mscReadThroughput(Type_USB_Drive *DriveHandle, ULONG MaxTransferSize);
+static void massStorageClassStatistics(void *NotUsed);
+static void fileCopyTest(void *NotUsed);
+static void fileCopyDriveTest(void *CopyDrives);
+static void driveList(void *NotUsed);
+static void driveConcurrentTest(void *NotUsed);
+static void driveConcurrentRun(Type_USB_DriveOperation Operation);
+static void uartStatistics(void *NotUsed);
+static void uartPolicy(void *Policy);
+static void usbHostStatistics(void *NotUsed);
+static void usbDeferredURB(void *Mode);
+static void usbAllocationBenchmark(void *NotUsed);
+static void usbFifoBenchmark(void *NotUsed);
+static void directoryBenchmark(void *NotUsed);
+static uint32_t directoryLookupCycles(FX_MEDIA *Media, uint32_t Lookups);
+static void directoryList(void *Path);
+static void usbEndpointStatistics(void *NotUsed);
+static void mscDriveInserted(uint8_t Drive);
 
 VOID testAppMainTask(ULONG InitValue)
 {
@@ -54,6 +88,22 @@ VOID testAppMainTask(ULONG InitValue)
     debugConsoleCommandAdd(TestApp.DebugConsole, "LED", "Toggle LED power", LED_Toggle, COMPLETE);
     debugConsoleCommandAdd(TestApp.DebugConsole, "MSC Off", "Disable MSC", massStorageClassDisable, COMPLETE);
     debugConsoleCommandAdd(TestApp.DebugConsole, "MSC On", "Enable MSC", massStorageClassEnable, COMPLETE);
+    debugConsoleCommandAdd(TestApp.DebugConsole, "MSC Bench", "Read speed: 1KB vs large BOT data phase", massStorageClassBenchmark, COMPLETE);
+    debugConsoleCommandAdd(TestApp.DebugConsole, "MSC Stats", "Show USB MSC driver statistics", massStorageClassStatistics, COMPLETE);
+    debugConsoleCommandAdd(TestApp.DebugConsole, "Copy Test", "Copy test file: serial vs pipelined", fileCopyTest, COMPLETE);
+    debugConsoleCommandAdd(TestApp.DebugConsole, "Copy Drive ", "Copy test file drive <x> to drive <y>", fileCopyDriveTest, PARTIAL);
+    debugConsoleCommandAdd(TestApp.DebugConsole, "Drives", "List USB drives and their throughput", driveList, COMPLETE);
+    debugConsoleCommandAdd(TestApp.DebugConsole, "Drive Test", "Write and read all USB drives at once", driveConcurrentTest, COMPLETE);
+    debugConsoleCommandAdd(TestApp.DebugConsole, "UART Stats", "Show debug port UART statistics", uartStatistics, COMPLETE);
+    debugConsoleCommandAdd(TestApp.DebugConsole, "UART Policy ", "Tx ring full policy <block | drop>", uartPolicy, PARTIAL);
+    debugConsoleCommandAdd(TestApp.DebugConsole, "USB Stats", "Show and restart USB IRQ, CPU load and NAK counts", usbHostStatistics, COMPLETE);
+    debugConsoleCommandAdd(TestApp.DebugConsole, "USB Defer ", "URB processing in HCD thread <on | off>", usbDeferredURB, PARTIAL);
+    debugConsoleCommandAdd(TestApp.DebugConsole, "USB Alloc Bench", "HCD ED and channel allocation cycles (no device)", usbAllocationBenchmark, COMPLETE);
+    debugConsoleCommandAdd(TestApp.DebugConsole, "USB FIFO Bench", "Bulk IN FIFO read cycles: aligned vs unaligned buffer", usbFifoBenchmark, COMPLETE);
+    debugConsoleCommandAdd(TestApp.DebugConsole, "Dir Bench", "Name lookup cycles vs directory size: linear vs index", directoryBenchmark, COMPLETE);
+    debugConsoleCommandAdd(TestApp.DebugConsole, "Dir List ", "List directory <path> and scan cycles: batched vs per entry", directoryList, PARTIAL);
+    debugConsoleCommandAdd(TestApp.DebugConsole, "USB ED Stats", "Show and restart per endpoint transfer counts and latency", usbEndpointStatistics, COMPLETE);
+    tx_semaphore_create(&DriveTestComplete, "Drive Test Complete", 0);
 
     // STEP 2: Show start up message
     terminal_SetDefaultForegroundColor();
@@ -67,24 +117,22 @@ VOID testAppMainTask(ULONG InitValue)
     while (1)
     {
         ULONG USB_CDC_EventFlag = 0;
-        tx_event_flags_get(&USB_EventFlag, 0xFF, TX_OR_CLEAR, &USB_CDC_EventFlag, TX_WAIT_FOREVER);
+        tx_event_flags_get(&USB_EventFlag, USB_EVENT_ALL, TX_OR_CLEAR, &USB_CDC_EventFlag, TX_WAIT_FOREVER);
         printf("USB_CDC_EventFlag = %d\r\n", (int)USB_CDC_EventFlag);
-        if (USB_CDC_EventFlag == USB_EVENT_MSC_INSERTED)
+        if (USB_CDC_EventFlag & USB_EVENT_MSC_INSERTED)
         {
             printf("USB Flash Drive Inserted\r\n");
-            printf("Test File: %s ", TEST_FILE_NAME);
-            if (FileX_FS_FileExists(USB_Media, TEST_FILE_NAME))
-                printf("Found on Flash Drive\r\n");
-            else
-                printf("NOT Found on Flash Drive\r\n");
         }
-        else if (USB_CDC_EventFlag == USB_EVENT_MSC_REMOVED)
+        for (uint8_t Drive = 0; Drive < USB_DRIVE_MAX; Drive++)
         {
-            printf("USB Flash Drive Removed\r\n");
+            if (USB_CDC_EventFlag & USB_EVENT_MSC_DRIVE_REMOVED_FLAG(Drive))
+                printf("Drive %u: Media Removed\r\n", Drive);
+            if (USB_CDC_EventFlag & USB_EVENT_MSC_DRIVE_INSERTED_FLAG(Drive))
+                mscDriveInserted(Drive);
         }
-        else
+        if (USB_CDC_EventFlag & USB_EVENT_MSC_REMOVED)
         {
-            DO_NOTHING();
+            printf("USB Flash Drive Removed\r\n");
         }
 
         // SLEEP ALLOW OTHER TASKS TO RUN:
@@ -133,6 +181,11 @@ uint16_t Init_TestAppHardware(void)
     Init_UART_DMA(&TestApp.Hardware.UART_2, &huart2);
     InitStatus = (&TestApp.Hardware.UART_2 == NULL)? InitStatus | 0x0001 : InitStatus;
 
+    // Cycle counter: USB interrupt time accounting
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
     // STEP 3: Init API Handlers
     // DEBUG CONSOLE
     TestApp.DebugConsole = Init_DebugConsoleCommand();
@@ -240,3 +293,869 @@ static void massStorageClassEnable(void *NotUsed)
         while(1);
     printf("USB MSC Turned on\r\n");
 }
+
+
+/**
+ * @brief Compare the read throughput of the USB flash drive with the BOT data phase split in 1KB chunks against
+ * the large transfer mode where the whole data phase of a READ(10) is a single transfer request
+ * @param void pointer: not used
+ * @return void
+ */
+static void massStorageClassBenchmark(void *NotUsed)
+{
+    (void)NotUsed;
+    uint8_t Drive = USB_DriveFirst();
+    Type_USB_Drive *DriveHandle = USB_DriveLock(Drive);
+    if (DriveHandle == NULL)
+    {
+        printf("No USB Flash Drive\r\n");
+        return;
+    }
+
+    uint32_t ChunkedRate = mscReadThroughput(DriveHandle, UX_HOST_CLASS_STORAGE_MAX_TRANSFER_SIZE);
+    uint32_t LargeRate = mscReadThroughput(DriveHandle, 0);
+    USB_DriveUnlock(DriveHandle);
+    printf("Drive %u: Read of %u KB in %u KB commands\r\n", Drive, (unsigned int)(MSC_BENCH_TOTAL_SIZE / 1024U), (unsigned int)(MSC_BENCH_BUFFER_SIZE / 1024U));
+    printf("%4u byte data phase: %lu KB/s\r\n", (unsigned int)UX_HOST_CLASS_STORAGE_MAX_TRANSFER_SIZE, (unsigned long)ChunkedRate);
+    printf("Large data phase: %lu KB/s\r\n", (unsigned long)LargeRate);
+}
+
+
+/**
+ * @brief Read MSC_BENCH_TOTAL_SIZE bytes from the start of the mounted partition and measure the throughput
+ * @param DriveHandle: Mounted drive to read from, locked by the caller
+ * @param MaxTransferSize: Data phase limit of the BOT transport, 0 for the bulk endpoint limit
+ * @return Throughput in KB/s or 0 on failure
+ */
+static uint32_t mscReadThroughput(Type_USB_Drive *DriveHandle, ULONG MaxTransferSize)
+{
+    UX_HOST_CLASS_STORAGE *storage = DriveHandle->Storage;
+    UX_HOST_CLASS_STORAGE_MEDIA *StorageMedia = DriveHandle->StorageMedia;
+    ULONG SectorSize = StorageMedia->ux_host_class_storage_media_sector_size;
+    ULONG SectorsPerRead = MSC_BENCH_BUFFER_SIZE / SectorSize;
+    ULONG Sector = StorageMedia->ux_host_class_storage_media_partition_start;
+    UINT Status = UX_SUCCESS;
+
+    if (ux_host_class_storage_lock(storage, UX_WAIT_FOREVER) != UX_SUCCESS)
+        return(0);
+    storage->ux_host_class_storage_lun = StorageMedia->ux_host_class_storage_media_lun;
+    storage->ux_host_class_storage_sector_size = SectorSize;
+    storage->ux_host_class_storage_last_sector_number = StorageMedia->ux_host_class_storage_media_number_sectors - 1;
+    ux_host_class_storage_max_transfer_size_set(storage, MaxTransferSize);
+
+    uint32_t StartTick = HAL_GetTick();
+    for (uint32_t BytesRead = 0; (BytesRead < MSC_BENCH_TOTAL_SIZE) && (Status == UX_SUCCESS) && !DriveHandle->Abort; BytesRead += MSC_BENCH_BUFFER_SIZE)
+    {
+        Status = ux_host_class_storage_media_read(storage, Sector, SectorsPerRead, MSC_BenchBuffer);
+        Sector += SectorsPerRead;
+    }
+    uint32_t ElapsedTime = HAL_GetTick() - StartTick;
+
+    ux_host_class_storage_max_transfer_size_set(storage, 0);
+    ux_host_class_storage_unlock(storage);
+
+    if ((Status != UX_SUCCESS) || DriveHandle->Abort || (ElapsedTime == 0))
+        return(0);
+    return((MSC_BENCH_TOTAL_SIZE / 1024U) * 1000U / ElapsedTime);
+}
+
+
+/**
+ * @brief Show the statistics of the USB MSC FileX driver for each mounted drive
+ * @param void pointer: not used
+ * @return void
+ */
+static void massStorageClassStatistics(void *NotUsed)
+{
+    (void)NotUsed;
+    if (USB_DriveFirst() == USB_DRIVE_NONE)
+    {
+        printf("No USB Flash Drive\r\n");
+        return;
+    }
+
+    for (uint8_t Drive = 0; Drive < USB_DRIVE_MAX; Drive++)
+    {
+        Type_USB_Drive *DriveHandle = USB_DriveLock(Drive);
+        if (DriveHandle == NULL)
+            continue;
+        printf("Drive %u (LUN %lu):\r\n", Drive, (unsigned long)DriveHandle->Lun);
+
+        FX_MEDIA *Media = DriveHandle->Media;
+        ULONG CacheSize = ux_host_class_storage_media_memory_size_get(DriveHandle->StorageMedia);
+        printf("Sector cache: %lu KB, %lu sectors%s\r\n", (unsigned long)(CacheSize / 1024U), (unsigned long)Media->fx_media_sector_cache_size,
+               (Media->fx_media_sector_cache_hashed) ? ", hashed" : "");
+#ifndef FX_MEDIA_STATISTICS_DISABLE
+        ULONG CacheHits = Media->fx_media_logical_sector_cache_read_hits;
+        ULONG CacheMisses = Media->fx_media_logical_sector_cache_read_misses;
+        ULONG CacheHitRate = ((CacheHits + CacheMisses) == 0) ? 0 : (CacheHits * 100U) / (CacheHits + CacheMisses);
+        printf("Sector cache: %lu hits, %lu misses, %lu%% hit rate\r\n", (unsigned long)CacheHits, (unsigned long)CacheMisses, (unsigned long)CacheHitRate);
+#endif
+
+#if defined(UX_HOST_CLASS_STORAGE_READ_AHEAD_ENABLE)
+        ULONG Hits = ux_host_class_storage_media_read_ahead_hits_get(DriveHandle->StorageMedia);
+        ULONG Misses = ux_host_class_storage_media_read_ahead_misses_get(DriveHandle->StorageMedia);
+        ULONG HitRate = ((Hits + Misses) == 0) ? 0 : (Hits * 100U) / (Hits + Misses);
+        printf("Read ahead: %lu hits, %lu misses, %lu%% hit rate\r\n", (unsigned long)Hits, (unsigned long)Misses, (unsigned long)HitRate);
+#else
+        printf("Read ahead: disabled\r\n");
+#endif
+
+#if defined(UX_HOST_CLASS_STORAGE_WRITE_COALESCE_ENABLE)
+        ULONG Merges = ux_host_class_storage_media_write_merges_get(DriveHandle->StorageMedia);
+        ULONG Flushes = ux_host_class_storage_media_write_flushes_get(DriveHandle->StorageMedia);
+        printf("Write coalescing: %lu merged writes, %lu flushed runs\r\n", (unsigned long)Merges, (unsigned long)Flushes);
+#else
+        printf("Write coalescing: disabled\r\n");
+#endif
+
+#if defined(FX_ENABLE_DIRECTORY_INDEX) && !defined(FX_MEDIA_STATISTICS_DISABLE)
+        printf("Directory index: %lu KB, %lu names, %lu builds, %lu hits\r\n", (unsigned long)((Media->fx_media_directory_index_size * sizeof(FX_DIRECTORY_INDEX_RECORD)) / 1024U),
+               (unsigned long)Media->fx_media_directory_index_used, (unsigned long)Media->fx_media_directory_index_builds, (unsigned long)Media->fx_media_directory_index_hits);
+#endif
+
+#if defined(FX_ENABLE_PATH_CACHE) && !defined(FX_MEDIA_STATISTICS_DISABLE)
+        printf("Path cache: %lu of %lu directory searches started in a remembered directory\r\n", (unsigned long)Media->fx_media_path_cache_hits,
+               (unsigned long)Media->fx_media_directory_searches);
+#endif
+        USB_DriveUnlock(DriveHandle);
+    }
+}
+
+
+/**
+ * @brief Copy the test file on the USB flash drive with the serial and with the pipelined drive to drive copy
+ * and show the copy rate of each
+ * @param void pointer: not used
+ * @return void
+ */
+static void fileCopyTest(void *NotUsed)
+{
+    (void)NotUsed;
+    Type_USB_Drive *DriveHandle = USB_DriveLock(USB_DriveFirst());
+    if (DriveHandle == NULL)
+    {
+        printf("No USB Flash Drive\r\n");
+        return;
+    }
+
+    uint32_t BytesCopied;
+    uint32_t BytesPerSecond;
+    ULONG StartTime = tx_time_get();
+    UINT FileX_Status = FileX_FS_FileCopyDriveToDrive(DriveHandle->Media, COPY_TEST_FILE_NAME, DriveHandle->Media, TEST_FILE_NAME, &Block4KB_Pool, BLOCK_4KB_SIZE, &BytesCopied, true);
+    ULONG ElapsedTime = tx_time_get() - StartTime;
+    BytesPerSecond = (ElapsedTime == 0) ? 0 : (uint32_t)(((uint64_t)BytesCopied * TX_TIMER_TICKS_PER_SECOND) / ElapsedTime);
+    printf("Serial copy: %lu bytes, %lu bytes/s, status 0x%02X\r\n", (unsigned long)BytesCopied, (unsigned long)BytesPerSecond, FileX_Status);
+
+    FileX_Status = FileX_FS_FileCopyDriveToDrivePipelined(DriveHandle->Media, COPY_TEST_FILE_NAME, DriveHandle->Media, TEST_FILE_NAME, &Block4KB_Pool, BLOCK_4KB_SIZE, &BytesCopied, true, &BytesPerSecond);
+    printf("Pipelined copy: %lu bytes, %lu bytes/s, status 0x%02X\r\n", (unsigned long)BytesCopied, (unsigned long)BytesPerSecond, FileX_Status);
+    USB_DriveUnlock(DriveHandle);
+}
+
+
+/**
+ * @brief Copy the test file from one USB drive to another, the command argument is "<x> <y>".  The drives can be
+ * two flash drives or two LUNs of a card reader, both stay mounted.
+ * @param void pointer: user console input
+ * @return void
+ */
+static void fileCopyDriveTest(void *CopyDrives)
+{
+    char *CommandArgument = (char *)CopyDrives;
+    char *NextArgument;
+    uint8_t SourceDrive = (uint8_t)strtoul(CommandArgument, &NextArgument, 10);
+    uint8_t DestinationDrive = (uint8_t)strtoul(NextArgument, NULL, 10);
+    // The drive locks are recursive, the source and the destination can be the same drive
+    Type_USB_Drive *SourceHandle = USB_DriveLock(SourceDrive);
+    Type_USB_Drive *DestinationHandle = USB_DriveLock(DestinationDrive);
+    if ((SourceHandle == NULL) || (DestinationHandle == NULL))
+    {
+        USB_DriveUnlock(DestinationHandle);
+        USB_DriveUnlock(SourceHandle);
+        printf("Drive not mounted\r\n");
+        return;
+    }
+
+    uint32_t BytesCopied;
+    uint32_t BytesPerSecond;
+    UINT FileX_Status = FileX_FS_FileCopyDriveToDrivePipelined(DestinationHandle->Media, COPY_TEST_FILE_NAME, SourceHandle->Media, TEST_FILE_NAME, &Block4KB_Pool, BLOCK_4KB_SIZE, &BytesCopied, true, &BytesPerSecond);
+    printf("Drive %u to drive %u: %lu bytes, %lu bytes/s, status 0x%02X\r\n", SourceDrive, DestinationDrive, (unsigned long)BytesCopied, (unsigned long)BytesPerSecond, FileX_Status);
+    USB_DriveUnlock(DestinationHandle);
+    USB_DriveUnlock(SourceHandle);
+}
+
+
+/**
+ * @brief List the mounted USB drives with the bytes moved by their worker thread and the throughput while busy
+ * @param void pointer: not used
+ * @return void
+ */
+static void driveList(void *NotUsed)
+{
+    (void)NotUsed;
+    if (USB_DriveFirst() == USB_DRIVE_NONE)
+    {
+        printf("No USB Flash Drive\r\n");
+        return;
+    }
+
+    for (uint8_t Drive = 0; Drive < USB_DRIVE_MAX; Drive++)
+    {
+        Type_USB_Drive *DriveHandle = USB_DriveGet(Drive);
+        if (DriveHandle == NULL)
+            continue;
+        uint32_t Bytes = DriveHandle->BytesRead + DriveHandle->BytesWritten;
+        printf("Drive %u: LUN %lu, %lu bytes read, %lu bytes written, %lu bytes/s\r\n", Drive, (unsigned long)DriveHandle->Lun, (unsigned long)DriveHandle->BytesRead, (unsigned long)DriveHandle->BytesWritten, (unsigned long)USB_DriveBytesPerSecond(Bytes, DriveHandle->BusyTicks));
+    }
+}
+
+
+/**
+ * @brief Write then read a DRIVE_TEST_SIZE file on all the mounted USB drives at once, each drive through its own
+ * worker thread, and show the throughput of each drive and the aggregate throughput
+ * @param void pointer: not used
+ * @return void
+ */
+static void driveConcurrentTest(void *NotUsed)
+{
+    (void)NotUsed;
+    if (USB_DriveFirst() == USB_DRIVE_NONE)
+    {
+        printf("No USB Flash Drive\r\n");
+        return;
+    }
+
+    driveConcurrentRun(USB_DRIVE_FILE_WRITE);
+    driveConcurrentRun(USB_DRIVE_FILE_READ);
+}
+
+
+/**
+ * @brief Queue the same file request to every mounted drive, wait for all to complete and show the throughput
+ * @param Operation: Write or read of DRIVE_TEST_FILE_NAME
+ * @return void
+ */
+static void driveConcurrentRun(Type_USB_DriveOperation Operation)
+{
+    uint32_t RequestCount = 0;
+    uint32_t TotalBytes = 0;
+
+    ULONG StartTime = tx_time_get();
+    for (uint8_t Drive = 0; Drive < USB_DRIVE_MAX; Drive++)
+    {
+        DriveTestRequest[Drive].Operation = Operation;
+        DriveTestRequest[Drive].FileName = DRIVE_TEST_FILE_NAME;
+        DriveTestRequest[Drive].Size = DRIVE_TEST_SIZE;
+        DriveTestRequest[Drive].BytesTransfered = 0;
+        DriveTestRequest[Drive].Complete = &DriveTestComplete;
+        DriveTestRequest[Drive].FileX_Status = FX_MEDIA_NOT_OPEN;
+        if (USB_DriveRequest(Drive, &DriveTestRequest[Drive]) == TX_SUCCESS)
+            RequestCount++;
+        else
+            DriveTestRequest[Drive].Complete = NULL;
+    }
+    for (uint32_t Count = 0; Count < RequestCount; Count++)
+        tx_semaphore_get(&DriveTestComplete, TX_WAIT_FOREVER);
+    ULONG ElapsedTime = tx_time_get() - StartTime;
+
+    for (uint8_t Drive = 0; Drive < USB_DRIVE_MAX; Drive++)
+    {
+        if (DriveTestRequest[Drive].Complete == NULL)
+            continue;
+        TotalBytes += DriveTestRequest[Drive].BytesTransfered;
+        printf("Drive %u %s: %lu bytes, %lu bytes/s, status 0x%02X\r\n", Drive, (Operation == USB_DRIVE_FILE_WRITE) ? "write" : "read", (unsigned long)DriveTestRequest[Drive].BytesTransfered, (unsigned long)USB_DriveBytesPerSecond(DriveTestRequest[Drive].BytesTransfered, DriveTestRequest[Drive].ElapsedTicks), DriveTestRequest[Drive].FileX_Status);
+    }
+    printf("Aggregate %s: %lu bytes, %lu bytes/s\r\n", (Operation == USB_DRIVE_FILE_WRITE) ? "write" : "read", (unsigned long)TotalBytes, (unsigned long)USB_DriveBytesPerSecond(TotalBytes, ElapsedTime));
+}
+
+
+
+/**
+ * @brief Show the statistics of the debug port UART
+ * @param void pointer: not used
+ * @return void
+ */
+static void uartStatistics(void *NotUsed)
+{
+    (void)NotUsed;
+    UART *Bus = &TestApp.Hardware.UART_2;
+    printf("Tx policy: %s\r\n", (Bus->Tx_Policy == UART_TX_DROP) ? "drop" : "block");
+    printf("Tx dropped: %lu bytes\r\n", (unsigned long)UART_TxDroppedBytes(Bus));
+    printf("Rx: %lu bytes, %lu overruns\r\n", (unsigned long)Bus->Rx_Bytes, (unsigned long)Bus->Rx_Overruns);
+}
+
+
+/**
+ * @brief Set what printf does when the debug port Tx ring is full
+ * @param void pointer: "block" or "drop"
+ * @return void
+ */
+static void uartPolicy(void *Policy)
+{
+    char *PolicyName = (char *)Policy;
+    if (strcmp(PolicyName, "block") == 0)
+        UART_TxPolicySet(&TestApp.Hardware.UART_2, UART_TX_BLOCK);
+    else if (strcmp(PolicyName, "drop") == 0)
+        UART_TxPolicySet(&TestApp.Hardware.UART_2, UART_TX_DROP);
+    else
+    {
+        printf("Policy must be block or drop\r\n");
+        return;
+    }
+    printf("Tx policy: %s\r\n", PolicyName);
+}
+
+/**
+ * @brief Show the OTG FS interrupt load, the idle and thread CPU load and the NAKs of each host channel since
+ * the last call, then restart the counts
+ * @param void pointer: not used
+ * @return void
+ */
+static void usbHostStatistics(void *NotUsed)
+{
+    (void)NotUsed;
+    ULONG ElapsedTicks = tx_time_get() - USB_StatsStartTick;
+    uint32_t Count = OTG_FS_IRQ_Count;
+    uint64_t Cycles = OTG_FS_IRQ_Cycles;
+    uint64_t ElapsedCycles = ((uint64_t)ElapsedTicks * SystemCoreClock) / TX_TIMER_TICKS_PER_SECOND;
+    printf("OTG FS IRQ: %lu calls in %lu ms\r\n", (unsigned long)Count, (unsigned long)((ElapsedTicks * 1000U) / TX_TIMER_TICKS_PER_SECOND));
+    uint32_t CyclesMin = (Count == 0) ? 0 : OTG_FS_IRQ_CyclesMin;
+    printf("OTG FS IRQ: %lu cycles min, %lu avg, %lu max, %lu jitter\r\n", (unsigned long)CyclesMin, (unsigned long)((Count == 0) ? 0 : (Cycles / Count)),
+           (unsigned long)OTG_FS_IRQ_CyclesMax, (unsigned long)((Count == 0) ? 0 : (OTG_FS_IRQ_CyclesMax - CyclesMin)));
+#if (USE_USB_RAM_FUNC == 1U)
+    printf("OTG FS IRQ: path in SRAM2\r\n");
+#else
+    printf("OTG FS IRQ: path in FLASH\r\n");
+#endif
+    printf("OTG FS IRQ: %lu.%02lu%% CPU\r\n", (unsigned long)((ElapsedCycles == 0) ? 0 : ((Cycles * 100U) / ElapsedCycles)),
+           (unsigned long)((ElapsedCycles == 0) ? 0 : (((Cycles * 10000U) / ElapsedCycles) % 100U)));
+
+#if defined(TX_ENABLE_EXECUTION_CHANGE_NOTIFY)
+    uint64_t IdleCycles = ExecutionProfileIdleCycles();
+    printf("CPU idle: %lu.%02lu%%\r\n", (unsigned long)((ElapsedCycles == 0) ? 0 : ((IdleCycles * 100U) / ElapsedCycles)),
+           (unsigned long)((ElapsedCycles == 0) ? 0 : (((IdleCycles * 10000U) / ElapsedCycles) % 100U)));
+    for (TX_THREAD *Thread = ExecutionProfileThreadNext(NULL); Thread != NULL; Thread = ExecutionProfileThreadNext(Thread))
+    {
+        uint64_t ThreadCycles = ExecutionProfileThreadCycles(Thread);
+        if (ThreadCycles == 0)
+            continue;
+        printf("  %s: %lu.%02lu%%\r\n", Thread->tx_thread_name, (unsigned long)((ElapsedCycles == 0) ? 0 : ((ThreadCycles * 100U) / ElapsedCycles)),
+               (unsigned long)((ElapsedCycles == 0) ? 0 : (((ThreadCycles * 10000U) / ElapsedCycles) % 100U)));
+    }
+#endif
+
+    UX_HCD *Hcd = (UX_HCD *)hhcd_USB_OTG_FS.pData;
+    UX_HCD_STM32 *HcdStm32 = (Hcd == NULL) ? NULL : (UX_HCD_STM32 *)Hcd->ux_hcd_controller_hardware;
+    (void)HcdStm32;
+#if defined(UX_HCD_STM32_NAK_BACKOFF_ENABLE)
+    if (HcdStm32 != NULL)
+    {
+        for (ULONG Channel = 0; Channel < HcdStm32->ux_hcd_stm32_nb_channels; Channel++)
+        {
+            if (HcdStm32->ux_hcd_stm32_channel_naks[Channel] == 0)
+                continue;
+            printf("Channel %lu: %lu NAKs, %lu retries deferred\r\n", (unsigned long)Channel, (unsigned long)HcdStm32->ux_hcd_stm32_channel_naks[Channel],
+                   (unsigned long)HcdStm32->ux_hcd_stm32_channel_nak_deferrals[Channel]);
+            HcdStm32->ux_hcd_stm32_channel_naks[Channel] = 0;
+            HcdStm32->ux_hcd_stm32_channel_nak_deferrals[Channel] = 0;
+        }
+    }
+#else
+    printf("NAK back-off: disabled\r\n");
+#endif
+
+#if defined(UX_HCD_STM32_DEFERRED_URB_ENABLE)
+    if (HcdStm32 != NULL)
+    {
+        printf("URB processing: %s, ring max %lu of %u, %lu overflows\r\n", (HcdStm32->ux_hcd_stm32_urb_deferred) ? "HCD thread" : "interrupt",
+               (unsigned long)HcdStm32->ux_hcd_stm32_urb_event_depth_max, (unsigned)UX_HCD_STM32_URB_EVENT_RING_SIZE, (unsigned long)HcdStm32->ux_hcd_stm32_urb_event_overflows);
+        HcdStm32->ux_hcd_stm32_urb_event_depth_max = 0;
+        HcdStm32->ux_hcd_stm32_urb_event_overflows = 0;
+    }
+#else
+    printf("URB processing: interrupt\r\n");
+#endif
+
+    // Restart the counts
+    __disable_irq();
+    OTG_FS_IRQ_Count = 0;
+    OTG_FS_IRQ_Cycles = 0;
+    OTG_FS_IRQ_CyclesMax = 0;
+    OTG_FS_IRQ_CyclesMin = UINT32_MAX;
+    __enable_irq();
+#if defined(TX_ENABLE_EXECUTION_CHANGE_NOTIFY)
+    ExecutionProfileReset();
+#endif
+    USB_StatsStartTick = tx_time_get();
+}
+
+
+/**
+ * @brief Select where the USB URB state changes are processed: the HCD thread or OTG_FS_IRQHandler.  Use
+ * "USB Stats" in each mode to compare the interrupt time.  The switch can be made during transfers.
+ * @param void pointer: "on" or "off"
+ * @return void
+ */
+static void usbDeferredURB(void *Mode)
+{
+#if defined(UX_HCD_STM32_DEFERRED_URB_ENABLE)
+    char *ModeName = (char *)Mode;
+    UX_HCD *Hcd = (UX_HCD *)hhcd_USB_OTG_FS.pData;
+    UX_HCD_STM32 *HcdStm32 = (Hcd == NULL) ? NULL : (UX_HCD_STM32 *)Hcd->ux_hcd_controller_hardware;
+    if (HcdStm32 == NULL)
+    {
+        printf("USB host not started\r\n");
+        return;
+    }
+    // Switching off drains the URB event ring first so no URB is processed ahead of an older event of its channel
+    if (strcmp(ModeName, "on") == 0)
+        ux_hcd_stm32_urb_deferred_set(HcdStm32, UX_TRUE);
+    else if (strcmp(ModeName, "off") == 0)
+        ux_hcd_stm32_urb_deferred_set(HcdStm32, UX_FALSE);
+    else
+    {
+        printf("Mode must be on or off\r\n");
+        return;
+    }
+    printf("URB processing: %s\r\n", (HcdStm32->ux_hcd_stm32_urb_deferred) ? "HCD thread" : "interrupt");
+#else
+    (void)Mode;
+    printf("Deferred URB processing not built\r\n");
+#endif
+}
+
+
+/**
+ * @brief Micro benchmark of the USB host controller driver allocation: the cycles to obtain and release an ED
+ * and a host channel, and to find the least loaded periodic slot, as more EDs and channels are in use.  The
+ * bitmap allocation (UX_HCD_STM32_BITMAP_ALLOCATION_ENABLE) should show the same cycles at every level.
+ * @note Run with no USB device attached, the EDs and channels are borrowed from the running driver
+ * @param void pointer: not used
+ * @return void
+ */
+static void usbAllocationBenchmark(void *NotUsed)
+{
+    (void)NotUsed;
+    UX_HCD *Hcd = (UX_HCD *)hhcd_USB_OTG_FS.pData;
+    UX_HCD_STM32 *HcdStm32 = (Hcd == NULL) ? NULL : (UX_HCD_STM32 *)Hcd->ux_hcd_controller_hardware;
+    UX_HCD_STM32_ED *HeldED[UX_HCD_STM32_MAX_NB_CHANNELS];
+    uint32_t HeldCount = 0;
+
+    if (HcdStm32 == NULL)
+    {
+        printf("USB host not started\r\n");
+        return;
+    }
+    for (ULONG Channel = 0; Channel < HcdStm32->ux_hcd_stm32_nb_channels; Channel++)
+    {
+        if (HcdStm32->ux_hcd_stm32_channels_ed[Channel] != NULL)
+        {
+            printf("Remove the USB device first\r\n");
+            return;
+        }
+    }
+
+#if defined(UX_HCD_STM32_BITMAP_ALLOCATION_ENABLE)
+    printf("Allocation: bitmap, %u loops\r\n", (unsigned)USB_ALLOC_BENCH_LOOPS);
+#else
+    printf("Allocation: linear scan, %u loops\r\n", (unsigned)USB_ALLOC_BENCH_LOOPS);
+#endif
+    printf("In use   Obtain+release   Least traffic (cycles)\r\n");
+    while (HeldCount < (HcdStm32->ux_hcd_stm32_nb_channels - 1U))
+    {
+        // Time with the EDs and channels in use so far
+        __disable_irq();
+        uint32_t StartCycles = DWT->CYCCNT;
+        for (uint32_t Loop = 0; Loop < USB_ALLOC_BENCH_LOOPS; Loop++)
+        {
+            UX_HCD_STM32_ED *ED = _ux_hcd_stm32_ed_obtain(HcdStm32);
+            _ux_hcd_stm32_channel_obtain(HcdStm32, ED);
+            _ux_hcd_stm32_channel_release(HcdStm32, ED);
+            _ux_hcd_stm32_ed_release(HcdStm32, ED);
+        }
+        uint32_t AllocationCycles = DWT->CYCCNT - StartCycles;
+        StartCycles = DWT->CYCCNT;
+        for (uint32_t Loop = 0; Loop < USB_ALLOC_BENCH_LOOPS; Loop++)
+            (void)_ux_hcd_stm32_least_traffic_list_get(HcdStm32);
+        uint32_t LeastTrafficCycles = DWT->CYCCNT - StartCycles;
+
+        // One more ED and channel in use for the next level
+        HeldED[HeldCount] = _ux_hcd_stm32_ed_obtain(HcdStm32);
+        if (HeldED[HeldCount] != NULL)
+            _ux_hcd_stm32_channel_obtain(HcdStm32, HeldED[HeldCount]);
+        __enable_irq();
+
+        printf("%6lu   %14lu   %13lu\r\n", (unsigned long)HeldCount, (unsigned long)(AllocationCycles / USB_ALLOC_BENCH_LOOPS),
+               (unsigned long)(LeastTrafficCycles / USB_ALLOC_BENCH_LOOPS));
+        if (HeldED[HeldCount] == NULL)
+            break;
+        HeldCount++;
+    }
+
+    // Give back the EDs and channels
+    __disable_irq();
+    while (HeldCount > 0)
+    {
+        HeldCount--;
+        _ux_hcd_stm32_channel_release(HcdStm32, HeldED[HeldCount]);
+        _ux_hcd_stm32_ed_release(HcdStm32, HeldED[HeldCount]);
+    }
+    __enable_irq();
+}
+
+
+/**
+ * @brief Benchmark of the OTG FIFO reads of USB_ReadPacket on the real bulk IN pipe of the first drive: the same
+ * sectors are read into a word aligned buffer (fast path) and into an unaligned one (byte packing path).  The OTG
+ * FS IRQ cycles per packet are those of the interrupt that empties the receive FIFO into the buffer.
+ * @note The reads go straight to ux_host_class_storage_media_read so the unaligned buffer is not bounced through
+ * the read ahead window.  The drive is locked for the bench, which stops if the drive is removed.
+ * @param void pointer: not used
+ * @return void
+ */
+static void usbFifoBenchmark(void *NotUsed)
+{
+    (void)NotUsed;
+    uint8_t Drive = USB_DriveFirst();
+    Type_USB_Drive *DriveHandle = USB_DriveLock(Drive);
+    if (DriveHandle == NULL)
+    {
+        printf("No USB Flash Drive\r\n");
+        return;
+    }
+
+    UX_HOST_CLASS_STORAGE *storage = DriveHandle->Storage;
+    UX_HOST_CLASS_STORAGE_MEDIA *StorageMedia = DriveHandle->StorageMedia;
+    ULONG SectorSize = StorageMedia->ux_host_class_storage_media_sector_size;
+    ULONG SectorsPerRead = USB_FIFO_BENCH_READ_SIZE / SectorSize;
+    if (ux_host_class_storage_lock(storage, UX_WAIT_FOREVER) != UX_SUCCESS)
+    {
+        USB_DriveUnlock(DriveHandle);
+        return;
+    }
+    storage->ux_host_class_storage_lun = StorageMedia->ux_host_class_storage_media_lun;
+    storage->ux_host_class_storage_sector_size = SectorSize;
+    storage->ux_host_class_storage_last_sector_number = StorageMedia->ux_host_class_storage_media_number_sectors - 1;
+    ULONG MaxPacketSize = storage->ux_host_class_storage_bulk_in_endpoint->ux_endpoint_descriptor.wMaxPacketSize;
+
+    printf("Drive %u: Read of %u KB in %u KB commands, %lu byte packets\r\n", Drive, (unsigned int)(USB_FIFO_BENCH_TOTAL_SIZE / 1024U),
+           (unsigned int)(USB_FIFO_BENCH_READ_SIZE / 1024U), (unsigned long)MaxPacketSize);
+    printf("Buffer      KB/s   IRQ cycles per packet\r\n");
+    for (uint32_t Offset = 0; Offset < 2U; Offset++)
+    {
+        // Offset 0 is word aligned, offset 1 is not
+        uint8_t *Buffer = &MSC_BenchBuffer[Offset];
+        ULONG Sector = StorageMedia->ux_host_class_storage_media_partition_start;
+        UINT Status = UX_SUCCESS;
+
+        __disable_irq();
+        uint32_t StartCount = OTG_FS_IRQ_Count;
+        uint64_t StartCycles = OTG_FS_IRQ_Cycles;
+        __enable_irq();
+        uint32_t StartTick = HAL_GetTick();
+        for (uint32_t BytesRead = 0; (BytesRead < USB_FIFO_BENCH_TOTAL_SIZE) && (Status == UX_SUCCESS) && !DriveHandle->Abort; BytesRead += USB_FIFO_BENCH_READ_SIZE)
+        {
+            Status = ux_host_class_storage_media_read(storage, Sector, SectorsPerRead, Buffer);
+            Sector += SectorsPerRead;
+        }
+        uint32_t ElapsedTime = HAL_GetTick() - StartTick;
+        __disable_irq();
+        uint64_t Cycles = OTG_FS_IRQ_Cycles - StartCycles;
+        uint32_t Count = OTG_FS_IRQ_Count - StartCount;
+        __enable_irq();
+
+        if ((Status != UX_SUCCESS) || DriveHandle->Abort)
+        {
+            printf("Read failed: 0x%X\r\n", (unsigned int)Status);
+            break;
+        }
+        // The IRQ count also holds the SOF, channel halt and command phase interrupts: the cycles are spread over
+        // the data packets, which is what the FIFO path changes
+        uint32_t Packets = USB_FIFO_BENCH_TOTAL_SIZE / MaxPacketSize;
+        printf("%-9s %6lu   %21lu (%lu IRQs)\r\n", (Offset == 0U) ? "Aligned" : "Unaligned", (unsigned long)((ElapsedTime == 0U) ? 0U : ((USB_FIFO_BENCH_TOTAL_SIZE / 1024U) * 1000U / ElapsedTime)),
+               (unsigned long)(Cycles / Packets), (unsigned long)Count);
+    }
+
+    ux_host_class_storage_unlock(storage);
+    USB_DriveUnlock(DriveHandle);
+}
+
+
+/**
+ * @brief Benchmark of the FileX directory search: the cycles to look up a name in a directory of 32, 128 and 512
+ * files, with the linear search and with the directory index (FX_ENABLE_DIRECTORY_INDEX).  The names looked up are
+ * not in the directory, the worst case of the linear search.  The first search after the index is enabled builds
+ * the index of the directory, its cycles are shown apart.
+ * @note The bench directory is created on the first drive and deleted at the end.  The drive is locked for the
+ * bench, which stops if the drive is removed.
+ * @param void pointer: not used
+ * @return void
+ */
+static void directoryBenchmark(void *NotUsed)
+{
+    (void)NotUsed;
+    const uint32_t DirectorySize[] = {32U, 128U, 512U};
+    Type_USB_Drive *DriveHandle = USB_DriveLock(USB_DriveFirst());
+    char FileName[32];
+    uint32_t FileCount = 0;
+
+    if (DriveHandle == NULL)
+    {
+        printf("No USB Flash Drive\r\n");
+        return;
+    }
+#if defined(UX_HOST_CLASS_STORAGE_DIRECTORY_INDEX_ENABLE)
+    FX_MEDIA *Media = DriveHandle->Media;
+    if (DriveHandle->StorageMedia->ux_host_class_storage_media_directory_index == NULL)
+    {
+        printf("No directory index for this drive\r\n");
+        USB_DriveUnlock(DriveHandle);
+        return;
+    }
+    UINT FileX_Status = fx_directory_create(Media, DIR_BENCH_DIRECTORY);
+    if ((FileX_Status != FX_SUCCESS) && (FileX_Status != FX_ALREADY_CREATED))
+    {
+        printf("Directory create failed, status 0x%02X\r\n", FileX_Status);
+        USB_DriveUnlock(DriveHandle);
+        return;
+    }
+
+    printf("Directory search, %u lookups of a missing name\r\n", (unsigned)DIR_BENCH_LOOKUPS);
+    printf("Files   Linear   Indexed   Index build (cycles)\r\n");
+    bool CreateFailed = false;
+    for (uint32_t Index = 0; (Index < (sizeof(DirectorySize) / sizeof(DirectorySize[0]))) && !CreateFailed; Index++)
+    {
+        // Grow the directory to the size of this level
+        while ((FileCount < DirectorySize[Index]) && !CreateFailed)
+        {
+            snprintf(FileName, sizeof(FileName), "%s/F%07lu.TXT", DIR_BENCH_DIRECTORY, (unsigned long)FileCount);
+            FileX_Status = fx_file_create(Media, FileName);
+            if ((FileX_Status != FX_SUCCESS) && (FileX_Status != FX_ALREADY_CREATED))
+            {
+                printf("File create failed, status 0x%02X\r\n", FileX_Status);
+                CreateFailed = true;
+            }
+            else
+                FileCount++;
+        }
+        if (CreateFailed)
+            break;
+        fx_media_flush(Media);
+
+        // Linear search: the index is detached from the media
+        fx_media_directory_index_enable(Media, NULL, 0);
+        uint32_t LinearCycles = directoryLookupCycles(Media, DIR_BENCH_LOOKUPS);
+
+        // Indexed search: the first lookup builds the index of the bench directory.  The index buffer is the one
+        // of the media now, it is freed with the media if the drive is removed
+        VOID *IndexBuffer = DriveHandle->StorageMedia->ux_host_class_storage_media_directory_index;
+        if (DriveHandle->Abort || (IndexBuffer == NULL))
+        {
+            printf("Drive removed\r\n");
+            USB_DriveUnlock(DriveHandle);
+            return;
+        }
+        fx_media_directory_index_enable(Media, IndexBuffer, UX_HOST_CLASS_STORAGE_DIRECTORY_INDEX_SIZE);
+        uint32_t BuildCycles = directoryLookupCycles(Media, 1);
+        uint32_t IndexedCycles = directoryLookupCycles(Media, DIR_BENCH_LOOKUPS);
+
+        printf("%5lu   %6lu   %7lu   %11lu\r\n", (unsigned long)FileCount, (unsigned long)(LinearCycles / DIR_BENCH_LOOKUPS),
+               (unsigned long)(IndexedCycles / DIR_BENCH_LOOKUPS), (unsigned long)BuildCycles);
+    }
+
+    // Remove the bench files and directory
+    while (FileCount > 0)
+    {
+        FileCount--;
+        snprintf(FileName, sizeof(FileName), "%s/F%07lu.TXT", DIR_BENCH_DIRECTORY, (unsigned long)FileCount);
+        fx_file_delete(Media, FileName);
+    }
+    fx_directory_delete(Media, DIR_BENCH_DIRECTORY);
+    fx_media_flush(Media);
+#else
+    (void)FileName;
+    (void)FileCount;
+    (void)DirectorySize;
+    printf("Directory index not built\r\n");
+#endif
+    USB_DriveUnlock(DriveHandle);
+}
+
+
+/**
+ * @brief Look up names that are not in the bench directory and return the cycles taken
+ * @param Media: FileX media of the drive
+ * @param Lookups: number of names to look up
+ * @return Cycles of all the lookups
+ */
+static uint32_t directoryLookupCycles(FX_MEDIA *Media, uint32_t Lookups)
+{
+    char FileName[32];
+    UINT Attributes;
+
+    uint32_t Cycles = 0;
+    for (uint32_t Lookup = 0; Lookup < Lookups; Lookup++)
+    {
+        snprintf(FileName, sizeof(FileName), "%s/M%07lu.TXT", DIR_BENCH_DIRECTORY, (unsigned long)Lookup);
+        uint32_t StartCycles = DWT->CYCCNT;
+        (void)fx_file_attributes_read(Media, FileName, &Attributes);
+        Cycles += DWT->CYCCNT - StartCycles;
+    }
+    return(Cycles);
+}
+
+
+/**
+ * @brief List a directory of the first USB drive a batch of entries at a time, then compare the cycles of a
+ * batched scan of the directory against a scan of one entry per call
+ * @param void pointer: directory path, empty or "/" for the root directory
+ * @return void
+ */
+static void directoryList(void *Path)
+{
+    char *DirectoryName = (char *)Path;
+    Type_USB_Drive *DriveHandle = USB_DriveLock(USB_DriveFirst());
+
+    if (DriveHandle == NULL)
+    {
+        printf("No USB Flash Drive\r\n");
+        return;
+    }
+#if defined(FX_ENABLE_DIRECTORY_LIST)
+    FX_MEDIA *Media = DriveHandle->Media;
+    if (DirectoryName[0] == 0)
+        DirectoryName = "/";
+
+    // List the entries, volume labels excluded
+    ULONG EntryIndex = 0;
+    UINT EntryCount;
+    UINT FileX_Status;
+    uint32_t EntryTotal = 0;
+    while ((FileX_Status = fx_directory_list_read(Media, DirectoryName, &EntryIndex, FX_VOLUME, 0, FX_NULL,
+                                                  DirListEntry, DIR_LIST_BATCH, &EntryCount)) == FX_SUCCESS)
+    {
+        for (UINT Entry = 0; Entry < EntryCount; Entry++)
+        {
+            FX_DIRECTORY_LIST_ENTRY *ListEntry = &DirListEntry[Entry];
+            UINT Date = ListEntry->fx_directory_list_entry_date;
+            UINT Time = ListEntry->fx_directory_list_entry_time;
+            printf("%04u-%02u-%02u %02u:%02u  %c %10lu  %s\r\n", ((Date >> FX_YEAR_SHIFT) & FX_YEAR_MASK) + FX_BASE_YEAR,
+                   (Date >> FX_MONTH_SHIFT) & FX_MONTH_MASK, Date & FX_DAY_MASK, (Time >> FX_HOUR_SHIFT) & FX_HOUR_MASK,
+                   (Time >> FX_MINUTE_SHIFT) & FX_MINUTE_MASK, (ListEntry->fx_directory_list_entry_attributes & FX_DIRECTORY) ? 'd' : '-',
+                   (unsigned long)ListEntry->fx_directory_list_entry_size, ListEntry->fx_directory_list_entry_name);
+        }
+        EntryTotal += EntryCount;
+    }
+    if (FileX_Status != FX_NO_MORE_ENTRIES)
+    {
+        printf("Directory list failed, status 0x%02X\r\n", FileX_Status);
+        USB_DriveUnlock(DriveHandle);
+        return;
+    }
+    printf("%lu entries\r\n", (unsigned long)EntryTotal);
+
+    // Batched scan
+    EntryIndex = 0;
+    uint32_t StartCycles = DWT->CYCCNT;
+    while (fx_directory_list_read(Media, DirectoryName, &EntryIndex, 0, 0, FX_NULL, DirListEntry, DIR_LIST_BATCH, &EntryCount) == FX_SUCCESS)
+        DO_NOTHING();
+    uint32_t BatchedCycles = DWT->CYCCNT - StartCycles;
+
+    // One entry per call, the directory is made the local path of this thread
+    FileX_Status = fx_directory_local_path_set(Media, &DirListPath, DirectoryName);
+    if (FileX_Status != FX_SUCCESS)
+    {
+        printf("Local path set failed, status 0x%02X\r\n", FileX_Status);
+        USB_DriveUnlock(DriveHandle);
+        return;
+    }
+    StartCycles = DWT->CYCCNT;
+    FileX_Status = fx_directory_first_full_entry_find(Media, DirListName, FX_NULL, FX_NULL, FX_NULL, FX_NULL, FX_NULL, FX_NULL, FX_NULL, FX_NULL);
+    while (FileX_Status == FX_SUCCESS)
+        FileX_Status = fx_directory_next_full_entry_find(Media, DirListName, FX_NULL, FX_NULL, FX_NULL, FX_NULL, FX_NULL, FX_NULL, FX_NULL, FX_NULL);
+    uint32_t PerEntryCycles = DWT->CYCCNT - StartCycles;
+    fx_directory_local_path_clear(Media);
+
+    printf("Scan cycles: %lu batched, %lu one entry per call\r\n", (unsigned long)BatchedCycles, (unsigned long)PerEntryCycles);
+#else
+    (void)DirectoryName;
+    printf("Directory list not built\r\n");
+#endif
+    USB_DriveUnlock(DriveHandle);
+}
+
+
+/**
+ * @brief Show the transfer counts and the submission to completion latency histogram of each USB host endpoint
+ * since the last call, then restart the counts.  Bucket "<2^n us" counts the latencies of n significant bits.
+ * @param void pointer: not used
+ * @return void
+ */
+static void usbEndpointStatistics(void *NotUsed)
+{
+    (void)NotUsed;
+#if defined(UX_HCD_STM32_ED_STATISTICS_ENABLE)
+    static const char *TypeName[] = { "CTRL", "ISOC", "BULK", "INTR" };
+    UX_HCD *Hcd = (UX_HCD *)hhcd_USB_OTG_FS.pData;
+    UX_HCD_STM32 *HcdStm32 = (Hcd == NULL) ? NULL : (UX_HCD_STM32 *)Hcd->ux_hcd_controller_hardware;
+    if (HcdStm32 == NULL)
+    {
+        printf("USB host not started\r\n");
+        return;
+    }
+
+    UX_HCD_STM32_ED *ED = HcdStm32->ux_hcd_stm32_ed_list;
+    for (ULONG Index = 0; Index < _ux_system_host->ux_system_host_max_ed; Index++, ED++)
+    {
+        UX_HCD_STM32_ED_STATISTICS *Stats = &ED->ux_stm32_ed_statistics;
+        if ((ED->ux_stm32_ed_status == UX_HCD_STM32_ED_STATUS_FREE) || (ED->ux_stm32_ed_endpoint == NULL) || (Stats->ux_hcd_stm32_ed_statistics_transfers == 0))
+            continue;
+        UX_ENDPOINT *Endpoint = ED->ux_stm32_ed_endpoint;
+        printf("Device %u EP 0x%02X %s: %lu transfers, %lu bytes, %lu NAKs, %lu retries, %lu errors, %lu stalls, %lu aborts\r\n",
+               (unsigned)Endpoint->ux_endpoint_device->ux_device_address, (unsigned)Endpoint->ux_endpoint_descriptor.bEndpointAddress,
+               TypeName[ED->ux_stm32_ed_type & 0x03U], (unsigned long)Stats->ux_hcd_stm32_ed_statistics_transfers,
+               (unsigned long)Stats->ux_hcd_stm32_ed_statistics_bytes, (unsigned long)Stats->ux_hcd_stm32_ed_statistics_naks,
+               (unsigned long)Stats->ux_hcd_stm32_ed_statistics_retries, (unsigned long)Stats->ux_hcd_stm32_ed_statistics_errors,
+               (unsigned long)Stats->ux_hcd_stm32_ed_statistics_stalls, (unsigned long)Stats->ux_hcd_stm32_ed_statistics_aborts);
+        printf("  latency max %lu us:", (unsigned long)Stats->ux_hcd_stm32_ed_statistics_latency_max);
+        for (ULONG Bucket = 0; Bucket < UX_HCD_STM32_LATENCY_BUCKETS; Bucket++)
+        {
+            if (Stats->ux_hcd_stm32_ed_statistics_latency[Bucket] == 0)
+                continue;
+            if (Bucket == (UX_HCD_STM32_LATENCY_BUCKETS - 1U))
+                printf(" >=2^%lu us %lu", (unsigned long)(Bucket - 1U), (unsigned long)Stats->ux_hcd_stm32_ed_statistics_latency[Bucket]);
+            else
+                printf(" <2^%lu us %lu", (unsigned long)Bucket, (unsigned long)Stats->ux_hcd_stm32_ed_statistics_latency[Bucket]);
+        }
+        printf("\r\n");
+    }
+
+    // Restart the counts
+    _ux_hcd_stm32_ed_statistics_reset(HcdStm32);
+#else
+    printf("ED statistics not built\r\n");
+#endif
+}
+
+/**
+ * @brief Report a mounted drive: the mount time and if the test file is on the media
+ * @param Drive: Drive index
+ * @return void
+ */
+static void mscDriveInserted(uint8_t Drive)
+{
+    Type_USB_Drive *DriveHandle = USB_DriveLock(Drive);
+    if (DriveHandle == NULL)
+        return;
+
+    printf("Drive %u (LUN %lu): Media Inserted\r\n", Drive, (unsigned long)DriveHandle->Lun);
+#if defined(UX_HOST_CLASS_STORAGE_ADAPTIVE_POLL_ENABLE)
+    printf("Mounted in %lu ms\r\n", (unsigned long)((ux_host_class_storage_media_mount_latency(DriveHandle->StorageMedia) * 1000U) / TX_TIMER_TICKS_PER_SECOND));
+#endif
+    printf("Test File: %s ", TEST_FILE_NAME);
+    if (FileX_FS_FileExists(DriveHandle->Media, TEST_FILE_NAME))
+        printf("Found on Flash Drive\r\n");
+    else
+        printf("NOT Found on Flash Drive\r\n");
+    USB_DriveUnlock(DriveHandle);
+}
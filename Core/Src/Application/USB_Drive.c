@@ -0,0 +1,578 @@
+/** ****************************************************************************************************
+ * @file            USB_Drive.c
+ * @brief           Registry of the mounted USB drives, each drive served by its own worker thread
+ * ****************************************************************************************************
+ * @author original Hab Collector (habco)\n
+ *
+ * @version         See Main_Support.h: FIRMWARE_REV_MAJOR, FIRMWARE_REV_MINOR
+ *
+ * @param Development_Environment \n
+ * Hardware:        STM32L4R5VGTx\n
+ * IDE:             STMCubeIDE \n
+ * Compiler:        GCC \n
+ * Editor Settings: 1 Tab = 4 Spaces, Recommended Courier New 11
+ *
+ * @note            A drive is a mounted media: a USB flash drive or one LUN of a card reader.  Drives are
+ *                  added and removed by the USBX host event callback.  Each drive has a worker thread and
+ *                  a request queue so file requests to different drives run concurrently.
+ *
+ *                  This is an embedded application
+ *                  It will be necessary to consult the reference documents to fully understand the code
+ *                  It is suggested that the documents be reviewed in the order shown.
+ *                    Schematic 002-5791-00
+ *                    Test_USB_MSC
+ *                    Design Document
+ *
+ * @copyright       Applied Concepts, Inc
+ ********************************************************************************************************/
+#include "USB_Drive.h"
+
+
+// Drive registry: the drive index is the slot index
+static Type_USB_Drive USB_Drive[USB_DRIVE_MAX];
+static TX_MUTEX USB_DriveMutex;
+
+static VOID usbDriveTask(ULONG Drive);
+static void usbDriveRelease(Type_USB_Drive *DriveHandle);
+static UINT usbDriveFileRead(Type_USB_Drive *DriveHandle, Type_USB_DriveRequest *Request);
+static UINT usbDriveFileWrite(Type_USB_Drive *DriveHandle, Type_USB_DriveRequest *Request);
+
+
+
+/*******************************************************************************************************
+* @brief Init of the drive registry.  The worker thread and request queue of every drive slot are created
+* here and wait for requests whether or not a drive is present in the slot.
+*
+* @author original: Hab Collector \n
+*
+* @note: Must be called before the USBX host reports any device
+*
+* @param void
+*
+* @return TX_SUCCESS or the ThreadX error of the failed create
+*
+* STEP 1: Create the registry mutex
+* STEP 2: Create the lock, the request queue and the worker thread of each drive
+********************************************************************************************************/
+UINT Init_USB_Drive(void)
+{
+    UINT Tx_Status;
+
+    // STEP 1: Create the registry mutex
+    Tx_Status = tx_mutex_create(&USB_DriveMutex, "USB Drive Mutex", TX_INHERIT);
+    if (Tx_Status != TX_SUCCESS)
+        return(Tx_Status);
+
+    // STEP 2: Create the lock, the request queue and the worker thread of each drive
+    for (ULONG Drive = 0; Drive < USB_DRIVE_MAX; Drive++)
+    {
+        USB_Drive[Drive].InUse = false;
+        USB_Drive[Drive].Abort = false;
+        Tx_Status = tx_mutex_create(&USB_Drive[Drive].Lock, "USB Drive Lock", TX_INHERIT);
+        if (Tx_Status != TX_SUCCESS)
+            return(Tx_Status);
+        Tx_Status = tx_queue_create(&USB_Drive[Drive].RequestQueue, "USB Drive Queue", TX_1_ULONG, USB_Drive[Drive].RequestQueueStorage, sizeof(USB_Drive[Drive].RequestQueueStorage));
+        if (Tx_Status != TX_SUCCESS)
+            return(Tx_Status);
+        Tx_Status = tx_thread_create(&USB_Drive[Drive].TaskHandler, "USB Drive", usbDriveTask, Drive, USB_Drive[Drive].TaskStack, sizeof(USB_Drive[Drive].TaskStack), USB_DRIVE_TASK_PRIORITY, USB_DRIVE_TASK_PRIORITY, TX_NO_TIME_SLICE, TX_AUTO_START);
+        if (Tx_Status != TX_SUCCESS)
+            return(Tx_Status);
+    }
+
+    return(TX_SUCCESS);
+
+} // END OF Init_USB_Drive
+
+
+
+/*******************************************************************************************************
+* @brief Add a mounted storage media to the drive registry
+*
+* @author original: Hab Collector \n
+*
+* @note: A media already in the registry keeps its drive index.  A free slot whose lock is still held, by
+* a request that did not abort within USB_DRIVE_REMOVE_WAIT, is skipped.
+*
+* @param StorageMedia: Storage media reported by the storage class
+*
+* @return The drive index or USB_DRIVE_NONE if the media is not mounted or the registry is full
+*
+* STEP 1: Check the media is mounted
+* STEP 2: Find the media in the registry or a free drive slot that is not locked
+* STEP 3: Fill the drive slot
+********************************************************************************************************/
+uint8_t USB_DriveAdd(UX_HOST_CLASS_STORAGE_MEDIA *StorageMedia)
+{
+    uint8_t FreeDrive = USB_DRIVE_NONE;
+
+    // STEP 1: Check the media is mounted
+    if ((StorageMedia == UX_NULL) || (StorageMedia->ux_host_class_storage_media_status != UX_HOST_CLASS_STORAGE_MEDIA_MOUNTED))
+        return(USB_DRIVE_NONE);
+
+    // STEP 2: Find the media in the registry or a free drive slot that is not locked
+    tx_mutex_get(&USB_DriveMutex, TX_WAIT_FOREVER);
+    for (uint8_t Drive = 0; Drive < USB_DRIVE_MAX; Drive++)
+    {
+        if (USB_Drive[Drive].InUse && (USB_Drive[Drive].StorageMedia == StorageMedia))
+        {
+            if (FreeDrive != USB_DRIVE_NONE)
+                tx_mutex_put(&USB_Drive[FreeDrive].Lock);
+            tx_mutex_put(&USB_DriveMutex);
+            return(Drive);
+        }
+        if (!USB_Drive[Drive].InUse && (FreeDrive == USB_DRIVE_NONE) && (tx_mutex_get(&USB_Drive[Drive].Lock, TX_NO_WAIT) == TX_SUCCESS))
+            FreeDrive = Drive;
+    }
+
+    // STEP 3: Fill the drive slot
+    if (FreeDrive != USB_DRIVE_NONE)
+    {
+        Type_USB_Drive *DriveHandle = &USB_Drive[FreeDrive];
+        DriveHandle->StorageMedia = StorageMedia;
+        DriveHandle->Media = &StorageMedia->ux_host_class_storage_media;
+        DriveHandle->Storage = (UX_HOST_CLASS_STORAGE *)ux_media_driver_info_get(DriveHandle->Media);
+        DriveHandle->Lun = StorageMedia->ux_host_class_storage_media_lun;
+        DriveHandle->BytesRead = 0;
+        DriveHandle->BytesWritten = 0;
+        DriveHandle->BusyTicks = 0;
+        DriveHandle->Abort = false;
+        DriveHandle->InUse = true;
+        tx_mutex_put(&DriveHandle->Lock);
+    }
+    tx_mutex_put(&USB_DriveMutex);
+
+    return(FreeDrive);
+
+} // END OF USB_DriveAdd
+
+
+
+/*******************************************************************************************************
+* @brief Remove a storage media from the drive registry
+*
+* @author original: Hab Collector \n
+*
+* @note: The media is searched by pointer as its content is no longer valid once unmounted.  Called from
+* the USBX enumeration thread, see usbDriveRelease: the wait on the running request is bounded.
+*
+* @param StorageMedia: Storage media reported by the storage class
+*
+* @return The drive index or USB_DRIVE_NONE if the media was not in the registry
+*
+* STEP 1: Find the drive of the media and free its slot
+********************************************************************************************************/
+uint8_t USB_DriveRemove(UX_HOST_CLASS_STORAGE_MEDIA *StorageMedia)
+{
+    uint8_t RemovedDrive = USB_DRIVE_NONE;
+
+    // STEP 1: Find the drive of the media and free its slot
+    tx_mutex_get(&USB_DriveMutex, TX_WAIT_FOREVER);
+    for (uint8_t Drive = 0; (StorageMedia != UX_NULL) && (Drive < USB_DRIVE_MAX); Drive++)
+    {
+        if (USB_Drive[Drive].InUse && (USB_Drive[Drive].StorageMedia == StorageMedia))
+        {
+            usbDriveRelease(&USB_Drive[Drive]);
+            RemovedDrive = Drive;
+            break;
+        }
+    }
+    tx_mutex_put(&USB_DriveMutex);
+
+    return(RemovedDrive);
+
+} // END OF USB_DriveRemove
+
+
+
+/*******************************************************************************************************
+* @brief Remove all the drives of a storage device from the drive registry, used when the device is removed
+*
+* @author original: Hab Collector \n
+*
+* @note: As USB_DriveRemove, each slot is freed by usbDriveRelease
+*
+* @param Storage: Storage instance of the removed device
+*
+* @return Bit mask of the drives removed, bit 0 for drive 0
+*
+* STEP 1: Free the slot of every drive of the storage instance
+********************************************************************************************************/
+uint32_t USB_DriveRemoveStorage(UX_HOST_CLASS_STORAGE *Storage)
+{
+    uint32_t RemovedDrives = 0;
+
+    // STEP 1: Free the slot of every drive of the storage instance
+    tx_mutex_get(&USB_DriveMutex, TX_WAIT_FOREVER);
+    for (uint8_t Drive = 0; Drive < USB_DRIVE_MAX; Drive++)
+    {
+        if (USB_Drive[Drive].InUse && (USB_Drive[Drive].Storage == Storage))
+        {
+            usbDriveRelease(&USB_Drive[Drive]);
+            RemovedDrives |= (1UL << Drive);
+        }
+    }
+    tx_mutex_put(&USB_DriveMutex);
+
+    return(RemovedDrives);
+
+} // END OF USB_DriveRemoveStorage
+
+
+
+/*******************************************************************************************************
+* @brief Free the slot of a removed drive.  The holder of the drive lock, the worker or a console command,
+* is told to abort and the lock is waited for at most USB_DRIVE_REMOVE_WAIT.
+*
+* @author original: Hab Collector \n
+*
+* @note: The media is already closed by the storage class, the FileX calls of the holder fail without
+* waiting on the bus and it stops at its next chunk.  If the lock is not released in time the slot is only
+* marked free: the enumeration thread is not held up and USB_DriveAdd skips the slot until it is unlocked.
+*
+* @param DriveHandle: Drive to free, the registry mutex is held by the caller
+*
+* @return void
+*
+* STEP 1: Tell the holder of the lock to abort
+* STEP 2: Free the slot, under the drive lock if it was released in time
+********************************************************************************************************/
+static void usbDriveRelease(Type_USB_Drive *DriveHandle)
+{
+    // STEP 1: Tell the holder of the lock to abort
+    DriveHandle->Abort = true;
+
+    // STEP 2: Free the slot, under the drive lock if it was released in time
+    if (tx_mutex_get(&DriveHandle->Lock, USB_DRIVE_REMOVE_WAIT) == TX_SUCCESS)
+    {
+        DriveHandle->InUse = false;
+        DriveHandle->Media = NULL;
+        tx_mutex_put(&DriveHandle->Lock);
+    }
+    else
+    {
+        DriveHandle->InUse = false;
+    }
+
+} // END OF usbDriveRelease
+
+
+
+/*******************************************************************************************************
+* @brief Get a drive of the registry
+*
+* @author original: Hab Collector \n
+*
+* @param Drive: Drive index
+*
+* @return Handle of the drive or NULL if there is no drive at this index
+*
+* STEP 1: Return the drive if in use
+********************************************************************************************************/
+Type_USB_Drive * USB_DriveGet(uint8_t Drive)
+{
+    // STEP 1: Return the drive if in use
+    if ((Drive >= USB_DRIVE_MAX) || !USB_Drive[Drive].InUse)
+        return(NULL);
+    return(&USB_Drive[Drive]);
+
+} // END OF USB_DriveGet
+
+
+
+/*******************************************************************************************************
+* @brief Lock a drive of the registry for a console command that uses its media directly
+*
+* @author original: Hab Collector \n
+*
+* @note: The drive is not removed while locked.  A removal sets Abort and waits USB_DRIVE_REMOVE_WAIT at
+* most for the lock, a command looping on the media must check Abort and stop when it is set.
+*
+* @param Drive: Drive index
+*
+* @return Handle of the locked drive or NULL if there is no drive at this index
+*
+* STEP 1: Take the drive lock
+* STEP 2: Release it if the drive is not in use or is being removed
+********************************************************************************************************/
+Type_USB_Drive * USB_DriveLock(uint8_t Drive)
+{
+    // STEP 1: Take the drive lock
+    if (Drive >= USB_DRIVE_MAX)
+        return(NULL);
+    Type_USB_Drive *DriveHandle = &USB_Drive[Drive];
+    tx_mutex_get(&DriveHandle->Lock, TX_WAIT_FOREVER);
+
+    // STEP 2: Release it if the drive is not in use or is being removed
+    if (!DriveHandle->InUse || DriveHandle->Abort || (DriveHandle->Media == NULL))
+    {
+        tx_mutex_put(&DriveHandle->Lock);
+        return(NULL);
+    }
+    return(DriveHandle);
+
+} // END OF USB_DriveLock
+
+
+
+/*******************************************************************************************************
+* @brief Unlock a drive locked by USB_DriveLock
+*
+* @author original: Hab Collector \n
+*
+* @param DriveHandle: Handle returned by USB_DriveLock, NULL is ignored
+*
+* @return void
+*
+* STEP 1: Forget the media if the drive was removed meanwhile and release the drive lock
+********************************************************************************************************/
+void USB_DriveUnlock(Type_USB_Drive *DriveHandle)
+{
+    // STEP 1: Forget the media if the drive was removed meanwhile and release the drive lock
+    if (DriveHandle == NULL)
+        return;
+    if (!DriveHandle->InUse)
+        DriveHandle->Media = NULL;
+    tx_mutex_put(&DriveHandle->Lock);
+
+} // END OF USB_DriveUnlock
+
+
+
+/*******************************************************************************************************
+* @brief Get the lowest drive index in use
+*
+* @author original: Hab Collector \n
+*
+* @param void
+*
+* @return The drive index or USB_DRIVE_NONE if no drive is mounted
+*
+* STEP 1: Return the first drive in use
+********************************************************************************************************/
+uint8_t USB_DriveFirst(void)
+{
+    // STEP 1: Return the first drive in use
+    for (uint8_t Drive = 0; Drive < USB_DRIVE_MAX; Drive++)
+    {
+        if (USB_Drive[Drive].InUse)
+            return(Drive);
+    }
+    return(USB_DRIVE_NONE);
+
+} // END OF USB_DriveFirst
+
+
+
+/*******************************************************************************************************
+* @brief Queue a file request to the worker thread of a drive
+*
+* @author original: Hab Collector \n
+*
+* @note: The request must stay valid until its Complete semaphore is put by the worker thread
+*
+* @param Drive: Drive index
+* @param Request: File request
+*
+* @return TX_SUCCESS if queued, TX_PTR_ERROR if there is no drive at this index
+*
+* STEP 1: Check the drive is in use
+* STEP 2: Queue the request, wait if the queue of the drive is full
+********************************************************************************************************/
+UINT USB_DriveRequest(uint8_t Drive, Type_USB_DriveRequest *Request)
+{
+    // STEP 1: Check the drive is in use
+    if ((Request == NULL) || (USB_DriveGet(Drive) == NULL))
+        return(TX_PTR_ERROR);
+
+    // STEP 2: Queue the request, wait if the queue of the drive is full
+    ULONG Message = (ULONG)Request;
+    return(tx_queue_send(&USB_Drive[Drive].RequestQueue, &Message, TX_WAIT_FOREVER));
+
+} // END OF USB_DriveRequest
+
+
+
+/*******************************************************************************************************
+* @brief Convert a byte count and a ThreadX tick count to a rate
+*
+* @author original: Hab Collector \n
+*
+* @param Bytes: Bytes transferred
+* @param Ticks: Time of the transfer in ThreadX ticks
+*
+* @return Rate in bytes per second, 0 if no time elapsed
+*
+* STEP 1: Scale with 64 bits to avoid the overflow
+********************************************************************************************************/
+uint32_t USB_DriveBytesPerSecond(uint32_t Bytes, ULONG Ticks)
+{
+    // STEP 1: Scale with 64 bits to avoid the overflow
+    if (Ticks == 0)
+        return(0);
+    return((uint32_t)(((uint64_t)Bytes * TX_TIMER_TICKS_PER_SECOND) / Ticks));
+
+} // END OF USB_DriveBytesPerSecond
+
+
+
+/*******************************************************************************************************
+* @brief Worker thread of a drive.  Runs the file requests of its drive one at a time.
+*
+* @author original: Hab Collector \n
+*
+* @note: The worker threads of the drives run at the same priority, a drive waiting on the USB bus
+* lets the others run
+*
+* @param Drive: Drive index served by this thread
+*
+* @return void
+*
+* STEP 1: Wait for a request
+* STEP 2: Run the request on the media of the drive, under the drive lock so the drive is not removed meanwhile
+* STEP 3: Account the bytes and the busy time of the drive, forget the media if removed meanwhile
+* STEP 4: Signal the requester
+********************************************************************************************************/
+static VOID usbDriveTask(ULONG Drive)
+{
+    Type_USB_Drive *DriveHandle = &USB_Drive[Drive];
+    Type_USB_DriveRequest *Request;
+    ULONG Message;
+
+    while (1)
+    {
+        // STEP 1: Wait for a request
+        tx_queue_receive(&DriveHandle->RequestQueue, &Message, TX_WAIT_FOREVER);
+        Request = (Type_USB_DriveRequest *)Message;
+        Request->BytesTransfered = 0;
+
+        // STEP 2: Run the request on the media of the drive, under the drive lock so the drive is not removed meanwhile
+        tx_mutex_get(&DriveHandle->Lock, TX_WAIT_FOREVER);
+        ULONG StartTime = tx_time_get();
+        if (!DriveHandle->InUse || DriveHandle->Abort || (DriveHandle->Media == NULL))
+            Request->FileX_Status = FX_MEDIA_NOT_OPEN;
+        else if (Request->Operation == USB_DRIVE_FILE_READ)
+            Request->FileX_Status = usbDriveFileRead(DriveHandle, Request);
+        else
+            Request->FileX_Status = usbDriveFileWrite(DriveHandle, Request);
+        Request->ElapsedTicks = tx_time_get() - StartTime;
+
+        // STEP 3: Account the bytes and the busy time of the drive, forget the media if removed meanwhile
+        if (Request->Operation == USB_DRIVE_FILE_READ)
+            DriveHandle->BytesRead += Request->BytesTransfered;
+        else
+            DriveHandle->BytesWritten += Request->BytesTransfered;
+        DriveHandle->BusyTicks += Request->ElapsedTicks;
+        if (!DriveHandle->InUse)
+            DriveHandle->Media = NULL;
+        tx_mutex_put(&DriveHandle->Lock);
+
+        // STEP 4: Signal the requester
+        if (Request->Complete != NULL)
+            tx_semaphore_put(Request->Complete);
+    }
+
+} // END OF usbDriveTask
+
+
+
+/*******************************************************************************************************
+* @brief Read a whole file of a drive through the drive buffer, the data is not kept
+*
+* @author original: Hab Collector \n
+*
+* @param DriveHandle: Drive to read from
+* @param Request: Request with the file name, the bytes read are returned in it
+*
+* @return See FileX FX return status for file read operations.  OK is FX_SUCCESS
+*
+* STEP 1: Open the file
+* STEP 2: Read until the end of the file, stop if the drive is removed
+* STEP 3: Close the file
+********************************************************************************************************/
+static UINT usbDriveFileRead(Type_USB_Drive *DriveHandle, Type_USB_DriveRequest *Request)
+{
+    FX_FILE FileHandle;
+    UINT FileX_Status;
+    ULONG BytesRead;
+
+    // STEP 1: Open the file
+    FileX_Status = fx_file_open(DriveHandle->Media, &FileHandle, Request->FileName, FX_OPEN_FOR_READ);
+    if (FileX_Status != FX_SUCCESS)
+        return(FileX_Status);
+
+    // STEP 2: Read until the end of the file, stop if the drive is removed
+    do
+    {
+        FileX_Status = fx_file_read(&FileHandle, DriveHandle->Buffer, USB_DRIVE_BUFFER_SIZE, &BytesRead);
+        if (FileX_Status == FX_SUCCESS)
+            Request->BytesTransfered += BytesRead;
+        if (DriveHandle->Abort)
+            FileX_Status = FX_MEDIA_NOT_OPEN;
+    } while ((FileX_Status == FX_SUCCESS) && (BytesRead >= USB_DRIVE_BUFFER_SIZE));
+    if (FileX_Status == FX_END_OF_FILE)
+        FileX_Status = FX_SUCCESS;
+
+    // STEP 3: Close the file
+    fx_file_close(&FileHandle);
+
+    return(FileX_Status);
+
+} // END OF usbDriveFileRead
+
+
+
+/*******************************************************************************************************
+* @brief Write a file of the requested size to a drive from the drive buffer, an existing file is replaced
+*
+* @author original: Hab Collector \n
+*
+* @param DriveHandle: Drive to write to
+* @param Request: Request with the file name and size, the bytes written are returned in it
+*
+* @return See FileX FX return status for file create and write operations.  OK is FX_SUCCESS
+*
+* STEP 1: Create the file - replace if the file exist
+* STEP 2: Open the file
+* STEP 3: Write the buffer until the requested size is written, stop if the drive is removed
+* STEP 4: Close the file and flush the media
+********************************************************************************************************/
+static UINT usbDriveFileWrite(Type_USB_Drive *DriveHandle, Type_USB_DriveRequest *Request)
+{
+    FX_FILE FileHandle;
+    UINT FileX_Status;
+
+    // STEP 1: Create the file - replace if the file exist
+    FileX_Status = fx_file_create(DriveHandle->Media, Request->FileName);
+    if (FileX_Status == FX_ALREADY_CREATED)
+    {
+        fx_file_delete(DriveHandle->Media, Request->FileName);
+        FileX_Status = fx_file_create(DriveHandle->Media, Request->FileName);
+    }
+    if (FileX_Status != FX_SUCCESS)
+        return(FileX_Status);
+
+    // STEP 2: Open the file
+    FileX_Status = fx_file_open(DriveHandle->Media, &FileHandle, Request->FileName, FX_OPEN_FOR_WRITE);
+    if (FileX_Status != FX_SUCCESS)
+        return(FileX_Status);
+
+    // STEP 3: Write the buffer until the requested size is written, stop if the drive is removed
+    while ((FileX_Status == FX_SUCCESS) && (Request->BytesTransfered < Request->Size))
+    {
+        ULONG BytesToWrite = Request->Size - Request->BytesTransfered;
+        if (BytesToWrite > USB_DRIVE_BUFFER_SIZE)
+            BytesToWrite = USB_DRIVE_BUFFER_SIZE;
+        FileX_Status = fx_file_write(&FileHandle, DriveHandle->Buffer, BytesToWrite);
+        if (FileX_Status == FX_SUCCESS)
+            Request->BytesTransfered += BytesToWrite;
+        if (DriveHandle->Abort)
+            FileX_Status = FX_MEDIA_NOT_OPEN;
+    }
+
+    // STEP 4: Close the file and flush the media
+    fx_file_close(&FileHandle);
+    fx_media_flush(DriveHandle->Media);
+
+    return(FileX_Status);
+
+} // END OF usbDriveFileWrite
@@ -41,11 +41,18 @@
 
 /* Private variables ---------------------------------------------------------*/
 /* USER CODE BEGIN PV */
+// OTG FS interrupt accounting: DWT cycles spent in OTG_FS_IRQHandler
+volatile uint32_t OTG_FS_IRQ_Count = 0;
+volatile uint64_t OTG_FS_IRQ_Cycles = 0;
+volatile uint32_t OTG_FS_IRQ_CyclesMax = 0;
+volatile uint32_t OTG_FS_IRQ_CyclesMin = UINT32_MAX;
 
 /* USER CODE END PV */
 
 /* Private function prototypes -----------------------------------------------*/
 /* USER CODE BEGIN PFP */
+// The USB host interrupt path runs from SRAM2, see __USB_RAM_FUNC in stm32l4xx_ll_usb.h
+__USB_RAM_FUNC void OTG_FS_IRQHandler(void);
 
 /* USER CODE END PFP */
 
@@ -225,10 +232,18 @@ void DMA2_Channel1_IRQHandler(void)
 void OTG_FS_IRQHandler(void)
 {
   /* USER CODE BEGIN OTG_FS_IRQn 0 */
+  uint32_t IRQ_StartCycles = DWT->CYCCNT;
 
   /* USER CODE END OTG_FS_IRQn 0 */
   HAL_HCD_IRQHandler(&hhcd_USB_OTG_FS);
   /* USER CODE BEGIN OTG_FS_IRQn 1 */
+  uint32_t IRQ_Cycles = DWT->CYCCNT - IRQ_StartCycles;
+  OTG_FS_IRQ_Count++;
+  OTG_FS_IRQ_Cycles += IRQ_Cycles;
+  if (IRQ_Cycles > OTG_FS_IRQ_CyclesMax)
+    OTG_FS_IRQ_CyclesMax = IRQ_Cycles;
+  if (IRQ_Cycles < OTG_FS_IRQ_CyclesMin)
+    OTG_FS_IRQ_CyclesMin = IRQ_Cycles;
 
   /* USER CODE END OTG_FS_IRQn 1 */
 }
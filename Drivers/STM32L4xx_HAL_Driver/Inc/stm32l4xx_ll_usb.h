@@ -504,6 +504,18 @@ typedef USB_HCTypeDef       USB_OTG_HCTypeDef;
 
 #define CLEAR_IN_EP_INTR(__EPNUM__, __INTERRUPT__)          (USBx_INEP(__EPNUM__)->DIEPINT = (__INTERRUPT__))
 #define CLEAR_OUT_EP_INTR(__EPNUM__, __INTERRUPT__)         (USBx_OUTEP(__EPNUM__)->DOEPINT = (__INTERRUPT__))
+
+/* The host interrupt and transfer completion path is executed from SRAM2 (.ramfunc section
+   copied by the startup code). Define USE_USB_RAM_FUNC to 0 to execute it from FLASH */
+#ifndef USE_USB_RAM_FUNC
+#define USE_USB_RAM_FUNC                                    1U
+#endif /* USE_USB_RAM_FUNC */
+
+#if (USE_USB_RAM_FUNC == 1U)
+#define __USB_RAM_FUNC                                      __attribute__((section(".ramfunc")))
+#else
+#define __USB_RAM_FUNC
+#endif /* USE_USB_RAM_FUNC */
 #endif /* defined (USB_OTG_FS) */
 /**
   * @}
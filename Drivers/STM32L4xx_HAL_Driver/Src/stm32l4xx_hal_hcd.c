@@ -358,7 +358,7 @@ __weak void  HAL_HCD_MspDeInit(HCD_HandleTypeDef *hhcd)
   *           0 : do ping inactive / 1 : do ping active
   * @retval HAL status
   */
-HAL_StatusTypeDef HAL_HCD_HC_SubmitRequest(HCD_HandleTypeDef *hhcd,
+__USB_RAM_FUNC HAL_StatusTypeDef HAL_HCD_HC_SubmitRequest(HCD_HandleTypeDef *hhcd,
                                            uint8_t ch_num,
                                            uint8_t direction,
                                            uint8_t ep_type,
@@ -488,7 +488,7 @@ HAL_StatusTypeDef HAL_HCD_HC_SubmitRequest(HCD_HandleTypeDef *hhcd,
   * @param  hhcd HCD handle
   * @retval None
   */
-void HAL_HCD_IRQHandler(HCD_HandleTypeDef *hhcd)
+__USB_RAM_FUNC void HAL_HCD_IRQHandler(HCD_HandleTypeDef *hhcd)
 {
   USB_OTG_GlobalTypeDef *USBx = hhcd->Instance;
   uint32_t USBx_BASE = (uint32_t)USBx;
@@ -593,6 +593,12 @@ void HAL_HCD_IRQHandler(HCD_HandleTypeDef *hhcd)
       __HAL_HCD_CLEAR_FLAG(hhcd, USB_OTG_GINTSTS_HCINT);
     }
 
+    /* Handle Non-Periodic TxFIFO Empty Interrupt */
+    if (__HAL_HCD_GET_FLAG(hhcd, USB_OTG_GINTSTS_NPTXFE))
+    {
+      HAL_HCD_NPTxFifoEmpty_Callback(hhcd);
+    }
+
     /* Handle Rx Queue Level Interrupts */
     if ((__HAL_HCD_GET_FLAG(hhcd, USB_OTG_GINTSTS_RXFLVL)) != 0U)
     {
@@ -651,6 +657,23 @@ __weak void HAL_HCD_Disconnect_Callback(HCD_HandleTypeDef *hhcd)
    */
 }
 
+/**
+  * @brief  Non-Periodic TxFIFO Empty callback.
+  * @note   The interrupt is unmasked by the host channel OUT transfer that needs more FIFO space,
+  *         the callback must write the FIFO or mask the interrupt.
+  * @param  hhcd HCD handle
+  * @retval None
+  */
+__weak void HAL_HCD_NPTxFifoEmpty_Callback(HCD_HandleTypeDef *hhcd)
+{
+  /* Nothing to write, mask the interrupt */
+  hhcd->Instance->GINTMSK &= ~USB_OTG_GINTMSK_NPTXFEM;
+
+  /* NOTE : This function should not be modified, when the callback is needed,
+            the HAL_HCD_NPTxFifoEmpty_Callback could be implemented in the user file
+   */
+}
+
 /**
   * @brief  Port Enabled  Event callback.
   * @param  hhcd HCD handle
@@ -1204,7 +1227,7 @@ HAL_StatusTypeDef HAL_HCD_HC_ClearHubInfo(HCD_HandleTypeDef *hhcd, uint8_t ch_nu
   *         This parameter can be a value from 1 to 15
   * @retval none
   */
-static void HCD_HC_IN_IRQHandler(HCD_HandleTypeDef *hhcd, uint8_t chnum)
+__USB_RAM_FUNC static void HCD_HC_IN_IRQHandler(HCD_HandleTypeDef *hhcd, uint8_t chnum)
 {
   const USB_OTG_GlobalTypeDef *USBx = hhcd->Instance;
   uint32_t USBx_BASE = (uint32_t)USBx;
@@ -1420,7 +1443,7 @@ static void HCD_HC_IN_IRQHandler(HCD_HandleTypeDef *hhcd, uint8_t chnum)
   *         This parameter can be a value from 1 to 15
   * @retval none
   */
-static void HCD_HC_OUT_IRQHandler(HCD_HandleTypeDef *hhcd, uint8_t chnum)
+__USB_RAM_FUNC static void HCD_HC_OUT_IRQHandler(HCD_HandleTypeDef *hhcd, uint8_t chnum)
 {
   const USB_OTG_GlobalTypeDef *USBx = hhcd->Instance;
   uint32_t USBx_BASE = (uint32_t)USBx;
@@ -1561,7 +1584,7 @@ static void HCD_HC_OUT_IRQHandler(HCD_HandleTypeDef *hhcd, uint8_t chnum)
   * @param  hhcd HCD handle
   * @retval none
   */
-static void HCD_RXQLVL_IRQHandler(HCD_HandleTypeDef *hhcd)
+__USB_RAM_FUNC static void HCD_RXQLVL_IRQHandler(HCD_HandleTypeDef *hhcd)
 {
   const USB_OTG_GlobalTypeDef *USBx = hhcd->Instance;
   uint32_t USBx_BASE = (uint32_t)USBx;
@@ -55,6 +55,10 @@
 /* Private functions ---------------------------------------------------------*/
 #if defined (USB_OTG_FS)
 static HAL_StatusTypeDef USB_CoreReset(USB_OTG_GlobalTypeDef *USBx);
+static void USB_WriteFifoAligned(__IO uint32_t *pFifo, const uint32_t *pSrc, uint32_t count32b);
+static void USB_WriteFifoUnaligned(__IO uint32_t *pFifo, const uint8_t *pSrc, uint32_t count32b);
+static void USB_ReadFifoAligned(__IO uint32_t *pFifo, uint32_t *pDest, uint32_t count32b);
+static void USB_ReadFifoUnaligned(__IO uint32_t *pFifo, uint8_t *pDest, uint32_t count32b);
 
 /* Exported functions --------------------------------------------------------*/
 /** @defgroup USB_LL_Exported_Functions USB Low Layer Exported Functions
@@ -875,22 +879,23 @@ HAL_StatusTypeDef USB_EPStopXfer(const USB_OTG_GlobalTypeDef *USBx, USB_OTG_EPTy
   * @param  len  Number of bytes to write
   * @retval HAL status
   */
-HAL_StatusTypeDef USB_WritePacket(const USB_OTG_GlobalTypeDef *USBx, uint8_t *src,
+__USB_RAM_FUNC HAL_StatusTypeDef USB_WritePacket(const USB_OTG_GlobalTypeDef *USBx, uint8_t *src,
                                   uint8_t ch_ep_num, uint16_t len)
 {
   uint32_t USBx_BASE = (uint32_t)USBx;
-  uint8_t *pSrc = src;
+  __IO uint32_t *pFifo = &USBx_DFIFO((uint32_t)ch_ep_num);
   uint32_t count32b;
-  uint32_t i;
 
   count32b = ((uint32_t)len + 3U) / 4U;
-  for (i = 0U; i < count32b; i++)
+
+  /* Word aligned buffers are copied a burst of words at a time */
+  if (((uint32_t)src & 3U) == 0U)
   {
-    USBx_DFIFO((uint32_t)ch_ep_num) = __UNALIGNED_UINT32_READ(pSrc);
-    pSrc++;
-    pSrc++;
-    pSrc++;
-    pSrc++;
+    USB_WriteFifoAligned(pFifo, (const uint32_t *)src, count32b);
+  }
+  else
+  {
+    USB_WriteFifoUnaligned(pFifo, src, count32b);
   }
 
   return HAL_OK;
@@ -903,23 +908,26 @@ HAL_StatusTypeDef USB_WritePacket(const USB_OTG_GlobalTypeDef *USBx, uint8_t *sr
   * @param  len  Number of bytes to read
   * @retval pointer to destination buffer
   */
-void *USB_ReadPacket(const USB_OTG_GlobalTypeDef *USBx, uint8_t *dest, uint16_t len)
+__USB_RAM_FUNC void *USB_ReadPacket(const USB_OTG_GlobalTypeDef *USBx, uint8_t *dest, uint16_t len)
 {
   uint32_t USBx_BASE = (uint32_t)USBx;
+  __IO uint32_t *pFifo = &USBx_DFIFO(0U);
   uint8_t *pDest = dest;
   uint32_t pData;
   uint32_t i;
   uint32_t count32b = (uint32_t)len >> 2U;
   uint16_t remaining_bytes = len % 4U;
 
-  for (i = 0U; i < count32b; i++)
+  /* Word aligned buffers are copied a burst of words at a time */
+  if (((uint32_t)dest & 3U) == 0U)
   {
-    __UNALIGNED_UINT32_WRITE(pDest, USBx_DFIFO(0U));
-    pDest++;
-    pDest++;
-    pDest++;
-    pDest++;
+    USB_ReadFifoAligned(pFifo, (uint32_t *)dest, count32b);
   }
+  else
+  {
+    USB_ReadFifoUnaligned(pFifo, dest, count32b);
+  }
+  pDest += count32b * 4U;
 
   /* When Number of data is not word aligned, read the remaining byte */
   if (remaining_bytes != 0U)
@@ -939,6 +947,130 @@ void *USB_ReadPacket(const USB_OTG_GlobalTypeDef *USBx, uint8_t *dest, uint16_t
   return ((void *)pDest);
 }
 
+/**
+  * @brief  USB_WriteFifoAligned : write words from a word aligned buffer into a Tx FIFO
+  * @note   Four words are loaded at once (LDM) then pushed, any address of the
+  *         FIFO window pushes the same FIFO
+  * @param  pFifo  FIFO window of the EP/channel
+  * @param  pSrc   word aligned source buffer
+  * @param  count32b  Number of words to write
+  * @retval None
+  */
+__USB_RAM_FUNC static void USB_WriteFifoAligned(__IO uint32_t *pFifo, const uint32_t *pSrc, uint32_t count32b)
+{
+  const uint32_t *pWord = pSrc;
+  uint32_t remaining = count32b;
+  uint32_t data0;
+  uint32_t data1;
+  uint32_t data2;
+  uint32_t data3;
+
+  while (remaining >= 4U)
+  {
+    data0 = pWord[0];
+    data1 = pWord[1];
+    data2 = pWord[2];
+    data3 = pWord[3];
+    pFifo[0] = data0;
+    pFifo[1] = data1;
+    pFifo[2] = data2;
+    pFifo[3] = data3;
+    pWord += 4U;
+    remaining -= 4U;
+  }
+
+  while (remaining != 0U)
+  {
+    *pFifo = *pWord;
+    pWord++;
+    remaining--;
+  }
+}
+
+/**
+  * @brief  USB_WriteFifoUnaligned : write words from a buffer of any alignment into a Tx FIFO
+  * @param  pFifo  FIFO window of the EP/channel
+  * @param  pSrc   source buffer
+  * @param  count32b  Number of words to write
+  * @retval None
+  */
+__USB_RAM_FUNC static void USB_WriteFifoUnaligned(__IO uint32_t *pFifo, const uint8_t *pSrc, uint32_t count32b)
+{
+  const uint8_t *pByte = pSrc;
+  uint32_t i;
+
+  for (i = 0U; i < count32b; i++)
+  {
+    *pFifo = __UNALIGNED_UINT32_READ(pByte);
+    pByte++;
+    pByte++;
+    pByte++;
+    pByte++;
+  }
+}
+
+/**
+  * @brief  USB_ReadFifoAligned : read words from the Rx FIFO into a word aligned buffer
+  * @note   Four words are popped then stored at once (STM), any address of the
+  *         FIFO window pops the same FIFO
+  * @param  pFifo  Rx FIFO window
+  * @param  pDest  word aligned destination buffer
+  * @param  count32b  Number of words to read
+  * @retval None
+  */
+__USB_RAM_FUNC static void USB_ReadFifoAligned(__IO uint32_t *pFifo, uint32_t *pDest, uint32_t count32b)
+{
+  uint32_t *pWord = pDest;
+  uint32_t remaining = count32b;
+  uint32_t data0;
+  uint32_t data1;
+  uint32_t data2;
+  uint32_t data3;
+
+  while (remaining >= 4U)
+  {
+    data0 = pFifo[0];
+    data1 = pFifo[1];
+    data2 = pFifo[2];
+    data3 = pFifo[3];
+    pWord[0] = data0;
+    pWord[1] = data1;
+    pWord[2] = data2;
+    pWord[3] = data3;
+    pWord += 4U;
+    remaining -= 4U;
+  }
+
+  while (remaining != 0U)
+  {
+    *pWord = *pFifo;
+    pWord++;
+    remaining--;
+  }
+}
+
+/**
+  * @brief  USB_ReadFifoUnaligned : read words from the Rx FIFO into a buffer of any alignment
+  * @param  pFifo  Rx FIFO window
+  * @param  pDest  destination buffer
+  * @param  count32b  Number of words to read
+  * @retval None
+  */
+__USB_RAM_FUNC static void USB_ReadFifoUnaligned(__IO uint32_t *pFifo, uint8_t *pDest, uint32_t count32b)
+{
+  uint8_t *pByte = pDest;
+  uint32_t i;
+
+  for (i = 0U; i < count32b; i++)
+  {
+    __UNALIGNED_UINT32_WRITE(pByte, *pFifo);
+    pByte++;
+    pByte++;
+    pByte++;
+    pByte++;
+  }
+}
+
 /**
   * @brief  USB_EPSetStall : set a stall condition over an EP
   * @param  USBx  Selected device
@@ -1095,7 +1227,7 @@ HAL_StatusTypeDef USB_DevDisconnect(const USB_OTG_GlobalTypeDef *USBx)
   * @param  USBx  Selected device
   * @retval USB Global Interrupt status
   */
-uint32_t USB_ReadInterrupts(USB_OTG_GlobalTypeDef const *USBx)
+__USB_RAM_FUNC uint32_t USB_ReadInterrupts(USB_OTG_GlobalTypeDef const *USBx)
 {
   uint32_t tmpreg;
 
@@ -1111,7 +1243,7 @@ uint32_t USB_ReadInterrupts(USB_OTG_GlobalTypeDef const *USBx)
   * @param  chnum Channel number
   * @retval USB Channel Interrupt status
   */
-uint32_t USB_ReadChInterrupts(const USB_OTG_GlobalTypeDef *USBx, uint8_t chnum)
+__USB_RAM_FUNC uint32_t USB_ReadChInterrupts(const USB_OTG_GlobalTypeDef *USBx, uint8_t chnum)
 {
   uint32_t USBx_BASE = (uint32_t)USBx;
   uint32_t tmpreg;
@@ -1213,7 +1345,7 @@ void  USB_ClearInterrupts(USB_OTG_GlobalTypeDef *USBx, uint32_t interrupt)
   *           0 : Host
   *           1 : Device
   */
-uint32_t USB_GetMode(const USB_OTG_GlobalTypeDef *USBx)
+__USB_RAM_FUNC uint32_t USB_GetMode(const USB_OTG_GlobalTypeDef *USBx)
 {
   return ((USBx->GINTSTS) & 0x1U);
 }
@@ -1620,7 +1752,7 @@ HAL_StatusTypeDef USB_HC_Init(USB_OTG_GlobalTypeDef *USBx, uint8_t ch_num,
   * @param  hc  pointer to host channel structure
   * @retval HAL state
   */
-HAL_StatusTypeDef USB_HC_StartXfer(USB_OTG_GlobalTypeDef *USBx, USB_OTG_HCTypeDef *hc)
+__USB_RAM_FUNC HAL_StatusTypeDef USB_HC_StartXfer(USB_OTG_GlobalTypeDef *USBx, USB_OTG_HCTypeDef *hc)
 {
   uint32_t USBx_BASE = (uint32_t)USBx;
   uint32_t ch_num = (uint32_t)hc->ch_num;
@@ -1730,7 +1862,7 @@ HAL_StatusTypeDef USB_HC_StartXfer(USB_OTG_GlobalTypeDef *USBx, USB_OTG_HCTypeDe
   * @param  USBx  Selected device
   * @retval HAL state
   */
-uint32_t USB_HC_ReadInterrupt(const USB_OTG_GlobalTypeDef *USBx)
+__USB_RAM_FUNC uint32_t USB_HC_ReadInterrupt(const USB_OTG_GlobalTypeDef *USBx)
 {
   uint32_t USBx_BASE = (uint32_t)USBx;
 
@@ -1744,7 +1876,7 @@ uint32_t USB_HC_ReadInterrupt(const USB_OTG_GlobalTypeDef *USBx)
   *         This parameter can be a value from 1 to 15
   * @retval HAL state
   */
-HAL_StatusTypeDef USB_HC_Halt(const USB_OTG_GlobalTypeDef *USBx, uint8_t hc_num)
+__USB_RAM_FUNC HAL_StatusTypeDef USB_HC_Halt(const USB_OTG_GlobalTypeDef *USBx, uint8_t hc_num)
 {
   uint32_t USBx_BASE = (uint32_t)USBx;
   uint32_t hcnum = (uint32_t)hc_num;
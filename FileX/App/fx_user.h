@@ -231,6 +231,49 @@ The FX_FAULT_TOLERANT_CACHE_SIZE is 2 power of FX_FAULT_TOLERANT_CACHE_SIZE_NB_S
 
 /* USER CODE BEGIN 2 */
 
+/* Defines the number of logical sectors cached per media. The USB media are given a 32K sector cache,
+   64 sectors of 512 bytes, more entries would only enlarge each FX_MEDIA.  */
+
+#define FX_MAX_SECTOR_CACHE               64
+
+/* Defined, each open file keeps a map of its cluster extents that is built as the FAT chain is
+   walked, so seeks and sequential reads within mapped clusters do not read the FAT.  */
+
+#define FX_ENABLE_FILE_EXTENT_CACHE
+
+/* Defines the number of extents in the map of each open file. Fragments beyond this number are
+   located by reading the FAT.  */
+
+#define FX_FILE_EXTENT_CACHE_SIZE         16
+
+/* Defined, a media can be given a buffer for a bitmap of its free clusters with
+   fx_media_cluster_bitmap_set before it is opened. The bitmap is filled in the FAT pass of the
+   open. Cluster allocation then skips used clusters without reading the FAT.  */
+
+#define FX_ENABLE_CLUSTER_BITMAP
+
+/* Defined, a media can be given a buffer with fx_media_directory_index_enable to hold a hash
+   index of the names in its most recently searched directories. A directory search then reads
+   only the entries with the hash of the name. Each open starts without the buffer.  */
+
+#define FX_ENABLE_DIRECTORY_INDEX
+
+/* Defines the number of directories indexed at once per media.  */
+
+#define FX_DIRECTORY_INDEX_MAX_DIRECTORIES 4
+
+/* Defined, each media remembers the directory entries of its most recently resolved directory
+   paths, so opening files in the same subdirectory does not read the parent directories again.
+   The paths are forgotten on rename, delete, media open and close. Each path keeps a copy of the
+   directory name, FX_MAX_LONG_NAME_LEN bytes in FX_MEDIA.  */
+
+#define FX_ENABLE_PATH_CACHE
+
+/* Defined, fx_directory_list_read returns many directory entries per call in a caller array,
+   read in one pass over the directory sectors and optionally filtered by attribute or name prefix.  */
+
+#define FX_ENABLE_DIRECTORY_LIST
+
 /* USER CODE END 2 */
 
 #endif
@@ -0,0 +1,131 @@
+/** ****************************************************************************************************
+ * @file            HostTest.c
+ * @brief           ThreadX start up and checks shared by the host tests
+ * ****************************************************************************************************
+ * @author original Hab Collector (habco)\n
+ *
+ * @version         See Main_Support.h: FIRMWARE_REV_MAJOR, FIRMWARE_REV_MINOR
+ *
+ * @param Development_Environment \n
+ * Hardware:        Linux host (off-target build)\n
+ * IDE:             CMake \n
+ * Compiler:        GCC \n
+ * Editor Settings: 1 Tab = 4 Spaces, Recommended Courier New 11
+ *
+ * @note            Each host test is a program that enters ThreadX and runs HostTest_Run in a thread.  The
+ *                  process exits with 0 once HostTest_Run returns, or with 1 at the first failed check, which
+ *                  is what ctest looks at.
+ *
+ * @copyright       Applied Concepts, Inc
+ ********************************************************************************************************/
+#include "HostTest.h"
+#include <time.h>
+
+
+static TX_THREAD HostTestThread;
+static ULONG64 HostTestThreadStack[HOST_TEST_THREAD_STACK_SIZE / sizeof(ULONG64)];
+
+static VOID hostTestTask(ULONG Parameter);
+
+
+
+/*******************************************************************************************************
+* @brief Enter ThreadX, it does not return
+*
+* @author original: Hab Collector \n
+*
+* @return Does not return: the test thread ends the process
+********************************************************************************************************/
+int main(void)
+{
+    setvbuf(stdout, NULL, _IONBF, 0);
+    tx_kernel_enter();
+    return(1);
+}
+
+
+
+/*******************************************************************************************************
+* @brief ThreadX application define: create the test thread
+*
+* @author original: Hab Collector \n
+*
+* @param FirstUnusedMemory: Not used, the tests use static memory
+*
+* @return void
+********************************************************************************************************/
+VOID tx_application_define(VOID *FirstUnusedMemory)
+{
+    (void)FirstUnusedMemory;
+
+    if (tx_thread_create(&HostTestThread, "Host Test", hostTestTask, 0, HostTestThreadStack, sizeof(HostTestThreadStack), HOST_TEST_THREAD_PRIORITY, HOST_TEST_THREAD_PRIORITY, TX_NO_TIME_SLICE, TX_AUTO_START) != TX_SUCCESS)
+        HostTest_Fail(__FILE__, __LINE__, "test thread create");
+}
+
+
+
+/*******************************************************************************************************
+* @brief Report a failed check and end the process with a failure
+*
+* @author original: Hab Collector \n
+*
+* @param File: Source file of the check
+* @param Line: Source line of the check
+* @param Message: What was checked
+*
+* @return Does not return
+********************************************************************************************************/
+void HostTest_Fail(const char *File, int Line, const char *Message)
+{
+    printf("FAIL %s:%d: %s\n", File, Line, Message);
+    exit(1);
+}
+
+
+
+/*******************************************************************************************************
+* @brief Time of the host monotonic clock.  The ThreadX tick is too coarse to time a transfer on the host.
+*
+* @author original: Hab Collector \n
+*
+* @return Microseconds since an arbitrary point
+********************************************************************************************************/
+ULONG64 HostTest_Microseconds(void)
+{
+    struct timespec Now;
+
+    clock_gettime(CLOCK_MONOTONIC, &Now);
+    return(((ULONG64)Now.tv_sec * 1000000ULL) + ((ULONG64)Now.tv_nsec / 1000ULL));
+}
+
+
+
+/*******************************************************************************************************
+* @brief Throughput of a transfer
+*
+* @author original: Hab Collector \n
+*
+* @param Bytes: Bytes transferred
+* @param Microseconds: Duration of the transfer
+*
+* @return KB/s, rounded down
+********************************************************************************************************/
+ULONG HostTest_KBytesPerSecond(ULONG64 Bytes, ULONG64 Microseconds)
+{
+    if (Microseconds == 0)
+        Microseconds = 1;
+
+    return((ULONG)((Bytes * 1000000ULL) / (Microseconds * 1024ULL)));
+}
+
+
+
+// Thread running the test
+static VOID hostTestTask(ULONG Parameter)
+{
+    (void)Parameter;
+
+    HostTest_Run();
+    printf("PASS\n");
+    exit(0);
+}
@@ -0,0 +1,47 @@
+/** ****************************************************************************************************
+ * @file            HostTest.h
+ * @brief           This is the Header file used to support HostTest.c
+ * ****************************************************************************************************
+ * @author original Hab Collector (habco) \n
+ *
+ * @version         See Main_Support.h: FIRMWARE_REV_MAJOR, FIRMWARE_REV_MINOR
+ *
+ * @param Development_Environment \n
+ * Hardware:        Linux host (off-target build)\n
+ * IDE:             CMake \n
+ * Compiler:        GCC \n
+ * Editor Settings: 1 Tab = 4 Spaces, Recommended Courier New 11
+ *
+ * @note            See source file for notes
+ *
+ * @copyright       Applied Concepts, Inc
+ ****************************************************************************************************** */
+#ifndef HOST_HOST_TEST_H_
+#define HOST_HOST_TEST_H_
+
+#ifdef __cplusplus
+extern"C" {
+#endif
+
+#include "tx_api.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+// DEFINES
+#define HOST_TEST_THREAD_STACK_SIZE         8192U
+#define HOST_TEST_THREAD_PRIORITY           15U
+
+// Fail the test with the file and line of the check
+#define HOST_TEST_CHECK(Condition, Message) do { if (!(Condition)) HostTest_Fail(__FILE__, __LINE__, Message); } while (0)
+
+
+// FUNCTION PROTOTYPES
+void HostTest_Run(void);
+void HostTest_Fail(const char *File, int Line, const char *Message);
+ULONG64 HostTest_Microseconds(void);
+ULONG HostTest_KBytesPerSecond(ULONG64 Bytes, ULONG64 Microseconds);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* HOST_HOST_TEST_H_ */
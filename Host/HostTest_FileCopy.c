@@ -0,0 +1,243 @@
+/** ****************************************************************************************************
+ * @file            HostTest_FileCopy.c
+ * @brief           Drive to drive file copy test between two RAM disks
+ * ****************************************************************************************************
+ * @author original Hab Collector (habco)\n
+ *
+ * @version         See Main_Support.h: FIRMWARE_REV_MAJOR, FIRMWARE_REV_MINOR
+ *
+ * @param Development_Environment \n
+ * Hardware:        Linux host (off-target build)\n
+ * IDE:             CMake \n
+ * Compiler:        GCC \n
+ * Editor Settings: 1 Tab = 4 Spaces, Recommended Courier New 11
+ *
+ * @note            FileX_FS_FileCopyDriveToDrive and FileX_FS_FileCopyDriveToDrivePipelined copy files of several
+ *                  sizes from one RAM disk to another.  Each copy is compared byte for byte with its source and
+ *                  with the count returned in TotalBytesTransfered, and both are held to the ForceOverwrite
+ *                  contract: an existing destination is kept when false and replaced when true.
+ *
+ * @copyright       Applied Concepts, Inc
+ ********************************************************************************************************/
+#include "HostTest.h"
+#include "RamDisk.h"
+#include "FileX_FS.h"
+#include <string.h>
+
+
+// DEFINES
+#define FILE_COPY_IMAGE_SIZE                (4UL * 1024UL * 1024UL)
+#define FILE_COPY_MEDIA_MEMORY_SIZE         (4UL * 1024UL)
+#define FILE_COPY_BLOCK_SIZE                (4UL * 1024UL)
+#define FILE_COPY_BLOCK_COUNT               FILE_COPY_PIPELINE_DEPTH
+#define FILE_COPY_LARGE_SIZE                (1024UL * 1024UL)
+#define FILE_COPY_OLD_SIZE                  (300UL * 1024UL + 77UL)
+#define FILE_COPY_SOURCE_NAME               "SOURCE.BIN"
+#define FILE_COPY_DESTINATION_NAME          "COPY.BIN"
+#define FILE_COPY_OLD_SEED                  0x5AUL
+#define FILE_COPY_SOURCE_SEED               0x00UL
+
+// A copy function under test: the serial one is wrapped to look like the pipelined one
+typedef UINT (*Type_FileCopyFunction)(FX_MEDIA *DestinationMedia, char *DestinationFileName, FX_MEDIA *SourceMedia, char *SourceFileName, TX_BLOCK_POOL *BlockPool, ULONG BlockPoolBlockSize, uint32_t *TotalBytesTransfered, bool ForceOverwrite, uint32_t *BytesPerSecond);
+
+
+static uint8_t SourceImage[FILE_COPY_IMAGE_SIZE];
+static uint8_t DestinationImage[FILE_COPY_IMAGE_SIZE];
+static ULONG64 SourceMediaMemory[FILE_COPY_MEDIA_MEMORY_SIZE / sizeof(ULONG64)];
+static ULONG64 DestinationMediaMemory[FILE_COPY_MEDIA_MEMORY_SIZE / sizeof(ULONG64)];
+static ULONG64 BlockPoolMemory[(FILE_COPY_BLOCK_COUNT * (FILE_COPY_BLOCK_SIZE + sizeof(VOID *))) / sizeof(ULONG64)];
+static uint8_t WriteBuffer[FILE_COPY_BLOCK_SIZE];
+static uint8_t ReadBuffer[FILE_COPY_BLOCK_SIZE];
+static FX_MEDIA SourceMedia;
+static FX_MEDIA DestinationMedia;
+static TX_BLOCK_POOL BlockPool;
+
+// File sizes around the block size: empty, short, exactly one and several blocks, a partial last block
+static const ULONG FileCopySize[] = {0UL, 1UL, FILE_COPY_BLOCK_SIZE - 1UL, FILE_COPY_BLOCK_SIZE, 3UL * FILE_COPY_BLOCK_SIZE, FILE_COPY_LARGE_SIZE + 513UL};
+
+static UINT fileCopySerial(FX_MEDIA *DestinationMedia, char *DestinationFileName, FX_MEDIA *SourceMedia, char *SourceFileName, TX_BLOCK_POOL *BlockPool, ULONG BlockPoolBlockSize, uint32_t *TotalBytesTransfered, bool ForceOverwrite, uint32_t *BytesPerSecond);
+static void fileCopyRun(const char *Name, Type_FileCopyFunction FileCopy);
+static void fileCopyPattern(uint8_t *Buffer, ULONG Seed, ULONG Offset, ULONG Length);
+static UINT fileCopyFileWrite(FX_MEDIA *Media, CHAR *FileName, ULONG Seed, ULONG FileSize);
+static UINT fileCopyFileCheck(FX_MEDIA *Media, CHAR *FileName, ULONG Seed, ULONG FileSize);
+
+
+
+/*******************************************************************************************************
+* @brief File copy test
+*
+* @author original: Hab Collector \n
+*
+* STEP 1: Format and open the source and the destination RAM disks
+* STEP 2: Create the block pool of the copy buffers
+* STEP 3: Run the copy checks with the serial and with the pipelined copy
+* STEP 4: Both disks still open and consistent after all the copies
+********************************************************************************************************/
+void HostTest_Run(void)
+{
+    // STEP 1: Format and open the source and the destination RAM disks
+    fx_system_initialize();
+    HOST_TEST_CHECK(RamDisk_Format(&SourceMedia, SourceImage, FILE_COPY_IMAGE_SIZE, (uint8_t *)SourceMediaMemory, sizeof(SourceMediaMemory), "SOURCE") == FX_SUCCESS, "source format");
+    HOST_TEST_CHECK(RamDisk_Format(&DestinationMedia, DestinationImage, FILE_COPY_IMAGE_SIZE, (uint8_t *)DestinationMediaMemory, sizeof(DestinationMediaMemory), "DEST") == FX_SUCCESS, "destination format");
+    HOST_TEST_CHECK(fx_media_open(&SourceMedia, "Source", RamDisk_Driver, SourceImage, SourceMediaMemory, sizeof(SourceMediaMemory)) == FX_SUCCESS, "source open");
+    HOST_TEST_CHECK(fx_media_open(&DestinationMedia, "Destination", RamDisk_Driver, DestinationImage, DestinationMediaMemory, sizeof(DestinationMediaMemory)) == FX_SUCCESS, "destination open");
+
+    // STEP 2: Create the block pool of the copy buffers
+    HOST_TEST_CHECK(tx_block_pool_create(&BlockPool, "File Copy Blocks", FILE_COPY_BLOCK_SIZE, BlockPoolMemory, sizeof(BlockPoolMemory)) == TX_SUCCESS, "block pool create");
+    HOST_TEST_CHECK(BlockPool.tx_block_pool_total == FILE_COPY_BLOCK_COUNT, "block pool size");
+
+    // STEP 3: Run the copy checks with the serial and with the pipelined copy
+    fileCopyRun("Serial", fileCopySerial);
+    fileCopyRun("Pipelined", FileX_FS_FileCopyDriveToDrivePipelined);
+
+    // STEP 4: Both disks still open and consistent after all the copies
+    HOST_TEST_CHECK(fx_media_close(&SourceMedia) == FX_SUCCESS, "source close");
+    HOST_TEST_CHECK(fx_media_close(&DestinationMedia) == FX_SUCCESS, "destination close");
+    HOST_TEST_CHECK(fx_media_open(&DestinationMedia, "Destination", RamDisk_Driver, DestinationImage, DestinationMediaMemory, sizeof(DestinationMediaMemory)) == FX_SUCCESS, "destination reopen");
+    HOST_TEST_CHECK(fileCopyFileCheck(&DestinationMedia, FILE_COPY_DESTINATION_NAME, FILE_COPY_SOURCE_SEED, FileCopySize[(sizeof(FileCopySize) / sizeof(FileCopySize[0])) - 1]) == FX_SUCCESS, "last copy in the image");
+    fx_media_close(&DestinationMedia);
+}
+
+
+
+/*******************************************************************************************************
+* @brief Copy checks of one copy function
+*
+* @author original: Hab Collector \n
+*
+* @param Name: Name of the copy function in the test output
+* @param FileCopy: The copy function
+*
+* STEP 1: A missing source file is reported and leaves nothing transferred
+* STEP 2: For each size: an existing destination is kept without ForceOverwrite
+* STEP 3: With ForceOverwrite the destination is replaced by an exact copy of the source
+* STEP 4: The destination was flushed by the copy: the image holds the copy
+* STEP 5: All the copy buffers are back in the block pool
+********************************************************************************************************/
+static void fileCopyRun(const char *Name, Type_FileCopyFunction FileCopy)
+{
+    uint32_t TotalBytesTransfered;
+    uint32_t BytesPerSecond;
+    ULONG64 StartTime;
+    ULONG64 ElapsedTime;
+    UINT FileX_Status;
+
+    // STEP 1: A missing source file is reported and leaves nothing transferred
+    TotalBytesTransfered = 1;
+    FileX_Status = FileCopy(&DestinationMedia, FILE_COPY_DESTINATION_NAME, &SourceMedia, "MISSING.BIN", &BlockPool, FILE_COPY_BLOCK_SIZE, &TotalBytesTransfered, true, &BytesPerSecond);
+    HOST_TEST_CHECK(FileX_Status == FX_NOT_FOUND, "missing source reported");
+    HOST_TEST_CHECK(TotalBytesTransfered == 0, "nothing transferred from a missing source");
+
+    for (ULONG SizeIndex = 0; SizeIndex < (sizeof(FileCopySize) / sizeof(FileCopySize[0])); SizeIndex++)
+    {
+        ULONG FileSize = FileCopySize[SizeIndex];
+
+        // STEP 2: For each size: an existing destination is kept without ForceOverwrite
+        HOST_TEST_CHECK(fileCopyFileWrite(&SourceMedia, FILE_COPY_SOURCE_NAME, FILE_COPY_SOURCE_SEED, FileSize) == FX_SUCCESS, "source file write");
+        HOST_TEST_CHECK(fileCopyFileWrite(&DestinationMedia, FILE_COPY_DESTINATION_NAME, FILE_COPY_OLD_SEED, FILE_COPY_OLD_SIZE) == FX_SUCCESS, "old destination file write");
+        TotalBytesTransfered = 1;
+        FileX_Status = FileCopy(&DestinationMedia, FILE_COPY_DESTINATION_NAME, &SourceMedia, FILE_COPY_SOURCE_NAME, &BlockPool, FILE_COPY_BLOCK_SIZE, &TotalBytesTransfered, false, &BytesPerSecond);
+        HOST_TEST_CHECK(FileX_Status == FX_ALREADY_CREATED, "existing destination reported");
+        HOST_TEST_CHECK(TotalBytesTransfered == 0, "nothing transferred without overwrite");
+        HOST_TEST_CHECK(fileCopyFileCheck(&DestinationMedia, FILE_COPY_DESTINATION_NAME, FILE_COPY_OLD_SEED, FILE_COPY_OLD_SIZE) == FX_SUCCESS, "existing destination kept");
+
+        // STEP 3: With ForceOverwrite the destination is replaced by an exact copy of the source
+        StartTime = HostTest_Microseconds();
+        FileX_Status = FileCopy(&DestinationMedia, FILE_COPY_DESTINATION_NAME, &SourceMedia, FILE_COPY_SOURCE_NAME, &BlockPool, FILE_COPY_BLOCK_SIZE, &TotalBytesTransfered, true, &BytesPerSecond);
+        ElapsedTime = HostTest_Microseconds() - StartTime;
+        HOST_TEST_CHECK(FileX_Status == FX_SUCCESS, "copy with overwrite");
+        HOST_TEST_CHECK(TotalBytesTransfered == FileSize, "bytes transferred");
+        HOST_TEST_CHECK(fileCopyFileCheck(&DestinationMedia, FILE_COPY_DESTINATION_NAME, FILE_COPY_SOURCE_SEED, FileSize) == FX_SUCCESS, "copy matches the source");
+        HOST_TEST_CHECK(fileCopyFileCheck(&SourceMedia, FILE_COPY_SOURCE_NAME, FILE_COPY_SOURCE_SEED, FileSize) == FX_SUCCESS, "source unchanged");
+        if (FileSize >= FILE_COPY_LARGE_SIZE)
+            printf("%s copy of %lu bytes in %llu us: %lu KB/s\n", Name, (unsigned long)FileSize, ElapsedTime, (unsigned long)HostTest_KBytesPerSecond(FileSize, ElapsedTime));
+
+        // STEP 4: The destination was flushed by the copy: the image holds the copy
+        HOST_TEST_CHECK(fx_media_cache_invalidate(&DestinationMedia) == FX_SUCCESS, "destination cache invalidate");
+        HOST_TEST_CHECK(fileCopyFileCheck(&DestinationMedia, FILE_COPY_DESTINATION_NAME, FILE_COPY_SOURCE_SEED, FileSize) == FX_SUCCESS, "copy flushed to the image");
+    }
+
+    // STEP 5: All the copy buffers are back in the block pool
+    HOST_TEST_CHECK(BlockPool.tx_block_pool_available == FILE_COPY_BLOCK_COUNT, "copy buffers released");
+}
+
+
+
+// FileX_FS_FileCopyDriveToDrive with the rate measured around the call, as the Copy Test console command does
+static UINT fileCopySerial(FX_MEDIA *DestinationMedia, char *DestinationFileName, FX_MEDIA *SourceMedia, char *SourceFileName, TX_BLOCK_POOL *BlockPool, ULONG BlockPoolBlockSize, uint32_t *TotalBytesTransfered, bool ForceOverwrite, uint32_t *BytesPerSecond)
+{
+    ULONG StartTime = tx_time_get();
+    UINT FileX_Status = FileX_FS_FileCopyDriveToDrive(DestinationMedia, DestinationFileName, SourceMedia, SourceFileName, BlockPool, BlockPoolBlockSize, TotalBytesTransfered, ForceOverwrite);
+    ULONG ElapsedTime = tx_time_get() - StartTime;
+    *BytesPerSecond = (ElapsedTime == 0) ? 0 : (uint32_t)(((uint64_t)*TotalBytesTransfered * TX_TIMER_TICKS_PER_SECOND) / ElapsedTime);
+
+    return(FileX_Status);
+}
+
+
+
+// Content of a test file: every byte depends on its offset and on the seed of the file
+static void fileCopyPattern(uint8_t *Buffer, ULONG Seed, ULONG Offset, ULONG Length)
+{
+    for (ULONG Index = 0; Index < Length; Index++)
+        Buffer[Index] = (uint8_t)((((Offset + Index) * 13UL) ^ ((Offset + Index) >> 11)) + Seed);
+}
+
+
+
+// Create a test file of the given size, an existing file is replaced
+static UINT fileCopyFileWrite(FX_MEDIA *Media, CHAR *FileName, ULONG Seed, ULONG FileSize)
+{
+    FX_FILE File;
+    ULONG Length;
+    UINT Status;
+
+    Status = fx_file_create(Media, FileName);
+    if ((Status != FX_SUCCESS) && (Status != FX_ALREADY_CREATED))
+        return(Status);
+    Status = fx_file_open(Media, &File, FileName, FX_OPEN_FOR_WRITE);
+    if (Status != FX_SUCCESS)
+        return(Status);
+    Status = fx_file_truncate_release(&File, 0);
+    for (ULONG Offset = 0; (Status == FX_SUCCESS) && (Offset < FileSize); Offset += Length)
+    {
+        Length = ((FileSize - Offset) < sizeof(WriteBuffer)) ? (FileSize - Offset) : sizeof(WriteBuffer);
+        fileCopyPattern(WriteBuffer, Seed, Offset, Length);
+        Status = fx_file_write(&File, WriteBuffer, Length);
+    }
+    fx_file_close(&File);
+    if (Status == FX_SUCCESS)
+        Status = fx_media_flush(Media);
+
+    return(Status);
+}
+
+
+
+// Compare a test file with its pattern, the file must have exactly the given size
+static UINT fileCopyFileCheck(FX_MEDIA *Media, CHAR *FileName, ULONG Seed, ULONG FileSize)
+{
+    FX_FILE File;
+    ULONG Length;
+    ULONG ActualSize;
+    UINT Status;
+
+    Status = fx_file_open(Media, &File, FileName, FX_OPEN_FOR_READ);
+    if (Status != FX_SUCCESS)
+        return(Status);
+    if (File.fx_file_current_file_size != FileSize)
+        Status = FX_IO_ERROR;
+    for (ULONG Offset = 0; (Status == FX_SUCCESS) && (Offset < FileSize); Offset += Length)
+    {
+        Length = ((FileSize - Offset) < sizeof(ReadBuffer)) ? (FileSize - Offset) : sizeof(ReadBuffer);
+        Status = fx_file_read(&File, ReadBuffer, Length, &ActualSize);
+        if ((Status == FX_SUCCESS) && (ActualSize != Length))
+            Status = FX_END_OF_FILE;
+        fileCopyPattern(WriteBuffer, Seed, Offset, Length);
+        if ((Status == FX_SUCCESS) && (memcmp(ReadBuffer, WriteBuffer, Length) != 0))
+            Status = FX_IO_ERROR;
+    }
+    fx_file_close(&File);
+
+    return(Status);
+}
@@ -0,0 +1,259 @@
+/** ****************************************************************************************************
+ * @file            HostTest_VirtualMSC.c
+ * @brief           USBX host mass storage test over the virtual MSC controller
+ * ****************************************************************************************************
+ * @author original Hab Collector (habco)\n
+ *
+ * @version         See Main_Support.h: FIRMWARE_REV_MAJOR, FIRMWARE_REV_MINOR
+ *
+ * @param Development_Environment \n
+ * Hardware:        Linux host (off-target build)\n
+ * IDE:             CMake \n
+ * Compiler:        GCC \n
+ * Editor Settings: 1 Tab = 4 Spaces, Recommended Courier New 11
+ *
+ * @note            The USBX host stack and its storage class run with the options of USBX/App/ux_user.h on a
+ *                  RAM image served by the virtual MSC controller.  The test mounts the image through USB,
+ *                  writes and reads back a file, runs the same read with device latency, NAKs and a stalled
+ *                  command, then pulls the device and checks the file in the image itself.
+ *
+ * @copyright       Applied Concepts, Inc
+ ********************************************************************************************************/
+#include "HostTest.h"
+#include "RamDisk.h"
+#include "ux_api.h"
+#include "ux_host_class_storage.h"
+#include "ux_hcd_virtual_msc.h"
+#include <string.h>
+
+
+// DEFINES
+#define VIRTUAL_MSC_IMAGE_SIZE              (8UL * 1024UL * 1024UL)
+#define VIRTUAL_MSC_FILE_SIZE               (512UL * 1024UL)
+#define VIRTUAL_MSC_CHUNK_SIZE              (16UL * 1024UL)
+#define VIRTUAL_MSC_LATENCY_SIZE            (32UL * 1024UL)
+#define VIRTUAL_MSC_REGULAR_MEMORY_SIZE     (256UL * 1024UL)
+#define VIRTUAL_MSC_CACHE_SAFE_MEMORY_SIZE  (1024UL * 1024UL)
+#define VIRTUAL_MSC_MEDIA_MEMORY_SIZE       (4UL * 1024UL)
+#define VIRTUAL_MSC_WAIT_TICKS              (5UL * TX_TIMER_TICKS_PER_SECOND)
+#define VIRTUAL_MSC_EVENT_INSERTED          0x01UL
+#define VIRTUAL_MSC_EVENT_REMOVED           0x02UL
+#define VIRTUAL_MSC_FILE_NAME               "VIRTUAL.BIN"
+
+
+static uint8_t Image[VIRTUAL_MSC_IMAGE_SIZE];
+static ULONG64 RegularMemory[VIRTUAL_MSC_REGULAR_MEMORY_SIZE / sizeof(ULONG64)];
+static ULONG64 CacheSafeMemory[VIRTUAL_MSC_CACHE_SAFE_MEMORY_SIZE / sizeof(ULONG64)];
+static ULONG64 MediaMemory[VIRTUAL_MSC_MEDIA_MEMORY_SIZE / sizeof(ULONG64)];
+static uint8_t WriteBuffer[VIRTUAL_MSC_CHUNK_SIZE];
+static uint8_t ReadBuffer[VIRTUAL_MSC_CHUNK_SIZE];
+static uint8_t UnalignedBuffer[VIRTUAL_MSC_CHUNK_SIZE + 1] __attribute__((aligned(4)));
+static FX_MEDIA RamDiskMedia;
+static TX_EVENT_FLAGS_GROUP VirtualMSC_Event;
+static UX_HOST_CLASS_STORAGE_MEDIA *VirtualMSC_StorageMedia;
+
+// The HCD parameter is a ULONG: the configuration is static, its address is below 4 GB in a non PIE program
+static UX_HCD_VIRTUAL_MSC_CONFIG VirtualMSC_Config =
+{
+    .ux_hcd_virtual_msc_config_image = Image,
+    .ux_hcd_virtual_msc_config_block_count = VIRTUAL_MSC_IMAGE_SIZE / RAM_DISK_SECTOR_SIZE,
+    .ux_hcd_virtual_msc_config_block_size = RAM_DISK_SECTOR_SIZE,
+    .ux_hcd_virtual_msc_config_max_packet_size = UX_HCD_VIRTUAL_MSC_HIGH_SPEED_MAX_PACKET_SIZE,
+    .ux_hcd_virtual_msc_config_stall_opcode = UX_HCD_VIRTUAL_MSC_NO_STALL,
+};
+
+static UINT virtualMSC_Event(ULONG Event, UX_HOST_CLASS *CurrentClass, VOID *CurrentInstance);
+static void virtualMSC_Pattern(uint8_t *Buffer, ULONG Offset, ULONG Length);
+static UINT virtualMSC_FileWrite(FX_MEDIA *Media, ULONG FileSize);
+static UINT virtualMSC_FileCheck(FX_MEDIA *Media, ULONG FileSize);
+
+
+
+/*******************************************************************************************************
+* @brief Virtual MSC test
+*
+* @author original: Hab Collector \n
+*
+* STEP 1: Format the image the virtual device serves
+* STEP 2: Start the USBX host with the storage class and the virtual MSC controller
+* STEP 3: Wait for the storage class to mount the media
+* STEP 4: Write a file through USB and read it back, also into an unaligned buffer
+* STEP 5: Read again with device latency and NAKs
+* STEP 6: A stalled READ(10) fails the read, the next read recovers
+* STEP 7: Pull the device and wait for the media to be released
+* STEP 8: The file is in the image
+********************************************************************************************************/
+void HostTest_Run(void)
+{
+    UX_HCD *Hcd;
+    UX_HCD_VIRTUAL_MSC *VirtualMSC;
+    FX_FILE File;
+    ULONG Flags;
+    ULONG ActualSize;
+    ULONG64 StartTime;
+    ULONG64 ElapsedTime;
+    ULONG Naks;
+
+    // STEP 1: Format the image the virtual device serves
+    fx_system_initialize();
+    HOST_TEST_CHECK(RamDisk_Format(&RamDiskMedia, Image, VIRTUAL_MSC_IMAGE_SIZE, (uint8_t *)MediaMemory, sizeof(MediaMemory), "VIRTUAL") == FX_SUCCESS, "image format");
+
+    // STEP 2: Start the USBX host with the storage class and the virtual MSC controller
+    HOST_TEST_CHECK(tx_event_flags_create(&VirtualMSC_Event, "Virtual MSC Event") == TX_SUCCESS, "event flags create");
+    HOST_TEST_CHECK(ux_system_initialize(RegularMemory, sizeof(RegularMemory), CacheSafeMemory, sizeof(CacheSafeMemory)) == UX_SUCCESS, "USBX system initialize");
+    HOST_TEST_CHECK(ux_host_stack_initialize(virtualMSC_Event) == UX_SUCCESS, "USBX host initialize");
+    HOST_TEST_CHECK(ux_host_stack_class_register(_ux_system_host_class_storage_name, ux_host_class_storage_entry) == UX_SUCCESS, "storage class register");
+    HOST_TEST_CHECK(ux_host_stack_hcd_register((UCHAR *)"virtual msc", ux_hcd_virtual_msc_initialize, 0, (ULONG)(ALIGN_TYPE)&VirtualMSC_Config) == UX_SUCCESS, "virtual MSC register");
+    Hcd = &_ux_system_host->ux_system_host_hcd_array[0];
+    VirtualMSC = (UX_HCD_VIRTUAL_MSC *)Hcd->ux_hcd_controller_hardware;
+
+    // STEP 3: Wait for the storage class to mount the media
+    HOST_TEST_CHECK(tx_event_flags_get(&VirtualMSC_Event, VIRTUAL_MSC_EVENT_INSERTED, TX_OR_CLEAR, &Flags, VIRTUAL_MSC_WAIT_TICKS) == TX_SUCCESS, "media mounted");
+    HOST_TEST_CHECK(VirtualMSC_StorageMedia != NULL, "storage media reported");
+    FX_MEDIA *Media = &VirtualMSC_StorageMedia->ux_host_class_storage_media;
+    printf("Mounted %lu sectors of %lu bytes\n", (unsigned long)Media->fx_media_total_sectors, (unsigned long)Media->fx_media_bytes_per_sector);
+
+    // STEP 4: Write a file through USB and read it back, also into an unaligned buffer
+    StartTime = HostTest_Microseconds();
+    HOST_TEST_CHECK(virtualMSC_FileWrite(Media, VIRTUAL_MSC_FILE_SIZE) == FX_SUCCESS, "file write");
+    ElapsedTime = HostTest_Microseconds() - StartTime;
+    printf("Write %lu bytes in %llu us: %lu KB/s\n", VIRTUAL_MSC_FILE_SIZE, ElapsedTime, (unsigned long)HostTest_KBytesPerSecond(VIRTUAL_MSC_FILE_SIZE, ElapsedTime));
+    StartTime = HostTest_Microseconds();
+    HOST_TEST_CHECK(virtualMSC_FileCheck(Media, VIRTUAL_MSC_FILE_SIZE) == FX_SUCCESS, "file read back");
+    ElapsedTime = HostTest_Microseconds() - StartTime;
+    printf("Read %lu bytes in %llu us: %lu KB/s\n", VIRTUAL_MSC_FILE_SIZE, ElapsedTime, (unsigned long)HostTest_KBytesPerSecond(VIRTUAL_MSC_FILE_SIZE, ElapsedTime));
+    HOST_TEST_CHECK(VirtualMSC->ux_hcd_virtual_msc_bytes_written >= VIRTUAL_MSC_FILE_SIZE, "bytes written by the device");
+    HOST_TEST_CHECK(fx_media_cache_invalidate(Media) == FX_SUCCESS, "cache invalidate");
+    HOST_TEST_CHECK(fx_file_open(Media, &File, VIRTUAL_MSC_FILE_NAME, FX_OPEN_FOR_READ) == FX_SUCCESS, "open for the unaligned read");
+    HOST_TEST_CHECK(fx_file_read(&File, &UnalignedBuffer[1], VIRTUAL_MSC_CHUNK_SIZE, &ActualSize) == FX_SUCCESS, "unaligned read");
+    fx_file_close(&File);
+    virtualMSC_Pattern(WriteBuffer, 0, sizeof(WriteBuffer));
+    HOST_TEST_CHECK((ActualSize == VIRTUAL_MSC_CHUNK_SIZE) && (memcmp(&UnalignedBuffer[1], WriteBuffer, VIRTUAL_MSC_CHUNK_SIZE) == 0), "unaligned read data");
+
+    // STEP 5: Read again with device latency and NAKs
+    Naks = VirtualMSC->ux_hcd_virtual_msc_naks;
+    VirtualMSC_Config.ux_hcd_virtual_msc_config_latency_ms = 10;
+    VirtualMSC_Config.ux_hcd_virtual_msc_config_nak_period = 4;
+    VirtualMSC_Config.ux_hcd_virtual_msc_config_nak_frames = 3;
+    StartTime = HostTest_Microseconds();
+    HOST_TEST_CHECK(virtualMSC_FileCheck(Media, VIRTUAL_MSC_LATENCY_SIZE) == FX_SUCCESS, "file read with latency and NAKs");
+    ElapsedTime = HostTest_Microseconds() - StartTime;
+    printf("Read %lu bytes with latency and NAKs in %llu us: %lu KB/s\n", VIRTUAL_MSC_LATENCY_SIZE, ElapsedTime, (unsigned long)HostTest_KBytesPerSecond(VIRTUAL_MSC_LATENCY_SIZE, ElapsedTime));
+    HOST_TEST_CHECK(VirtualMSC->ux_hcd_virtual_msc_naks > Naks, "NAKs counted");
+    VirtualMSC_Config.ux_hcd_virtual_msc_config_latency_ms = 0;
+    VirtualMSC_Config.ux_hcd_virtual_msc_config_nak_period = 0;
+    VirtualMSC_Config.ux_hcd_virtual_msc_config_nak_frames = 0;
+
+    // STEP 6: A stalled READ(10) fails the read, the next read recovers
+    HOST_TEST_CHECK(fx_media_cache_invalidate(Media) == FX_SUCCESS, "cache invalidate");
+    HOST_TEST_CHECK(fx_file_open(Media, &File, VIRTUAL_MSC_FILE_NAME, FX_OPEN_FOR_READ) == FX_SUCCESS, "open for the stall");
+    VirtualMSC_Config.ux_hcd_virtual_msc_config_stall_opcode = UX_HCD_VIRTUAL_MSC_SCSI_READ10;
+    HOST_TEST_CHECK(fx_file_read(&File, ReadBuffer, sizeof(ReadBuffer), &ActualSize) != FX_SUCCESS, "stalled read fails");
+    VirtualMSC_Config.ux_hcd_virtual_msc_config_stall_opcode = UX_HCD_VIRTUAL_MSC_NO_STALL;
+    fx_file_close(&File);
+    HOST_TEST_CHECK(virtualMSC_FileCheck(Media, VIRTUAL_MSC_CHUNK_SIZE) == FX_SUCCESS, "read after the stall");
+
+    // STEP 7: Pull the device and wait for the media to be released
+    HOST_TEST_CHECK(fx_media_flush(Media) == FX_SUCCESS, "media flush");
+    ux_hcd_virtual_msc_device_connect(Hcd, UX_FALSE);
+    HOST_TEST_CHECK(tx_event_flags_get(&VirtualMSC_Event, VIRTUAL_MSC_EVENT_REMOVED, TX_OR_CLEAR, &Flags, VIRTUAL_MSC_WAIT_TICKS) == TX_SUCCESS, "media released");
+
+    // STEP 8: The file is in the image
+    HOST_TEST_CHECK(fx_media_open(&RamDiskMedia, "RAM Disk", RamDisk_Driver, Image, MediaMemory, sizeof(MediaMemory)) == FX_SUCCESS, "image open");
+    HOST_TEST_CHECK(virtualMSC_FileCheck(&RamDiskMedia, VIRTUAL_MSC_FILE_SIZE) == FX_SUCCESS, "file in the image");
+    fx_media_close(&RamDiskMedia);
+}
+
+
+
+// USBX host event callback: report the media of the storage device
+static UINT virtualMSC_Event(ULONG Event, UX_HOST_CLASS *CurrentClass, VOID *CurrentInstance)
+{
+    UX_HOST_CLASS_STORAGE_MEDIA *StorageMedia;
+
+    if ((CurrentClass == UX_NULL) || (CurrentClass->ux_host_class_entry_function != ux_host_class_storage_entry))
+        return(UX_SUCCESS);
+
+    if (Event == UX_DEVICE_INSERTION)
+    {
+        StorageMedia = (UX_HOST_CLASS_STORAGE_MEDIA *)CurrentClass->ux_host_class_media;
+        for (UINT MediaIndex = 0; MediaIndex < UX_HOST_CLASS_STORAGE_MAX_MEDIA; MediaIndex++, StorageMedia++)
+        {
+            if (ux_media_driver_info_get(&StorageMedia->ux_host_class_storage_media) == CurrentInstance)
+            {
+                VirtualMSC_StorageMedia = StorageMedia;
+                tx_event_flags_set(&VirtualMSC_Event, VIRTUAL_MSC_EVENT_INSERTED, TX_OR);
+                break;
+            }
+        }
+    }
+    else if (Event == UX_DEVICE_REMOVAL)
+    {
+        VirtualMSC_StorageMedia = NULL;
+        tx_event_flags_set(&VirtualMSC_Event, VIRTUAL_MSC_EVENT_REMOVED, TX_OR);
+    }
+
+    return(UX_SUCCESS);
+}
+
+
+
+// Content of the test file: every byte depends on its offset
+static void virtualMSC_Pattern(uint8_t *Buffer, ULONG Offset, ULONG Length)
+{
+    for (ULONG Index = 0; Index < Length; Index++)
+        Buffer[Index] = (uint8_t)(((Offset + Index) * 7UL) ^ ((Offset + Index) >> 9));
+}
+
+
+
+// Create the test file
+static UINT virtualMSC_FileWrite(FX_MEDIA *Media, ULONG FileSize)
+{
+    FX_FILE File;
+    UINT Status;
+
+    Status = fx_file_create(Media, VIRTUAL_MSC_FILE_NAME);
+    if ((Status != FX_SUCCESS) && (Status != FX_ALREADY_CREATED))
+        return(Status);
+    Status = fx_file_open(Media, &File, VIRTUAL_MSC_FILE_NAME, FX_OPEN_FOR_WRITE);
+    if (Status != FX_SUCCESS)
+        return(Status);
+    Status = fx_file_truncate(&File, 0);
+    for (ULONG Offset = 0; (Status == FX_SUCCESS) && (Offset < FileSize); Offset += sizeof(WriteBuffer))
+    {
+        virtualMSC_Pattern(WriteBuffer, Offset, sizeof(WriteBuffer));
+        Status = fx_file_write(&File, WriteBuffer, sizeof(WriteBuffer));
+    }
+    fx_file_close(&File);
+    if (Status == FX_SUCCESS)
+        Status = fx_media_flush(Media);
+
+    return(Status);
+}
+
+
+
+// Compare the start of the test file with its pattern
+static UINT virtualMSC_FileCheck(FX_MEDIA *Media, ULONG FileSize)
+{
+    FX_FILE File;
+    ULONG ActualSize;
+    UINT Status;
+
+    Status = fx_file_open(Media, &File, VIRTUAL_MSC_FILE_NAME, FX_OPEN_FOR_READ);
+    if (Status != FX_SUCCESS)
+        return(Status);
+    for (ULONG Offset = 0; (Status == FX_SUCCESS) && (Offset < FileSize); Offset += sizeof(ReadBuffer))
+    {
+        Status = fx_file_read(&File, ReadBuffer, sizeof(ReadBuffer), &ActualSize);
+        if ((Status == FX_SUCCESS) && (ActualSize != sizeof(ReadBuffer)))
+            Status = FX_END_OF_FILE;
+        virtualMSC_Pattern(WriteBuffer, Offset, sizeof(WriteBuffer));
+        if ((Status == FX_SUCCESS) && (memcmp(ReadBuffer, WriteBuffer, sizeof(ReadBuffer)) != 0))
+            Status = FX_IO_ERROR;
+    }
+    fx_file_close(&File);
+
+    return(Status);
+}
@@ -0,0 +1,111 @@
+/** ****************************************************************************************************
+ * @file            RamDisk.c
+ * @brief           FileX driver of a disk image held in host memory
+ * ****************************************************************************************************
+ * @author original Hab Collector (habco)\n
+ *
+ * @version         See Main_Support.h: FIRMWARE_REV_MAJOR, FIRMWARE_REV_MINOR
+ *
+ * @param Development_Environment \n
+ * Hardware:        Linux host (off-target build)\n
+ * IDE:             CMake \n
+ * Compiler:        GCC \n
+ * Editor Settings: 1 Tab = 4 Spaces, Recommended Courier New 11
+ *
+ * @note            The image is passed to fx_media_open or fx_media_format as the driver info.  The same
+ *                  image can be formatted here and then served to USBX by the virtual MSC controller, or
+ *                  opened here to check what the USB side wrote to it.
+ *
+ * @copyright       Applied Concepts, Inc
+ ********************************************************************************************************/
+#include "RamDisk.h"
+#include <string.h>
+
+
+/*******************************************************************************************************
+* @brief FileX driver entry of the RAM disk.  The image starts with the boot sector, there is no partition
+* table.
+*
+* @author original: Hab Collector \n
+*
+* @note: The image must be at least as large as the media described by its boot sector
+*
+* @param MediaPtr: The media the request is for, fx_media_driver_info is the image
+*
+* @return void: The outcome is in fx_media_driver_status
+*
+* STEP 1: Locate the sectors of the request in the image
+* STEP 2: Process the request
+********************************************************************************************************/
+VOID RamDisk_Driver(FX_MEDIA *MediaPtr)
+{
+    uint8_t *Image = (uint8_t *)MediaPtr->fx_media_driver_info;
+    uint8_t *Sector;
+    ULONG Bytes;
+
+    // STEP 1: Locate the sectors of the request in the image
+    Sector = Image + ((MediaPtr->fx_media_driver_logical_sector + MediaPtr->fx_media_hidden_sectors) * MediaPtr->fx_media_bytes_per_sector);
+    Bytes = MediaPtr->fx_media_driver_sectors * MediaPtr->fx_media_bytes_per_sector;
+
+    // STEP 2: Process the request
+    switch (MediaPtr->fx_media_driver_request)
+    {
+        case FX_DRIVER_READ:
+            memcpy(MediaPtr->fx_media_driver_buffer, Sector, Bytes);
+            MediaPtr->fx_media_driver_status = FX_SUCCESS;
+            break;
+
+        case FX_DRIVER_WRITE:
+            memcpy(Sector, MediaPtr->fx_media_driver_buffer, Bytes);
+            MediaPtr->fx_media_driver_status = FX_SUCCESS;
+            break;
+
+        case FX_DRIVER_BOOT_READ:
+            // The boot sector is not known yet: the sector size is the one of the RAM disk
+            memcpy(MediaPtr->fx_media_driver_buffer, Image, RAM_DISK_SECTOR_SIZE);
+            MediaPtr->fx_media_driver_status = FX_SUCCESS;
+            break;
+
+        case FX_DRIVER_BOOT_WRITE:
+            memcpy(Image, MediaPtr->fx_media_driver_buffer, RAM_DISK_SECTOR_SIZE);
+            MediaPtr->fx_media_driver_status = FX_SUCCESS;
+            break;
+
+        case FX_DRIVER_FLUSH:
+        case FX_DRIVER_ABORT:
+        case FX_DRIVER_INIT:
+        case FX_DRIVER_UNINIT:
+        case FX_DRIVER_RELEASE_SECTORS:
+            // Nothing is buffered in the driver
+            MediaPtr->fx_media_driver_status = FX_SUCCESS;
+            break;
+
+        default:
+            MediaPtr->fx_media_driver_status = FX_IO_ERROR;
+            break;
+    }
+}
+
+
+
+/*******************************************************************************************************
+* @brief Format a RAM disk image with a FAT file system
+*
+* @author original: Hab Collector \n
+*
+* @note: FileX picks FAT12, FAT16 or FAT32 from the size of the image
+*
+* @param MediaPtr: Media used for the format, it is left closed
+* @param Image: The image to format
+* @param ImageSize: Size of the image in bytes, a multiple of RAM_DISK_SECTOR_SIZE
+* @param MediaMemory: Sector buffer of the media
+* @param MediaMemorySize: Size of the sector buffer
+* @param VolumeName: Volume label of the new file system
+*
+* @return The FileX status of the format
+********************************************************************************************************/
+UINT RamDisk_Format(FX_MEDIA *MediaPtr, uint8_t *Image, ULONG ImageSize, uint8_t *MediaMemory, ULONG MediaMemorySize, CHAR *VolumeName)
+{
+    memset(Image, 0, ImageSize);
+    return(fx_media_format(MediaPtr, RamDisk_Driver, Image, MediaMemory, MediaMemorySize, VolumeName, 1, 256, 0, ImageSize / RAM_DISK_SECTOR_SIZE, RAM_DISK_SECTOR_SIZE, 8, 1, 1));
+}
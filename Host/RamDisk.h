@@ -0,0 +1,40 @@
+/** ****************************************************************************************************
+ * @file            RamDisk.h
+ * @brief           This is the Header file used to support RamDisk.c
+ * ****************************************************************************************************
+ * @author original Hab Collector (habco) \n
+ *
+ * @version         See Main_Support.h: FIRMWARE_REV_MAJOR, FIRMWARE_REV_MINOR
+ *
+ * @param Development_Environment \n
+ * Hardware:        Linux host (off-target build)\n
+ * IDE:             CMake \n
+ * Compiler:        GCC \n
+ * Editor Settings: 1 Tab = 4 Spaces, Recommended Courier New 11
+ *
+ * @note            See source file for notes
+ *
+ * @copyright       Applied Concepts, Inc
+ ****************************************************************************************************** */
+#ifndef HOST_RAM_DISK_H_
+#define HOST_RAM_DISK_H_
+
+#ifdef __cplusplus
+extern"C" {
+#endif
+
+#include "fx_api.h"
+#include <stdint.h>
+
+// DEFINES
+#define RAM_DISK_SECTOR_SIZE                512U
+
+
+// FUNCTION PROTOTYPES
+VOID RamDisk_Driver(FX_MEDIA *MediaPtr);
+UINT RamDisk_Format(FX_MEDIA *MediaPtr, uint8_t *Image, ULONG ImageSize, uint8_t *MediaMemory, ULONG MediaMemorySize, CHAR *VolumeName);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* HOST_RAM_DISK_H_ */
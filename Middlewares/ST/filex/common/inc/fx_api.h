@@ -428,6 +428,42 @@ VOID _fx_trace_event_update(TX_TRACE_BUFFER_ENTRY *event, ULONG timestamp, ULONG
 #define FX_MAX_FAT_CACHE                       16   /* Minimum value is 8, all values must be a power of 2.  */
 #endif
 
+/* Define the number of extents in the cluster extent map of each open file. Each extent describes
+   a run of physically consecutive clusters, so a file with up to this many fragments is mapped
+   completely. This is only used if FX_ENABLE_FILE_EXTENT_CACHE is defined.  */
+
+#ifndef FX_FILE_EXTENT_CACHE_SIZE
+#define FX_FILE_EXTENT_CACHE_SIZE              16   /* Minimum value is 1.  */
+#endif
+
+/* Define the number of directories the directory index of a media holds at once. The
+   least recently used directory is dropped from the index when another directory is
+   indexed. This is only used if FX_ENABLE_DIRECTORY_INDEX is defined.  */
+
+#ifndef FX_DIRECTORY_INDEX_MAX_DIRECTORIES
+#define FX_DIRECTORY_INDEX_MAX_DIRECTORIES     4    /* Minimum value is 1.  */
+#endif
+
+/* Define the number of resolved directory paths each media remembers, and the length of
+   the longest directory path remembered. Longer paths are resolved from the start on each
+   search. This is only used if FX_ENABLE_PATH_CACHE is defined.  */
+
+#ifndef FX_PATH_CACHE_SIZE
+#define FX_PATH_CACHE_SIZE                     4    /* Minimum value is 1.  */
+#endif
+
+#ifndef FX_PATH_CACHE_PATH_LEN
+#define FX_PATH_CACHE_PATH_LEN                 64   /* Minimum value is 2.  */
+#endif
+
+/* Define the size of the name in each entry returned by fx_directory_list_read. A long
+   name that does not fit is replaced by its short name. This is only used if
+   FX_ENABLE_DIRECTORY_LIST is defined.  */
+
+#ifndef FX_DIRECTORY_LIST_NAME_LEN
+#define FX_DIRECTORY_LIST_NAME_LEN             64   /* Minimum value is 13.  */
+#endif
+
 
 /* Define the size of fault tolerant cache, which is used when freeing FAT chain. */
 
@@ -879,6 +915,108 @@ typedef struct FX_CACHED_SECTOR_STRUCT
 } FX_CACHED_SECTOR;
 
 
+#ifdef FX_ENABLE_DIRECTORY_INDEX
+
+/* Define a record of the directory index. A record maps the hash of the
+   long or the short name of a directory entry to the index of the first
+   entry of the name in its directory.  */
+
+typedef struct FX_DIRECTORY_INDEX_RECORD_STRUCT
+{
+
+    /* Define the hash of the name, 0 while the entry is to be read again.  */
+    ULONG               fx_directory_index_record_hash;
+
+    /* Define the index of the first directory entry of the name.  */
+    ULONG               fx_directory_index_record_entry;
+
+} FX_DIRECTORY_INDEX_RECORD;
+
+
+/* Define the index of one directory. Its records are kept sorted by hash
+   in one run of the record buffer of the media.  */
+
+typedef struct FX_DIRECTORY_INDEX_STRUCT
+{
+
+    /* Define the state of the index, free, valid or too large.  */
+    ULONG               fx_directory_index_state;
+
+    /* Define the first cluster of the directory, 0 for the root directory.  */
+    ULONG               fx_directory_index_cluster;
+
+    /* Define the first record of the directory and the number of records.  */
+    ULONG               fx_directory_index_first;
+    ULONG               fx_directory_index_records;
+
+    /* Define the time of the last use, the least recently used index is
+       dropped when the record buffer is full.  */
+    ULONG               fx_directory_index_last_used;
+
+} FX_DIRECTORY_INDEX;
+#endif /* FX_ENABLE_DIRECTORY_INDEX */
+
+
+#ifdef FX_ENABLE_PATH_CACHE
+
+/* Define a resolved directory path. It maps the directory part of a searched
+   name, relative to the directory the search started in, to the directory
+   entry of that directory.  */
+
+typedef struct FX_PATH_CACHE_ENTRY_STRUCT
+{
+
+    /* Define the directory path, empty if the entry is not used.  */
+    CHAR                fx_path_cache_path[FX_PATH_CACHE_PATH_LEN];
+
+    /* Define the first cluster of the directory the path starts in, 0 for
+       the root directory.  */
+    ULONG               fx_path_cache_start_cluster;
+
+    /* Define the time of the last use, the least recently used path is
+       replaced when all are used.  */
+    ULONG               fx_path_cache_last_used;
+
+    /* Define the directory entry of the path. Its name points to the name
+       buffer, which is as long as the name buffers the entry is copied to.  */
+    FX_DIR_ENTRY        fx_path_cache_directory;
+    CHAR                fx_path_cache_name[FX_MAX_LONG_NAME_LEN];
+
+} FX_PATH_CACHE_ENTRY;
+#endif /* FX_ENABLE_PATH_CACHE */
+
+
+#ifdef FX_ENABLE_DIRECTORY_LIST
+
+/* Define a directory entry as returned by fx_directory_list_read.  */
+
+typedef struct FX_DIRECTORY_LIST_ENTRY_STRUCT
+{
+
+    /* Define the name of the entry, the short name if the long name does
+       not fit.  */
+    CHAR                fx_directory_list_entry_name[FX_DIRECTORY_LIST_NAME_LEN];
+
+    /* Define the size of the entry in bytes.  */
+    ULONG64             fx_directory_list_entry_size;
+
+    /* Define the first cluster of the entry, 0 if nothing is allocated.  */
+    ULONG               fx_directory_list_entry_cluster;
+
+    /* Define the attributes of the entry.  */
+    UINT                fx_directory_list_entry_attributes;
+
+    /* Define the modified and created time and date, in the packed format
+       of the directory entry.  */
+    UINT                fx_directory_list_entry_time;
+    UINT                fx_directory_list_entry_date;
+    UINT                fx_directory_list_entry_created_time;
+    UINT                fx_directory_list_entry_created_date;
+
+} FX_DIRECTORY_LIST_ENTRY;
+#endif /* FX_ENABLE_DIRECTORY_LIST */
+
+
 /* Determine if the media control block has an extension defined. If not, 
    define the extension to whitespace.  */
 
@@ -1217,6 +1355,44 @@ typedef struct FX_MEDIA_STRUCT
     /* Media geometry structure */
     UCHAR               fx_media_FAT_type;
 
+#ifdef FX_ENABLE_CLUSTER_BITMAP
+
+    /* Define the free cluster bitmap, one bit per cluster number, set if the
+       cluster is in use. The buffer is supplied with fx_media_cluster_bitmap_set,
+       the bitmap is only used once it has been built from the FAT.  */
+    ULONG              *fx_media_cluster_bitmap;
+    ULONG              *fx_media_cluster_bitmap_buffer;
+    ULONG               fx_media_cluster_bitmap_size;
+    ULONG               fx_media_cluster_bitmap_words;
+#endif /* FX_ENABLE_CLUSTER_BITMAP */
+
+#ifdef FX_ENABLE_DIRECTORY_INDEX
+
+    /* Define the directory index. The records of all indexed directories
+       share the buffer supplied with fx_media_directory_index_enable.  */
+    FX_DIRECTORY_INDEX_RECORD
+                       *fx_media_directory_index_buffer;
+    ULONG               fx_media_directory_index_size;
+    ULONG               fx_media_directory_index_used;
+    ULONG               fx_media_directory_index_time;
+    FX_DIRECTORY_INDEX  fx_media_directory_index[FX_DIRECTORY_INDEX_MAX_DIRECTORIES];
+#ifndef FX_MEDIA_STATISTICS_DISABLE
+    ULONG               fx_media_directory_index_builds;
+    ULONG               fx_media_directory_index_hits;
+#endif
+#endif /* FX_ENABLE_DIRECTORY_INDEX */
+
+#ifdef FX_ENABLE_PATH_CACHE
+
+    /* Define the recently resolved directory paths, so a search in the same
+       directory does not read its parent directories again.  */
+    FX_PATH_CACHE_ENTRY fx_media_path_cache[FX_PATH_CACHE_SIZE];
+    ULONG               fx_media_path_cache_time;
+#ifndef FX_MEDIA_STATISTICS_DISABLE
+    ULONG               fx_media_path_cache_hits;
+#endif
+#endif /* FX_ENABLE_PATH_CACHE */
+
     /* Define the module port extension in the media control block. This 
        is typically defined to whitespace in fx_port.h.  */
     FX_MEDIA_MODULE_EXTENSION
@@ -1234,6 +1410,21 @@ typedef FX_MEDIA *      FX_MEDIA_PTR;
 #endif
 
 
+#ifdef FX_ENABLE_FILE_EXTENT_CACHE
+
+/* Define the cluster extent structure. An extent maps a run of consecutive
+   relative clusters of a file to consecutive physical clusters. The length
+   of an extent is given by the relative cluster of the next extent, or by
+   the number of mapped clusters for the last extent.  */
+
+typedef struct FX_FILE_EXTENT_STRUCT
+{
+    ULONG fx_file_extent_relative_cluster;
+    ULONG fx_file_extent_physical_cluster;
+} FX_FILE_EXTENT;
+#endif /* FX_ENABLE_FILE_EXTENT_CACHE */
+
+
 /* Define the FileX file control block.  All information about open
    files are found in this data type.  */
 
@@ -1288,6 +1479,16 @@ typedef struct FX_FILE_STRUCT
     /* Define a notify function called when file is written to. */
     VOID               (*fx_file_write_notify)(struct FX_FILE_STRUCT *);
 
+#ifdef FX_ENABLE_FILE_EXTENT_CACHE
+
+    /* Define the cluster extent map. The map covers the relative clusters
+       0 through fx_file_extent_clusters - 1 and is built as the FAT chain
+       of the file is walked.  */
+    ULONG               fx_file_extent_count;
+    ULONG               fx_file_extent_clusters;
+    FX_FILE_EXTENT      fx_file_extents[FX_FILE_EXTENT_CACHE_SIZE];
+#endif /* FX_ENABLE_FILE_EXTENT_CACHE */
+
     /* Define the module port extension in the file control block. This 
        is typically defined to whitespace in fx_port.h.  */
     FX_FILE_MODULE_EXTENSION
@@ -1331,6 +1532,9 @@ typedef FX_FILE  *FX_FILE_PTR;
 #define fx_directory_first_entry_find         _fx_directory_first_entry_find
 #define fx_directory_first_full_entry_find    _fx_directory_first_full_entry_find
 #define fx_directory_information_get          _fx_directory_information_get
+#ifdef FX_ENABLE_DIRECTORY_LIST
+#define fx_directory_list_read                _fx_directory_list_read
+#endif /* FX_ENABLE_DIRECTORY_LIST */
 #define fx_directory_local_path_clear         _fx_directory_local_path_clear
 #define fx_directory_local_path_get           _fx_directory_local_path_get
 #define fx_directory_local_path_get_copy      _fx_directory_local_path_get_copy
@@ -1377,8 +1581,14 @@ typedef FX_FILE  *FX_FILE_PTR;
 
 #define fx_media_abort                        _fx_media_abort
 #define fx_media_cache_invalidate             _fx_media_cache_invalidate
+#ifdef FX_ENABLE_CLUSTER_BITMAP
+#define fx_media_cluster_bitmap_set           _fx_media_cluster_bitmap_set
+#endif /* FX_ENABLE_CLUSTER_BITMAP */
 #define fx_media_check                        _fx_media_check
 #define fx_media_close                        _fx_media_close
+#ifdef FX_ENABLE_DIRECTORY_INDEX
+#define fx_media_directory_index_enable       _fx_media_directory_index_enable
+#endif /* FX_ENABLE_DIRECTORY_INDEX */
 #define fx_media_flush                        _fx_media_flush
 #define fx_media_format                       _fx_media_format
 #ifdef FX_ENABLE_EXFAT
@@ -1430,6 +1640,9 @@ typedef FX_FILE  *FX_FILE_PTR;
 #define fx_directory_first_entry_find         _fxe_directory_first_entry_find
 #define fx_directory_first_full_entry_find    _fxe_directory_first_full_entry_find
 #define fx_directory_information_get          _fxe_directory_information_get
+#ifdef FX_ENABLE_DIRECTORY_LIST
+#define fx_directory_list_read                _fxe_directory_list_read
+#endif /* FX_ENABLE_DIRECTORY_LIST */
 #define fx_directory_local_path_clear         _fxe_directory_local_path_clear
 #define fx_directory_local_path_get           _fxe_directory_local_path_get
 #define fx_directory_local_path_get_copy      _fxe_directory_local_path_get_copy
@@ -1476,8 +1689,14 @@ typedef FX_FILE  *FX_FILE_PTR;
 
 #define fx_media_abort                        _fxe_media_abort
 #define fx_media_cache_invalidate             _fxe_media_cache_invalidate
+#ifdef FX_ENABLE_CLUSTER_BITMAP
+#define fx_media_cluster_bitmap_set           _fxe_media_cluster_bitmap_set
+#endif /* FX_ENABLE_CLUSTER_BITMAP */
 #define fx_media_check                        _fxe_media_check
 #define fx_media_close                        _fxe_media_close
+#ifdef FX_ENABLE_DIRECTORY_INDEX
+#define fx_media_directory_index_enable       _fxe_media_directory_index_enable
+#endif /* FX_ENABLE_DIRECTORY_INDEX */
 #define fx_media_flush                        _fxe_media_flush
 #define fx_media_format                       _fxe_media_format
 #ifdef FX_ENABLE_EXFAT
@@ -1531,6 +1750,11 @@ UINT fx_directory_first_full_entry_find(FX_MEDIA *media_ptr, CHAR *directory_nam
                                         ULONG *size, UINT *year, UINT *month, UINT *day, UINT *hour, UINT *minute, UINT *second);
 UINT fx_directory_information_get(FX_MEDIA *media_ptr, CHAR *directory_name, UINT *attributes, ULONG *size,
                                   UINT *year, UINT *month, UINT *day, UINT *hour, UINT *minute, UINT *second);
+#ifdef FX_ENABLE_DIRECTORY_LIST
+UINT fx_directory_list_read(FX_MEDIA *media_ptr, CHAR *directory_name, ULONG *entry_index, UINT attributes_mask,
+                            UINT attributes_value, CHAR *name_prefix, FX_DIRECTORY_LIST_ENTRY *list_ptr,
+                            UINT list_size, UINT *list_count);
+#endif /* FX_ENABLE_DIRECTORY_LIST */
 UINT fx_directory_local_path_clear(FX_MEDIA *media_ptr);
 UINT fx_directory_local_path_get(FX_MEDIA *media_ptr, CHAR **return_path_name);
 UINT fx_directory_local_path_get_copy(FX_MEDIA *media_ptr, CHAR *return_path_name_buffer, UINT return_path_name_buffer_size);
@@ -1589,8 +1813,14 @@ UINT fx_file_extended_truncate_release(FX_FILE *file_ptr, ULONG64 size);
 
 UINT fx_media_abort(FX_MEDIA *media_ptr);
 UINT fx_media_cache_invalidate(FX_MEDIA *media_ptr);
+#ifdef FX_ENABLE_CLUSTER_BITMAP
+UINT fx_media_cluster_bitmap_set(FX_MEDIA *media_ptr, VOID *bitmap_buffer, ULONG bitmap_size);
+#endif /* FX_ENABLE_CLUSTER_BITMAP */
 UINT fx_media_check(FX_MEDIA *media_ptr, UCHAR *scratch_memory_ptr, ULONG scratch_memory_size, ULONG error_correction_option, ULONG *errors_detected);
 UINT fx_media_close(FX_MEDIA *media_ptr);
+#ifdef FX_ENABLE_DIRECTORY_INDEX
+UINT fx_media_directory_index_enable(FX_MEDIA *media_ptr, VOID *index_buffer, ULONG index_size);
+#endif /* FX_ENABLE_DIRECTORY_INDEX */
 UINT fx_media_flush(FX_MEDIA *media_ptr);
 UINT fx_media_format(FX_MEDIA *media_ptr, VOID (*driver)(FX_MEDIA *media), VOID *driver_info_ptr, UCHAR *memory_ptr, UINT memory_size,
                      CHAR *volume_name, UINT number_of_fats, UINT directory_entries, UINT hidden_sectors,
@@ -67,6 +67,11 @@ UINT _fx_directory_first_full_entry_find(FX_MEDIA *media_ptr, CHAR *directory_na
                                          ULONG *size, UINT *year, UINT *month, UINT *day, UINT *hour, UINT *minute, UINT *second);
 UINT _fx_directory_information_get(FX_MEDIA *media_ptr, CHAR *directory_name, UINT *attributes, ULONG *size,
                                    UINT *year, UINT *month, UINT *day, UINT *hour, UINT *minute, UINT *second);
+#ifdef FX_ENABLE_DIRECTORY_LIST
+UINT _fx_directory_list_read(FX_MEDIA *media_ptr, CHAR *directory_name, ULONG *entry_index, UINT attributes_mask,
+                             UINT attributes_value, CHAR *name_prefix, FX_DIRECTORY_LIST_ENTRY *list_ptr,
+                             UINT list_size, UINT *list_count);
+#endif /* FX_ENABLE_DIRECTORY_LIST */
 UINT _fx_directory_local_path_clear(FX_MEDIA *media_ptr);
 UINT _fx_directory_local_path_get(FX_MEDIA *media_ptr, CHAR **return_path_name);
 UINT _fx_directory_local_path_get_copy(FX_MEDIA *media_ptr, CHAR *return_path_name_buffer, UINT return_path_name_buffer_size);
@@ -94,6 +99,11 @@ UINT _fxe_directory_first_full_entry_find(FX_MEDIA *media_ptr, CHAR *directory_n
                                           ULONG *size, UINT *year, UINT *month, UINT *day, UINT *hour, UINT *minute, UINT *second);
 UINT _fxe_directory_information_get(FX_MEDIA *media_ptr, CHAR *directory_name, UINT *attributes, ULONG *size,
                                     UINT *year, UINT *month, UINT *day, UINT *hour, UINT *minute, UINT *second);
+#ifdef FX_ENABLE_DIRECTORY_LIST
+UINT _fxe_directory_list_read(FX_MEDIA *media_ptr, CHAR *directory_name, ULONG *entry_index, UINT attributes_mask,
+                              UINT attributes_value, CHAR *name_prefix, FX_DIRECTORY_LIST_ENTRY *list_ptr,
+                              UINT list_size, UINT *list_count);
+#endif /* FX_ENABLE_DIRECTORY_LIST */
 UINT _fxe_directory_local_path_clear(FX_MEDIA *media_ptr);
 UINT _fxe_directory_local_path_get(FX_MEDIA *media_ptr, CHAR **return_path_name);
 UINT _fxe_directory_local_path_get_copy(FX_MEDIA *media_ptr, CHAR *return_path_name_buffer, UINT return_path_name_buffer_size);
@@ -111,6 +121,23 @@ UINT _fxe_directory_short_name_get_extended(FX_MEDIA *media_ptr, CHAR *long_file
 
 
 /* Define the internal Directory component function prototypes.  */
+#ifdef FX_ENABLE_DIRECTORY_INDEX
+
+/* Define the directory index states and the hash of the records that are
+   read again from the directory at the next search.  */
+
+#define FX_DIRECTORY_INDEX_FREE                0
+#define FX_DIRECTORY_INDEX_VALID               1
+#define FX_DIRECTORY_INDEX_TOO_LARGE           2
+#define FX_DIRECTORY_INDEX_PENDING             0
+#define FX_DIRECTORY_INDEX_ALL                 0xFFFFFFFF
+
+/* Define the largest number of long name entries of a name.  */
+
+#define FX_DIRECTORY_INDEX_LONG_NAME_ENTRIES   20
+
+#endif /* FX_ENABLE_DIRECTORY_INDEX */
+
 #ifdef FX_ENABLE_EXFAT
 #define UPDATE_DELETE (0)
 #define UPDATE_FILE   (1)
@@ -130,7 +157,27 @@ UINT _fx_directory_exFAT_free_search(FX_MEDIA *media_ptr, FX_DIR_ENTRY *director
 UINT  _fx_directory_entry_read(FX_MEDIA *media_ptr, FX_DIR_ENTRY *source_dir, ULONG *entry, FX_DIR_ENTRY *destination_ptr);
 UINT  _fx_directory_entry_write(FX_MEDIA *media_ptr, FX_DIR_ENTRY *entry_ptr);
 UINT  _fx_directory_free_search(FX_MEDIA *media_ptr, FX_DIR_ENTRY *directory_ptr, FX_DIR_ENTRY *entry_ptr);
+#ifdef FX_ENABLE_DIRECTORY_INDEX
+UINT  _fx_directory_index_build(FX_MEDIA *media_ptr, FX_DIR_ENTRY *directory_ptr, ULONG directory_size, FX_DIR_ENTRY *entry_ptr);
+UINT  _fx_directory_index_evict(FX_MEDIA *media_ptr, FX_DIRECTORY_INDEX *keep_ptr);
+FX_DIRECTORY_INDEX
+     *_fx_directory_index_get(FX_MEDIA *media_ptr, FX_DIR_ENTRY *directory_ptr);
+ULONG _fx_directory_index_hash(CHAR *name_ptr);
+UINT  _fx_directory_index_insert(FX_MEDIA *media_ptr, FX_DIRECTORY_INDEX *index_ptr, ULONG hash, ULONG entry);
+VOID  _fx_directory_index_invalidate(FX_MEDIA *media_ptr, ULONG cluster);
+VOID  _fx_directory_index_record_delete(FX_MEDIA *media_ptr, FX_DIRECTORY_INDEX *index_ptr, ULONG entry);
+VOID  _fx_directory_index_release(FX_MEDIA *media_ptr, FX_DIRECTORY_INDEX *index_ptr);
+VOID  _fx_directory_index_remove(FX_MEDIA *media_ptr, FX_DIR_ENTRY *directory_ptr, FX_DIR_ENTRY *entry_ptr);
+UINT  _fx_directory_index_search(FX_MEDIA *media_ptr, FX_DIR_ENTRY *directory_ptr, ULONG directory_size, CHAR *name_ptr, FX_DIR_ENTRY *entry_ptr);
+VOID  _fx_directory_index_update(FX_MEDIA *media_ptr, FX_DIR_ENTRY *directory_ptr, ULONG entry);
+#endif /* FX_ENABLE_DIRECTORY_INDEX */
+UINT  _fx_directory_name_compare(CHAR *name_ptr, FX_DIR_ENTRY *entry_ptr);
 CHAR *_fx_directory_name_extract(CHAR *source_ptr, CHAR *dest_ptr);
+#ifdef FX_ENABLE_PATH_CACHE
+VOID  _fx_directory_path_cache_insert(FX_MEDIA *media_ptr, ULONG start_cluster, CHAR *path_ptr, UINT path_length, FX_DIR_ENTRY *directory_ptr);
+VOID  _fx_directory_path_cache_invalidate(FX_MEDIA *media_ptr);
+UINT  _fx_directory_path_cache_search(FX_MEDIA *media_ptr, ULONG start_cluster, CHAR *path_ptr, UINT path_length, FX_DIR_ENTRY *directory_ptr);
+#endif /* FX_ENABLE_PATH_CACHE */
 UINT  _fx_directory_search(FX_MEDIA *media_ptr, CHAR *name_ptr, FX_DIR_ENTRY *entry_ptr, FX_DIR_ENTRY *last_dir_ptr, CHAR **last_name_ptr);
 
 #endif
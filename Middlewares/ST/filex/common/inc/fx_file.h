@@ -94,6 +94,12 @@ UINT _fx_file_extended_relative_seek(FX_FILE *file_ptr, ULONG64 byte_offset, UIN
 UINT _fx_file_extended_seek(FX_FILE *file_ptr, ULONG64 byte_offset);
 UINT _fx_file_extended_truncate(FX_FILE *file_ptr, ULONG64 size);
 UINT _fx_file_extended_truncate_release(FX_FILE *file_ptr, ULONG64 size);
+#ifdef FX_ENABLE_FILE_EXTENT_CACHE
+VOID _fx_file_extent_add(FX_FILE *file_ptr, ULONG relative_cluster, ULONG cluster);
+UINT _fx_file_extent_cluster_get(FX_FILE *file_ptr, ULONG relative_cluster, ULONG *cluster_ptr);
+VOID _fx_file_extent_invalidate(FX_FILE *file_ptr, ULONG relative_cluster);
+UINT _fx_file_extent_next_get(FX_FILE *file_ptr, ULONG relative_cluster, ULONG cluster, ULONG *next_cluster);
+#endif /* FX_ENABLE_FILE_EXTENT_CACHE */
 
 UINT _fxe_file_allocate(FX_FILE *file_ptr, ULONG size);
 UINT _fxe_file_attributes_read(FX_MEDIA *media_ptr, CHAR *file_name, UINT *attributes_ptr);
@@ -55,8 +55,14 @@
 
 UINT _fx_media_abort(FX_MEDIA *media_ptr);
 UINT _fx_media_cache_invalidate(FX_MEDIA *media_ptr);
+#ifdef FX_ENABLE_CLUSTER_BITMAP
+UINT _fx_media_cluster_bitmap_set(FX_MEDIA *media_ptr, VOID *bitmap_buffer, ULONG bitmap_size);
+#endif /* FX_ENABLE_CLUSTER_BITMAP */
 UINT _fx_media_check(FX_MEDIA *media_ptr, UCHAR *scratch_memory_ptr, ULONG scratch_memory_size, ULONG error_correction_option, ULONG *errors_detected);
 UINT _fx_media_close(FX_MEDIA *media_ptr);
+#ifdef FX_ENABLE_DIRECTORY_INDEX
+UINT _fx_media_directory_index_enable(FX_MEDIA *media_ptr, VOID *index_buffer, ULONG index_size);
+#endif /* FX_ENABLE_DIRECTORY_INDEX */
 UINT _fx_media_flush(FX_MEDIA *media_ptr);
 UINT _fx_media_format(FX_MEDIA *media_ptr, VOID (*driver)(FX_MEDIA *media), VOID *driver_info_ptr, UCHAR *memory_ptr, UINT memory_size,
                       CHAR *volume_name, UINT number_of_fats, UINT directory_entries, UINT hidden_sectors,
@@ -80,8 +86,14 @@ UINT _fx_media_extended_space_available(FX_MEDIA *media_ptr, ULONG64 *available_
 
 UINT _fxe_media_abort(FX_MEDIA *media_ptr);
 UINT _fxe_media_cache_invalidate(FX_MEDIA *media_ptr);
+#ifdef FX_ENABLE_CLUSTER_BITMAP
+UINT _fxe_media_cluster_bitmap_set(FX_MEDIA *media_ptr, VOID *bitmap_buffer, ULONG bitmap_size);
+#endif /* FX_ENABLE_CLUSTER_BITMAP */
 UINT _fxe_media_check(FX_MEDIA *media_ptr, UCHAR *scratch_memory_ptr, ULONG scratch_memory_size, ULONG error_correction_option, ULONG *errors_detected);
 UINT _fxe_media_close(FX_MEDIA *media_ptr);
+#ifdef FX_ENABLE_DIRECTORY_INDEX
+UINT _fxe_media_directory_index_enable(FX_MEDIA *media_ptr, VOID *index_buffer, ULONG index_size);
+#endif /* FX_ENABLE_DIRECTORY_INDEX */
 UINT _fxe_media_flush(FX_MEDIA *media_ptr);
 UINT _fxe_media_format(FX_MEDIA *media_ptr, VOID (*driver)(FX_MEDIA *media), VOID *driver_info_ptr, UCHAR *memory_ptr, UINT memory_size,
                        CHAR *volume_name, UINT number_of_fats, UINT directory_entries, UINT hidden_sectors,
@@ -77,6 +77,12 @@ UINT    _fx_utility_FAT_entry_read(FX_MEDIA *media_ptr, ULONG cluster, ULONG *en
 UINT    _fx_utility_FAT_entry_write(FX_MEDIA *media_ptr, ULONG cluster, ULONG next_cluster);
 UINT    _fx_utility_FAT_flush(FX_MEDIA *media_ptr);
 UINT    _fx_utility_FAT_map_flush(FX_MEDIA *media_ptr);
+#ifdef FX_ENABLE_CLUSTER_BITMAP
+UINT    _fx_utility_cluster_bitmap_build(FX_MEDIA *media_ptr);
+UINT    _fx_utility_cluster_bitmap_free_find(FX_MEDIA *media_ptr, ULONG start_cluster, ULONG *free_cluster);
+UINT    _fx_utility_cluster_bitmap_run_find(FX_MEDIA *media_ptr, ULONG start_cluster, ULONG clusters, ULONG *first_cluster);
+VOID    _fx_utility_cluster_bitmap_update(FX_MEDIA *media_ptr, ULONG cluster, ULONG value);
+#endif /* FX_ENABLE_CLUSTER_BITMAP */
 ULONG   _fx_utility_FAT_sector_get(FX_MEDIA *media_ptr, ULONG cluster);
 UINT    _fx_utility_string_length_get(CHAR *string, UINT max_length);
 
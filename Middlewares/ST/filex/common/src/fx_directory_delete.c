@@ -69,6 +69,11 @@
 /*                                                                        */
 /*    _fx_directory_entry_read              Read a directory entry        */
 /*    _fx_directory_entry_write             Write the new directory entry */
+/*    _fx_directory_index_invalidate        Drop directory indexes        */
+/*    _fx_directory_index_remove            Remove directory entry from   */
+/*                                            directory index             */
+/*    _fx_directory_path_cache_invalidate   Forget resolved directory     */
+/*                                            paths                       */
 /*    _fx_directory_search                  Search for the file name in   */
 /*                                          the directory structure       */
 /*    _fx_utility_logical_sector_flush      Flush the written log sector  */
@@ -167,7 +172,11 @@ ULONG        bytes_per_cluster;
     }
 
     /* Search the system for the supplied directory name.  */
+#ifdef FX_ENABLE_DIRECTORY_INDEX
+    status =  _fx_directory_search(media_ptr, directory_name, &dir_entry, &search_directory, FX_NULL);
+#else
     status =  _fx_directory_search(media_ptr, directory_name, &dir_entry, FX_NULL, FX_NULL);
+#endif /* FX_ENABLE_DIRECTORY_INDEX */
 
     /* Determine if the search was successful.  */
     if (status != FX_SUCCESS)
@@ -213,6 +222,13 @@ ULONG        bytes_per_cluster;
         return(FX_WRITE_PROTECT);
     }
 
+#ifdef FX_ENABLE_DIRECTORY_INDEX
+
+    /* Have the directory index of the parent directory read the entries
+       of the sub-directory again.  */
+    _fx_directory_index_remove(media_ptr, &search_directory, &dir_entry);
+#endif /* FX_ENABLE_DIRECTORY_INDEX */
+
     /* Copy the directory entry to the search directory structure for
        looking at the specified sub-directory contents.  */
     search_directory =  dir_entry;
@@ -390,6 +406,12 @@ ULONG        bytes_per_cluster;
     media_ptr -> fx_media_last_found_name[0] =  FX_NULL;
 #endif
 
+#ifdef FX_ENABLE_PATH_CACHE
+
+    /* Forget the resolved directory paths.  */
+    _fx_directory_path_cache_invalidate(media_ptr);
+#endif /* FX_ENABLE_PATH_CACHE */
+
     /* Mark the sub-directory entry as available.  */
     dir_entry.fx_dir_entry_name[0] =  (CHAR)FX_DIR_ENTRY_FREE;
     dir_entry.fx_dir_entry_short_name[0] =  (CHAR)FX_DIR_ENTRY_FREE;
@@ -424,6 +446,12 @@ ULONG        bytes_per_cluster;
         return(status);
     }
 
+#ifdef FX_ENABLE_DIRECTORY_INDEX
+
+    /* Drop the index of the deleted sub-directory.  */
+    _fx_directory_index_invalidate(media_ptr, search_directory.fx_dir_entry_cluster);
+#endif /* FX_ENABLE_DIRECTORY_INDEX */
+
 #ifdef FX_ENABLE_EXFAT
     bytes_per_cluster =  ((ULONG)media_ptr -> fx_media_bytes_per_sector) *
         ((ULONG)media_ptr -> fx_media_sectors_per_cluster);
@@ -64,6 +64,8 @@
 /*                                                                        */
 /*    _fx_directory_entry_read              Read entries from directory   */
 /*    _fx_directory_entry_write             Write entries to directory    */
+/*    _fx_directory_index_update            Mark directory index records  */
+/*                                            as pending                  */
 /*    _fx_utility_FAT_entry_read            Read a FAT entry              */
 /*    _fx_utility_FAT_entry_write           Write a FAT entry             */
 /*    _fx_utility_FAT_flush                 Flush written FAT entries     */
@@ -411,6 +413,13 @@ FX_INT_SAVE_AREA
                     entry_ptr -> fx_dir_entry_long_name_present =  1;
                 }
 
+#ifdef FX_ENABLE_DIRECTORY_INDEX
+
+                /* The caller writes the new name at this entry, have the
+                   directory index read it again.  */
+                _fx_directory_index_update(media_ptr, search_dir_ptr, free_entry_start);
+#endif /* FX_ENABLE_DIRECTORY_INDEX */
+
                 /* Return a successful completion.  */
                 return(FX_SUCCESS);
             }
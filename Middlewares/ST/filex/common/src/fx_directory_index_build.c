@@ -0,0 +1,236 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** FileX Component                                                       */
+/**                                                                       */
+/**   Directory                                                           */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define FX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "fx_api.h"
+#include "fx_system.h"
+#include "fx_directory.h"
+
+
+#ifdef FX_ENABLE_DIRECTORY_INDEX
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _fx_directory_index_build                           PORTABLE C      */
+/*                                                           6.2.0        */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function builds the index of the specified directory from one  */
+/*    pass over its entries. The long and the short name of each entry    */
+/*    are hashed to the index of the first entry of the name, then the    */
+/*    records are sorted. The least recently used directories are dropped */
+/*    to make room. A directory that does not fit is remembered as too    */
+/*    large and is searched linearly.                                     */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    media_ptr                             Media control block pointer   */
+/*    directory_ptr                         Pointer to the directory, NULL*/
+/*                                          for the root                  */
+/*    directory_size                        Number of directory entries   */
+/*    entry_ptr                             Pointer to a directory entry  */
+/*                                          to read the entries into      */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    return status                                                       */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _fx_directory_entry_read              Read entries from directory   */
+/*    _fx_directory_index_evict             Free the least recently used  */
+/*                                          directory index               */
+/*    _fx_directory_index_hash              Hash a name                   */
+/*    _fx_directory_index_release           Free a directory index        */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _fx_directory_index_search            Search directory index        */
+/*                                                                        */
+/**************************************************************************/
+UINT  _fx_directory_index_build(FX_MEDIA *media_ptr, FX_DIR_ENTRY *directory_ptr, ULONG directory_size, FX_DIR_ENTRY *entry_ptr)
+{
+
+UINT                       i;
+UINT                       status;
+ULONG                      entry, next_entry;
+ULONG                      hash[2];
+ULONG                      gap, j, k;
+FX_DIRECTORY_INDEX        *index_ptr;
+FX_DIRECTORY_INDEX_RECORD *records;
+FX_DIRECTORY_INDEX_RECORD  record;
+
+
+    /* Loop to find a free directory index.  */
+    index_ptr =  FX_NULL;
+    while (index_ptr == FX_NULL)
+    {
+        for (i = 0; (i < FX_DIRECTORY_INDEX_MAX_DIRECTORIES) && (index_ptr == FX_NULL); i++)
+        {
+            if (media_ptr -> fx_media_directory_index[i].fx_directory_index_state == FX_DIRECTORY_INDEX_FREE)
+            {
+                index_ptr =  &media_ptr -> fx_media_directory_index[i];
+            }
+        }
+
+        /* If all are used, drop the least recently used directory.  */
+        if (index_ptr == FX_NULL)
+        {
+            _fx_directory_index_evict(media_ptr, FX_NULL);
+        }
+    }
+
+    /* Setup the directory index, its records are added at the end of the buffer.  */
+    index_ptr -> fx_directory_index_state =      FX_DIRECTORY_INDEX_VALID;
+    index_ptr -> fx_directory_index_cluster =    0;
+    index_ptr -> fx_directory_index_first =      media_ptr -> fx_media_directory_index_used;
+    index_ptr -> fx_directory_index_records =    0;
+    index_ptr -> fx_directory_index_last_used =  ++media_ptr -> fx_media_directory_index_time;
+    if ((directory_ptr) && (directory_ptr -> fx_dir_entry_name[0]))
+    {
+        index_ptr -> fx_directory_index_cluster =  directory_ptr -> fx_dir_entry_cluster;
+    }
+
+#ifndef FX_MEDIA_STATISTICS_DISABLE
+
+    /* Increment the number of directory index builds.  */
+    media_ptr -> fx_media_directory_index_builds++;
+#endif
+
+    /* Loop through the entries of the directory.  */
+    entry =  0;
+    while (entry < directory_size)
+    {
+
+        /* Read an entry from the directory.  */
+        next_entry =  entry;
+        status =  _fx_directory_entry_read(media_ptr, directory_ptr, &next_entry, entry_ptr);
+
+        /* Check for error status.  */
+        if (status != FX_SUCCESS)
+        {
+
+            /* Free the partial directory index.  */
+            _fx_directory_index_release(media_ptr, index_ptr);
+
+            /* Return the error status.  */
+            return(status);
+        }
+
+        /* Determine if this is the last directory entry.  */
+        if ((UCHAR)entry_ptr -> fx_dir_entry_name[0] == (UCHAR)FX_DIR_ENTRY_DONE)
+        {
+            break;
+        }
+
+        /* Index the names of used entries, other than the volume label.  */
+        if ((!(entry_ptr -> fx_dir_entry_attributes & FX_VOLUME)) &&
+            (!(((UCHAR)entry_ptr -> fx_dir_entry_name[0] == (UCHAR)FX_DIR_ENTRY_FREE) && (entry_ptr -> fx_dir_entry_short_name[0] == 0))))
+        {
+
+            /* Hash the name and the short name, if any.  */
+            hash[0] =  _fx_directory_index_hash(entry_ptr -> fx_dir_entry_name);
+            hash[1] =  hash[0];
+            if (entry_ptr -> fx_dir_entry_short_name[0] != 0)
+            {
+                hash[1] =  _fx_directory_index_hash(entry_ptr -> fx_dir_entry_short_name);
+            }
+
+            /* Add a record for each different hash.  */
+            for (i = 0; (i < 2) && ((i == 0) || (hash[1] != hash[0])); i++)
+            {
+
+                /* Loop to make room for the record.  */
+                while (media_ptr -> fx_media_directory_index_used >= media_ptr -> fx_media_directory_index_size)
+                {
+
+                    /* Drop the least recently used other directory.  */
+                    if (_fx_directory_index_evict(media_ptr, index_ptr) != FX_SUCCESS)
+                    {
+
+                        /* The directory does not fit, remember to search it linearly.  */
+                        _fx_directory_index_release(media_ptr, index_ptr);
+                        index_ptr -> fx_directory_index_state =  FX_DIRECTORY_INDEX_TOO_LARGE;
+
+                        /* Return successful status.  */
+                        return(FX_SUCCESS);
+                    }
+                }
+
+                /* Add the record at the end of the buffer, the records of the
+                   directory are the last ones in the buffer.  */
+                if (index_ptr -> fx_directory_index_records == 0)
+                {
+                    index_ptr -> fx_directory_index_first =  media_ptr -> fx_media_directory_index_used;
+                }
+                records =  media_ptr -> fx_media_directory_index_buffer + media_ptr -> fx_media_directory_index_used;
+                records -> fx_directory_index_record_hash =   hash[i];
+                records -> fx_directory_index_record_entry =  entry;
+                media_ptr -> fx_media_directory_index_used++;
+                index_ptr -> fx_directory_index_records++;
+            }
+        }
+
+        /* Move to the entry after the short name entry.  */
+        entry =  next_entry + 1;
+    }
+
+    /* Sort the records by hash and entry.  */
+    records =  media_ptr -> fx_media_directory_index_buffer + index_ptr -> fx_directory_index_first;
+    gap =  1;
+    while (gap < (index_ptr -> fx_directory_index_records / 3))
+    {
+        gap =  (gap * 3) + 1;
+    }
+    for (; gap > 0; gap =  gap / 3)
+    {
+        for (j = gap; j < index_ptr -> fx_directory_index_records; j++)
+        {
+
+            /* Insert the record among the records a gap apart.  */
+            record =  records[j];
+            for (k = j; k >= gap; k -=  gap)
+            {
+                if ((records[k - gap].fx_directory_index_record_hash < record.fx_directory_index_record_hash) ||
+                    ((records[k - gap].fx_directory_index_record_hash == record.fx_directory_index_record_hash) &&
+                     (records[k - gap].fx_directory_index_record_entry < record.fx_directory_index_record_entry)))
+                {
+                    break;
+                }
+                records[k] =  records[k - gap];
+            }
+            records[k] =  record;
+        }
+    }
+
+    /* Return successful status.  */
+    return(FX_SUCCESS);
+}
+#endif /* FX_ENABLE_DIRECTORY_INDEX */
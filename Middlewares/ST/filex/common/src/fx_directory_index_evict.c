@@ -0,0 +1,106 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** FileX Component                                                       */
+/**                                                                       */
+/**   Directory                                                           */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define FX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "fx_api.h"
+#include "fx_system.h"
+#include "fx_directory.h"
+
+
+#ifdef FX_ENABLE_DIRECTORY_INDEX
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _fx_directory_index_evict                           PORTABLE C      */
+/*                                                           6.2.0        */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function frees the least recently used directory index, other  */
+/*    than the one specified, to make room in the directory index.        */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    media_ptr                             Media control block pointer   */
+/*    keep_ptr                              Directory index to keep, NULL */
+/*                                          for none                      */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    return status                                                       */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _fx_directory_index_release           Free a directory index        */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    FileX System Functions                                              */
+/*                                                                        */
+/**************************************************************************/
+UINT  _fx_directory_index_evict(FX_MEDIA *media_ptr, FX_DIRECTORY_INDEX *keep_ptr)
+{
+
+UINT                i;
+FX_DIRECTORY_INDEX *index_ptr;
+FX_DIRECTORY_INDEX *oldest_ptr;
+
+
+    /* Loop to find the least recently used directory index.  */
+    oldest_ptr =  FX_NULL;
+    index_ptr =   media_ptr -> fx_media_directory_index;
+    for (i = 0; i < FX_DIRECTORY_INDEX_MAX_DIRECTORIES; i++)
+    {
+
+        /* Determine if this directory index is older.  */
+        if ((index_ptr != keep_ptr) && (index_ptr -> fx_directory_index_state != FX_DIRECTORY_INDEX_FREE) &&
+            ((oldest_ptr == FX_NULL) || (index_ptr -> fx_directory_index_last_used < oldest_ptr -> fx_directory_index_last_used)))
+        {
+            oldest_ptr =  index_ptr;
+        }
+
+        /* Move to the next directory index.  */
+        index_ptr++;
+    }
+
+    /* Determine if there is a directory index to free.  */
+    if (oldest_ptr == FX_NULL)
+    {
+
+        /* No, the directory index cannot make more room.  */
+        return(FX_NO_MORE_SPACE);
+    }
+
+    /* Free the least recently used directory index.  */
+    _fx_directory_index_release(media_ptr, oldest_ptr);
+
+    /* Return successful status.  */
+    return(FX_SUCCESS);
+}
+#endif /* FX_ENABLE_DIRECTORY_INDEX */
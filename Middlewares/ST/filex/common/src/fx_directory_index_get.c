@@ -0,0 +1,107 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** FileX Component                                                       */
+/**                                                                       */
+/**   Directory                                                           */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define FX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "fx_api.h"
+#include "fx_system.h"
+#include "fx_directory.h"
+
+
+#ifdef FX_ENABLE_DIRECTORY_INDEX
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _fx_directory_index_get                             PORTABLE C      */
+/*                                                           6.2.0        */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function returns the index of the specified directory, if the  */
+/*    directory is indexed, and marks it as the most recently used.       */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    media_ptr                             Media control block pointer   */
+/*    directory_ptr                         Pointer to the directory, NULL*/
+/*                                          or unnamed for the root       */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    index_ptr                             Directory index, NULL if the  */
+/*                                          directory is not indexed      */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    FileX System Functions                                              */
+/*                                                                        */
+/**************************************************************************/
+FX_DIRECTORY_INDEX  *_fx_directory_index_get(FX_MEDIA *media_ptr, FX_DIR_ENTRY *directory_ptr)
+{
+
+UINT                i;
+ULONG               cluster;
+FX_DIRECTORY_INDEX *index_ptr;
+
+
+    /* The root directory is indexed as cluster 0.  */
+    cluster =  0;
+    if ((directory_ptr) && (directory_ptr -> fx_dir_entry_name[0]))
+    {
+        cluster =  directory_ptr -> fx_dir_entry_cluster;
+    }
+
+    /* Loop to find the index of the directory.  */
+    index_ptr =  media_ptr -> fx_media_directory_index;
+    for (i = 0; i < FX_DIRECTORY_INDEX_MAX_DIRECTORIES; i++)
+    {
+
+        /* Determine if this is the index of the directory.  */
+        if ((index_ptr -> fx_directory_index_state != FX_DIRECTORY_INDEX_FREE) &&
+            (index_ptr -> fx_directory_index_cluster == cluster))
+        {
+
+            /* Yes, mark it as the most recently used.  */
+            index_ptr -> fx_directory_index_last_used =  ++media_ptr -> fx_media_directory_index_time;
+
+            /* Return the directory index.  */
+            return(index_ptr);
+        }
+
+        /* Move to the next directory index.  */
+        index_ptr++;
+    }
+
+    /* The directory is not indexed.  */
+    return(FX_NULL);
+}
+#endif /* FX_ENABLE_DIRECTORY_INDEX */
@@ -0,0 +1,104 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** FileX Component                                                       */
+/**                                                                       */
+/**   Directory                                                           */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define FX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "fx_api.h"
+#include "fx_system.h"
+#include "fx_directory.h"
+
+
+#ifdef FX_ENABLE_DIRECTORY_INDEX
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _fx_directory_index_hash                            PORTABLE C      */
+/*                                                           6.2.0        */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function returns the hash of a file or directory name for the  */
+/*    directory index. Lower case letters are hashed as upper case, the   */
+/*    same way names are compared by the directory search. The hash value */
+/*    of the pending records is never returned.                           */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    name_ptr                              Pointer to the name           */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    hash                                  Hash of the name              */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _fx_directory_index_build             Build directory index         */
+/*    _fx_directory_index_search            Search directory index        */
+/*                                                                        */
+/**************************************************************************/
+ULONG  _fx_directory_index_hash(CHAR *name_ptr)
+{
+
+ULONG hash;
+CHAR  alpha;
+
+
+    /* Calculate the FNV-1a hash of the upper case name.  */
+    hash =  0x811C9DC5;
+    while (*name_ptr)
+    {
+
+        /* Pickup the next character of the name.  */
+        alpha =  *name_ptr++;
+
+        /* Determine if its case needs to be changed.  */
+        if ((alpha >= 'a') && (alpha <= 'z'))
+        {
+
+            /* Yes, make upper case.  */
+            alpha =  (CHAR)((INT)alpha - 0x20);
+        }
+
+        /* Add the character to the hash.  */
+        hash =  (hash ^ (ULONG)((UCHAR)alpha)) * 0x01000193;
+    }
+
+    /* The hash of the pending records is reserved.  */
+    if (hash == FX_DIRECTORY_INDEX_PENDING)
+    {
+        hash =  1;
+    }
+
+    /* Return the hash.  */
+    return(hash);
+}
+#endif /* FX_ENABLE_DIRECTORY_INDEX */
@@ -0,0 +1,150 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** FileX Component                                                       */
+/**                                                                       */
+/**   Directory                                                           */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define FX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "fx_api.h"
+#include "fx_system.h"
+#include "fx_directory.h"
+
+
+#ifdef FX_ENABLE_DIRECTORY_INDEX
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _fx_directory_index_insert                          PORTABLE C      */
+/*                                                           6.2.0        */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function inserts a record in the specified directory index, in */
+/*    hash and entry order. The least recently used other directories are */
+/*    dropped from the index if the record buffer is full.                */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    media_ptr                             Media control block pointer   */
+/*    index_ptr                             Directory index               */
+/*    hash                                  Hash of the name              */
+/*    entry                                 Index of the first directory  */
+/*                                          entry of the name             */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    return status                                                       */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _fx_directory_index_evict             Free the least recently used  */
+/*                                          directory index               */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    FileX System Functions                                              */
+/*                                                                        */
+/**************************************************************************/
+UINT  _fx_directory_index_insert(FX_MEDIA *media_ptr, FX_DIRECTORY_INDEX *index_ptr, ULONG hash, ULONG entry)
+{
+
+UINT                       i;
+ULONG                      j;
+ULONG                      low, high, middle;
+FX_DIRECTORY_INDEX_RECORD *buffer;
+FX_DIRECTORY_INDEX_RECORD *records;
+FX_DIRECTORY_INDEX        *other_ptr;
+
+
+    /* Loop to make room for the record.  */
+    while (media_ptr -> fx_media_directory_index_used >= media_ptr -> fx_media_directory_index_size)
+    {
+
+        /* Drop the least recently used other directory.  */
+        if (_fx_directory_index_evict(media_ptr, index_ptr) != FX_SUCCESS)
+        {
+
+            /* The record does not fit.  */
+            return(FX_NO_MORE_SPACE);
+        }
+    }
+
+    /* The records of an empty directory index start at the end of the buffer.  */
+    buffer =  media_ptr -> fx_media_directory_index_buffer;
+    if (index_ptr -> fx_directory_index_records == 0)
+    {
+        index_ptr -> fx_directory_index_first =  media_ptr -> fx_media_directory_index_used;
+    }
+    records =  buffer + index_ptr -> fx_directory_index_first;
+
+    /* Find the position of the record.  */
+    low =   0;
+    high =  index_ptr -> fx_directory_index_records;
+    while (low < high)
+    {
+        middle =  (low + high) >> 1;
+        if ((records[middle].fx_directory_index_record_hash < hash) ||
+            ((records[middle].fx_directory_index_record_hash == hash) &&
+             (records[middle].fx_directory_index_record_entry < entry)))
+        {
+            low =  middle + 1;
+        }
+        else
+        {
+            high =  middle;
+        }
+    }
+
+    /* Move the records that follow up by one.  */
+    for (j = media_ptr -> fx_media_directory_index_used; j > (index_ptr -> fx_directory_index_first + low); j--)
+    {
+        buffer[j] =  buffer[j - 1];
+    }
+
+    /* Store the record.  */
+    records[low].fx_directory_index_record_hash =   hash;
+    records[low].fx_directory_index_record_entry =  entry;
+
+    /* Adjust the first record of the directories that follow.  */
+    other_ptr =  media_ptr -> fx_media_directory_index;
+    for (i = 0; i < FX_DIRECTORY_INDEX_MAX_DIRECTORIES; i++)
+    {
+        if ((other_ptr -> fx_directory_index_records) &&
+            (other_ptr -> fx_directory_index_first > index_ptr -> fx_directory_index_first))
+        {
+            other_ptr -> fx_directory_index_first++;
+        }
+        other_ptr++;
+    }
+
+    /* Count the record.  */
+    index_ptr -> fx_directory_index_records++;
+    media_ptr -> fx_media_directory_index_used++;
+
+    /* Return successful status.  */
+    return(FX_SUCCESS);
+}
+#endif /* FX_ENABLE_DIRECTORY_INDEX */
@@ -0,0 +1,93 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** FileX Component                                                       */
+/**                                                                       */
+/**   Directory                                                           */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define FX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "fx_api.h"
+#include "fx_system.h"
+#include "fx_directory.h"
+
+
+#ifdef FX_ENABLE_DIRECTORY_INDEX
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _fx_directory_index_invalidate                      PORTABLE C      */
+/*                                                           6.2.0        */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function drops the index of the directory that starts at the   */
+/*    specified cluster, when the directory is deleted, or the index of   */
+/*    every directory for FX_DIRECTORY_INDEX_ALL.                         */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    media_ptr                             Media control block pointer   */
+/*    cluster                               First cluster of the directory*/
+/*                                          or FX_DIRECTORY_INDEX_ALL     */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _fx_directory_index_release           Free a directory index        */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    FileX System Functions                                              */
+/*                                                                        */
+/**************************************************************************/
+VOID  _fx_directory_index_invalidate(FX_MEDIA *media_ptr, ULONG cluster)
+{
+
+UINT                i;
+FX_DIRECTORY_INDEX *index_ptr;
+
+
+    /* Loop through the directory indexes.  */
+    index_ptr =  media_ptr -> fx_media_directory_index;
+    for (i = 0; i < FX_DIRECTORY_INDEX_MAX_DIRECTORIES; i++)
+    {
+
+        /* Determine if the index of this directory is to be dropped.  */
+        if ((index_ptr -> fx_directory_index_state != FX_DIRECTORY_INDEX_FREE) &&
+            ((cluster == FX_DIRECTORY_INDEX_ALL) || (index_ptr -> fx_directory_index_cluster == cluster)))
+        {
+
+            /* Yes, free it.  */
+            _fx_directory_index_release(media_ptr, index_ptr);
+        }
+
+        /* Move to the next directory index.  */
+        index_ptr++;
+    }
+}
+#endif /* FX_ENABLE_DIRECTORY_INDEX */
@@ -0,0 +1,117 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** FileX Component                                                       */
+/**                                                                       */
+/**   Directory                                                           */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define FX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "fx_api.h"
+#include "fx_system.h"
+#include "fx_directory.h"
+
+
+#ifdef FX_ENABLE_DIRECTORY_INDEX
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _fx_directory_index_record_delete                   PORTABLE C      */
+/*                                                           6.2.0        */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function deletes the records of the specified directory entry  */
+/*    from the directory index.                                           */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    media_ptr                             Media control block pointer   */
+/*    index_ptr                             Directory index               */
+/*    entry                                 Index of the first directory  */
+/*                                          entry of the name             */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    FileX System Functions                                              */
+/*                                                                        */
+/**************************************************************************/
+VOID  _fx_directory_index_record_delete(FX_MEDIA *media_ptr, FX_DIRECTORY_INDEX *index_ptr, ULONG entry)
+{
+
+UINT                       i;
+ULONG                      j, k;
+ULONG                      first;
+ULONG                      removed;
+FX_DIRECTORY_INDEX_RECORD *buffer;
+FX_DIRECTORY_INDEX        *other_ptr;
+
+
+    /* Keep the records of the other entries, in order.  */
+    buffer =  media_ptr -> fx_media_directory_index_buffer;
+    first =   index_ptr -> fx_directory_index_first;
+    k =       first;
+    for (j = first; j < (first + index_ptr -> fx_directory_index_records); j++)
+    {
+        if (buffer[j].fx_directory_index_record_entry != entry)
+        {
+            buffer[k++] =  buffer[j];
+        }
+    }
+
+    /* Determine if records were removed.  */
+    removed =  j - k;
+    if (removed == 0)
+    {
+        return;
+    }
+
+    /* Move the records that follow down over the removed records.  */
+    for (; j < media_ptr -> fx_media_directory_index_used; j++)
+    {
+        buffer[j - removed] =  buffer[j];
+    }
+    media_ptr -> fx_media_directory_index_used -=  removed;
+    index_ptr -> fx_directory_index_records -=     removed;
+
+    /* Adjust the first record of the directories that follow.  */
+    other_ptr =  media_ptr -> fx_media_directory_index;
+    for (i = 0; i < FX_DIRECTORY_INDEX_MAX_DIRECTORIES; i++)
+    {
+        if ((other_ptr -> fx_directory_index_records) && (other_ptr -> fx_directory_index_first > first))
+        {
+            other_ptr -> fx_directory_index_first -=  removed;
+        }
+        other_ptr++;
+    }
+}
+#endif /* FX_ENABLE_DIRECTORY_INDEX */
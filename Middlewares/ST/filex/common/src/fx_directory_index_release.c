@@ -0,0 +1,110 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** FileX Component                                                       */
+/**                                                                       */
+/**   Directory                                                           */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define FX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "fx_api.h"
+#include "fx_system.h"
+#include "fx_directory.h"
+
+
+#ifdef FX_ENABLE_DIRECTORY_INDEX
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _fx_directory_index_release                         PORTABLE C      */
+/*                                                           6.2.0        */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function frees the specified directory index. Its records are  */
+/*    removed from the record buffer and the records of the directories   */
+/*    that follow are moved down, so the used records stay contiguous.    */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    media_ptr                             Media control block pointer   */
+/*    index_ptr                             Directory index to free       */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    FileX System Functions                                              */
+/*                                                                        */
+/**************************************************************************/
+VOID  _fx_directory_index_release(FX_MEDIA *media_ptr, FX_DIRECTORY_INDEX *index_ptr)
+{
+
+UINT                       i;
+ULONG                      j;
+ULONG                      first;
+ULONG                      records;
+FX_DIRECTORY_INDEX_RECORD *buffer;
+
+
+    /* Pickup the records of the directory.  */
+    buffer =   media_ptr -> fx_media_directory_index_buffer;
+    first =    index_ptr -> fx_directory_index_first;
+    records =  index_ptr -> fx_directory_index_records;
+
+    /* Mark the directory index as free.  */
+    index_ptr -> fx_directory_index_state =    FX_DIRECTORY_INDEX_FREE;
+    index_ptr -> fx_directory_index_records =  0;
+
+    /* Determine if there are records to remove.  */
+    if (records == 0)
+    {
+        return;
+    }
+
+    /* Move the records that follow down over the removed records.  */
+    for (j = first + records; j < media_ptr -> fx_media_directory_index_used; j++)
+    {
+        buffer[j - records] =  buffer[j];
+    }
+    media_ptr -> fx_media_directory_index_used -=  records;
+
+    /* Adjust the first record of the directories that follow.  */
+    index_ptr =  media_ptr -> fx_media_directory_index;
+    for (i = 0; i < FX_DIRECTORY_INDEX_MAX_DIRECTORIES; i++)
+    {
+        if ((index_ptr -> fx_directory_index_records) && (index_ptr -> fx_directory_index_first > first))
+        {
+            index_ptr -> fx_directory_index_first -=  records;
+        }
+        index_ptr++;
+    }
+}
+#endif /* FX_ENABLE_DIRECTORY_INDEX */
@@ -0,0 +1,139 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** FileX Component                                                       */
+/**                                                                       */
+/**   Directory                                                           */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define FX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "fx_api.h"
+#include "fx_system.h"
+#include "fx_directory.h"
+
+
+#ifdef FX_ENABLE_DIRECTORY_INDEX
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _fx_directory_index_remove                          PORTABLE C      */
+/*                                                           6.2.0        */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function marks the records of a directory entry found by the   */
+/*    directory search as pending, before the entry is deleted or renamed.*/
+/*    The records are under the index of the first long name entry, so the*/
+/*    records of the entries up to the short name entry are marked. The   */
+/*    entries are read again at the next search in the directory.         */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    media_ptr                             Media control block pointer   */
+/*    directory_ptr                         Pointer to the directory, NULL*/
+/*                                          or unnamed for the root       */
+/*    entry_ptr                             Pointer to directory entry    */
+/*                                          record                        */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _fx_directory_index_get               Get directory index           */
+/*    _fx_directory_index_update            Mark directory index records  */
+/*                                          as pending                    */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    FileX System Functions                                              */
+/*                                                                        */
+/**************************************************************************/
+VOID  _fx_directory_index_remove(FX_MEDIA *media_ptr, FX_DIR_ENTRY *directory_ptr, FX_DIR_ENTRY *entry_ptr)
+{
+
+ULONG                      j;
+ULONG                      first_entry;
+ULONG                      last_entry;
+FX_DIRECTORY_INDEX        *index_ptr;
+FX_DIRECTORY_INDEX_RECORD *record_ptr;
+
+
+    /* Determine if the media has a directory index.  */
+    if (media_ptr -> fx_media_directory_index_buffer == FX_NULL)
+    {
+        return;
+    }
+
+    /* Pickup the index of the directory.  */
+    index_ptr =  _fx_directory_index_get(media_ptr, directory_ptr);
+
+    /* Determine if the directory is indexed.  */
+    if ((index_ptr == FX_NULL) || (index_ptr -> fx_directory_index_state != FX_DIRECTORY_INDEX_VALID))
+    {
+        return;
+    }
+
+    /* Calculate the entries the first long name entry can be at.  */
+    last_entry =   entry_ptr -> fx_dir_entry_number;
+    first_entry =  0;
+    if (last_entry > FX_DIRECTORY_INDEX_LONG_NAME_ENTRIES)
+    {
+        first_entry =  last_entry - FX_DIRECTORY_INDEX_LONG_NAME_ENTRIES;
+    }
+
+    /* Loop through the records of the directory.  */
+    j =  0;
+    while (j < index_ptr -> fx_directory_index_records)
+    {
+
+        /* Determine if the record is for one of the entries.  */
+        record_ptr =  media_ptr -> fx_media_directory_index_buffer + index_ptr -> fx_directory_index_first + j;
+        if ((record_ptr -> fx_directory_index_record_hash != FX_DIRECTORY_INDEX_PENDING) &&
+            (record_ptr -> fx_directory_index_record_entry >= first_entry) &&
+            (record_ptr -> fx_directory_index_record_entry <= last_entry))
+        {
+
+            /* Yes, mark the entry as pending.  */
+            _fx_directory_index_update(media_ptr, directory_ptr, record_ptr -> fx_directory_index_record_entry);
+
+            /* Determine if the directory was dropped from the index.  */
+            if (index_ptr -> fx_directory_index_state != FX_DIRECTORY_INDEX_VALID)
+            {
+                return;
+            }
+
+            /* The records moved, start over.  */
+            j =  0;
+        }
+        else
+        {
+
+            /* Move to the next record.  */
+            j++;
+        }
+    }
+}
+#endif /* FX_ENABLE_DIRECTORY_INDEX */
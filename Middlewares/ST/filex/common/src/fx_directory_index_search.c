@@ -0,0 +1,249 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** FileX Component                                                       */
+/**                                                                       */
+/**   Directory                                                           */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define FX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "fx_api.h"
+#include "fx_system.h"
+#include "fx_directory.h"
+
+
+#ifdef FX_ENABLE_DIRECTORY_INDEX
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _fx_directory_index_search                          PORTABLE C      */
+/*                                                           6.2.0        */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function searches the index of the specified directory for a   */
+/*    name. The index is built on the first search of the directory, and  */
+/*    the entries that changed since are read again first. The entries    */
+/*    with the hash of the name are read and compared in directory order, */
+/*    so the entry found is the one the linear search would find.         */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    media_ptr                             Media control block pointer   */
+/*    directory_ptr                         Pointer to the directory, NULL*/
+/*                                          for the root                  */
+/*    directory_size                        Number of directory entries   */
+/*    name_ptr                              Name to search for            */
+/*    entry_ptr                             Pointer to directory entry    */
+/*                                          record                        */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    FX_SUCCESS                            Name found                    */
+/*    FX_NOT_FOUND                          Name not in the directory     */
+/*    FX_NOT_AVAILABLE                      Directory not indexed, search */
+/*                                          it linearly                   */
+/*    return status                         Error reading the directory   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _fx_directory_entry_read              Read entries from directory   */
+/*    _fx_directory_index_build             Build directory index         */
+/*    _fx_directory_index_get               Get directory index           */
+/*    _fx_directory_index_hash              Hash a name                   */
+/*    _fx_directory_index_insert            Insert directory index record */
+/*    _fx_directory_index_record_delete     Delete the records of a       */
+/*                                          directory entry               */
+/*    _fx_directory_index_release           Free a directory index        */
+/*    _fx_directory_name_compare            Compare name with an entry    */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _fx_directory_search                  Search for the file name in   */
+/*                                            the directory structure     */
+/*                                                                        */
+/**************************************************************************/
+UINT  _fx_directory_index_search(FX_MEDIA *media_ptr, FX_DIR_ENTRY *directory_ptr, ULONG directory_size, CHAR *name_ptr, FX_DIR_ENTRY *entry_ptr)
+{
+
+UINT                       status;
+ULONG                      i;
+ULONG                      entry;
+ULONG                      hash;
+ULONG                      low, high, middle;
+FX_DIRECTORY_INDEX        *index_ptr;
+FX_DIRECTORY_INDEX_RECORD *records;
+
+
+    /* Determine if the media has a directory index.  */
+    if (media_ptr -> fx_media_directory_index_buffer == FX_NULL)
+    {
+
+        /* No, search the directory linearly.  */
+        return(FX_NOT_AVAILABLE);
+    }
+
+    /* Pickup the index of the directory.  */
+    index_ptr =  _fx_directory_index_get(media_ptr, directory_ptr);
+
+    /* Determine if the directory is indexed.  */
+    if (index_ptr == FX_NULL)
+    {
+
+        /* No, this is the first search in the directory, build its index.  */
+        status =  _fx_directory_index_build(media_ptr, directory_ptr, directory_size, entry_ptr);
+
+        /* Check for error status.  */
+        if (status != FX_SUCCESS)
+        {
+            return(status);
+        }
+
+        /* Pickup the new index of the directory.  */
+        index_ptr =  _fx_directory_index_get(media_ptr, directory_ptr);
+    }
+
+    /* Determine if the directory did not fit in the index.  */
+    if ((index_ptr == FX_NULL) || (index_ptr -> fx_directory_index_state != FX_DIRECTORY_INDEX_VALID))
+    {
+
+        /* Search the directory linearly.  */
+        return(FX_NOT_AVAILABLE);
+    }
+
+    /* Loop to read again the entries that changed, their pending records are first.  */
+    records =  media_ptr -> fx_media_directory_index_buffer + index_ptr -> fx_directory_index_first;
+    while ((index_ptr -> fx_directory_index_records) &&
+           (records[0].fx_directory_index_record_hash == FX_DIRECTORY_INDEX_PENDING))
+    {
+
+        /* Remove the records of the entry.  */
+        entry =  records[0].fx_directory_index_record_entry;
+        _fx_directory_index_record_delete(media_ptr, index_ptr, entry);
+
+        /* Determine if the entry is in the directory.  */
+        if (entry < directory_size)
+        {
+
+            /* Read the entry from the directory.  */
+            i =  entry;
+            status =  _fx_directory_entry_read(media_ptr, directory_ptr, &i, entry_ptr);
+
+            /* Check for error status.  */
+            if (status != FX_SUCCESS)
+            {
+                return(status);
+            }
+
+            /* Determine if the entry is a used entry, other than the volume label.  */
+            if (((UCHAR)entry_ptr -> fx_dir_entry_name[0] != (UCHAR)FX_DIR_ENTRY_DONE) &&
+                (!(entry_ptr -> fx_dir_entry_attributes & FX_VOLUME)) &&
+                (!(((UCHAR)entry_ptr -> fx_dir_entry_name[0] == (UCHAR)FX_DIR_ENTRY_FREE) && (entry_ptr -> fx_dir_entry_short_name[0] == 0))))
+            {
+
+                /* Yes, index its name and its short name.  */
+                hash =  _fx_directory_index_hash(entry_ptr -> fx_dir_entry_name);
+                status =  _fx_directory_index_insert(media_ptr, index_ptr, hash, entry);
+                if ((status == FX_SUCCESS) && (entry_ptr -> fx_dir_entry_short_name[0] != 0) &&
+                    (_fx_directory_index_hash(entry_ptr -> fx_dir_entry_short_name) != hash))
+                {
+                    status =  _fx_directory_index_insert(media_ptr, index_ptr,
+                                                         _fx_directory_index_hash(entry_ptr -> fx_dir_entry_short_name), entry);
+                }
+
+                /* Determine if the records did not fit.  */
+                if (status != FX_SUCCESS)
+                {
+
+                    /* Drop the index of the directory, it is built again at the next search.  */
+                    _fx_directory_index_release(media_ptr, index_ptr);
+
+                    /* Search the directory linearly.  */
+                    return(FX_NOT_AVAILABLE);
+                }
+            }
+        }
+
+        /* Pickup the records again, other directories may have been dropped.  */
+        records =  media_ptr -> fx_media_directory_index_buffer + index_ptr -> fx_directory_index_first;
+    }
+
+    /* Find the first record with the hash of the name.  */
+    hash =  _fx_directory_index_hash(name_ptr);
+    low =   0;
+    high =  index_ptr -> fx_directory_index_records;
+    while (low < high)
+    {
+        middle =  (low + high) >> 1;
+        if (records[middle].fx_directory_index_record_hash < hash)
+        {
+            low =  middle + 1;
+        }
+        else
+        {
+            high =  middle;
+        }
+    }
+
+    /* Loop through the entries with the hash of the name, in directory order.  */
+    for (; (low < index_ptr -> fx_directory_index_records) && (records[low].fx_directory_index_record_hash == hash); low++)
+    {
+
+        /* Read the entry from the directory.  */
+        i =  records[low].fx_directory_index_record_entry;
+        status =  _fx_directory_entry_read(media_ptr, directory_ptr, &i, entry_ptr);
+
+        /* Check for error status.  */
+        if (status != FX_SUCCESS)
+        {
+            return(status);
+        }
+
+        /* Skip entries that are not used anymore.  */
+        if (((UCHAR)entry_ptr -> fx_dir_entry_name[0] == (UCHAR)FX_DIR_ENTRY_DONE) ||
+            (entry_ptr -> fx_dir_entry_attributes & FX_VOLUME) ||
+            (((UCHAR)entry_ptr -> fx_dir_entry_name[0] == (UCHAR)FX_DIR_ENTRY_FREE) && (entry_ptr -> fx_dir_entry_short_name[0] == 0)))
+        {
+            continue;
+        }
+
+        /* Determine if the entry is the one searched for.  */
+        if (_fx_directory_name_compare(name_ptr, entry_ptr))
+        {
+
+#ifndef FX_MEDIA_STATISTICS_DISABLE
+
+            /* Increment the number of names found with the directory index.  */
+            media_ptr -> fx_media_directory_index_hits++;
+#endif
+
+            /* Return success, the directory entry is in the entry record.  */
+            return(FX_SUCCESS);
+        }
+    }
+
+    /* The name is not in the directory.  */
+    return(FX_NOT_FOUND);
+}
+#endif /* FX_ENABLE_DIRECTORY_INDEX */
@@ -0,0 +1,107 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** FileX Component                                                       */
+/**                                                                       */
+/**   Directory                                                           */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define FX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "fx_api.h"
+#include "fx_system.h"
+#include "fx_directory.h"
+
+
+#ifdef FX_ENABLE_DIRECTORY_INDEX
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _fx_directory_index_update                          PORTABLE C      */
+/*                                                           6.2.0        */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function replaces the records of the specified directory entry */
+/*    with a pending record, when the entry is created or changed. The    */
+/*    entry is read again at the next search in the directory.            */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    media_ptr                             Media control block pointer   */
+/*    directory_ptr                         Pointer to the directory, NULL*/
+/*                                          or unnamed for the root       */
+/*    entry                                 Index of the first directory  */
+/*                                          entry of the name             */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _fx_directory_index_get               Get directory index           */
+/*    _fx_directory_index_insert            Insert directory index record */
+/*    _fx_directory_index_record_delete     Delete the records of a       */
+/*                                          directory entry               */
+/*    _fx_directory_index_release           Free a directory index        */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _fx_directory_free_search             Search for a free directory   */
+/*                                            entry                       */
+/*    _fx_directory_index_remove            Remove directory entry from   */
+/*                                            directory index             */
+/*                                                                        */
+/**************************************************************************/
+VOID  _fx_directory_index_update(FX_MEDIA *media_ptr, FX_DIR_ENTRY *directory_ptr, ULONG entry)
+{
+
+FX_DIRECTORY_INDEX *index_ptr;
+
+
+    /* Determine if the media has a directory index.  */
+    if (media_ptr -> fx_media_directory_index_buffer == FX_NULL)
+    {
+        return;
+    }
+
+    /* Pickup the index of the directory.  */
+    index_ptr =  _fx_directory_index_get(media_ptr, directory_ptr);
+
+    /* Determine if the directory is indexed.  */
+    if ((index_ptr == FX_NULL) || (index_ptr -> fx_directory_index_state != FX_DIRECTORY_INDEX_VALID))
+    {
+        return;
+    }
+
+    /* Replace the records of the entry with a pending record.  */
+    _fx_directory_index_record_delete(media_ptr, index_ptr, entry);
+    if (_fx_directory_index_insert(media_ptr, index_ptr, FX_DIRECTORY_INDEX_PENDING, entry) != FX_SUCCESS)
+    {
+
+        /* No room, drop the index of the directory, it is built again at the next search.  */
+        _fx_directory_index_release(media_ptr, index_ptr);
+    }
+}
+#endif /* FX_ENABLE_DIRECTORY_INDEX */
@@ -0,0 +1,429 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** FileX Component                                                       */
+/**                                                                       */
+/**   Directory                                                           */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define FX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "fx_api.h"
+#include "fx_system.h"
+#include "fx_directory.h"
+#include "fx_utility.h"
+#ifdef FX_ENABLE_EXFAT
+#include "fx_directory_exFAT.h"
+#endif /* FX_ENABLE_EXFAT */
+
+#ifndef FX_NO_LOCAL_PATH
+FX_LOCAL_PATH_SETUP
+#endif
+
+
+#ifdef FX_ENABLE_DIRECTORY_LIST
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _fx_directory_list_read                             PORTABLE C      */
+/*                                                           6.2.0        */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function returns the entries of a directory in a caller array, */
+/*    from one pass over the directory sectors. Entries are returned with */
+/*    their name, size, attributes, times and first cluster, starting at  */
+/*    the supplied entry index, until the array is full or the end of the */
+/*    directory is reached. The index is updated so the next call         */
+/*    continues where this one stopped. Only entries whose attributes     */
+/*    masked with the attributes mask equal the attributes value, and     */
+/*    whose name starts with the name prefix (case insensitive) are       */
+/*    returned. FX_NO_MORE_ENTRIES is returned when no entry is left.     */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    media_ptr                             Media control block pointer   */
+/*    directory_name                        Directory name, FX_NULL for   */
+/*                                            the default directory       */
+/*    entry_index                           Pointer to the entry to start */
+/*                                            at, 0 first, updated to the */
+/*                                            entry to continue at        */
+/*    attributes_mask                       Attributes checked by filter  */
+/*    attributes_value                      Value the checked attributes  */
+/*                                            must have                   */
+/*    name_prefix                           Leading characters of names   */
+/*                                            returned, FX_NULL for all   */
+/*    list_ptr                              Destination entry array       */
+/*    list_size                             Number of entries in array    */
+/*    list_count                            Destination for the number of */
+/*                                            entries returned            */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    return status                                                       */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _fx_directory_entry_read              Read an entry from directory  */
+/*    _fx_directory_exFAT_entry_read        Read exFAT directory entry    */
+/*    _fx_directory_search                  Search for the directory      */
+/*    _fx_utility_FAT_entry_read            Read a FAT entry              */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application Code                                                    */
+/*                                                                        */
+/**************************************************************************/
+UINT  _fx_directory_list_read(FX_MEDIA *media_ptr, CHAR *directory_name, ULONG *entry_index,
+                              UINT attributes_mask, UINT attributes_value, CHAR *name_prefix,
+                              FX_DIRECTORY_LIST_ENTRY *list_ptr, UINT list_size, UINT *list_count)
+{
+
+ULONG         i;
+UINT          status;
+UINT          count;
+ULONG         index;
+ULONG         cluster, next_cluster = 0;
+ULONG64       directory_size;
+CHAR         *name_ptr;
+CHAR          alpha, beta;
+FX_DIR_ENTRY  entry;
+FX_DIR_ENTRY  search_dir;
+FX_DIR_ENTRY *search_dir_ptr;
+
+
+    /* Nothing is returned yet.  */
+    *list_count =  0;
+
+    /* Setup pointers to media name buffer.  */
+    search_dir.fx_dir_entry_name =  media_ptr -> fx_media_name_buffer + FX_MAX_LONG_NAME_LEN;
+    entry.fx_dir_entry_name =       media_ptr -> fx_media_name_buffer + FX_MAX_LONG_NAME_LEN * 2;
+
+    /* Clear the short name strings.  */
+    search_dir.fx_dir_entry_short_name[0] =  0;
+    entry.fx_dir_entry_short_name[0] =       0;
+
+#ifdef FX_ENABLE_EXFAT
+    /* Will be set by exFAT.  */
+    entry.fx_dir_entry_secondary_count = 0;
+#endif /* FX_ENABLE_EXFAT */
+
+    /* Check the media to make sure it is open.  */
+    if (media_ptr -> fx_media_id != FX_MEDIA_ID)
+    {
+
+        /* Return the media not opened error.  */
+        return(FX_MEDIA_NOT_OPEN);
+    }
+
+    /* Protect against other threads accessing the media.  */
+    FX_PROTECT
+
+    /* Determine which directory is listed.  */
+    if (directory_name == FX_NULL)
+    {
+
+        /* List the default directory. First check for a local path pointer
+           stored in the thread control block.  */
+#ifndef FX_NO_LOCAL_PATH
+        if (_tx_thread_current_ptr -> tx_thread_filex_ptr)
+        {
+
+            /* Pickup the local path directory.  */
+            search_dir =  ((FX_PATH *)_tx_thread_current_ptr -> tx_thread_filex_ptr) -> fx_path_directory;
+        }
+        else
+#endif
+
+        /* Pickup the default path directory.  */
+        search_dir =  media_ptr -> fx_media_default_path.fx_path_directory;
+
+        /* An empty name means the default directory is the root.  */
+        if (search_dir.fx_dir_entry_name[0])
+        {
+            search_dir_ptr =  &search_dir;
+        }
+        else
+        {
+            search_dir_ptr =  FX_NULL;
+        }
+    }
+    else if ((directory_name[0] == 0) ||
+             (((directory_name[0] == '\\') || (directory_name[0] == '/')) && (directory_name[1] == 0)))
+    {
+
+        /* List the root directory.  */
+        search_dir_ptr =  FX_NULL;
+    }
+    else
+    {
+
+        /* Search the system for the supplied directory name.  */
+        status =  _fx_directory_search(media_ptr, directory_name, &search_dir, FX_NULL, FX_NULL);
+
+        /* Determine if the search was successful.  */
+        if (status != FX_SUCCESS)
+        {
+
+            /* Release media protection.  */
+            FX_UNPROTECT
+
+            /* Return the error code.  */
+            return(status);
+        }
+
+        /* Check to make sure the found entry is a directory.  */
+        if (!(search_dir.fx_dir_entry_attributes & (UCHAR)(FX_DIRECTORY)))
+        {
+
+            /* Release media protection.  */
+            FX_UNPROTECT
+
+            /* Return the not a directory error code.  */
+            return(FX_NOT_DIRECTORY);
+        }
+
+        search_dir_ptr =  &search_dir;
+    }
+
+    /* Calculate the directory size.  */
+    if (search_dir_ptr)
+    {
+
+        /* Clear the last search cluster, it is kept up to date in the local
+           copy of the directory entry as the sectors are read in order.  */
+        search_dir.fx_dir_entry_last_search_cluster =  0;
+
+#ifdef FX_ENABLE_EXFAT
+
+        if (media_ptr -> fx_media_FAT_type == FX_exFAT)
+        {
+            directory_size = search_dir.fx_dir_entry_file_size / FX_DIR_ENTRY_SIZE;
+        }
+        else
+        {
+#endif /* FX_ENABLE_EXFAT */
+
+            /* Calculate the directory size by counting the allocated
+               clusters for it.  */
+            i =        0;
+            cluster =  search_dir.fx_dir_entry_cluster;
+            while (cluster < media_ptr -> fx_media_fat_reserved)
+            {
+
+                /* Increment the cluster count.  */
+                i++;
+
+                /* Read the next FAT entry.  */
+                status =  _fx_utility_FAT_entry_read(media_ptr, cluster, &next_cluster);
+
+                /* Check the return status.  */
+                if (status != FX_SUCCESS)
+                {
+
+                    /* Release media protection.  */
+                    FX_UNPROTECT
+
+                    /* Return the bad status.  */
+                    return(status);
+                }
+
+                if ((cluster < FX_FAT_ENTRY_START) || (cluster == next_cluster) || (i > media_ptr -> fx_media_total_clusters))
+                {
+
+                    /* Release media protection.  */
+                    FX_UNPROTECT
+
+                    /* Return the bad status.  */
+                    return(FX_FAT_READ_ERROR);
+                }
+
+                cluster = next_cluster;
+            }
+
+            /* Now we can calculate the directory size.  */
+            directory_size =  (((ULONG64) media_ptr -> fx_media_bytes_per_sector) *
+                               ((ULONG64) media_ptr -> fx_media_sectors_per_cluster) * i)
+                                / (ULONG64) FX_DIR_ENTRY_SIZE;
+#ifdef FX_ENABLE_EXFAT
+        }
+#endif /* FX_ENABLE_EXFAT */
+    }
+    else
+    {
+
+        /* Directory size is the number of entries in the root directory.  */
+        directory_size =  (ULONG)media_ptr -> fx_media_root_directory_entries;
+    }
+
+    /* Loop through the directory entries until the list is full.  */
+    status =  FX_SUCCESS;
+    index =   *entry_index;
+    count =   0;
+    while ((count < list_size) && (index < directory_size))
+    {
+
+        /* Read an entry from the directory.  */
+#ifdef FX_ENABLE_EXFAT
+        if (media_ptr -> fx_media_FAT_type == FX_exFAT)
+        {
+            status =  _fx_directory_exFAT_entry_read(media_ptr, search_dir_ptr, &index, &entry,
+                                                     0, FX_FALSE, FX_NULL, FX_NULL);
+        }
+        else
+        {
+#endif /* FX_ENABLE_EXFAT */
+            status =  _fx_directory_entry_read(media_ptr, search_dir_ptr, &index, &entry);
+#ifdef FX_ENABLE_EXFAT
+        }
+#endif /* FX_ENABLE_EXFAT */
+
+        /* Check for error status.  */
+        if (status != FX_SUCCESS)
+        {
+            break;
+        }
+
+#ifdef FX_ENABLE_EXFAT
+        if (entry.fx_dir_entry_type == FX_EXFAT_DIR_ENTRY_TYPE_END_MARKER)
+        {
+
+            /* No more entries follow, the next call returns none.  */
+            index =  (ULONG)directory_size;
+            break;
+        }
+
+        /* Check to see if the entry has something in it.  */
+        else if (entry.fx_dir_entry_type != FX_EXFAT_DIR_ENTRY_TYPE_FILE_DIRECTORY)
+#else
+        if (((UCHAR)entry.fx_dir_entry_name[0] == (UCHAR)FX_DIR_ENTRY_FREE) && (entry.fx_dir_entry_short_name[0] == 0))
+#endif /* FX_ENABLE_EXFAT */
+        {
+
+            /* Current entry is free, skip to next entry and continue the loop.  */
+            index++;
+            continue;
+        }
+#ifndef FX_ENABLE_EXFAT
+        else if ((UCHAR)entry.fx_dir_entry_name[0] == (UCHAR)FX_DIR_ENTRY_DONE)
+        {
+
+            /* No more entries follow, the next call returns none.  */
+            index =  (ULONG)directory_size;
+            break;
+        }
+#endif /* FX_ENABLE_EXFAT */
+
+        /* A valid directory entry is present, move past it.  */
+        index++;
+
+        /* Determine if the entry has the requested attributes.  */
+        if ((entry.fx_dir_entry_attributes & attributes_mask) != attributes_value)
+        {
+            continue;
+        }
+
+        /* Determine if the name starts with the requested prefix.  */
+        if (name_prefix)
+        {
+
+            /* Compare the prefix without regard to case.  */
+            for (i = 0; name_prefix[i]; i++)
+            {
+
+                /* Pickup the characters and convert them to upper case.  */
+                alpha =  name_prefix[i];
+                beta =   entry.fx_dir_entry_name[i];
+                if ((alpha >= 'a') && (alpha <= 'z'))
+                {
+                    alpha =  (CHAR)(alpha - 0x20);
+                }
+                if ((beta >= 'a') && (beta <= 'z'))
+                {
+                    beta =  (CHAR)(beta - 0x20);
+                }
+
+                /* Stop at the first difference.  */
+                if (alpha != beta)
+                {
+                    break;
+                }
+            }
+
+            /* Skip the entry if the whole prefix did not match.  */
+            if (name_prefix[i])
+            {
+                continue;
+            }
+        }
+
+        /* Use the short name if the long name does not fit.  */
+        name_ptr =  entry.fx_dir_entry_name;
+        for (i = 0; (i < FX_DIRECTORY_LIST_NAME_LEN) && (name_ptr[i]); i++)
+        {
+        }
+        if ((i == FX_DIRECTORY_LIST_NAME_LEN) && (entry.fx_dir_entry_short_name[0]))
+        {
+            name_ptr =  entry.fx_dir_entry_short_name;
+        }
+
+        /* Copy the name into the list entry.  */
+        for (i = 0; (i < (FX_DIRECTORY_LIST_NAME_LEN - 1)) && (name_ptr[i]); i++)
+        {
+            list_ptr -> fx_directory_list_entry_name[i] =  name_ptr[i];
+        }
+        list_ptr -> fx_directory_list_entry_name[i] =  0;
+
+        /* Copy the rest of the entry.  */
+        list_ptr -> fx_directory_list_entry_size =          entry.fx_dir_entry_file_size;
+        list_ptr -> fx_directory_list_entry_cluster =       entry.fx_dir_entry_cluster;
+        list_ptr -> fx_directory_list_entry_attributes =    (UINT)entry.fx_dir_entry_attributes;
+        list_ptr -> fx_directory_list_entry_time =          entry.fx_dir_entry_time;
+        list_ptr -> fx_directory_list_entry_date =          entry.fx_dir_entry_date;
+        list_ptr -> fx_directory_list_entry_created_time =  entry.fx_dir_entry_created_time;
+        list_ptr -> fx_directory_list_entry_created_date =  entry.fx_dir_entry_created_date;
+
+        /* Move to the next list entry.  */
+        list_ptr++;
+        count++;
+    }
+
+    /* Return where to continue and the number of entries.  */
+    *entry_index =  index;
+    *list_count =   count;
+
+    /* Release media protection.  */
+    FX_UNPROTECT
+
+    /* Determine if the end of the directory was reached with nothing returned.  */
+    if ((status == FX_SUCCESS) && (count == 0))
+    {
+
+        /* No more entries.  */
+        status =  FX_NO_MORE_ENTRIES;
+    }
+
+    /* Return status to the caller.  */
+    return(status);
+}
+#endif /* FX_ENABLE_DIRECTORY_LIST */
@@ -0,0 +1,180 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** FileX Component                                                       */
+/**                                                                       */
+/**   Directory                                                           */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define FX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "fx_api.h"
+#include "fx_directory.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _fx_directory_name_compare                          PORTABLE C      */
+/*                                                           6.2.0        */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function compares a name with the name of a directory entry,   */
+/*    ignoring case, and then with its short name, which is upper case.   */
+/*    exFAT entries have no short name.                                   */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    name_ptr                              Name to compare               */
+/*    entry_ptr                             Pointer to directory entry    */
+/*                                          record                        */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    FX_TRUE                               The entry has the name        */
+/*    FX_FALSE                              The entry has another name    */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _fx_directory_index_search            Search directory index        */
+/*    _fx_directory_search                  Search for the file name in   */
+/*                                            the directory structure     */
+/*                                                                        */
+/**************************************************************************/
+UINT  _fx_directory_name_compare(CHAR *name_ptr, FX_DIR_ENTRY *entry_ptr)
+{
+
+CHAR *work_ptr;
+CHAR *dir_name_ptr;
+CHAR  alpha, name_alpha;
+
+
+    /* Compare the input name and extension with the directory
+       entry.  */
+    work_ptr =      name_ptr;
+    dir_name_ptr =  &(entry_ptr -> fx_dir_entry_name[0]);
+
+    /* Loop to compare names.  */
+    do
+    {
+
+        /* Pickup character of directory name.  */
+        alpha =  *dir_name_ptr;
+
+        /* Pickup character of name.  */
+        name_alpha =  *work_ptr;
+
+        /* Determine if its case needs to be changed.  */
+        if ((alpha >= 'a') && (alpha <= 'z'))
+        {
+
+            /* Yes, make upper case.  */
+            alpha =  (CHAR)((INT)alpha - 0x20);
+        }
+
+        /* Determine if its case needs to be changed.  */
+        if ((name_alpha >= 'a') && (name_alpha <= 'z'))
+        {
+
+            /* Yes, make upper case.  */
+            name_alpha =  (CHAR)((INT)name_alpha - 0x20);
+        }
+
+        /* Compare name with directory name.  */
+        if (alpha != name_alpha)
+        {
+
+            /* The names don't match, get out of the loop. */
+            break;
+        }
+
+        /* Otherwise, increment the name pointers.  */
+        work_ptr++;
+        dir_name_ptr++;
+    } while (*dir_name_ptr);
+
+    /* Determine if the requested name has been found.  */
+    if ((*dir_name_ptr == 0) && (*work_ptr == *dir_name_ptr))
+    {
+
+        /* Yes, the name was located.  */
+        return(FX_TRUE);
+    }
+
+    /* Determine if there is a short name to check.  */
+    if (entry_ptr -> fx_dir_entry_short_name[0] == 0)
+    {
+
+        /* No, the names don't match.  */
+        return(FX_FALSE);
+    }
+
+    /* Compare the input name and extension with the short name.  */
+    work_ptr =      name_ptr;
+    dir_name_ptr =  &(entry_ptr -> fx_dir_entry_short_name[0]);
+
+    /* Loop to compare names.  */
+    do
+    {
+
+        /* Pickup character of directory name.  */
+        alpha =  *dir_name_ptr;
+
+        /* Pickup character of name.  */
+        name_alpha =  *work_ptr;
+
+        /* Determine if its case needs to be changed.  */
+        if ((name_alpha >= 'a') && (name_alpha <= 'z'))
+        {
+
+            /* Yes, make upper case.  */
+            name_alpha =  (CHAR)((INT)name_alpha - 0x20);
+        }
+
+        /* Compare name with directory name.  */
+        if (alpha != name_alpha)
+        {
+
+            /* The names don't match, get out of the loop. */
+            break;
+        }
+
+        /* Otherwise, move the name pointers.  */
+        work_ptr++;
+        dir_name_ptr++;
+    } while (*dir_name_ptr);
+
+    /* Determine if the names match.  */
+    if ((*dir_name_ptr == 0) && (*work_ptr == *dir_name_ptr))
+    {
+
+        /* Yes, the name was located.  */
+        return(FX_TRUE);
+    }
+
+    /* The names don't match.  */
+    return(FX_FALSE);
+}
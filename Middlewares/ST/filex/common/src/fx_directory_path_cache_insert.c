@@ -0,0 +1,155 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** FileX Component                                                       */
+/**                                                                       */
+/**   Directory                                                           */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define FX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "fx_api.h"
+#include "fx_system.h"
+#include "fx_directory.h"
+
+
+#ifdef FX_ENABLE_PATH_CACHE
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _fx_directory_path_cache_insert                     PORTABLE C      */
+/*                                                           6.2.0        */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function remembers the directory entry of a resolved directory */
+/*    path, in place of the unused or the least recently used path. The   */
+/*    separators of the path are stored as '/'. The name of the directory */
+/*    entry is copied with it.                                            */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    media_ptr                             Media control block pointer   */
+/*    start_cluster                         First cluster of the directory*/
+/*                                          the path starts in, 0 for the */
+/*                                          root directory                */
+/*    path_ptr                              Pointer to the path           */
+/*    path_length                           Length of the directory path  */
+/*    directory_ptr                         Pointer to the directory entry*/
+/*                                          of the path                   */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _fx_directory_search                  Search for the file name in   */
+/*                                            the directory structure     */
+/*                                                                        */
+/**************************************************************************/
+VOID  _fx_directory_path_cache_insert(FX_MEDIA *media_ptr, ULONG start_cluster, CHAR *path_ptr, UINT path_length, FX_DIR_ENTRY *directory_ptr)
+{
+
+UINT                 i;
+CHAR                 alpha;
+FX_PATH_CACHE_ENTRY *cache_ptr;
+FX_PATH_CACHE_ENTRY *oldest_ptr;
+
+
+#ifdef FX_ENABLE_EXFAT
+
+    /* exFAT directory entries hold the size of the directory, which changes
+       as the directory grows, so exFAT paths are not remembered.  */
+    if (media_ptr -> fx_media_FAT_type == FX_exFAT)
+    {
+        return;
+    }
+#endif /* FX_ENABLE_EXFAT */
+
+    /* Determine if the path is too long to be remembered.  */
+    if (path_length >= FX_PATH_CACHE_PATH_LEN)
+    {
+        return;
+    }
+
+    /* Loop to find an unused or the least recently used path.  */
+    cache_ptr =   media_ptr -> fx_media_path_cache;
+    oldest_ptr =  cache_ptr;
+    for (i = 0; i < FX_PATH_CACHE_SIZE; i++)
+    {
+
+        /* Determine if the path is not used.  */
+        if (cache_ptr -> fx_path_cache_path[0] == 0)
+        {
+
+            /* Yes, use it.  */
+            oldest_ptr =  cache_ptr;
+            break;
+        }
+
+        /* Determine if this path is older.  */
+        if (cache_ptr -> fx_path_cache_last_used < oldest_ptr -> fx_path_cache_last_used)
+        {
+            oldest_ptr =  cache_ptr;
+        }
+
+        /* Move to the next path.  */
+        cache_ptr++;
+    }
+
+    /* Copy the path.  */
+    for (i = 0; i < path_length; i++)
+    {
+
+        /* Pickup the character, both separators are stored as '/'.  */
+        alpha =  path_ptr[i];
+        if (alpha == '\\')
+        {
+            alpha =  '/';
+        }
+
+        /* Store the character.  */
+        oldest_ptr -> fx_path_cache_path[i] =  alpha;
+    }
+    oldest_ptr -> fx_path_cache_path[i] =  0;
+
+    /* Remember the directory the path starts in and the directory entry.  */
+    oldest_ptr -> fx_path_cache_start_cluster =  start_cluster;
+    oldest_ptr -> fx_path_cache_last_used =      ++media_ptr -> fx_media_path_cache_time;
+    oldest_ptr -> fx_path_cache_directory =      *directory_ptr;
+
+    /* Copy the name of the directory entry up to its NULL, it is copied out
+       in full by the directory search.  */
+    for (i = 0; (i < (FX_MAX_LONG_NAME_LEN - 1)) && (directory_ptr -> fx_dir_entry_name[i]); i++)
+    {
+        oldest_ptr -> fx_path_cache_name[i] =  directory_ptr -> fx_dir_entry_name[i];
+    }
+    oldest_ptr -> fx_path_cache_name[i] =  0;
+    oldest_ptr -> fx_path_cache_directory.fx_dir_entry_name =  oldest_ptr -> fx_path_cache_name;
+}
+#endif /* FX_ENABLE_PATH_CACHE */
@@ -0,0 +1,175 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** FileX Component                                                       */
+/**                                                                       */
+/**   Directory                                                           */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define FX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "fx_api.h"
+#include "fx_system.h"
+#include "fx_directory.h"
+
+
+#ifdef FX_ENABLE_PATH_CACHE
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _fx_directory_path_cache_search                     PORTABLE C      */
+/*                                                           6.2.0        */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function searches the resolved directory paths of the media for*/
+/*    the directory part of a name. The paths are compared ignoring case  */
+/*    and the kind of separator. If found, the directory entry of the     */
+/*    directory is returned and the search of the name starts there       */
+/*    instead of reading the parent directories again.                    */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    media_ptr                             Media control block pointer   */
+/*    start_cluster                         First cluster of the directory*/
+/*                                          the path starts in, 0 for the */
+/*                                          root directory                */
+/*    path_ptr                              Pointer to the path           */
+/*    path_length                           Length of the directory path  */
+/*    directory_ptr                         Destination for the directory */
+/*                                          entry                         */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    FX_SUCCESS                            Directory path found          */
+/*    FX_NOT_FOUND                          Directory path not remembered */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _fx_directory_search                  Search for the file name in   */
+/*                                            the directory structure     */
+/*                                                                        */
+/**************************************************************************/
+UINT  _fx_directory_path_cache_search(FX_MEDIA *media_ptr, ULONG start_cluster, CHAR *path_ptr, UINT path_length, FX_DIR_ENTRY *directory_ptr)
+{
+
+UINT                 i, j;
+CHAR                 alpha, beta;
+FX_PATH_CACHE_ENTRY *cache_ptr;
+
+
+#ifdef FX_ENABLE_EXFAT
+
+    /* exFAT directory entries hold the size of the directory, which changes
+       as the directory grows, so exFAT paths are not remembered.  */
+    if (media_ptr -> fx_media_FAT_type == FX_exFAT)
+    {
+        return(FX_NOT_FOUND);
+    }
+#endif /* FX_ENABLE_EXFAT */
+
+    /* Determine if the path is too long to be remembered.  */
+    if (path_length >= FX_PATH_CACHE_PATH_LEN)
+    {
+        return(FX_NOT_FOUND);
+    }
+
+    /* Loop through the resolved directory paths.  */
+    cache_ptr =  media_ptr -> fx_media_path_cache;
+    for (i = 0; i < FX_PATH_CACHE_SIZE; i++)
+    {
+
+        /* Determine if the path starts in the same directory.  */
+        if ((cache_ptr -> fx_path_cache_path[0]) && (cache_ptr -> fx_path_cache_start_cluster == start_cluster))
+        {
+
+            /* Loop to compare the paths.  */
+            for (j = 0; j < path_length; j++)
+            {
+
+                /* Pickup the characters of the paths.  */
+                alpha =  path_ptr[j];
+                beta =   cache_ptr -> fx_path_cache_path[j];
+
+                /* Determine if their case needs to be changed.  */
+                if ((alpha >= 'a') && (alpha <= 'z'))
+                {
+
+                    /* Yes, make upper case.  */
+                    alpha =  (CHAR)((INT)alpha - 0x20);
+                }
+                if ((beta >= 'a') && (beta <= 'z'))
+                {
+
+                    /* Yes, make upper case.  */
+                    beta =  (CHAR)((INT)beta - 0x20);
+                }
+
+                /* Both separators are the same.  */
+                if (alpha == '\\')
+                {
+                    alpha =  '/';
+                }
+
+                /* Compare the characters.  */
+                if (alpha != beta)
+                {
+
+                    /* The paths don't match, get out of the loop.  */
+                    break;
+                }
+            }
+
+            /* Determine if the paths match.  */
+            if ((j == path_length) && (cache_ptr -> fx_path_cache_path[j] == 0))
+            {
+
+                /* Yes, mark the path as the most recently used.  */
+                cache_ptr -> fx_path_cache_last_used =  ++media_ptr -> fx_media_path_cache_time;
+
+                /* Return the directory entry.  */
+                *directory_ptr =  cache_ptr -> fx_path_cache_directory;
+
+#ifndef FX_MEDIA_STATISTICS_DISABLE
+
+                /* Increment the number of resolved directory paths used.  */
+                media_ptr -> fx_media_path_cache_hits++;
+#endif
+
+                /* Return successful status.  */
+                return(FX_SUCCESS);
+            }
+        }
+
+        /* Move to the next path.  */
+        cache_ptr++;
+    }
+
+    /* The directory path is not remembered.  */
+    return(FX_NOT_FOUND);
+}
+#endif /* FX_ENABLE_PATH_CACHE */
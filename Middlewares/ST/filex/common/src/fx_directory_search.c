@@ -73,6 +73,11 @@ FX_LOCAL_PATH_SETUP
 /*    _fx_directory_name_extract            Extract directory name from   */
 /*                                            input string                */
 /*    _fx_directory_entry_read              Read entries from root dir    */
+/*    _fx_directory_index_search            Search directory index        */
+/*    _fx_directory_name_compare            Compare name with an entry    */
+/*    _fx_directory_path_cache_insert       Remember directory path       */
+/*    _fx_directory_path_cache_search       Search remembered directory   */
+/*                                            paths                       */
 /*    _fx_utility_exFAT_name_hash_get       Get name hash                 */
 /*    _fx_utility_FAT_entry_read            Read FAT entries to calculate */
 /*                                            the sub-directory size      */
@@ -111,13 +116,11 @@ UINT          v, j;
 #endif /* FX_MEDIA_DISABLE_SEARCH_CACHE */
 ULONG         cluster, next_cluster = 0;
 ULONG64       directory_size;
-CHAR         *dir_name_ptr;
-CHAR         *work_ptr;
 CHAR         *source_name_ptr;
 CHAR         *destination_name_ptr;
 FX_DIR_ENTRY  search_dir;
 FX_DIR_ENTRY *search_dir_ptr;
-CHAR         *name, alpha, name_alpha;
+CHAR         *name;
 #ifndef FX_MEDIA_DISABLE_SEARCH_CACHE
 UINT          index;
 CHAR         *path_ptr =  FX_NULL;
@@ -126,6 +129,11 @@ CHAR         *original_name =  name_ptr;
 #ifdef FX_ENABLE_EXFAT
 USHORT        hash = 0;
 #endif /* FX_ENABLE_EXFAT */
+#ifdef FX_ENABLE_PATH_CACHE
+ULONG         path_cluster;
+UINT          path_length;
+CHAR         *path_name_ptr;
+#endif /* FX_ENABLE_PATH_CACHE */
 
 #ifndef FX_MEDIA_STATISTICS_DISABLE
 
@@ -220,7 +228,7 @@ USHORT        hash = 0;
     {
 
     UINT  match;
-    CHAR *temp_ptr, beta;
+    CHAR *temp_ptr, alpha, beta;
 
         /* Yes, there is a previously found directory in our cache.  */
 
@@ -498,6 +506,44 @@ USHORT        hash = 0;
 #endif
 #endif
 
+#ifdef FX_ENABLE_PATH_CACHE
+
+    /* Find the length of the directory path in front of the last name.  */
+    path_name_ptr =  name_ptr;
+    path_length =    0;
+    for (i = 0; name_ptr[i]; i++)
+    {
+
+        /* Determine if a name follows this separator.  */
+        if (((name_ptr[i] == '\\') || (name_ptr[i] == '/')) && (name_ptr[i + 1]))
+        {
+
+            /* Yes, the directory path ends here.  */
+            path_length =  (UINT)i;
+        }
+    }
+
+    /* Pickup the first cluster of the directory the search starts in.  */
+    path_cluster =  0;
+    if (search_dir_ptr)
+    {
+        path_cluster =  search_dir_ptr -> fx_dir_entry_cluster;
+    }
+
+    /* Determine if the directory path was resolved before.  */
+    if ((path_length) &&
+        (_fx_directory_path_cache_search(media_ptr, path_cluster, path_name_ptr, path_length, &search_dir) == FX_SUCCESS))
+    {
+
+        /* Yes, search the last name in that directory.  */
+        search_dir_ptr =  &search_dir;
+        name_ptr =        name_ptr + path_length;
+
+        /* The directory path is already remembered.  */
+        path_length =  0;
+    }
+#endif /* FX_ENABLE_PATH_CACHE */
+
     /* Loop to traverse the directory paths to find the specified file.  */
     do
     {
@@ -620,6 +666,17 @@ USHORT        hash = 0;
             directory_size =  (ULONG)media_ptr -> fx_media_root_directory_entries;
         }
 
+#ifdef FX_ENABLE_PATH_CACHE
+
+        /* Determine if this is the directory of the last name.  */
+        if ((name_ptr == FX_NULL) && (path_length) && (search_dir_ptr))
+        {
+
+            /* Yes, remember it for the next search with the same directory path.  */
+            _fx_directory_path_cache_insert(media_ptr, path_cluster, path_name_ptr, path_length, search_dir_ptr);
+        }
+#endif /* FX_ENABLE_PATH_CACHE */
+
         /* Loop through entries in the directory.  Yes, this is a
            linear search!  */
         i =      0;
@@ -634,7 +691,28 @@ USHORT        hash = 0;
         }
 #endif /* FX_ENABLE_EXFAT */
 
-        do
+#ifdef FX_ENABLE_DIRECTORY_INDEX
+
+        /* Search the directory index first, the directory is searched
+           linearly only if it is not indexed.  */
+        status =  _fx_directory_index_search(media_ptr, search_dir_ptr, (ULONG)directory_size, name, entry_ptr);
+
+        /* Determine if the index answered the search.  */
+        if (status == FX_SUCCESS)
+        {
+
+            /* Yes, the name was located.  */
+            found =  FX_TRUE;
+        }
+        else if (status != FX_NOT_AVAILABLE)
+        {
+
+            /* Return the not found or error status.  */
+            return(status);
+        }
+#endif /* FX_ENABLE_DIRECTORY_INDEX */
+
+        while ((i < directory_size) && (!found))
         {
 
             /* Read an entry from the directory.  */
@@ -679,115 +757,9 @@ USHORT        hash = 0;
             }
 
             /* Compare the input name and extension with the directory
-               entry.  */
-            work_ptr =      &name[0];
-            dir_name_ptr =  &(entry_ptr -> fx_dir_entry_name[0]);
-
-            /* Loop to compare names.  */
-            do
-            {
-
-                /* Pickup character of directory name.  */
-                alpha =  *dir_name_ptr;
-
-                /* Pickup character of name.  */
-                name_alpha =  *work_ptr;
-
-                /* Determine if its case needs to be changed.  */
-                if ((alpha >= 'a') && (alpha <= 'z'))
-                {
-
-                    /* Yes, make upper case.  */
-                    alpha =  (CHAR)((INT)alpha - 0x20);
-                }
-
-                /* Determine if its case needs to be changed.  */
-                if ((name_alpha >= 'a') && (name_alpha <= 'z'))
-                {
-
-                    /* Yes, make upper case.  */
-                    name_alpha =  (CHAR)((INT)name_alpha - 0x20);
-                }
-
-                /* Compare name with directory name.  */
-                if (alpha != name_alpha)
-                {
-
-                    /* The names don't match, get out of the loop. */
-                    break;
-                }
-
-                /* Otherwise, increment the name pointers.  */
-                work_ptr++;
-                dir_name_ptr++;
-            } while (*dir_name_ptr);
-
-            /* Determine if the requested name has been found.  If so,
-               return success to the caller.  */
-            if ((*dir_name_ptr == 0) && (*work_ptr == *dir_name_ptr))
-            {
-
-                /* Yes, the name was located.  All pertinent directory
-                   information is in the directory entry field.  */
-                found =  FX_TRUE;
-            }
-            /* Determine if there is a short name to check.  */
-#ifdef FX_ENABLE_EXFAT
-            else if ((media_ptr -> fx_media_FAT_type != FX_exFAT) &&
-                     (entry_ptr -> fx_dir_entry_short_name[0] != 0))
-#else
-            else if (entry_ptr -> fx_dir_entry_short_name[0] != 0)
-#endif /* FX_ENABLE_EXFAT */
-            {
-
-                /* Yes, check for the short part of the name.  */
-
-                /* Compare the input name and extension with the directory entry.  */
-                work_ptr =      &name[0];
-                dir_name_ptr =  &(entry_ptr -> fx_dir_entry_short_name[0]);
-
-                /* Loop to compare names.  */
-                do
-                {
-
-                    /* Pickup character of directory name.  */
-                    alpha =  *dir_name_ptr;
-
-                    /* Pickup character of name.  */
-                    name_alpha =  *work_ptr;
-
-                    /* Determine if its case needs to be changed.  */
-                    if ((name_alpha >= 'a') && (name_alpha <= 'z'))
-                    {
-
-                        /* Yes, make upper case.  */
-                        name_alpha =  (CHAR)((INT)name_alpha - 0x20);
-                    }
-
-                    /* Compare name with directory name.  */
-                    if (alpha != name_alpha)
-                    {
-
-                        /* The names don't match, get out of the loop. */
-                        break;
-                    }
-
-                    /* Otherwise, move the name pointers and increment the
-                       count.  */
-                    work_ptr++;
-                    dir_name_ptr++;
-                } while (*dir_name_ptr);
-
-                /* Determine if the names match.  */
-                if ((*dir_name_ptr == 0) && (*work_ptr == *dir_name_ptr))
-                {
-
-                    /* Yes, the name was located.  All pertinent directory
-                        information is in the directory entry field.  */
-                    found =  FX_TRUE;
-                }
-            }
-        } while ((i < directory_size) && (!found));
+               entry and its short name.  */
+            found =  _fx_directory_name_compare(name, entry_ptr);
+        }
 
         /* Now determine if we have a match.  */
         if (!found)
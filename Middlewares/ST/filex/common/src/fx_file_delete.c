@@ -65,6 +65,10 @@
 /*  CALLS                                                                 */
 /*                                                                        */
 /*    _fx_directory_entry_write             Write the new directory entry */
+/*    _fx_directory_index_remove            Remove directory entry from   */
+/*                                            directory index             */
+/*    _fx_directory_path_cache_invalidate   Forget resolved directory     */
+/*                                            paths                       */
 /*    _fx_directory_search                  Search for the file name in   */
 /*                                          the directory structure       */
 /*    _fx_utility_exFAT_cluster_state_set   Set cluster state             */
@@ -102,6 +106,9 @@ FX_FILE     *search_ptr;
 ULONG        cluster_count;
 FX_DIR_ENTRY dir_entry;
 UCHAR        not_a_file_attr;
+#ifdef FX_ENABLE_DIRECTORY_INDEX
+FX_DIR_ENTRY search_directory;
+#endif /* FX_ENABLE_DIRECTORY_INDEX */
 #ifdef FX_ENABLE_EXFAT
 ULONG        bytes_per_cluster;
 ULONG        clusters_count;
@@ -119,6 +126,15 @@ ULONG        clusters_count;
     /* Clear the short name string.  */
     dir_entry.fx_dir_entry_short_name[0] =  0;
 
+#ifdef FX_ENABLE_DIRECTORY_INDEX
+
+    /* Setup pointer to the search directory name buffer.  */
+    search_directory.fx_dir_entry_name =  media_ptr -> fx_media_name_buffer + FX_MAX_LONG_NAME_LEN * 2;
+
+    /* Clear the short name string.  */
+    search_directory.fx_dir_entry_short_name[0] =  0;
+#endif /* FX_ENABLE_DIRECTORY_INDEX */
+
     /* Check the media to make sure it is open.  */
     if (media_ptr -> fx_media_id != FX_MEDIA_ID)
     {
@@ -154,7 +170,11 @@ ULONG        clusters_count;
     }
 
     /* Search the system for the supplied file name.  */
+#ifdef FX_ENABLE_DIRECTORY_INDEX
+    status =  _fx_directory_search(media_ptr, file_name, &dir_entry, &search_directory, FX_NULL);
+#else
     status =  _fx_directory_search(media_ptr, file_name, &dir_entry, FX_NULL, FX_NULL);
+#endif /* FX_ENABLE_DIRECTORY_INDEX */
 
     /* Determine if the search was successful.  */
     if (status != FX_SUCCESS)
@@ -252,6 +272,12 @@ ULONG        clusters_count;
     media_ptr -> fx_media_last_found_name[0] =  FX_NULL;
 #endif
 
+#ifdef FX_ENABLE_PATH_CACHE
+
+    /* Forget the resolved directory paths.  */
+    _fx_directory_path_cache_invalidate(media_ptr);
+#endif /* FX_ENABLE_PATH_CACHE */
+
     /* Mark the directory entry as available, while leaving the other
        information for the sake of posterity.  */
     dir_entry.fx_dir_entry_name[0] =        (CHAR)FX_DIR_ENTRY_FREE;
@@ -286,6 +312,12 @@ ULONG        clusters_count;
         return(status);
     }
 
+#ifdef FX_ENABLE_DIRECTORY_INDEX
+
+    /* Have the directory index read the freed entries again.  */
+    _fx_directory_index_remove(media_ptr, &search_directory, &dir_entry);
+#endif /* FX_ENABLE_DIRECTORY_INDEX */
+
     /* Now that the directory entry is no longer valid and pointing at the chain of clusters,
        walk the chain of allocated FAT entries and mark each of them as free.  */
     cluster_count =     0;
@@ -71,6 +71,10 @@
 /*                                            Find exFAT free cluster     */
 /*    _fx_utility_exFAT_cluster_state_get   Get cluster state             */
 /*    _fx_utility_exFAT_cluster_state_set   Set cluster state             */
+/*    _fx_utility_cluster_bitmap_run_find                                 */
+/*                                          Find free run in bitmap       */
+/*    _fx_utility_cluster_bitmap_update                                   */
+/*                                          Update cluster in bitmap      */
 /*    _fx_utility_FAT_entry_read            Read a FAT entry              */
 /*    _fx_utility_FAT_entry_write           Write a FAT entry             */
 /*    _fx_utility_FAT_flush                 Flush written FAT entries     */
@@ -307,6 +311,16 @@ ULONG                  trace_timestamp;
 
         while (FAT_index < (media_ptr -> fx_media_total_clusters + FX_FAT_ENTRY_START))
         {
+#ifdef FX_ENABLE_CLUSTER_BITMAP
+
+            /* Skip to the next cluster the free cluster bitmap shows as free, its FAT
+               entries are still read below.  */
+            if ((media_ptr -> fx_media_cluster_bitmap_buffer) &&
+                (_fx_utility_cluster_bitmap_run_find(media_ptr, FAT_index, 1, &FAT_index) != FX_SUCCESS))
+            {
+                break;
+            }
+#endif /* FX_ENABLE_CLUSTER_BITMAP */
 
             /* Determine if enough consecutive FAT entries are available.  */
             i =  0;
@@ -373,6 +387,11 @@ ULONG                  trace_timestamp;
                     /* Determine if the entry is free.  */
                     if (FAT_value != FX_FREE_CLUSTER)
                     {
+#ifdef FX_ENABLE_CLUSTER_BITMAP
+
+                        /* Correct the free cluster bitmap if it showed the cluster as free.  */
+                        _fx_utility_cluster_bitmap_update(media_ptr, FAT_index + i, FAT_value);
+#endif /* FX_ENABLE_CLUSTER_BITMAP */
                         break;
                     }
 
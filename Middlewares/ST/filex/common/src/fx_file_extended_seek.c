@@ -60,6 +60,8 @@
 /*                                                                        */
 /*  CALLS                                                                 */
 /*                                                                        */
+/*    _fx_file_extent_cluster_get           Look up cluster in extent map */
+/*    _fx_file_extent_next_get              Find next cluster of the file */
 /*    _fx_utility_FAT_entry_read            Read a FAT entry              */
 /*                                                                        */
 /*  CALLED BY                                                             */
@@ -89,6 +91,9 @@ ULONG     last_cluster;
 ULONG     cluster_count;
 ULONG64   bytes_remaining;
 FX_MEDIA *media_ptr;
+#ifdef FX_ENABLE_FILE_EXTENT_CACHE
+ULONG     relative_cluster;
+#endif /* FX_ENABLE_FILE_EXTENT_CACHE */
 
 
     /* First, determine if the file is still open.  */
@@ -203,6 +208,31 @@ FX_MEDIA *media_ptr;
                 cluster_count =     (file_ptr -> fx_file_consecutive_cluster - 1);
             }
 
+#ifdef FX_ENABLE_FILE_EXTENT_CACHE
+
+            /* Determine if the extent map reaches closer to the seek position.  */
+            if ((byte_offset > 0) && (file_ptr -> fx_file_extent_clusters > cluster_count + 1))
+            {
+
+                /* Calculate the relative cluster that contains the last byte before
+                   the seek position, limited to the last mapped cluster.  */
+                relative_cluster =  (ULONG)((byte_offset - 1) / bytes_per_cluster);
+                if (relative_cluster >= file_ptr -> fx_file_extent_clusters)
+                {
+                    relative_cluster =  file_ptr -> fx_file_extent_clusters - 1;
+                }
+
+                /* Start the walk from the mapped cluster instead.  */
+                if ((relative_cluster > cluster_count) &&
+                    (_fx_file_extent_cluster_get(file_ptr, relative_cluster, &contents) == FX_SUCCESS))
+                {
+                    cluster =          contents;
+                    bytes_remaining =  byte_offset - ((ULONG64)relative_cluster * (ULONG64)bytes_per_cluster);
+                    cluster_count =    relative_cluster;
+                }
+            }
+#endif /* FX_ENABLE_FILE_EXTENT_CACHE */
+
 
             /* Follow the link of FAT entries.  */
             while ((cluster >= FX_FAT_ENTRY_START) && (cluster < media_ptr -> fx_media_fat_reserved))
@@ -211,8 +241,15 @@ FX_MEDIA *media_ptr;
                 /* Increment the number of clusters.  */
                 cluster_count++;
 
+#ifdef FX_ENABLE_FILE_EXTENT_CACHE
+
+                /* Find the next cluster from the extent map or the FAT.  */
+                status =  _fx_file_extent_next_get(file_ptr, cluster_count - 1, cluster, &contents);
+#else
+
                 /* Read the current cluster entry from the FAT.  */
                 status =  _fx_utility_FAT_entry_read(media_ptr, cluster, &contents);
+#endif /* FX_ENABLE_FILE_EXTENT_CACHE */
 
                 /* Check the return value.  */
                 if (status != FX_SUCCESS)
@@ -65,6 +65,7 @@
 /*  CALLS                                                                 */
 /*                                                                        */
 /*    _fx_directory_entry_write             Write directory entry         */
+/*    _fx_file_extent_invalidate            Discard extent map entries    */
 /*    _fx_utility_exFAT_bitmap_flush        Flush exFAT allocation bitmap */
 /*    _fx_utility_exFAT_cluster_state_set   Set cluster state             */
 /*    _fx_utility_FAT_entry_read            Read a FAT entry              */
@@ -706,6 +707,12 @@ ULONG                  trace_timestamp;
         file_ptr -> fx_file_consecutive_cluster =       1;
     }
 
+#ifdef FX_ENABLE_FILE_EXTENT_CACHE
+
+    /* Discard the extents of the released clusters.  */
+    _fx_file_extent_invalidate(file_ptr, file_ptr -> fx_file_total_clusters);
+#endif /* FX_ENABLE_FILE_EXTENT_CACHE */
+
 #ifndef FX_DONT_UPDATE_OPEN_FILES
 
     /* Search the opened files list to see if the same file is opened for reading.  */
@@ -0,0 +1,136 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** FileX Component                                                       */
+/**                                                                       */
+/**   File                                                                */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define FX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "fx_api.h"
+#include "fx_file.h"
+
+
+#ifdef FX_ENABLE_FILE_EXTENT_CACHE
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _fx_file_extent_add                                 PORTABLE C      */
+/*                                                           6.2.0        */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function records the physical cluster of a relative cluster in */
+/*    the cluster extent map of the file. Only the cluster directly after */
+/*    the mapped clusters is recorded, so the map always describes a      */
+/*    contiguous prefix of the FAT chain. A cluster that follows the last */
+/*    extent physically extends it, otherwise a new extent is started. If */
+/*    the map is full the cluster is not recorded and lookups past the end*/
+/*    of the map fall back to reading the FAT.                            */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    file_ptr                              File control block pointer    */
+/*    relative_cluster                      Relative cluster in the file  */
+/*    cluster                               Physical cluster              */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _fx_file_extent_next_get                                            */
+/*    _fx_file_open                                                       */
+/*                                                                        */
+/**************************************************************************/
+VOID  _fx_file_extent_add(FX_FILE *file_ptr, ULONG relative_cluster, ULONG cluster)
+{
+
+FX_FILE_EXTENT *extent_ptr;
+
+
+    /* Determine if the map is empty and the cluster is past the first cluster.  */
+    if ((file_ptr -> fx_file_extent_count == 0) && (relative_cluster != 0))
+    {
+
+        /* Determine if the file has any clusters.  */
+        if ((file_ptr -> fx_file_first_physical_cluster < FX_FAT_ENTRY_START) ||
+            (file_ptr -> fx_file_consecutive_cluster == 0))
+        {
+
+            /* Nothing to map against.  */
+            return;
+        }
+
+        /* Seed the map with the leading consecutive clusters of the file.  */
+        file_ptr -> fx_file_extents[0].fx_file_extent_relative_cluster =  0;
+        file_ptr -> fx_file_extents[0].fx_file_extent_physical_cluster =  file_ptr -> fx_file_first_physical_cluster;
+        file_ptr -> fx_file_extent_count =     1;
+        file_ptr -> fx_file_extent_clusters =  file_ptr -> fx_file_consecutive_cluster;
+    }
+
+    /* Only the cluster directly after the mapped clusters can be recorded.  */
+    if (relative_cluster != file_ptr -> fx_file_extent_clusters)
+    {
+        return;
+    }
+
+    /* Determine if the cluster physically follows the last extent.  */
+    if (file_ptr -> fx_file_extent_count)
+    {
+
+        /* Pickup the last extent.  */
+        extent_ptr =  &file_ptr -> fx_file_extents[file_ptr -> fx_file_extent_count - 1];
+
+        if (cluster == extent_ptr -> fx_file_extent_physical_cluster +
+                       (relative_cluster - extent_ptr -> fx_file_extent_relative_cluster))
+        {
+
+            /* Yes, extend the last extent.  */
+            file_ptr -> fx_file_extent_clusters++;
+            return;
+        }
+    }
+
+    /* Determine if there is room for another extent.  */
+    if (file_ptr -> fx_file_extent_count >= FX_FILE_EXTENT_CACHE_SIZE)
+    {
+
+        /* No, the rest of the chain stays unmapped.  */
+        return;
+    }
+
+    /* Start a new extent with this cluster.  */
+    extent_ptr =  &file_ptr -> fx_file_extents[file_ptr -> fx_file_extent_count];
+    extent_ptr -> fx_file_extent_relative_cluster =  relative_cluster;
+    extent_ptr -> fx_file_extent_physical_cluster =  cluster;
+    file_ptr -> fx_file_extent_count++;
+    file_ptr -> fx_file_extent_clusters++;
+}
+#endif /* FX_ENABLE_FILE_EXTENT_CACHE */
@@ -0,0 +1,115 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** FileX Component                                                       */
+/**                                                                       */
+/**   File                                                                */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define FX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "fx_api.h"
+#include "fx_file.h"
+
+
+#ifdef FX_ENABLE_FILE_EXTENT_CACHE
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _fx_file_extent_cluster_get                         PORTABLE C      */
+/*                                                           6.2.0        */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function looks up the physical cluster of a relative cluster in*/
+/*    the cluster extent map of the file. The extents are sorted by their */
+/*    relative cluster, so the extent is found with a binary search and no*/
+/*    FAT entries are read.                                               */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    file_ptr                              File control block pointer    */
+/*    relative_cluster                      Relative cluster in the file  */
+/*    cluster_ptr                           Destination for the physical  */
+/*                                            cluster                     */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    FX_SUCCESS                            Cluster found in the map      */
+/*    FX_NOT_FOUND                          Cluster is not mapped         */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _fx_file_extended_seek                                              */
+/*    _fx_file_extent_next_get                                            */
+/*                                                                        */
+/**************************************************************************/
+UINT  _fx_file_extent_cluster_get(FX_FILE *file_ptr, ULONG relative_cluster, ULONG *cluster_ptr)
+{
+
+ULONG           low;
+ULONG           high;
+ULONG           middle;
+FX_FILE_EXTENT *extent_ptr;
+
+
+    /* Determine if the relative cluster is covered by the map.  */
+    if (relative_cluster >= file_ptr -> fx_file_extent_clusters)
+    {
+
+        /* No, the caller must walk the FAT.  */
+        return(FX_NOT_FOUND);
+    }
+
+    /* Find the last extent that starts at or before the relative cluster.  */
+    low =   0;
+    high =  file_ptr -> fx_file_extent_count - 1;
+    while (low < high)
+    {
+
+        /* Split the remaining extents, rounding up so the search always moves.  */
+        middle =  (low + high + 1) >> 1;
+
+        if (file_ptr -> fx_file_extents[middle].fx_file_extent_relative_cluster <= relative_cluster)
+        {
+            low =  middle;
+        }
+        else
+        {
+            high =  middle - 1;
+        }
+    }
+
+    /* Calculate the physical cluster within the extent.  */
+    extent_ptr =  &file_ptr -> fx_file_extents[low];
+    *cluster_ptr =  extent_ptr -> fx_file_extent_physical_cluster +
+                    (relative_cluster - extent_ptr -> fx_file_extent_relative_cluster);
+
+    /* Return successful status.  */
+    return(FX_SUCCESS);
+}
+#endif /* FX_ENABLE_FILE_EXTENT_CACHE */
@@ -0,0 +1,116 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** FileX Component                                                       */
+/**                                                                       */
+/**   File                                                                */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define FX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "fx_api.h"
+#include "fx_file.h"
+
+
+#ifdef FX_ENABLE_FILE_EXTENT_CACHE
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _fx_file_extent_invalidate                          PORTABLE C      */
+/*                                                           6.2.0        */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function discards the extent map entries of the file from the  */
+/*    specified relative cluster onward. The maps of all other opened     */
+/*    instances of the same file are trimmed as well. It is called        */
+/*    whenever clusters are released from, or replaced in, the FAT chain  */
+/*    of the file.                                                        */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    file_ptr                              File control block pointer    */
+/*    relative_cluster                      First relative cluster that is*/
+/*                                            no longer valid             */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _fx_file_extended_truncate_release                                  */
+/*    _fx_file_write                                                      */
+/*                                                                        */
+/**************************************************************************/
+VOID  _fx_file_extent_invalidate(FX_FILE *file_ptr, ULONG relative_cluster)
+{
+
+ULONG     open_count;
+FX_FILE  *search_ptr;
+FX_MEDIA *media_ptr;
+
+
+    /* Setup pointer to media structure.  */
+    media_ptr =  file_ptr -> fx_file_media_ptr;
+
+    /* Search the opened files list for every instance of this file.  */
+    open_count =  media_ptr -> fx_media_opened_file_count;
+    search_ptr =  media_ptr -> fx_media_opened_file_list;
+    while (open_count)
+    {
+
+        /* Is this the same file?  */
+        if ((search_ptr == file_ptr) ||
+            ((search_ptr -> fx_file_dir_entry.fx_dir_entry_log_sector ==
+              file_ptr -> fx_file_dir_entry.fx_dir_entry_log_sector) &&
+             (search_ptr -> fx_file_dir_entry.fx_dir_entry_byte_offset ==
+              file_ptr -> fx_file_dir_entry.fx_dir_entry_byte_offset)))
+        {
+
+            /* Determine if the map covers the invalid clusters.  */
+            if (search_ptr -> fx_file_extent_clusters > relative_cluster)
+            {
+
+                /* Shorten the map.  */
+                search_ptr -> fx_file_extent_clusters =  relative_cluster;
+
+                /* Drop the extents that start at or after the invalid clusters.  */
+                while ((search_ptr -> fx_file_extent_count) &&
+                       (search_ptr -> fx_file_extents[search_ptr -> fx_file_extent_count - 1].fx_file_extent_relative_cluster >= relative_cluster))
+                {
+                    search_ptr -> fx_file_extent_count--;
+                }
+            }
+        }
+
+        /* Adjust the pointer and decrement the search count.  */
+        search_ptr =  search_ptr -> fx_file_opened_next;
+        open_count--;
+    }
+}
+#endif /* FX_ENABLE_FILE_EXTENT_CACHE */
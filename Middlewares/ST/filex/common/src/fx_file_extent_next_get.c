@@ -0,0 +1,107 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** FileX Component                                                       */
+/**                                                                       */
+/**   File                                                                */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define FX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "fx_api.h"
+#include "fx_file.h"
+#include "fx_utility.h"
+
+
+#ifdef FX_ENABLE_FILE_EXTENT_CACHE
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _fx_file_extent_next_get                            PORTABLE C      */
+/*                                                           6.2.0        */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function returns the cluster that follows a cluster of the     */
+/*    file. The extent map is used if it covers the next cluster,         */
+/*    otherwise the FAT entry is read and a valid next cluster is         */
+/*    recorded in the map.                                                */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    file_ptr                              File control block pointer    */
+/*    relative_cluster                      Relative cluster of the       */
+/*                                            current cluster             */
+/*    cluster                               Current physical cluster      */
+/*    next_cluster                          Destination for the next      */
+/*                                            cluster                     */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    return status                                                       */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _fx_file_extent_add                   Add cluster to extent map     */
+/*    _fx_file_extent_cluster_get           Look up cluster in extent map */
+/*    _fx_utility_FAT_entry_read            Read a FAT entry              */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _fx_file_extended_seek                                              */
+/*    _fx_file_read                                                       */
+/*    _fx_file_write                                                      */
+/*                                                                        */
+/**************************************************************************/
+UINT  _fx_file_extent_next_get(FX_FILE *file_ptr, ULONG relative_cluster, ULONG cluster, ULONG *next_cluster)
+{
+
+UINT      status;
+FX_MEDIA *media_ptr;
+
+
+    /* Determine if the next cluster is already mapped.  */
+    if (_fx_file_extent_cluster_get(file_ptr, relative_cluster + 1, next_cluster) == FX_SUCCESS)
+    {
+
+        /* Yes, no need to read the FAT.  */
+        return(FX_SUCCESS);
+    }
+
+    /* Setup pointer to media structure.  */
+    media_ptr =  file_ptr -> fx_file_media_ptr;
+
+    /* Read the FAT entry of the current cluster.  */
+    status =  _fx_utility_FAT_entry_read(media_ptr, cluster, next_cluster);
+
+    /* Record the next cluster if it is part of the chain.  */
+    if ((status == FX_SUCCESS) && (*next_cluster >= FX_FAT_ENTRY_START) &&
+        (*next_cluster < media_ptr -> fx_media_fat_reserved))
+    {
+        _fx_file_extent_add(file_ptr, relative_cluster + 1, *next_cluster);
+    }
+
+    /* Return the status.  */
+    return(status);
+}
+#endif /* FX_ENABLE_FILE_EXTENT_CACHE */
@@ -64,6 +64,7 @@
 /*                                                                        */
 /*    _fx_directory_search                  Search for the file name in   */
 /*                                          the directory structure       */
+/*    _fx_file_extent_add                   Add cluster to extent map     */
 /*    _fx_utility_FAT_entry_read            Read a FAT entry              */
 /*                                                                        */
 /*  CALLED BY                                                             */
@@ -123,6 +124,13 @@ UCHAR    not_a_file_attr;
     /* Clear the notify function. */
     file_ptr -> fx_file_write_notify = FX_NULL;
 
+#ifdef FX_ENABLE_FILE_EXTENT_CACHE
+
+    /* Clear the cluster extent map.  */
+    file_ptr -> fx_file_extent_count =     0;
+    file_ptr -> fx_file_extent_clusters =  0;
+#endif /* FX_ENABLE_FILE_EXTENT_CACHE */
+
     /* Determine the type of FAT and setup variables accordingly.  */
 #ifdef FX_ENABLE_EXFAT
     if (media_ptr -> fx_media_FAT_type == FX_exFAT)
@@ -444,6 +452,12 @@ UCHAR    not_a_file_attr;
                 }
 #endif /* FX_DISABLE_CONSECUTIVE_DETECT */
 
+#ifdef FX_ENABLE_FILE_EXTENT_CACHE
+
+                /* Record the cluster in the extent map.  */
+                _fx_file_extent_add(file_ptr, cluster_count - 1, cluster);
+#endif /* FX_ENABLE_FILE_EXTENT_CACHE */
+
                 /* Save the last valid cluster.  */
                 last_cluster =  cluster;
 
@@ -63,6 +63,7 @@
 /*                                                                        */
 /*  CALLS                                                                 */
 /*                                                                        */
+/*    _fx_file_extent_next_get              Find next cluster of the file */
 /*    _fx_utility_FAT_entry_read            Read a FAT entry              */
 /*    _fx_utility_logical_sector_read       Read a logical sector         */
 /*    _fx_utility_memory_copy               Fast memory copy routine      */
@@ -233,7 +234,15 @@ ULONG                  trace_timestamp;
                 else
                 {
 #endif /* FX_ENABLE_EXFAT */
+#ifdef FX_ENABLE_FILE_EXTENT_CACHE
+                    status =  _fx_file_extent_next_get(file_ptr,
+                                                       file_ptr -> fx_file_current_relative_cluster +
+                                                       ((i + file_ptr -> fx_file_current_relative_sector) /
+                                                        media_ptr -> fx_media_sectors_per_cluster) - 1,
+                                                       cluster, &next_cluster);
+#else
                     status =  _fx_utility_FAT_entry_read(media_ptr, cluster, &next_cluster);
+#endif /* FX_ENABLE_FILE_EXTENT_CACHE */
 
                     /* Determine if an error is present.  */
                     if ((status != FX_SUCCESS) || (next_cluster < FX_FAT_ENTRY_START) ||
@@ -391,10 +400,18 @@ ULONG                  trace_timestamp;
                 {
 #endif /* FX_ENABLE_EXFAT */
 
+#ifdef FX_ENABLE_FILE_EXTENT_CACHE
+
+                    /* Find the next cluster from the extent map or the FAT.  */
+                    status =  _fx_file_extent_next_get(file_ptr, file_ptr -> fx_file_current_relative_cluster,
+                                                       file_ptr -> fx_file_current_physical_cluster, &next_cluster);
+#else
+
                     /* Read the FAT entry of the current cluster to find
                        the next cluster.  */
                     status =  _fx_utility_FAT_entry_read(media_ptr,
                                                          file_ptr -> fx_file_current_physical_cluster, &next_cluster);
+#endif /* FX_ENABLE_FILE_EXTENT_CACHE */
 
                     /* Determine if an error is present.  */
                     if ((status != FX_SUCCESS) || (next_cluster < FX_FAT_ENTRY_START) ||
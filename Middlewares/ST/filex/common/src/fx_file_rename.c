@@ -70,7 +70,11 @@
 /*    _fx_directory_entry_write             Write the new directory entry */
 /*    _fx_directory_free_search             Search for a free directory   */
 /*                                            entry in target directory   */
+/*    _fx_directory_index_remove            Remove directory entry from   */
+/*                                            directory index             */
 /*    _fx_directory_name_extract            Extract the new filename      */
+/*    _fx_directory_path_cache_invalidate   Forget resolved directory     */
+/*                                            paths                       */
 /*    _fx_directory_search                  Search for the file name in   */
 /*                                          the directory structure       */
 /*    _fx_fault_tolerant_transaction_start  Start fault tolerant          */
@@ -213,6 +217,12 @@ UCHAR        not_a_file_attr;
         return(status);
     }
 
+#ifdef FX_ENABLE_DIRECTORY_INDEX
+
+    /* Have the directory index read the entries of the old name again.  */
+    _fx_directory_index_remove(media_ptr, &search_directory, &old_dir_entry);
+#endif /* FX_ENABLE_DIRECTORY_INDEX */
+
 #ifdef FX_ENABLE_EXFAT
     if (media_ptr -> fx_media_FAT_type == FX_exFAT)
     {
@@ -465,6 +475,12 @@ UCHAR        not_a_file_attr;
     media_ptr -> fx_media_last_found_name[0] =  FX_NULL;
 #endif
 
+#ifdef FX_ENABLE_PATH_CACHE
+
+    /* Forget the resolved directory paths.  */
+    _fx_directory_path_cache_invalidate(media_ptr);
+#endif /* FX_ENABLE_PATH_CACHE */
+
     /* Now write out the directory entry.  */
 #ifdef FX_ENABLE_EXFAT
     if (media_ptr -> fx_media_FAT_type == FX_exFAT)
@@ -69,6 +69,12 @@
 /*                                          Find exFAT free cluster       */
 /*    _fx_utility_exFAT_cluster_state_get   Get cluster state             */
 /*    _fx_utility_exFAT_cluster_state_set   Set cluster state             */
+/*    _fx_file_extent_invalidate            Discard extent map entries    */
+/*    _fx_file_extent_next_get              Find next cluster of the file */
+/*    _fx_utility_cluster_bitmap_free_find                                */
+/*                                          Find free cluster in bitmap   */
+/*    _fx_utility_cluster_bitmap_update                                   */
+/*                                          Update cluster in bitmap      */
 /*    _fx_utility_FAT_entry_read            Read a FAT entry              */
 /*    _fx_utility_FAT_entry_write           Write a FAT entry             */
 /*    _fx_utility_FAT_flush                 Flush written FAT entries     */
@@ -577,6 +583,12 @@ UCHAR                  dont_use_fat_old = FX_FALSE; /* Used by exFAT logic to in
             /* Reset consecutive cluster. */
             file_ptr -> fx_file_consecutive_cluster = 1;
 
+#ifdef FX_ENABLE_FILE_EXTENT_CACHE
+
+            /* The chain is about to change, discard the extent map.  */
+            _fx_file_extent_invalidate(file_ptr, 0);
+#endif /* FX_ENABLE_FILE_EXTENT_CACHE */
+
             last_cluster =   insertion_front;
 
 #ifdef FX_ENABLE_EXFAT
@@ -783,6 +795,25 @@ UCHAR                  dont_use_fat_old = FX_FALSE; /* Used by exFAT logic to in
                         return(FX_NO_MORE_SPACE);
                     }
 
+#ifdef FX_ENABLE_CLUSTER_BITMAP
+
+                    /* Skip to the next cluster the free cluster bitmap shows as free.  */
+                    if ((media_ptr -> fx_media_cluster_bitmap_buffer) &&
+                        (_fx_utility_cluster_bitmap_free_find(media_ptr, FAT_index, &FAT_index) != FX_SUCCESS))
+                    {
+
+#ifdef FX_ENABLE_FAULT_TOLERANT
+                        FX_FAULT_TOLERANT_TRANSACTION_FAIL(media_ptr);
+#endif /* FX_ENABLE_FAULT_TOLERANT */
+
+                        /* Release media protection.  */
+                        FX_UNPROTECT
+
+                        /* No free cluster left on the media.  */
+                        return(FX_NO_MORE_SPACE);
+                    }
+#endif /* FX_ENABLE_CLUSTER_BITMAP */
+
                     /* Read FAT entry.  */
                     status =  _fx_utility_FAT_entry_read(media_ptr, FAT_index, &FAT_value);
 
@@ -825,6 +856,12 @@ UCHAR                  dont_use_fat_old = FX_FALSE; /* Used by exFAT logic to in
                     else
                     {
 
+#ifdef FX_ENABLE_CLUSTER_BITMAP
+
+                        /* Correct the free cluster bitmap if it showed the cluster as free.  */
+                        _fx_utility_cluster_bitmap_update(media_ptr, FAT_index, FAT_value);
+#endif /* FX_ENABLE_CLUSTER_BITMAP */
+
                         /* FAT entry is not free... Advance the FAT index.  */
                         FAT_index++;
 
@@ -1348,7 +1385,15 @@ UCHAR                  dont_use_fat_old = FX_FALSE; /* Used by exFAT logic to in
                 else
                 {
 #endif /* FX_ENABLE_EXFAT */
+#ifdef FX_ENABLE_FILE_EXTENT_CACHE
+                    status =  _fx_file_extent_next_get(file_ptr,
+                                                       file_ptr -> fx_file_current_relative_cluster +
+                                                       ((i + file_ptr -> fx_file_current_relative_sector) /
+                                                        media_ptr -> fx_media_sectors_per_cluster) - 1,
+                                                       cluster, &next_cluster);
+#else
                     status =  _fx_utility_FAT_entry_read(media_ptr, cluster, &next_cluster);
+#endif /* FX_ENABLE_FILE_EXTENT_CACHE */
 
                     /* Determine if an error is present.  */
                     if ((status != FX_SUCCESS) || (next_cluster < FX_FAT_ENTRY_START) ||
@@ -1484,10 +1529,18 @@ UCHAR                  dont_use_fat_old = FX_FALSE; /* Used by exFAT logic to in
                 {
 #endif /* FX_ENABLE_EXFAT */
 
+#ifdef FX_ENABLE_FILE_EXTENT_CACHE
+
+                    /* Find the next cluster from the extent map or the FAT.  */
+                    status =  _fx_file_extent_next_get(file_ptr, file_ptr -> fx_file_current_relative_cluster,
+                                                       file_ptr -> fx_file_current_physical_cluster, &next_cluster);
+#else
+
                     /* Read the FAT entry of the current cluster to find
                        the next cluster.  */
                     status =  _fx_utility_FAT_entry_read(media_ptr,
                                                          file_ptr -> fx_file_current_physical_cluster, &next_cluster);
+#endif /* FX_ENABLE_FILE_EXTENT_CACHE */
 
                     /* Determine if an error is present.  */
                     if ((status != FX_SUCCESS) || (next_cluster < FX_FAT_ENTRY_START) ||
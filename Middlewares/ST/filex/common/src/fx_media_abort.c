@@ -125,6 +125,14 @@ FX_FILE *file_ptr;
     /* Call the specified I/O driver with the abort request.  */
     (media_ptr -> fx_media_driver_entry) (media_ptr);
 
+#ifdef FX_ENABLE_CLUSTER_BITMAP
+
+    /* Forget the free cluster bitmap, the next open only uses a buffer supplied again.  */
+    media_ptr -> fx_media_cluster_bitmap =         FX_NULL;
+    media_ptr -> fx_media_cluster_bitmap_buffer =  FX_NULL;
+    media_ptr -> fx_media_cluster_bitmap_size =    0;
+#endif /* FX_ENABLE_CLUSTER_BITMAP */
+
     /* Now remove this media from the open list.  */
 
     /* Lockout interrupts for media removal.  */
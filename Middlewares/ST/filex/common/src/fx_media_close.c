@@ -64,6 +64,8 @@
 /*  CALLS                                                                 */
 /*                                                                        */
 /*    _fx_directory_entry_write             Write the directory entry     */
+/*    _fx_directory_path_cache_invalidate   Forget resolved directory     */
+/*                                            paths                       */
 /*    _fx_media_abort                       Abort the media on error      */
 /*    _fx_utility_exFAT_bitmap_flush        Flush exFAT allocation bitmap */
 /*    _fx_utility_FAT_flush                 Flush cached FAT entries      */
@@ -377,6 +379,20 @@ UINT     status;
     /* Call the specified I/O driver with the uninitialize request.  */
     (media_ptr -> fx_media_driver_entry) (media_ptr);
 
+#ifdef FX_ENABLE_PATH_CACHE
+
+    /* Forget the resolved directory paths.  */
+    _fx_directory_path_cache_invalidate(media_ptr);
+#endif /* FX_ENABLE_PATH_CACHE */
+
+#ifdef FX_ENABLE_CLUSTER_BITMAP
+
+    /* Forget the free cluster bitmap, the next open only uses a buffer supplied again.  */
+    media_ptr -> fx_media_cluster_bitmap =         FX_NULL;
+    media_ptr -> fx_media_cluster_bitmap_buffer =  FX_NULL;
+    media_ptr -> fx_media_cluster_bitmap_size =    0;
+#endif /* FX_ENABLE_CLUSTER_BITMAP */
+
     /* Now remove this media from the open list.  */
 
     /* Lockout interrupts for media removal.  */
@@ -0,0 +1,91 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** FileX Component                                                       */
+/**                                                                       */
+/**   Media                                                               */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define FX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "fx_api.h"
+#include "fx_media.h"
+
+
+#ifdef FX_ENABLE_CLUSTER_BITMAP
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _fx_media_cluster_bitmap_set                        PORTABLE C      */
+/*                                                           6.2.0        */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function supplies the buffer for the free cluster bitmap of    */
+/*    the next open of the media, one bit per cluster number. It must be  */
+/*    called before fx_media_open. The bitmap is filled in the FAT pass   */
+/*    open already makes to count the free clusters. If open takes the    */
+/*    free cluster count from the FAT32 information sector instead, the   */
+/*    bitmap is built on the first cluster allocation. Open ignores a     */
+/*    buffer too small for the media and exFAT media, which keep their    */
+/*    own allocation bitmap. The buffer must stay valid until the media   */
+/*    is closed, close forgets it.                                        */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    media_ptr                             Media control block pointer   */
+/*    bitmap_buffer                         Pointer to the bitmap buffer, */
+/*                                            FX_NULL for no bitmap       */
+/*    bitmap_size                           Size of the bitmap buffer in  */
+/*                                            bytes                       */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    return status                                                       */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application Code                                                    */
+/*                                                                        */
+/**************************************************************************/
+UINT  _fx_media_cluster_bitmap_set(FX_MEDIA *media_ptr, VOID *bitmap_buffer, ULONG bitmap_size)
+{
+
+    /* The buffer can only be changed while the media is not open.  */
+    if (media_ptr -> fx_media_id == FX_MEDIA_ID)
+    {
+        return(FX_ACCESS_ERROR);
+    }
+
+    /* Remember the buffer for the next open.  */
+    media_ptr -> fx_media_cluster_bitmap_buffer =  (ULONG *)bitmap_buffer;
+    media_ptr -> fx_media_cluster_bitmap_size =    bitmap_size;
+
+    /* Return successful status.  */
+    return(FX_SUCCESS);
+}
+#endif /* FX_ENABLE_CLUSTER_BITMAP */
@@ -0,0 +1,121 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** FileX Component                                                       */
+/**                                                                       */
+/**   Media                                                               */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define FX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "fx_api.h"
+#include "fx_system.h"
+#include "fx_media.h"
+#include "fx_directory.h"
+
+
+#ifdef FX_ENABLE_DIRECTORY_INDEX
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _fx_media_directory_index_enable                    PORTABLE C      */
+/*                                                           6.2.0        */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function gives an open FAT12, FAT16 or FAT32 media a buffer for*/
+/*    its directory index. Each directory is indexed at its first search  */
+/*    and the name hashes of its entries are kept in the buffer, 8 bytes  */
+/*    per name, so a search reads only the entries with the hash of the   */
+/*    name. The least recently used directories are dropped when the      */
+/*    buffer is full. A NULL buffer disables the directory index. The     */
+/*    buffer must stay valid until the media is closed.                   */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    media_ptr                             Media control block pointer   */
+/*    index_buffer                          Pointer to the index buffer   */
+/*    index_size                            Size of the index buffer in   */
+/*                                            bytes                       */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    return status                                                       */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _fx_directory_index_invalidate        Drop directory indexes        */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application Code                                                    */
+/*                                                                        */
+/**************************************************************************/
+UINT  _fx_media_directory_index_enable(FX_MEDIA *media_ptr, VOID *index_buffer, ULONG index_size)
+{
+
+
+    /* Check the media to make sure it is open.  */
+    if (media_ptr -> fx_media_id != FX_MEDIA_ID)
+    {
+
+        /* Return the media not opened error.  */
+        return(FX_MEDIA_NOT_OPEN);
+    }
+
+#ifdef FX_ENABLE_EXFAT
+
+    /* exFAT directory entries already hold a name hash.  */
+    if (media_ptr -> fx_media_FAT_type == FX_exFAT)
+    {
+        return(FX_NOT_IMPLEMENTED);
+    }
+#endif /* FX_ENABLE_EXFAT */
+
+    /* Protect against other threads accessing the media.  */
+    FX_PROTECT
+
+    /* Drop the index of every directory.  */
+    _fx_directory_index_invalidate(media_ptr, FX_DIRECTORY_INDEX_ALL);
+
+    /* Attach the buffer to the media, a buffer too small for one record
+       disables the directory index.  */
+    media_ptr -> fx_media_directory_index_size =  index_size / sizeof(FX_DIRECTORY_INDEX_RECORD);
+    media_ptr -> fx_media_directory_index_used =  0;
+    if ((index_buffer == FX_NULL) || (media_ptr -> fx_media_directory_index_size == 0))
+    {
+        media_ptr -> fx_media_directory_index_buffer =  FX_NULL;
+        media_ptr -> fx_media_directory_index_size =    0;
+    }
+    else
+    {
+        media_ptr -> fx_media_directory_index_buffer =  (FX_DIRECTORY_INDEX_RECORD *)index_buffer;
+    }
+
+    /* Release media protection.  */
+    FX_UNPROTECT
+
+    /* Return successful status.  */
+    return(FX_SUCCESS);
+}
+#endif /* FX_ENABLE_DIRECTORY_INDEX */
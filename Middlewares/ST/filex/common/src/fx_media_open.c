@@ -28,6 +28,7 @@
 #include "fx_api.h"
 #include "fx_system.h"
 #include "fx_media.h"
+#include "fx_directory.h"
 #include "fx_utility.h"
 
 
@@ -113,6 +114,9 @@
 /*    _fx_utility_logical_sector_flush      Invalidate log sector cache   */
 /*    _fx_media_boot_info_extract           Extract media information     */
 /*    _fx_utility_FAT_entry_read            Pickup FAT entry contents     */
+/*    _fx_utility_memory_set                Set the cluster bitmap        */
+/*    _fx_directory_path_cache_invalidate   Forget resolved directory     */
+/*                                            paths                       */
 /*    tx_mutex_create                       Create protection mutex       */
 /*                                                                        */
 /*  CALLED BY                                                             */
@@ -154,6 +158,10 @@ UINT              status;
 UINT              additional_info_sector;
 UCHAR            *original_memory_ptr;
 ULONG             bytes_in_buffer;
+#ifdef FX_ENABLE_CLUSTER_BITMAP
+ULONG            *bitmap;
+ULONG             bitmap_size;
+#endif /* FX_ENABLE_CLUSTER_BITMAP */
 FX_INT_SAVE_AREA
 
 
@@ -168,9 +176,22 @@ FX_INT_SAVE_AREA
     }
 #endif /* FX_DISABLE_BUILD_OPTIONS */
 
+#ifdef FX_ENABLE_CLUSTER_BITMAP
+
+    /* Pickup the free cluster bitmap buffer supplied with fx_media_cluster_bitmap_set. The media
+       only keeps it once it is checked below, a failed open forgets it.  */
+    bitmap =       media_ptr -> fx_media_cluster_bitmap_buffer;
+    bitmap_size =  media_ptr -> fx_media_cluster_bitmap_size;
+#endif /* FX_ENABLE_CLUSTER_BITMAP */
+
 #ifdef FX_DISABLE_FORCE_MEMORY_OPERATION
     _fx_utility_memory_set((UCHAR *)media_ptr, 0, sizeof(FX_MEDIA));
 #endif /* FX_DISABLE_FORCE_MEMORY_OPERATION */
+#ifdef FX_ENABLE_CLUSTER_BITMAP
+    media_ptr -> fx_media_cluster_bitmap =         FX_NULL;
+    media_ptr -> fx_media_cluster_bitmap_buffer =  FX_NULL;
+    media_ptr -> fx_media_cluster_bitmap_size =    0;
+#endif /* FX_ENABLE_CLUSTER_BITMAP */
 #ifdef FX_DISABLE_CACHE
     media_ptr -> fx_media_memory_buffer_sector = (ULONG64)-1;
 #endif /* FX_DISABLE_CACHE */
@@ -638,6 +659,36 @@ FX_INT_SAVE_AREA
     media_ptr -> fx_media_cluster_search_start =  0;
 #endif /* FX_DISABLE_FORCE_MEMORY_OPERATION */
 
+#ifdef FX_ENABLE_CLUSTER_BITMAP
+
+    /* Calculate the number of free cluster bitmap words, indexed by cluster number.  */
+    media_ptr -> fx_media_cluster_bitmap_words =  (media_ptr -> fx_media_total_clusters + FX_FAT_ENTRY_START + 31) >> 5;
+
+    /* Determine if the bitmap buffer is too small for the media.  */
+    if (bitmap_size < media_ptr -> fx_media_cluster_bitmap_words * sizeof(ULONG))
+    {
+        bitmap =  FX_NULL;
+    }
+#ifdef FX_ENABLE_EXFAT
+
+    /* exFAT media already keep an allocation bitmap.  */
+    if (media_ptr -> fx_media_FAT_type == FX_exFAT)
+    {
+        bitmap =  FX_NULL;
+    }
+#endif /* FX_ENABLE_EXFAT */
+
+    /* Mark all clusters in use, including the reserved entries and the bits past the
+       last cluster. The free clusters are cleared by the FAT pass below, or by the
+       first cluster search if the FAT32 information sector makes the pass unnecessary.  */
+    if (bitmap)
+    {
+        _fx_utility_memory_set((UCHAR *)bitmap, 0xFF, media_ptr -> fx_media_cluster_bitmap_words * sizeof(ULONG));
+        media_ptr -> fx_media_cluster_bitmap_buffer =  bitmap;
+        media_ptr -> fx_media_cluster_bitmap_size =    bitmap_size;
+    }
+#endif /* FX_ENABLE_CLUSTER_BITMAP */
+
     /* Determine if there is 32-bit FAT additional information sector. */
     if (media_ptr -> fx_media_FAT32_additional_info_sector)
     {
@@ -793,6 +844,15 @@ FX_INT_SAVE_AREA
                 /* Increment the number of available clusters.  */
                 media_ptr -> fx_media_available_clusters++;
 
+#ifdef FX_ENABLE_CLUSTER_BITMAP
+
+                /* Clear the cluster in the free cluster bitmap.  */
+                if (bitmap)
+                {
+                    bitmap[cluster_number >> 5] &=  ~(((ULONG)1) << (cluster_number & 31));
+                }
+#endif /* FX_ENABLE_CLUSTER_BITMAP */
+
                 /* Determine if the starting free cluster has been found yet.  */
                 if (media_ptr -> fx_media_cluster_search_start == 0)
                 {
@@ -802,6 +862,12 @@ FX_INT_SAVE_AREA
                 }
             }
         }
+
+#ifdef FX_ENABLE_CLUSTER_BITMAP
+
+        /* The FAT pass built the free cluster bitmap, attach it.  */
+        media_ptr -> fx_media_cluster_bitmap =  bitmap;
+#endif /* FX_ENABLE_CLUSTER_BITMAP */
     }
 #ifdef FX_ENABLE_EXFAT
     else if ((media_ptr -> fx_media_available_clusters == 0)
@@ -917,6 +983,15 @@ FX_INT_SAVE_AREA
                     /* Entry is free, increment available clusters.  */
                     media_ptr -> fx_media_available_clusters++;
 
+#ifdef FX_ENABLE_CLUSTER_BITMAP
+
+                    /* Clear the cluster in the free cluster bitmap.  */
+                    if ((bitmap) && (cluster_number >= FX_FAT_ENTRY_START))
+                    {
+                        bitmap[cluster_number >> 5] &=  ~(((ULONG)1) << (cluster_number & 31));
+                    }
+#endif /* FX_ENABLE_CLUSTER_BITMAP */
+
                     /* Determine if the starting free cluster has been found yet.  */
                     if (media_ptr -> fx_media_cluster_search_start == 0)
                     {
@@ -941,6 +1016,12 @@ FX_INT_SAVE_AREA
                 }
             }
         }
+
+#ifdef FX_ENABLE_CLUSTER_BITMAP
+
+        /* The FAT pass built the free cluster bitmap, attach it.  */
+        media_ptr -> fx_media_cluster_bitmap =  bitmap;
+#endif /* FX_ENABLE_CLUSTER_BITMAP */
     }
 #ifdef FX_ENABLE_EXFAT
     else if (media_ptr -> fx_media_FAT_type == FX_exFAT)
@@ -978,6 +1059,34 @@ FX_INT_SAVE_AREA
     media_ptr -> fx_media_last_found_name[0] =  0;
 #endif
 
+#ifdef FX_ENABLE_DIRECTORY_INDEX
+
+    /* Start without a directory index. The buffer of a previous open may be gone, it is
+       supplied again with fx_media_directory_index_enable.  */
+    media_ptr -> fx_media_directory_index_buffer =  FX_NULL;
+    media_ptr -> fx_media_directory_index_size =    0;
+    media_ptr -> fx_media_directory_index_used =    0;
+    for (i = 0; i < FX_DIRECTORY_INDEX_MAX_DIRECTORIES; i++)
+    {
+        media_ptr -> fx_media_directory_index[i].fx_directory_index_state =  FX_DIRECTORY_INDEX_FREE;
+    }
+#ifndef FX_MEDIA_STATISTICS_DISABLE
+    media_ptr -> fx_media_directory_index_builds =  0;
+    media_ptr -> fx_media_directory_index_hits =    0;
+#endif
+#endif /* FX_ENABLE_DIRECTORY_INDEX */
+
+#ifdef FX_ENABLE_PATH_CACHE
+
+    /* Forget the directory paths resolved before, an aborted media does not
+       forget them and another volume may be in the drive now.  */
+    _fx_directory_path_cache_invalidate(media_ptr);
+    media_ptr -> fx_media_path_cache_time =  0;
+#ifndef FX_MEDIA_STATISTICS_DISABLE
+    media_ptr -> fx_media_path_cache_hits =  0;
+#endif
+#endif /* FX_ENABLE_PATH_CACHE */
+
 #ifndef FX_DISABLE_FORCE_MEMORY_OPERATION
     /* Initialize the opened file linked list and associated counter.  */
     media_ptr -> fx_media_opened_file_list =      FX_NULL;
@@ -27,6 +27,7 @@
 
 #include "fx_api.h"
 #include "fx_unicode.h"
+#include "fx_directory.h"
 #include "fx_utility.h"
 #ifdef FX_ENABLE_FAULT_TOLERANT
 #include "fx_fault_tolerant.h"
@@ -60,6 +61,7 @@
 /*                                                                        */
 /*  CALLS                                                                 */
 /*                                                                        */
+/*    _fx_directory_index_invalidate        Drop directory indexes        */
 /*    _fx_utility_FAT_entry_read            Read a FAT entry              */
 /*    _fx_utility_logical_sector_read       Read a logical sector         */
 /*    _fx_utility_logical_sector_write      Write a logical sector        */
@@ -367,6 +369,12 @@ ULONG  changed_offset;
         return(FX_FILE_CORRUPT);
     }
 
+#ifdef FX_ENABLE_DIRECTORY_INDEX
+
+    /* The long name of the entry changes, drop the directory indexes.  */
+    _fx_directory_index_invalidate(media_ptr, FX_DIRECTORY_INDEX_ALL);
+#endif /* FX_ENABLE_DIRECTORY_INDEX */
+
 #ifdef FX_ENABLE_FAULT_TOLERANT
     if (media_ptr -> fx_media_fault_tolerant_enabled)
     {
@@ -60,6 +60,8 @@
 /*                                                                        */
 /*  CALLS                                                                 */
 /*                                                                        */
+/*    _fx_utility_cluster_bitmap_update                                   */
+/*                                          Update cluster in bitmap      */
 /*    _fx_utility_FAT_flush                 FLUSH dirty entries in the    */
 /*                                            FAT cache                   */
 /*    _fx_fault_tolerant_add_fat_log        Add FAT redo log              */
@@ -84,6 +86,15 @@ UINT                status, index, i;
 FX_FAT_CACHE_ENTRY *cache_entry_ptr;
 #ifdef FX_ENABLE_FAULT_TOLERANT
 ULONG               FAT_sector;
+#endif /* FX_ENABLE_FAULT_TOLERANT */
+
+#ifdef FX_ENABLE_CLUSTER_BITMAP
+
+    /* Keep the free cluster bitmap in step with the FAT.  */
+    _fx_utility_cluster_bitmap_update(media_ptr, cluster, next_cluster);
+#endif /* FX_ENABLE_CLUSTER_BITMAP */
+
+#ifdef FX_ENABLE_FAULT_TOLERANT
 
     /* While fault_tolerant is enabled, only FAT entries in the same sector are allowed to be cached. */
     /* We must flush FAT sectors in the order of FAT chains. */
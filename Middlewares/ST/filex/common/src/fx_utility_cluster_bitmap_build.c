@@ -0,0 +1,156 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** FileX Component                                                       */
+/**                                                                       */
+/**   Utility                                                             */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define FX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "fx_api.h"
+#include "fx_utility.h"
+
+
+#ifdef FX_ENABLE_CLUSTER_BITMAP
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _fx_utility_cluster_bitmap_build                    PORTABLE C      */
+/*                                                           6.2.0        */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function builds the free cluster bitmap of a media opened      */
+/*    without a FAT pass, because the FAT32 information sector supplied   */
+/*    the free cluster count. It is called on the first cluster search.   */
+/*    Open has already marked all clusters in use, the free clusters are  */
+/*    cleared here and the available cluster count and the free cluster   */
+/*    search start are set from the bitmap. If the FAT can't be read the  */
+/*    buffer is dropped and allocation searches the FAT.                  */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    media_ptr                             Media control block pointer   */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    return status                                                       */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _fx_utility_32_unsigned_read          Read a ULONG from memory      */
+/*    _fx_utility_FAT_flush                 Flush written FAT entries     */
+/*    _fx_utility_logical_sector_read       Read a FAT sector             */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _fx_utility_cluster_bitmap_free_find                                */
+/*    _fx_utility_cluster_bitmap_run_find                                 */
+/*                                                                        */
+/**************************************************************************/
+UINT  _fx_utility_cluster_bitmap_build(FX_MEDIA *media_ptr)
+{
+
+UINT   status;
+ULONG  cluster;
+ULONG  end_cluster;
+ULONG  FAT_sector;
+ULONG  current_sector;
+ULONG  byte_offset;
+ULONG  available_clusters;
+ULONG  first_free_cluster;
+ULONG *bitmap;
+
+
+    /* Write the cached FAT entries so the FAT sectors are up to date.  */
+    status =  _fx_utility_FAT_flush(media_ptr);
+
+    /* Walk through the FAT. Only FAT32 media have an information sector, so
+       the entries are 32 bits.  */
+    bitmap =              media_ptr -> fx_media_cluster_bitmap_buffer;
+    end_cluster =         media_ptr -> fx_media_total_clusters + FX_FAT_ENTRY_START;
+    available_clusters =  0;
+    first_free_cluster =  0;
+    current_sector =      0;
+    for (cluster = FX_FAT_ENTRY_START; (status == FX_SUCCESS) && (cluster < end_cluster); cluster++)
+    {
+
+        /* Calculate the FAT sector and the offset of the entry.  */
+        FAT_sector =   ((cluster * 4) / media_ptr -> fx_media_bytes_per_sector) +
+            (ULONG)media_ptr -> fx_media_reserved_sectors;
+        byte_offset =  (cluster * 4) % media_ptr -> fx_media_bytes_per_sector;
+
+        /* Read the FAT sector once for all of its entries.  */
+        if (FAT_sector != current_sector)
+        {
+            status =  _fx_utility_logical_sector_read(media_ptr, (ULONG64) FAT_sector,
+                                                      media_ptr -> fx_media_memory_buffer, ((ULONG) 1), FX_FAT_SECTOR);
+            current_sector =  FAT_sector;
+            if (status != FX_SUCCESS)
+            {
+                break;
+            }
+        }
+
+        /* Determine if the cluster is free.  */
+        if ((_fx_utility_32_unsigned_read((UCHAR *)media_ptr -> fx_media_memory_buffer + byte_offset) & 0x0FFFFFFF) == FX_FREE_CLUSTER)
+        {
+
+            /* Clear its bit and count it.  */
+            bitmap[cluster >> 5] &=  ~(((ULONG)1) << (cluster & 31));
+            available_clusters++;
+
+            /* Remember the first free cluster.  */
+            if (first_free_cluster == 0)
+            {
+                first_free_cluster =  cluster;
+            }
+        }
+    }
+
+    /* Determine if an error occurred.  */
+    if (status != FX_SUCCESS)
+    {
+
+        /* Drop the partly built bitmap, allocation searches the FAT.  */
+        media_ptr -> fx_media_cluster_bitmap_buffer =  FX_NULL;
+
+        /* Return the error status.  */
+        return(status);
+    }
+
+    /* The bitmap count is exact, it replaces the count of the information sector.  */
+    media_ptr -> fx_media_available_clusters =  available_clusters;
+
+    /* Start further searches from the first free cluster.  */
+    if (first_free_cluster)
+    {
+        media_ptr -> fx_media_cluster_search_start =  first_free_cluster;
+    }
+
+    /* Attach the bitmap to the media.  */
+    media_ptr -> fx_media_cluster_bitmap =  bitmap;
+
+    /* Return successful status.  */
+    return(FX_SUCCESS);
+}
+#endif /* FX_ENABLE_CLUSTER_BITMAP */
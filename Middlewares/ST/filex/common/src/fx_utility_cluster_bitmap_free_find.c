@@ -0,0 +1,138 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** FileX Component                                                       */
+/**                                                                       */
+/**   Utility                                                             */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define FX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "fx_api.h"
+#include "fx_utility.h"
+
+
+#ifdef FX_ENABLE_CLUSTER_BITMAP
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _fx_utility_cluster_bitmap_free_find                PORTABLE C      */
+/*                                                           6.2.0        */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function finds the first cluster the free cluster bitmap shows */
+/*    as free, starting at the specified cluster and wrapping around to   */
+/*    the first cluster of the media. Words with all clusters in use are  */
+/*    skipped whole. The caller still reads the FAT entry of the cluster  */
+/*    before it is allocated. A bitmap not built at open is built first.  */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    media_ptr                             Media control block pointer   */
+/*    start_cluster                         Cluster to start the search   */
+/*    free_cluster                          Destination for the free      */
+/*                                            cluster                     */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    FX_SUCCESS                            Free cluster found            */
+/*    FX_NO_MORE_SPACE                      No free cluster               */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _fx_utility_cluster_bitmap_build      Build the bitmap from the FAT */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _fx_file_write                                                      */
+/*                                                                        */
+/**************************************************************************/
+UINT  _fx_utility_cluster_bitmap_free_find(FX_MEDIA *media_ptr, ULONG start_cluster, ULONG *free_cluster)
+{
+
+ULONG  cluster;
+ULONG  end_cluster;
+ULONG  free_bits;
+ULONG  words;
+ULONG *bitmap;
+
+
+    /* Build the bitmap on the first search if open didn't pass over the FAT.  */
+    if ((media_ptr -> fx_media_cluster_bitmap == FX_NULL) &&
+        (_fx_utility_cluster_bitmap_build(media_ptr) != FX_SUCCESS))
+    {
+
+        /* No bitmap, the caller searches the FAT from the start cluster.  */
+        *free_cluster =  start_cluster;
+        return(FX_SUCCESS);
+    }
+
+    /* Setup the bitmap pointer and the end of the data clusters.  */
+    bitmap =       media_ptr -> fx_media_cluster_bitmap;
+    end_cluster =  media_ptr -> fx_media_total_clusters + FX_FAT_ENTRY_START;
+
+    /* Make sure the start is a data cluster.  */
+    if ((start_cluster < FX_FAT_ENTRY_START) || (start_cluster >= end_cluster))
+    {
+        start_cluster =  FX_FAT_ENTRY_START;
+    }
+
+    /* Pickup the free clusters of the start word at or after the start cluster.  */
+    cluster =    start_cluster & ~((ULONG)31);
+    free_bits =  ~bitmap[cluster >> 5] & (((ULONG)0xFFFFFFFF) << (start_cluster & 31));
+
+    /* Examine each word once, plus the start word again for the clusters before the start.  */
+    words =  media_ptr -> fx_media_cluster_bitmap_words + 1;
+    while (words--)
+    {
+
+        /* Determine if this word has a free cluster.  */
+        if (free_bits)
+        {
+
+            /* Locate the lowest free cluster in the word.  */
+            while (!(free_bits & 1))
+            {
+                free_bits =  free_bits >> 1;
+                cluster++;
+            }
+
+            /* Return the cluster. Bits past the last cluster are always set.  */
+            *free_cluster =  cluster;
+            return(FX_SUCCESS);
+        }
+
+        /* Move to the next word, wrapping to the start of the bitmap.  */
+        cluster =  (cluster & ~((ULONG)31)) + 32;
+        if (cluster >= end_cluster)
+        {
+            cluster =  0;
+        }
+        free_bits =  ~bitmap[cluster >> 5];
+    }
+
+    /* No free cluster on the media.  */
+    return(FX_NO_MORE_SPACE);
+}
+#endif /* FX_ENABLE_CLUSTER_BITMAP */
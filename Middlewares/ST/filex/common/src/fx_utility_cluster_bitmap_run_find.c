@@ -0,0 +1,178 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** FileX Component                                                       */
+/**                                                                       */
+/**   Utility                                                             */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define FX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "fx_api.h"
+#include "fx_utility.h"
+
+
+#ifdef FX_ENABLE_CLUSTER_BITMAP
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _fx_utility_cluster_bitmap_run_find                 PORTABLE C      */
+/*                                                           6.2.0        */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function finds the first run of consecutive clusters the free  */
+/*    cluster bitmap shows as free, at or after the specified cluster.    */
+/*    Words with all clusters free or all clusters in use are handled     */
+/*    whole. The caller still reads the FAT entries of the run before it  */
+/*    is allocated. A bitmap not built at open is built first.            */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    media_ptr                             Media control block pointer   */
+/*    start_cluster                         Cluster to start the search   */
+/*    clusters                              Number of clusters in the run */
+/*    first_cluster                         Destination for the first     */
+/*                                            cluster of the run          */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    FX_SUCCESS                            Run found                     */
+/*    FX_NO_MORE_SPACE                      No run of that length         */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _fx_utility_cluster_bitmap_build      Build the bitmap from the FAT */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _fx_file_extended_allocate                                          */
+/*    _fx_file_extended_best_effort_allocate                              */
+/*                                                                        */
+/**************************************************************************/
+UINT  _fx_utility_cluster_bitmap_run_find(FX_MEDIA *media_ptr, ULONG start_cluster, ULONG clusters, ULONG *first_cluster)
+{
+
+ULONG  cluster;
+ULONG  end_cluster;
+ULONG  run_start;
+ULONG  run_length;
+ULONG  word;
+ULONG *bitmap;
+
+
+    /* Build the bitmap on the first search if open didn't pass over the FAT.  */
+    if ((media_ptr -> fx_media_cluster_bitmap == FX_NULL) &&
+        (_fx_utility_cluster_bitmap_build(media_ptr) != FX_SUCCESS))
+    {
+
+        /* No bitmap, the caller searches the FAT from the start cluster.  */
+        *first_cluster =  start_cluster;
+        return(FX_SUCCESS);
+    }
+
+    /* Setup the bitmap pointer and the end of the data clusters.  */
+    bitmap =       media_ptr -> fx_media_cluster_bitmap;
+    end_cluster =  media_ptr -> fx_media_total_clusters + FX_FAT_ENTRY_START;
+
+    /* Make sure the start is a data cluster.  */
+    if (start_cluster < FX_FAT_ENTRY_START)
+    {
+        start_cluster =  FX_FAT_ENTRY_START;
+    }
+
+    /* Loop through the clusters until the run is found.  */
+    run_start =   start_cluster;
+    run_length =  0;
+    cluster =     start_cluster;
+    while (cluster < end_cluster)
+    {
+
+        /* Pickup the word of this cluster.  */
+        word =  bitmap[cluster >> 5];
+
+        /* Determine if a whole word can be taken at once.  */
+        if (((cluster & 31) == 0) && ((word == 0) || (word == 0xFFFFFFFF)))
+        {
+
+            /* Determine if all the clusters of the word are free.  */
+            if (word == 0)
+            {
+
+                /* Yes, add them to the run.  */
+                if (run_length == 0)
+                {
+                    run_start =  cluster;
+                }
+                run_length =  run_length + 32;
+            }
+            else
+            {
+
+                /* No, all are in use, the run starts over.  */
+                run_length =  0;
+            }
+
+            /* Move to the next word.  */
+            cluster =  cluster + 32;
+        }
+        else
+        {
+
+            /* Determine if this cluster is free.  */
+            if (word & (((ULONG)1) << (cluster & 31)))
+            {
+
+                /* No, the run starts over.  */
+                run_length =  0;
+            }
+            else
+            {
+
+                /* Yes, add it to the run.  */
+                if (run_length == 0)
+                {
+                    run_start =  cluster;
+                }
+                run_length++;
+            }
+
+            /* Move to the next cluster.  */
+            cluster++;
+        }
+
+        /* Determine if the run is long enough. Bits past the last cluster are
+           always set, so the run never passes the end of the media.  */
+        if (run_length >= clusters)
+        {
+
+            /* Return the first cluster of the run.  */
+            *first_cluster =  run_start;
+            return(FX_SUCCESS);
+        }
+    }
+
+    /* No run of this length.  */
+    return(FX_NO_MORE_SPACE);
+}
+#endif /* FX_ENABLE_CLUSTER_BITMAP */
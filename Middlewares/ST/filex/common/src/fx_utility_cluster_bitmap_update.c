@@ -0,0 +1,103 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** FileX Component                                                       */
+/**                                                                       */
+/**   Utility                                                             */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define FX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "fx_api.h"
+#include "fx_utility.h"
+
+
+#ifdef FX_ENABLE_CLUSTER_BITMAP
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _fx_utility_cluster_bitmap_update                   PORTABLE C      */
+/*                                                           6.2.0        */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function updates the bit of a cluster in the free cluster      */
+/*    bitmap of the media after its FAT entry is written. A free entry    */
+/*    clears the bit, any other value sets it.                            */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    media_ptr                             Media control block pointer   */
+/*    cluster                               Cluster entry number          */
+/*    value                                 New value of the FAT entry    */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _fx_utility_FAT_entry_write                                         */
+/*    _fx_file_write                                                      */
+/*    _fx_file_extended_allocate                                          */
+/*    _fx_file_extended_best_effort_allocate                              */
+/*                                                                        */
+/**************************************************************************/
+VOID  _fx_utility_cluster_bitmap_update(FX_MEDIA *media_ptr, ULONG cluster, ULONG value)
+{
+
+ULONG *word_ptr;
+ULONG  bit;
+
+
+    /* Determine if the bitmap is enabled and the cluster is a data cluster.  */
+    if ((media_ptr -> fx_media_cluster_bitmap == FX_NULL) ||
+        (cluster < FX_FAT_ENTRY_START) ||
+        (cluster >= media_ptr -> fx_media_total_clusters + FX_FAT_ENTRY_START))
+    {
+        return;
+    }
+
+    /* Build the word pointer and bit of the cluster.  */
+    word_ptr =  &media_ptr -> fx_media_cluster_bitmap[cluster >> 5];
+    bit =       ((ULONG)1) << (cluster & 31);
+
+    /* Determine if the cluster is now free.  */
+    if (value == FX_FREE_CLUSTER)
+    {
+
+        /* Yes, clear the bit.  */
+        *word_ptr &=  ~bit;
+    }
+    else
+    {
+
+        /* No, set the bit.  */
+        *word_ptr |=  bit;
+    }
+}
+#endif /* FX_ENABLE_CLUSTER_BITMAP */
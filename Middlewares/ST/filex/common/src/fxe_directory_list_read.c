@@ -0,0 +1,107 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** FileX Component                                                       */
+/**                                                                       */
+/**   Directory                                                           */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define FX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "fx_api.h"
+#include "fx_directory.h"
+
+
+FX_CALLER_CHECKING_EXTERNS
+
+
+#ifdef FX_ENABLE_DIRECTORY_LIST
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _fxe_directory_list_read                            PORTABLE C      */
+/*                                                           6.2.0        */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function checks for errors in the directory list read call.    */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    media_ptr                             Media control block pointer   */
+/*    directory_name                        Directory name, FX_NULL for   */
+/*                                            the default directory       */
+/*    entry_index                           Pointer to the entry to start */
+/*                                            at, 0 first, updated to the */
+/*                                            entry to continue at        */
+/*    attributes_mask                       Attributes checked by filter  */
+/*    attributes_value                      Value the checked attributes  */
+/*                                            must have                   */
+/*    name_prefix                           Leading characters of names   */
+/*                                            returned, FX_NULL for all   */
+/*    list_ptr                              Destination entry array       */
+/*    list_size                             Number of entries in array    */
+/*    list_count                            Destination for the number of */
+/*                                            entries returned            */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    FX_PTR_ERROR                          Invalid pointer or list size  */
+/*    return status                         Actual completion status      */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _fx_directory_list_read               Actual directory list read    */
+/*                                            service                     */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application Code                                                    */
+/*                                                                        */
+/**************************************************************************/
+UINT  _fxe_directory_list_read(FX_MEDIA *media_ptr, CHAR *directory_name, ULONG *entry_index,
+                               UINT attributes_mask, UINT attributes_value, CHAR *name_prefix,
+                               FX_DIRECTORY_LIST_ENTRY *list_ptr, UINT list_size, UINT *list_count)
+{
+
+UINT status;
+
+
+    /* Check for a NULL pointer or an empty list.  */
+    if ((media_ptr == FX_NULL) || (entry_index == FX_NULL) || (list_ptr == FX_NULL) ||
+        (list_size == 0) || (list_count == FX_NULL))
+    {
+        return(FX_PTR_ERROR);
+    }
+
+    /* Check for a valid caller.  */
+    FX_CALLER_CHECKING_CODE
+
+    /* Call actual directory list read service.  */
+    status =  _fx_directory_list_read(media_ptr, directory_name, entry_index, attributes_mask,
+                                      attributes_value, name_prefix, list_ptr, list_size, list_count);
+
+    /* Return status.  */
+    return(status);
+}
+#endif /* FX_ENABLE_DIRECTORY_LIST */
@@ -0,0 +1,94 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** FileX Component                                                       */
+/**                                                                       */
+/**   Media                                                               */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define FX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "fx_api.h"
+#include "fx_media.h"
+
+
+FX_CALLER_CHECKING_EXTERNS
+
+
+#ifdef FX_ENABLE_CLUSTER_BITMAP
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _fxe_media_cluster_bitmap_set                       PORTABLE C      */
+/*                                                           6.2.0        */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function checks for errors in the media cluster bitmap set     */
+/*    call.                                                               */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    media_ptr                             Media control block pointer   */
+/*    bitmap_buffer                         Pointer to the bitmap buffer, */
+/*                                            FX_NULL for no bitmap       */
+/*    bitmap_size                           Size of the bitmap buffer in  */
+/*                                            bytes                       */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    return status                                                       */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _fx_media_cluster_bitmap_set          Actual media cluster bitmap   */
+/*                                            set service                 */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application Code                                                    */
+/*                                                                        */
+/**************************************************************************/
+UINT  _fxe_media_cluster_bitmap_set(FX_MEDIA *media_ptr, VOID *bitmap_buffer, ULONG bitmap_size)
+{
+
+UINT status;
+
+
+    /* Check for a NULL media pointer, or a bitmap not aligned for ULONG access.  */
+    if ((media_ptr == FX_NULL) ||
+        (((ALIGN_TYPE)bitmap_buffer) & (sizeof(ULONG) - 1)))
+    {
+        return(FX_PTR_ERROR);
+    }
+
+    /* Check for a valid caller.  */
+    FX_CALLER_CHECKING_CODE
+
+    /* Call actual media cluster bitmap set service.  */
+    status =  _fx_media_cluster_bitmap_set(media_ptr, bitmap_buffer, bitmap_size);
+
+    /* Return status to the caller.  */
+    return(status);
+}
+#endif /* FX_ENABLE_CLUSTER_BITMAP */
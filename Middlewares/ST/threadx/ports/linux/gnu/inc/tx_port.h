@@ -0,0 +1,316 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** ThreadX Component                                                     */
+/**                                                                       */
+/**   Port Specific                                                       */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  PORT SPECIFIC C INFORMATION                            RELEASE        */
+/*                                                                        */
+/*    tx_port.h                                           Linux/GNU       */
+/*                                                           6.2.0        */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This file contains data type definitions that make the ThreadX      */
+/*    real-time kernel function identically on a variety of different     */
+/*    processor architectures.  For example, the size or number of bits   */
+/*    in an "int" data type vary between microprocessor architectures and */
+/*    even C compilers for the same microprocessor.  ThreadX does not     */
+/*    directly use native C data types.  Instead, ThreadX creates its     */
+/*    own special types that can be mapped to actual data types by this   */
+/*    file to guarantee consistency in the interface and functionality.   */
+/*                                                                        */
+/*    This port runs ThreadX as a process on a Linux host so that the     */
+/*    middleware can be built and exercised off-target.  Each ThreadX     */
+/*    thread is a pthread that only runs while it is the current thread.  */
+/*    A single mutex stands for the interrupt lockout and a pthread       */
+/*    driven by an absolute clock delivers the periodic timer interrupt.  */
+/*    A thread made ready by the timer interrupt takes over at the next   */
+/*    kernel service of the running thread, not in the middle of          */
+/*    application code.                                                   */
+/*                                                                        */
+/**************************************************************************/
+
+#ifndef TX_PORT_H
+#define TX_PORT_H
+
+
+/* Determine if the optional ThreadX user define file should be used.  */
+
+#ifdef TX_INCLUDE_USER_DEFINE_FILE
+
+/* Yes, include the user defines in tx_user.h. The defines in this file may
+   alternately be defined on the command line.  */
+
+#include "tx_user.h"
+#endif
+
+
+/* Define compiler library include files.  */
+
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <semaphore.h>
+
+
+/* Define ThreadX basic types for this port.  ULONG stays 32 bits wide on a
+   64-bit host since the middleware relies on it to walk 32-bit fields.  */
+
+#define VOID                                    void
+typedef char                                    CHAR;
+typedef unsigned char                           UCHAR;
+typedef int                                     INT;
+typedef unsigned int                            UINT;
+#ifdef __LP64__
+typedef int                                     LONG;
+typedef unsigned int                            ULONG;
+#else
+typedef long                                    LONG;
+typedef unsigned long                           ULONG;
+#endif
+typedef unsigned long long                      ULONG64;
+typedef short                                   SHORT;
+typedef unsigned short                          USHORT;
+#define ULONG64_DEFINED
+
+
+/* Pointers do not fit in a ULONG on a 64-bit host.  Align on and convert
+   through a 64-bit type and keep the thread and timer control block
+   pointers in the extension fields below.  */
+
+#ifdef __LP64__
+#ifndef TX_64_BIT
+#define TX_64_BIT
+#endif
+#define ALIGN_TYPE_DEFINED
+#define ALIGN_TYPE                              ULONG64
+#endif
+
+
+/* Define the priority levels for ThreadX.  Legal values range
+   from 32 to 1024 and MUST be evenly divisible by 32.  */
+
+#ifndef TX_MAX_PRIORITIES
+#define TX_MAX_PRIORITIES                       32
+#endif
+
+
+/* Define the minimum stack for a ThreadX thread on this processor. The
+   thread really runs on the stack of its pthread, the ThreadX stack is
+   only kept for the stack checking and the diagnostics.  */
+
+#ifndef TX_MINIMUM_STACK
+#define TX_MINIMUM_STACK                        200         /* Minimum stack size for this port  */
+#endif
+
+
+/* Define the system timer thread's default stack size and priority.  These are only applicable
+   if TX_TIMER_PROCESS_IN_ISR is not defined.  */
+
+#ifndef TX_TIMER_THREAD_STACK_SIZE
+#define TX_TIMER_THREAD_STACK_SIZE              1024        /* Default timer thread stack size  */
+#endif
+
+#ifndef TX_TIMER_THREAD_PRIORITY
+#define TX_TIMER_THREAD_PRIORITY                0           /* Default timer thread priority    */
+#endif
+
+
+/* Define the rate of the periodic timer interrupt.  */
+
+#ifndef TX_TIMER_TICKS_PER_SECOND
+#define TX_TIMER_TICKS_PER_SECOND               (100UL)
+#endif
+
+
+/* Define various constants for the ThreadX Linux port.  */
+
+#define TX_INT_DISABLE                          1           /* Disable interrupts               */
+#define TX_INT_ENABLE                           0           /* Enable interrupts                */
+
+
+/* Define the clock source for trace event entry time stamp. The host has no
+   free running counter that can be read as a memory location, use the
+   ThreadX tick instead.  */
+
+#ifndef TX_TRACE_TIME_SOURCE
+#define TX_TRACE_TIME_SOURCE                    _tx_timer_system_clock
+#endif
+
+#ifndef TX_TRACE_TIME_MASK
+#define TX_TRACE_TIME_MASK                      0xFFFFFFFFUL
+#endif
+
+
+/* Define the port specific options for the _tx_build_options variable. This variable indicates
+   how the ThreadX library was built.  */
+
+#define TX_PORT_SPECIFIC_BUILD_OPTIONS          (0)
+
+
+/* Define the in-line initialization constant so that modules with in-line
+   initialization capabilities can prevent their initialization from being
+   a function call.  */
+
+#define TX_INLINE_INITIALIZATION
+
+
+/* Determine whether or not stack checking is enabled. By default, ThreadX stack checking is
+   disabled. When the following is defined, ThreadX thread stack checking is enabled.  If stack
+   checking is enabled (TX_ENABLE_STACK_CHECKING is defined), the TX_DISABLE_STACK_FILLING
+   define is negated, thereby forcing the stack fill which is necessary for the stack checking
+   logic.  */
+
+#ifdef TX_ENABLE_STACK_CHECKING
+#undef TX_DISABLE_STACK_FILLING
+#endif
+
+
+/* Define the TX_THREAD control block extensions for this port. Each thread
+   records its pthread and the semaphore it waits on while it is not the
+   current thread.  */
+
+#define TX_THREAD_EXTENSION_0           pthread_t   tx_thread_linux_thread_id;              \
+                                        sem_t       tx_thread_linux_thread_run_semaphore;
+#define TX_THREAD_EXTENSION_1
+#ifdef  TX_64_BIT
+#define TX_THREAD_EXTENSION_2           VOID        *tx_thread_extension_ptr;
+#else
+#define TX_THREAD_EXTENSION_2
+#endif
+#define TX_THREAD_EXTENSION_3
+
+
+/* Define the port extensions of the remaining ThreadX objects.  */
+
+#define TX_BLOCK_POOL_EXTENSION
+#define TX_BYTE_POOL_EXTENSION
+#define TX_EVENT_FLAGS_GROUP_EXTENSION
+#define TX_MUTEX_EXTENSION
+#define TX_QUEUE_EXTENSION
+#define TX_SEMAPHORE_EXTENSION
+#define TX_TIMER_EXTENSION
+
+#ifdef  TX_64_BIT
+#define TX_TIMER_INTERNAL_EXTENSION     VOID        *tx_timer_internal_extension_ptr;
+#endif
+
+
+/* Define the user extension field of the thread control block.  Nothing
+   additional is needed for this port so it is defined as white space.  */
+
+#ifndef TX_THREAD_USER_EXTENSION
+#define TX_THREAD_USER_EXTENSION
+#endif
+
+
+/* Define the macros for processing extensions in tx_thread_create, tx_thread_delete,
+   tx_thread_shell_entry, and tx_thread_terminate.  */
+
+#define TX_THREAD_CREATE_EXTENSION(thread_ptr)
+#define TX_THREAD_DELETE_EXTENSION(thread_ptr)
+#define TX_THREAD_COMPLETED_EXTENSION(thread_ptr)
+#define TX_THREAD_TERMINATED_EXTENSION(thread_ptr)
+
+
+/* The pthread of a deleted or reset thread is waiting on its semaphore,
+   release it together with the control block.  */
+
+struct TX_THREAD_STRUCT;
+VOID    _tx_linux_thread_delete(struct TX_THREAD_STRUCT *thread_ptr);
+
+#define TX_THREAD_DELETE_PORT_COMPLETION(thread_ptr)                _tx_linux_thread_delete(thread_ptr);
+#define TX_THREAD_RESET_PORT_COMPLETION(thread_ptr)                 _tx_linux_thread_delete(thread_ptr);
+
+
+/* On a 64-bit host the thread and timer control block pointers do not fit
+   in the ULONG timeout parameter, keep them in the extension fields.  */
+
+#ifdef  TX_64_BIT
+#define TX_THREAD_CREATE_TIMEOUT_SETUP(t)                           (t) -> tx_thread_timer.tx_timer_internal_timeout_function =  &(_tx_thread_timeout);    \
+                                                                    (t) -> tx_thread_timer.tx_timer_internal_timeout_param =     0;                         \
+                                                                    (t) -> tx_thread_timer.tx_timer_internal_extension_ptr =     (VOID *) (t);
+
+#define TX_THREAD_TIMEOUT_POINTER_SETUP(t)                          (t) =  (TX_THREAD *) _tx_timer_expired_timer_ptr -> tx_timer_internal_extension_ptr;
+#endif
+
+
+/* Define the ThreadX object creation extensions for the remaining objects.  */
+
+#define TX_BLOCK_POOL_CREATE_EXTENSION(pool_ptr)
+#define TX_BYTE_POOL_CREATE_EXTENSION(pool_ptr)
+#define TX_EVENT_FLAGS_GROUP_CREATE_EXTENSION(group_ptr)
+#define TX_MUTEX_CREATE_EXTENSION(mutex_ptr)
+#define TX_QUEUE_CREATE_EXTENSION(queue_ptr)
+#define TX_SEMAPHORE_CREATE_EXTENSION(semaphore_ptr)
+#define TX_TIMER_CREATE_EXTENSION(timer_ptr)
+
+
+/* Define the ThreadX object deletion extensions for the remaining objects.  */
+
+#define TX_BLOCK_POOL_DELETE_EXTENSION(pool_ptr)
+#define TX_BYTE_POOL_DELETE_EXTENSION(pool_ptr)
+#define TX_EVENT_FLAGS_GROUP_DELETE_EXTENSION(group_ptr)
+#define TX_MUTEX_DELETE_EXTENSION(mutex_ptr)
+#define TX_QUEUE_DELETE_EXTENSION(queue_ptr)
+#define TX_SEMAPHORE_DELETE_EXTENSION(semaphore_ptr)
+#define TX_TIMER_DELETE_EXTENSION(timer_ptr)
+
+
+/* Define the interrupt lockout macros.  The lockout is a process wide mutex,
+   the posture is kept per pthread so that nested lockouts are not taken
+   twice.  */
+
+UINT                                            _tx_thread_interrupt_disable(VOID);
+VOID                                            _tx_thread_interrupt_restore(UINT previous_posture);
+
+#define TX_INTERRUPT_SAVE_AREA                  UINT interrupt_save;
+
+#define TX_DISABLE                              interrupt_save = _tx_thread_interrupt_disable();
+#define TX_RESTORE                              _tx_thread_interrupt_restore(interrupt_save);
+
+
+/* Define the port specific data and services used by the Linux port.  */
+
+extern pthread_mutex_t                          _tx_linux_mutex;
+extern sem_t                                    _tx_linux_scheduler_semaphore;
+extern __thread struct TX_THREAD_STRUCT         *_tx_linux_threadx_thread;
+extern __thread UINT                            _tx_linux_interrupt_posture;
+
+VOID                                            _tx_linux_mutex_obtain(VOID);
+VOID                                            _tx_linux_mutex_release(VOID);
+VOID                                            _tx_linux_semaphore_wait(sem_t *semaphore);
+VOID                                            _tx_timer_interrupt(VOID);
+
+
+/* Define the version ID of ThreadX.  This may be utilized by the application.  */
+
+#ifdef TX_THREAD_INIT
+CHAR                            _tx_version_id[] =
+                                    "Copyright (c) Microsoft Corporation. All rights reserved.  *  ThreadX Linux/GNU Version 6.2.0 *";
+#else
+extern  CHAR                    _tx_version_id[];
+#endif
+
+
+#endif
@@ -0,0 +1,156 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** ThreadX Component                                                     */
+/**                                                                       */
+/**   Initialize                                                          */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define TX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "tx_api.h"
+#include "tx_initialize.h"
+#include "tx_thread.h"
+#include <errno.h>
+#include <time.h>
+
+
+/* Define the interrupt lockout of the Linux port and the semaphore the
+   scheduler waits on while a thread runs or while there is nothing to do.  */
+
+pthread_mutex_t         _tx_linux_mutex;
+sem_t                   _tx_linux_scheduler_semaphore;
+
+
+/* Define the ThreadX thread each pthread runs and its interrupt posture.  */
+
+__thread TX_THREAD      *_tx_linux_threadx_thread;
+__thread UINT           _tx_linux_interrupt_posture;
+
+
+/* Define the memory handed to tx_application_define as the first unused
+   memory address.  */
+
+#ifndef TX_LINUX_MEMORY_SIZE
+#define TX_LINUX_MEMORY_SIZE    (64 * 1024)
+#endif
+
+static ULONG64          _tx_linux_memory[TX_LINUX_MEMORY_SIZE / sizeof(ULONG64)];
+
+
+/* Define the pthread that delivers the timer interrupt.  */
+
+static pthread_t        _tx_linux_timer_id;
+static VOID             *_tx_linux_timer_interrupt_thread(VOID *parameter);
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _tx_initialize_low_level                            Linux/GNU       */
+/*                                                           6.2.0        */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function is responsible for any low-level processor            */
+/*    initialization, including setting up interrupt vectors, setting     */
+/*    up a periodic timer interrupt source, saving the system stack       */
+/*    pointer for use in ISR processing later, and finding the first      */
+/*    available RAM memory address for tx_application_define.             */
+/*                                                                        */
+/*    On the Linux host the calling pthread becomes the scheduler. It     */
+/*    keeps interrupts disabled, it holds the lockout mutex, until the    */
+/*    scheduling loop waits for the first thread.                         */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    pthread_mutex_init                    Create the interrupt lockout  */
+/*    sem_init                              Create scheduler semaphore    */
+/*    pthread_create                        Start the timer interrupt     */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _tx_initialize_kernel_enter           ThreadX entry function        */
+/*                                                                        */
+/**************************************************************************/
+VOID   _tx_initialize_low_level(VOID)
+{
+
+    /* Create the interrupt lockout and disable interrupts for the rest of
+       the initialization.  */
+    pthread_mutex_init(&_tx_linux_mutex, NULL);
+    _tx_linux_mutex_obtain();
+    _tx_linux_interrupt_posture =  TX_INT_DISABLE;
+
+    /* Create the semaphore that wakes up the scheduler.  */
+    sem_init(&_tx_linux_scheduler_semaphore, 0, 0);
+
+    /* Save the first available memory address.  */
+    _tx_initialize_unused_memory =  (VOID *) _tx_linux_memory;
+
+    /* Start the periodic timer interrupt. It is held off by the lockout
+       until the scheduler starts.  */
+    pthread_create(&_tx_linux_timer_id, NULL, _tx_linux_timer_interrupt_thread, NULL);
+}
+
+
+/* Define the timer interrupt source.  The ticks are taken from an absolute
+   clock so that the time spent in the interrupt does not make them drift.  */
+
+static VOID  *_tx_linux_timer_interrupt_thread(VOID *parameter)
+{
+
+struct timespec     next_tick;
+
+
+    (VOID) parameter;
+
+    clock_gettime(CLOCK_MONOTONIC, &next_tick);
+    while (1)
+    {
+
+        /* Wait for the next tick.  */
+        next_tick.tv_nsec +=  (long) (1000000000UL / TX_TIMER_TICKS_PER_SECOND);
+        if (next_tick.tv_nsec >= 1000000000L)
+        {
+            next_tick.tv_nsec -=  1000000000L;
+            next_tick.tv_sec++;
+        }
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next_tick, NULL) == EINTR)
+        {
+        }
+
+        /* Process the timer interrupt like an ISR would.  */
+        _tx_thread_context_save();
+        _tx_timer_interrupt();
+        _tx_thread_context_restore();
+    }
+
+    return(NULL);
+}
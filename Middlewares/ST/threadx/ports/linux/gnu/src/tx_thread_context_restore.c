@@ -0,0 +1,91 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** ThreadX Component                                                     */
+/**                                                                       */
+/**   Thread                                                              */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define TX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "tx_api.h"
+#include "tx_thread.h"
+
+
+#ifdef TX_ENABLE_EXECUTION_CHANGE_NOTIFY
+extern VOID _tx_execution_isr_exit(VOID);
+#endif
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _tx_thread_context_restore                          Linux/GNU       */
+/*                                                           6.2.0        */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function restores the interrupt context if it is processing a  */
+/*    nested interrupt.  If not, it wakes up the scheduler when no thread */
+/*    is executing and the interrupt readied one.  A thread that is       */
+/*    executing is preempted when it next enables interrupts.             */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    sem_post                              Wake up the scheduler         */
+/*    _tx_linux_mutex_release               Release the lockout           */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    ISRs                                                                */
+/*                                                                        */
+/**************************************************************************/
+VOID   _tx_thread_context_restore(VOID)
+{
+
+#ifdef TX_ENABLE_EXECUTION_CHANGE_NOTIFY
+
+    /* Call the ISR exit function to indicate an ISR is complete.  */
+    _tx_execution_isr_exit();
+#endif
+
+    /* Decrement the interrupt nesting.  */
+    _tx_thread_system_state--;
+
+    /* Wake up the idle scheduler if there is a thread to run.  */
+    if ((_tx_thread_system_state == ((ULONG) 0)) &&
+        (_tx_thread_current_ptr == TX_NULL) && (_tx_thread_execute_ptr != TX_NULL))
+    {
+        sem_post(&_tx_linux_scheduler_semaphore);
+    }
+
+    /* Let the threads and the scheduler run again.  */
+    _tx_linux_interrupt_posture =  TX_INT_ENABLE;
+    _tx_linux_mutex_release();
+}
@@ -0,0 +1,225 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** ThreadX Component                                                     */
+/**                                                                       */
+/**   Thread                                                              */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define TX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "tx_api.h"
+#include "tx_thread.h"
+#include <errno.h>
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _tx_thread_interrupt_control                        Linux/GNU       */
+/*                                                           6.2.0        */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function is responsible for changing the interrupt lockout     */
+/*    posture of the system.                                              */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    new_posture                           New interrupt lockout posture */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    old_posture                           Old interrupt lockout posture */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _tx_thread_interrupt_disable          Disable interrupts            */
+/*    _tx_thread_interrupt_restore          Restore interrupts            */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application Code                                                    */
+/*                                                                        */
+/**************************************************************************/
+UINT   _tx_thread_interrupt_control(UINT new_posture)
+{
+
+UINT    old_posture;
+
+
+    /* Pickup the current posture.  */
+    old_posture =  _tx_linux_interrupt_posture;
+
+    /* Apply the new posture.  */
+    if (new_posture == TX_INT_DISABLE)
+    {
+        (VOID) _tx_thread_interrupt_disable();
+    }
+    else
+    {
+        _tx_thread_interrupt_restore(TX_INT_ENABLE);
+    }
+
+    /* Return the previous posture.  */
+    return(old_posture);
+}
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _tx_thread_interrupt_disable                        Linux/GNU       */
+/*                                                           6.2.0        */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function disables interrupts, that is it takes the lockout     */
+/*    mutex unless the calling pthread holds it already.                  */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    previous_posture                      Previous interrupt posture    */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _tx_linux_mutex_obtain                Obtain the lockout            */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    ThreadX components                                                  */
+/*                                                                        */
+/**************************************************************************/
+UINT   _tx_thread_interrupt_disable(VOID)
+{
+
+UINT    previous_posture;
+
+
+    previous_posture =  _tx_linux_interrupt_posture;
+    if (previous_posture == TX_INT_ENABLE)
+    {
+        _tx_linux_mutex_obtain();
+        _tx_linux_interrupt_posture =  TX_INT_DISABLE;
+    }
+
+    return(previous_posture);
+}
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _tx_thread_interrupt_restore                        Linux/GNU       */
+/*                                                           6.2.0        */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function restores the interrupt posture saved by               */
+/*    _tx_thread_interrupt_disable.  When interrupts are enabled again    */
+/*    and a thread readied meanwhile, typically by the timer interrupt,   */
+/*    must preempt the calling thread, control is returned to the         */
+/*    scheduler first.  This is where the Cortex-M port takes its         */
+/*    pending PendSV.                                                     */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    previous_posture                      Previous interrupt posture    */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _tx_thread_system_return              Return to the scheduler       */
+/*    _tx_linux_mutex_release               Release the lockout           */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    ThreadX components                                                  */
+/*                                                                        */
+/**************************************************************************/
+VOID   _tx_thread_interrupt_restore(UINT previous_posture)
+{
+
+TX_THREAD   *thread_ptr;
+
+
+    if ((previous_posture == TX_INT_ENABLE) && (_tx_linux_interrupt_posture == TX_INT_DISABLE))
+    {
+
+        /* Is the calling thread preempted?  */
+        thread_ptr =  _tx_linux_threadx_thread;
+        if ((thread_ptr != TX_NULL) && (thread_ptr == _tx_thread_current_ptr) &&
+            (_tx_thread_execute_ptr != thread_ptr) &&
+            (_tx_thread_preempt_disable == ((UINT) 0)) && (_tx_thread_system_state == ((ULONG) 0)))
+        {
+
+            /* Yes, let the scheduler run the other thread. This returns
+               once the calling thread is scheduled again.  */
+            _tx_thread_system_return();
+        }
+
+        /* Enable interrupts.  */
+        _tx_linux_interrupt_posture =  TX_INT_ENABLE;
+        _tx_linux_mutex_release();
+    }
+}
+
+
+/* Define the raw lockout services. They do not change the posture of the
+   calling pthread.  */
+
+VOID   _tx_linux_mutex_obtain(VOID)
+{
+
+    pthread_mutex_lock(&_tx_linux_mutex);
+}
+
+
+VOID   _tx_linux_mutex_release(VOID)
+{
+
+    pthread_mutex_unlock(&_tx_linux_mutex);
+}
+
+
+/* Wait on a semaphore, a signal delivered to the process does not end the
+   wait.  */
+
+VOID   _tx_linux_semaphore_wait(sem_t *semaphore)
+{
+
+    while (sem_wait(semaphore) != 0)
+    {
+        if (errno != EINTR)
+        {
+            break;
+        }
+    }
+}
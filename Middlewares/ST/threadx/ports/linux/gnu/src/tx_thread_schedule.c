@@ -0,0 +1,111 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** ThreadX Component                                                     */
+/**                                                                       */
+/**   Thread                                                              */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define TX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "tx_api.h"
+#include "tx_thread.h"
+#include "tx_timer.h"
+
+
+#ifdef TX_ENABLE_EXECUTION_CHANGE_NOTIFY
+extern VOID _tx_execution_thread_enter(VOID);
+#endif
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _tx_thread_schedule                                 Linux/GNU       */
+/*                                                           6.2.0        */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function waits for a thread control block pointer to appear in */
+/*    the _tx_thread_execute_ptr variable.  Once a thread pointer appears */
+/*    in the variable, the corresponding thread is resumed.  The          */
+/*    scheduler runs on the pthread that entered ThreadX and wakes up     */
+/*    whenever the current thread returns to the system or an interrupt   */
+/*    readies a thread while none is executing.                           */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _tx_linux_mutex_obtain                Obtain the lockout            */
+/*    _tx_linux_mutex_release               Release the lockout           */
+/*    _tx_linux_semaphore_wait              Wait for a thread to run      */
+/*    sem_post                              Resume the thread             */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _tx_initialize_kernel_enter          ThreadX entry function         */
+/*                                                                        */
+/**************************************************************************/
+VOID   _tx_thread_schedule(VOID)
+{
+
+TX_THREAD   *thread_ptr;
+
+
+    /* The lockout is held since the low-level initialization.  */
+    while (1)
+    {
+
+        /* Wait for the current thread to return and another to be ready.  */
+        while ((_tx_thread_current_ptr != TX_NULL) || (_tx_thread_execute_ptr == TX_NULL))
+        {
+            _tx_linux_mutex_release();
+            _tx_linux_semaphore_wait(&_tx_linux_scheduler_semaphore);
+            _tx_linux_mutex_obtain();
+        }
+
+        /* Setup the current thread pointer.  */
+        thread_ptr =  _tx_thread_execute_ptr;
+        _tx_thread_current_ptr =  thread_ptr;
+
+        /* Increment the run count for this thread.  */
+        thread_ptr -> tx_thread_run_count++;
+
+        /* Setup time-slice, if present.  */
+        _tx_timer_time_slice =  thread_ptr -> tx_thread_time_slice;
+
+#ifdef TX_ENABLE_EXECUTION_CHANGE_NOTIFY
+
+        /* Call the thread entry function to indicate the thread is executing.  */
+        _tx_execution_thread_enter();
+#endif
+
+        /* Resume the thread.  */
+        sem_post(&thread_ptr -> tx_thread_linux_thread_run_semaphore);
+    }
+}
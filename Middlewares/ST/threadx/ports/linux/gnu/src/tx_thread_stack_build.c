@@ -0,0 +1,117 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** ThreadX Component                                                     */
+/**                                                                       */
+/**   Thread                                                              */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define TX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "tx_api.h"
+#include "tx_thread.h"
+
+
+static VOID  *_tx_linux_thread_entry(VOID *parameter);
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _tx_thread_stack_build                              Linux/GNU       */
+/*                                                           6.2.0        */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function builds a stack frame on the supplied thread's stack.  */
+/*    On the Linux host the thread runs on its own pthread, which is      */
+/*    created here and waits until the scheduler first resumes the        */
+/*    thread.                                                             */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    thread_ptr                            Pointer to thread control blk */
+/*    function_ptr                          Pointer to return function    */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    sem_init                              Create the run semaphore      */
+/*    pthread_create                        Create the thread's pthread   */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _tx_thread_create                     Create thread service         */
+/*                                                                        */
+/**************************************************************************/
+VOID   _tx_thread_stack_build(TX_THREAD *thread_ptr, VOID (*function_ptr)(VOID))
+{
+
+    /* The pthread always enters the thread through the shell.  */
+    (VOID) function_ptr;
+
+    /* Create the semaphore the thread waits on while it is not running.  */
+    sem_init(&thread_ptr -> tx_thread_linux_thread_run_semaphore, 0, 0);
+
+    /* Create the pthread of the thread.  */
+    pthread_create(&thread_ptr -> tx_thread_linux_thread_id, NULL, _tx_linux_thread_entry, thread_ptr);
+
+    /* The stack of the thread is not used, mark it as empty.  */
+    thread_ptr -> tx_thread_stack_ptr =  thread_ptr -> tx_thread_stack_end;
+}
+
+
+/* Define the entry of the pthread of a thread.  */
+
+static VOID  *_tx_linux_thread_entry(VOID *parameter)
+{
+
+TX_THREAD   *thread_ptr;
+
+
+    /* Remember the thread, it runs with interrupts enabled.  */
+    thread_ptr =  (TX_THREAD *) parameter;
+    _tx_linux_threadx_thread =  thread_ptr;
+    _tx_linux_interrupt_posture =  TX_INT_ENABLE;
+
+    /* Wait to be scheduled the first time.  */
+    _tx_linux_semaphore_wait(&thread_ptr -> tx_thread_linux_thread_run_semaphore);
+
+    /* Call the thread entry through the shell.  */
+    _tx_thread_shell_entry();
+
+    return(NULL);
+}
+
+
+/* Release the pthread of a deleted or reset thread. It is waiting on its
+   run semaphore since the thread is completed or terminated.  */
+
+VOID   _tx_linux_thread_delete(TX_THREAD *thread_ptr)
+{
+
+    pthread_cancel(thread_ptr -> tx_thread_linux_thread_id);
+    pthread_join(thread_ptr -> tx_thread_linux_thread_id, NULL);
+    sem_destroy(&thread_ptr -> tx_thread_linux_thread_run_semaphore);
+}
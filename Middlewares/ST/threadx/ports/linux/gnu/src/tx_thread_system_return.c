@@ -0,0 +1,119 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** ThreadX Component                                                     */
+/**                                                                       */
+/**   Thread                                                              */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define TX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "tx_api.h"
+#include "tx_thread.h"
+#include "tx_timer.h"
+
+
+#ifdef TX_ENABLE_EXECUTION_CHANGE_NOTIFY
+extern VOID _tx_execution_thread_exit(VOID);
+#endif
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _tx_thread_system_return                            Linux/GNU       */
+/*                                                           6.2.0        */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function is target processor specific.  It is used to transfer */
+/*    control from a thread back to the ThreadX system.  The pthread of   */
+/*    the calling thread hands over to the scheduler and waits until the  */
+/*    thread is scheduled again.  Nothing is done when the calling        */
+/*    thread is still the one to execute.                                 */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _tx_linux_mutex_obtain                Obtain the lockout            */
+/*    _tx_linux_mutex_release               Release the lockout           */
+/*    _tx_linux_semaphore_wait              Wait to be scheduled again    */
+/*    sem_post                              Wake up the scheduler         */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    ThreadX components                                                  */
+/*                                                                        */
+/**************************************************************************/
+VOID   _tx_thread_system_return(VOID)
+{
+
+TX_THREAD   *thread_ptr;
+UINT        posture;
+
+
+    /* Disable interrupts unless the caller did already.  */
+    posture =  _tx_linux_interrupt_posture;
+    if (posture == TX_INT_ENABLE)
+    {
+        _tx_linux_mutex_obtain();
+    }
+
+    /* Is there another thread to run?  */
+    thread_ptr =  _tx_linux_threadx_thread;
+    if ((thread_ptr != TX_NULL) && (thread_ptr == _tx_thread_current_ptr) &&
+        (_tx_thread_execute_ptr != thread_ptr))
+    {
+
+#ifdef TX_ENABLE_EXECUTION_CHANGE_NOTIFY
+
+        /* Call the thread exit function to indicate the thread is no longer executing.  */
+        _tx_execution_thread_exit();
+#endif
+
+        /* Save the remaining time-slice of the thread.  */
+        if (_tx_timer_time_slice != ((ULONG) 0))
+        {
+            thread_ptr -> tx_thread_time_slice =  _tx_timer_time_slice;
+            _tx_timer_time_slice =  ((ULONG) 0);
+        }
+
+        /* Return to the scheduler and wait to be scheduled again.  */
+        _tx_thread_current_ptr =  TX_NULL;
+        sem_post(&_tx_linux_scheduler_semaphore);
+        _tx_linux_mutex_release();
+        _tx_linux_semaphore_wait(&thread_ptr -> tx_thread_linux_thread_run_semaphore);
+        _tx_linux_mutex_obtain();
+    }
+
+    /* Restore the posture of the caller.  */
+    if (posture == TX_INT_ENABLE)
+    {
+        _tx_linux_mutex_release();
+    }
+}
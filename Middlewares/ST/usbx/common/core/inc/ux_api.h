@@ -1440,6 +1440,7 @@ VOID    _ux_trace_event_update(TX_TRACE_BUFFER_ENTRY *event, ULONG timestamp, UL
 #define UX_TRANSFER_BUFFER_OVERFLOW                                     0x27
 #define UX_TRANSFER_APPLICATION_RESET                                   0x28
 #define UX_TRANSFER_DATA_LESS_THAN_EXPECTED                             0x29
+#define UX_TRANSFER_DEVICE_REMOVED                                      0x2a
                                                                         
 #define UX_PORT_RESET_FAILED                                            0x31
 #define UX_CONTROLLER_INIT_FAILED                                       0x32
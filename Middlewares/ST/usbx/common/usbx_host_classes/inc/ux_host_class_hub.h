@@ -114,6 +114,12 @@ extern   "C" {
 #define UX_HOST_CLASS_HUB_C_PORT_RESET                          0x14
 
 
+/* Define HUB Class hub feature constants.  */
+
+#define UX_HOST_CLASS_HUB_C_HUB_LOCAL_POWER                     0x00
+#define UX_HOST_CLASS_HUB_C_HUB_OVER_CURRENT                    0x01
+
+
 /* Define HUB Class port status constants.  */
 
 #define UX_HOST_CLASS_HUB_PORT_STATUS_CONNECTION                0x0001
@@ -135,6 +141,14 @@ extern   "C" {
 #define UX_HOST_CLASS_HUB_PORT_CHANGE_RESET                     0x00010u
 
 
+/* Define HUB Class hub status and change constants.  */
+
+#define UX_HOST_CLASS_HUB_STATUS_LOCAL_POWER                    0x0001
+#define UX_HOST_CLASS_HUB_STATUS_OVER_CURRENT                   0x0002
+#define UX_HOST_CLASS_HUB_CHANGE_LOCAL_POWER                    0x0001
+#define UX_HOST_CLASS_HUB_CHANGE_OVER_CURRENT                   0x0002
+
+
 /* Define HUB Class other constants.  */
 
 #define UX_HOST_CLASS_HUB_ENABLE_RETRY_COUNT                    3
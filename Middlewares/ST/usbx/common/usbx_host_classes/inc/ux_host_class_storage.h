@@ -122,6 +122,22 @@ extern   "C" {
 #ifndef ux_media_close
 #define ux_media_close                                      fx_media_close
 #endif
+
+#ifndef ux_media_abort
+#define ux_media_abort                                      fx_media_abort
+#endif
+
+#ifndef ux_media_cluster_bitmap_set
+#define ux_media_cluster_bitmap_set                         fx_media_cluster_bitmap_set
+#endif
+
+#ifndef ux_media_directory_index_enable
+#define ux_media_directory_index_enable                     fx_media_directory_index_enable
+#endif
+
+#ifndef ux_media_cluster_bitmap_buffer_get
+#define ux_media_cluster_bitmap_buffer_get(m)               ((m)->fx_media_cluster_bitmap_buffer)
+#endif
 #endif
 
 /* Define User configurable Storage Class constants.  */
@@ -134,6 +150,11 @@ extern   "C" {
 #define UX_HOST_CLASS_STORAGE_MAX_MEDIA                     1
 #endif
 
+/* Define the memory pool of the media array, UX_HOST_CLASS_STORAGE_MAX_MEDIA media with their FX_MEDIA.  */
+#ifndef UX_HOST_CLASS_STORAGE_MEDIA_MEMORY
+#define UX_HOST_CLASS_STORAGE_MEDIA_MEMORY                  UX_REGULAR_MEMORY
+#endif
+
 #ifndef UX_HOST_CLASS_STORAGE_MEMORY_BUFFER_SIZE
 #define UX_HOST_CLASS_STORAGE_MEMORY_BUFFER_SIZE            (1024)
 #endif
@@ -150,6 +171,54 @@ extern   "C" {
 #define UX_HOST_CLASS_STORAGE_NO_FILEX
 #endif
 
+/* The sector cache handed to FileX at mount time.  With UX_HOST_CLASS_STORAGE_MEDIA_CACHE_ENABLE
+   UX_HOST_CLASS_STORAGE_MEDIA_CACHE_SIZE bytes are tried first and halved until they fit in the
+   free cache safe memory, down to UX_HOST_CLASS_STORAGE_MEMORY_BUFFER_SIZE.  FileX hashes its sector cache only
+   when it holds a power of two sectors, so keep the size a power of two.  */
+#if defined(UX_HOST_CLASS_STORAGE_MEDIA_CACHE_ENABLE) && defined(UX_HOST_CLASS_STORAGE_NO_FILEX)
+#undef UX_HOST_CLASS_STORAGE_MEDIA_CACHE_ENABLE
+#endif
+
+#ifndef UX_HOST_CLASS_STORAGE_MEDIA_CACHE_SIZE
+#define UX_HOST_CLASS_STORAGE_MEDIA_CACHE_SIZE              (1024 * 32)
+#endif
+
+/* The read-ahead window is part of the FileX driver entry.  */
+#if defined(UX_HOST_CLASS_STORAGE_READ_AHEAD_ENABLE) && defined(UX_HOST_CLASS_STORAGE_NO_FILEX)
+#undef UX_HOST_CLASS_STORAGE_READ_AHEAD_ENABLE
+#endif
+
+#ifndef UX_HOST_CLASS_STORAGE_READ_AHEAD_BUFFER_SIZE
+#define UX_HOST_CLASS_STORAGE_READ_AHEAD_BUFFER_SIZE        (1024 * 8)
+#endif
+
+/* The write-coalescing buffer is part of the FileX driver entry.  */
+#if defined(UX_HOST_CLASS_STORAGE_WRITE_COALESCE_ENABLE) && defined(UX_HOST_CLASS_STORAGE_NO_FILEX)
+#undef UX_HOST_CLASS_STORAGE_WRITE_COALESCE_ENABLE
+#endif
+
+#ifndef UX_HOST_CLASS_STORAGE_WRITE_COALESCE_BUFFER_SIZE
+#define UX_HOST_CLASS_STORAGE_WRITE_COALESCE_BUFFER_SIZE    (1024 * 8)
+#endif
+
+/* The free cluster bitmap is supplied to the FileX media before it is opened and needs FX_ENABLE_CLUSTER_BITMAP.  */
+#if defined(UX_HOST_CLASS_STORAGE_CLUSTER_BITMAP_ENABLE) && (defined(UX_HOST_CLASS_STORAGE_NO_FILEX) || !defined(FX_ENABLE_CLUSTER_BITMAP))
+#undef UX_HOST_CLASS_STORAGE_CLUSTER_BITMAP_ENABLE
+#endif
+
+#ifndef UX_HOST_CLASS_STORAGE_CLUSTER_BITMAP_SIZE_MAX
+#define UX_HOST_CLASS_STORAGE_CLUSTER_BITMAP_SIZE_MAX       (1024 * 32)
+#endif
+
+/* The directory index is attached to the FileX media after mount and needs FX_ENABLE_DIRECTORY_INDEX.  */
+#if defined(UX_HOST_CLASS_STORAGE_DIRECTORY_INDEX_ENABLE) && (defined(UX_HOST_CLASS_STORAGE_NO_FILEX) || !defined(FX_ENABLE_DIRECTORY_INDEX))
+#undef UX_HOST_CLASS_STORAGE_DIRECTORY_INDEX_ENABLE
+#endif
+
+#ifndef UX_HOST_CLASS_STORAGE_DIRECTORY_INDEX_SIZE
+#define UX_HOST_CLASS_STORAGE_DIRECTORY_INDEX_SIZE          (1024 * 16)
+#endif
+
 
 /* Define Storage Class constants.  */
 
@@ -158,6 +227,22 @@ extern   "C" {
 #define UX_HOST_CLASS_STORAGE_INSTANCE_SHUTDOWN_TIMER       (10)
 #define UX_HOST_CLASS_STORAGE_THREAD_PRIORITY_CLASS         20
 #define UX_HOST_CLASS_STORAGE_TRANSFER_TIMEOUT              10000
+
+/* Define the adaptive media presence polling of the storage class thread.  The thread polls
+   every UX_HOST_CLASS_STORAGE_THREAD_SLEEP_TIME_MIN ms after a device is enumerated or a media
+   changes, and doubles the delay each idle poll up to UX_HOST_CLASS_STORAGE_THREAD_SLEEP_TIME_MAX ms.  */
+
+#if defined(UX_HOST_CLASS_STORAGE_ADAPTIVE_POLL_ENABLE) && defined(UX_HOST_STANDALONE)
+#undef UX_HOST_CLASS_STORAGE_ADAPTIVE_POLL_ENABLE
+#endif
+
+#ifndef UX_HOST_CLASS_STORAGE_THREAD_SLEEP_TIME_MIN
+#define UX_HOST_CLASS_STORAGE_THREAD_SLEEP_TIME_MIN         (100)
+#endif
+
+#ifndef UX_HOST_CLASS_STORAGE_THREAD_SLEEP_TIME_MAX
+#define UX_HOST_CLASS_STORAGE_THREAD_SLEEP_TIME_MAX         UX_HOST_CLASS_STORAGE_THREAD_SLEEP_TIME
+#endif
 #define UX_HOST_CLASS_STORAGE_CBI_STATUS_TIMEOUT            3000
 #define UX_HOST_CLASS_STORAGE_CLASS                         8
 #define UX_HOST_CLASS_STORAGE_SUBCLASS_RBC                  1
@@ -475,12 +560,16 @@ typedef struct UX_HOST_CLASS_STORAGE_STRUCT
     UINT            ux_host_class_storage_max_lun;
     UINT            ux_host_class_storage_lun;
     UINT            ux_host_class_storage_lun_types[UX_MAX_HOST_LUN];
-#if defined(UX_HOST_CLASS_STORAGE_NO_FILEX)
     ULONG           ux_host_class_storage_last_sector_number;
-#endif
     ULONG           ux_host_class_storage_sector_size;
     ULONG           ux_host_class_storage_data_phase_length;
     ULONG           ux_host_class_storage_sense_code;
+#if defined(UX_HOST_CLASS_STORAGE_LARGE_TRANSFER_ENABLE)
+    ULONG           ux_host_class_storage_max_transfer_size;
+#endif
+#if defined(UX_HOST_CLASS_STORAGE_ADAPTIVE_POLL_ENABLE)
+    ULONG           ux_host_class_storage_presence_time;
+#endif
     UCHAR           *ux_host_class_storage_memory;
 #if !defined(UX_HOST_STANDALONE)
     UINT            (*ux_host_class_storage_transport) (struct UX_HOST_CLASS_STORAGE_STRUCT *storage, UCHAR * data_pointer);
@@ -577,6 +666,10 @@ typedef struct UX_HOST_CLASS_STORAGE_EXT_STRUCT
 #if !defined(UX_HOST_STANDALONE)
     UX_THREAD       ux_host_class_thread;
     CHAR            ux_host_class_thread_stack[UX_HOST_CLASS_STORAGE_THREAD_STACK_SIZE];
+#if defined(UX_HOST_CLASS_STORAGE_ADAPTIVE_POLL_ENABLE)
+    UX_SEMAPHORE    ux_host_class_storage_poll_semaphore;
+    ULONG           ux_host_class_storage_poll_delay;
+#endif
 #else
     ALIGN_TYPE      reserved;
 #endif
@@ -592,9 +685,36 @@ typedef struct UX_HOST_CLASS_STORAGE_MEDIA_STRUCT
     UX_MEDIA        ux_host_class_storage_media;
     ULONG           ux_host_class_storage_media_partition_start;
     VOID            *ux_host_class_storage_media_memory;
+    ULONG           ux_host_class_storage_media_memory_size;
     ULONG           ux_host_class_storage_media_status;
     ULONG           ux_host_class_storage_media_lun;
     ULONG           ux_host_class_storage_media_sector_size;
+    ULONG           ux_host_class_storage_media_number_sectors;
+#if defined(UX_HOST_CLASS_STORAGE_ADAPTIVE_POLL_ENABLE)
+    ULONG           ux_host_class_storage_media_insert_time;
+    ULONG           ux_host_class_storage_media_mount_time;
+#endif
+#if defined(UX_HOST_CLASS_STORAGE_READ_AHEAD_ENABLE)
+    UCHAR           *ux_host_class_storage_media_read_ahead_buffer;
+    ULONG           ux_host_class_storage_media_read_ahead_sector;
+    ULONG           ux_host_class_storage_media_read_ahead_sectors;
+    ULONG           ux_host_class_storage_media_read_ahead_next_sector;
+    ULONG           ux_host_class_storage_media_read_ahead_hits;
+    ULONG           ux_host_class_storage_media_read_ahead_misses;
+#endif
+#if defined(UX_HOST_CLASS_STORAGE_WRITE_COALESCE_ENABLE)
+    UCHAR           *ux_host_class_storage_media_write_buffer;
+    ULONG           ux_host_class_storage_media_write_sector;
+    ULONG           ux_host_class_storage_media_write_sectors;
+    ULONG           ux_host_class_storage_media_write_merges;
+    ULONG           ux_host_class_storage_media_write_flushes;
+#endif
+#if defined(UX_HOST_CLASS_STORAGE_CLUSTER_BITMAP_ENABLE)
+    VOID            *ux_host_class_storage_media_cluster_bitmap;
+#endif
+#if defined(UX_HOST_CLASS_STORAGE_DIRECTORY_INDEX_ENABLE)
+    VOID            *ux_host_class_storage_media_directory_index;
+#endif
 #else
     struct UX_HOST_CLASS_STORAGE_STRUCT
                     *ux_host_class_storage_media_storage;
@@ -633,9 +753,27 @@ UINT    _ux_host_class_storage_media_open(UX_HOST_CLASS_STORAGE *storage, ULONG
 UINT    _ux_host_class_storage_media_protection_check(UX_HOST_CLASS_STORAGE *storage);
 UINT    _ux_host_class_storage_media_read(UX_HOST_CLASS_STORAGE *storage, ULONG sector_start,
                                         ULONG sector_count, UCHAR *data_pointer);
+#if defined(UX_HOST_CLASS_STORAGE_READ_AHEAD_ENABLE)
+UINT    _ux_host_class_storage_media_read_ahead(UX_HOST_CLASS_STORAGE *storage,
+                                        UX_HOST_CLASS_STORAGE_MEDIA *storage_media,
+                                        ULONG sector_start, ULONG sector_count, UCHAR *data_pointer);
+#endif
 UINT    _ux_host_class_storage_media_recovery_sense_get(UX_HOST_CLASS_STORAGE *storage);
+#if !defined(UX_HOST_CLASS_STORAGE_NO_FILEX)
+VOID    _ux_host_class_storage_media_resources_free(UX_HOST_CLASS_STORAGE_MEDIA *storage_media);
+#endif
 UINT    _ux_host_class_storage_media_write(UX_HOST_CLASS_STORAGE *storage, ULONG sector_start,
                                         ULONG sector_count, UCHAR *data_pointer);
+#if defined(UX_HOST_CLASS_STORAGE_WRITE_COALESCE_ENABLE)
+UINT    _ux_host_class_storage_media_write_coalesce(UX_HOST_CLASS_STORAGE *storage,
+                                        UX_HOST_CLASS_STORAGE_MEDIA *storage_media,
+                                        ULONG sector_start, ULONG sector_count, UCHAR *data_pointer);
+UINT    _ux_host_class_storage_media_write_flush(UX_HOST_CLASS_STORAGE *storage,
+                                        UX_HOST_CLASS_STORAGE_MEDIA *storage_media);
+#endif
+#if defined(UX_HOST_CLASS_STORAGE_ADAPTIVE_POLL_ENABLE)
+VOID    _ux_host_class_storage_presence_recheck(UX_HOST_CLASS_STORAGE *storage);
+#endif
 UINT    _ux_host_class_storage_partition_read(UX_HOST_CLASS_STORAGE *storage, UCHAR *sector_memory, ULONG sector);
 UINT    _ux_host_class_storage_request_sense(UX_HOST_CLASS_STORAGE *storage);
 UINT    _ux_host_class_storage_sense_code_translate(UX_HOST_CLASS_STORAGE *storage, UINT status);
@@ -664,6 +802,28 @@ UINT    _ux_host_class_storage_lock(UX_HOST_CLASS_STORAGE *storage, ULONG wait);
 #define _ux_host_class_storage_lun(s)               ((s) -> ux_host_class_storage_lun)
 #define _ux_host_class_storage_lun_select(s,l)      do { (s) -> ux_host_class_storage_lun = (l); } while(0)
 #define _ux_host_class_storage_sense_status(s)      ((s) -> ux_host_class_storage_sense_code)
+#if defined(UX_HOST_CLASS_STORAGE_LARGE_TRANSFER_ENABLE)
+#define _ux_host_class_storage_max_transfer_size_set(s,n) do { (s) -> ux_host_class_storage_max_transfer_size = (n); } while(0)
+#endif
+#if !defined(UX_HOST_CLASS_STORAGE_NO_FILEX)
+#define _ux_host_class_storage_media_memory_size_get(m)       ((m) -> ux_host_class_storage_media_memory_size)
+#endif
+#if defined(UX_HOST_CLASS_STORAGE_READ_AHEAD_ENABLE)
+#define _ux_host_class_storage_media_read_ahead_invalidate(m) do { (m) -> ux_host_class_storage_media_read_ahead_sectors = 0; } while(0)
+#define _ux_host_class_storage_media_read_ahead_hits_get(m)   ((m) -> ux_host_class_storage_media_read_ahead_hits)
+#define _ux_host_class_storage_media_read_ahead_misses_get(m) ((m) -> ux_host_class_storage_media_read_ahead_misses)
+#endif
+#if defined(UX_HOST_CLASS_STORAGE_ADAPTIVE_POLL_ENABLE)
+#define _ux_host_class_storage_media_mount_latency(m)         ((m) -> ux_host_class_storage_media_mount_time - (m) -> ux_host_class_storage_media_insert_time)
+#endif
+#if defined(UX_HOST_CLASS_STORAGE_WRITE_COALESCE_ENABLE)
+#define _ux_host_class_storage_media_write_discard(m)         do { (m) -> ux_host_class_storage_media_write_sectors = 0; } while(0)
+#define _ux_host_class_storage_media_write_pending(m,s,n)     (((m) -> ux_host_class_storage_media_write_sectors != 0) && \
+                                                               ((s) < (m) -> ux_host_class_storage_media_write_sector + (m) -> ux_host_class_storage_media_write_sectors) && \
+                                                               ((s) + (n) > (m) -> ux_host_class_storage_media_write_sector))
+#define _ux_host_class_storage_media_write_merges_get(m)      ((m) -> ux_host_class_storage_media_write_merges)
+#define _ux_host_class_storage_media_write_flushes_get(m)     ((m) -> ux_host_class_storage_media_write_flushes)
+#endif
 
 UINT    _ux_host_class_storage_media_check(UX_HOST_CLASS_STORAGE *storage);
 
@@ -692,6 +852,29 @@ UINT    _ux_host_class_storage_read_write_run(UX_HOST_CLASS_STORAGE *storage,
 
 #define  ux_host_class_storage_sense_status                    _ux_host_class_storage_sense_status
 
+#if defined(UX_HOST_CLASS_STORAGE_LARGE_TRANSFER_ENABLE)
+#define  ux_host_class_storage_max_transfer_size_set           _ux_host_class_storage_max_transfer_size_set
+#endif
+
+#if !defined(UX_HOST_CLASS_STORAGE_NO_FILEX)
+#define  ux_host_class_storage_media_memory_size_get           _ux_host_class_storage_media_memory_size_get
+#endif
+
+#if defined(UX_HOST_CLASS_STORAGE_READ_AHEAD_ENABLE)
+#define  ux_host_class_storage_media_read_ahead_hits_get       _ux_host_class_storage_media_read_ahead_hits_get
+#define  ux_host_class_storage_media_read_ahead_misses_get     _ux_host_class_storage_media_read_ahead_misses_get
+#endif
+
+#if defined(UX_HOST_CLASS_STORAGE_ADAPTIVE_POLL_ENABLE)
+#define  ux_host_class_storage_presence_recheck                _ux_host_class_storage_presence_recheck
+#define  ux_host_class_storage_media_mount_latency             _ux_host_class_storage_media_mount_latency
+#endif
+
+#if defined(UX_HOST_CLASS_STORAGE_WRITE_COALESCE_ENABLE)
+#define  ux_host_class_storage_media_write_merges_get          _ux_host_class_storage_media_write_merges_get
+#define  ux_host_class_storage_media_write_flushes_get         _ux_host_class_storage_media_write_flushes_get
+#endif
+
 /* Determine if a C++ compiler is being used.  If so, complete the standard 
    C conditional started above.  */   
 #ifdef __cplusplus
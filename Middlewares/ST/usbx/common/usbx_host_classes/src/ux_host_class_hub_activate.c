@@ -0,0 +1,146 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */ 
+/** USBX Component                                                        */ 
+/**                                                                       */
+/**   Hub Class                                                           */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_class_hub.h"
+#include "ux_host_stack.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_class_hub_activate                         PORTABLE C      */
+/*                                                           6.1.12       */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function activates the hub class. It configures the hub, reads */
+/*    its hub descriptor, powers its downstream ports and starts the      */
+/*    polling of its interrupt endpoint for port changes.                 */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    command                               Pointer to class command      */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_host_class_hub_configure          Configure the hub             */
+/*    _ux_host_class_hub_descriptor_get     Get the hub descriptor        */
+/*    _ux_host_class_hub_interrupt_endpoint_start                         */
+/*                                          Start the interrupt endpoint  */
+/*    _ux_host_class_hub_ports_power        Power the hub ports           */
+/*    _ux_host_stack_class_instance_create  Create class instance         */
+/*    _ux_utility_memory_allocate           Allocate memory block         */
+/*    _ux_utility_memory_free               Free memory block             */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_host_class_hub_entry              Entry of the hub class        */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_host_class_hub_activate(UX_HOST_CLASS_COMMAND *command)
+{
+
+UX_DEVICE           *device;
+UX_HOST_CLASS_HUB   *hub;
+UINT                status;
+
+
+    /* The hub is a device class, the container is the device.  */
+    device =  (UX_DEVICE *) command -> ux_host_class_command_container;
+
+    /* Obtain memory for this class instance.  */
+    hub =  _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY, sizeof(UX_HOST_CLASS_HUB));
+    if (hub == UX_NULL)
+        return(UX_MEMORY_INSUFFICIENT);
+
+    /* Store the class container into this instance.  */
+    hub -> ux_host_class_hub_class =  command -> ux_host_class_command_class_ptr;
+
+    /* Store the device container instance in the hub instance, this is for
+       the class instance when it needs to talk to the USBX stack.  */
+    hub -> ux_host_class_hub_device =  device;
+
+    /* Configure the hub.  */
+    status =  _ux_host_class_hub_configure(hub);
+    if (status == UX_SUCCESS)
+    {
+
+        /* Get the hub descriptor, it gives the number of ports.  */
+        status =  _ux_host_class_hub_descriptor_get(hub);
+        if (status == UX_SUCCESS)
+        {
+
+            /* Power the downstream ports. A port that fails to power is only reported,
+               the other ports are still usable.  */
+            _ux_host_class_hub_ports_power(hub);
+
+            /* Search the interrupt endpoint of the hub and start polling it.  */
+            status =  _ux_host_class_hub_interrupt_endpoint_start(hub);
+            if (status == UX_SUCCESS)
+            {
+
+                /* Create this class instance.  */
+                _ux_host_stack_class_instance_create(hub -> ux_host_class_hub_class, (VOID *) hub);
+
+                /* Store the instance in the device container, this is for the USBX stack
+                   when it needs to invoke the class.  */
+                device -> ux_device_class_instance =  (VOID *) hub;
+
+                /* Mark the hub as live now.  */
+                hub -> ux_host_class_hub_state =  UX_HOST_CLASS_INSTANCE_LIVE;
+
+                /* If all is fine and the device is mounted, we may need to inform the application
+                   if a function has been programmed in the system structure.  */
+                if (_ux_system_host -> ux_system_host_change_function != UX_NULL)
+                {
+
+                    /* Call system change function.  */
+                    _ux_system_host ->  ux_system_host_change_function(UX_DEVICE_INSERTION, hub -> ux_host_class_hub_class, (VOID *) hub);
+                }
+
+                /* If trace is enabled, register this object.  */
+                UX_TRACE_OBJECT_REGISTER(UX_TRACE_HOST_OBJECT_TYPE_INTERFACE, hub, 0, 0, 0)
+
+                /* Return success.  */
+                return(UX_SUCCESS);
+            }
+        }
+    }
+
+    /* The hub could not be activated, free its instance.  */
+    _ux_utility_memory_free(hub);
+
+    /* Return completion status.  */
+    return(status);
+}
+
@@ -0,0 +1,96 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */ 
+/** USBX Component                                                        */ 
+/**                                                                       */
+/**   Hub Class                                                           */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_class_hub.h"
+#include "ux_host_stack.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_class_hub_change_detect                    PORTABLE C      */
+/*                                                           6.1.12       */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function is called by the enumeration thread when it is        */
+/*    awaken. It processes the change of every hub instance that has one  */
+/*    pending.                                                            */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_host_class_hub_change_process     Process hub change            */
+/*    _ux_host_stack_class_get              Get class container           */
+/*    _ux_host_stack_class_instance_get     Get class instance            */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_host_stack_enum_thread_entry      Enumeration thread            */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_host_class_hub_change_detect(VOID)
+{
+
+UX_HOST_CLASS           *class_inst;
+UX_HOST_CLASS_HUB       *hub;
+UINT                    class_index;
+UINT                    status;
+
+
+    /* Get the class container of the hub class.  */
+    status =  _ux_host_stack_class_get(_ux_system_host_class_hub_name, &class_inst);
+    if (status != UX_SUCCESS)
+        return;
+
+    /* Scan the hub instances.  */
+    class_index =  0;
+    while (_ux_host_stack_class_instance_get(class_inst, class_index++, (VOID **) &hub) == UX_SUCCESS)
+    {
+
+        /* Process a pending change of this hub.  */
+        if (hub -> ux_host_class_hub_change_semaphore != 0)
+        {
+
+            /* One change is consumed.  */
+            hub -> ux_host_class_hub_change_semaphore--;
+
+            /* Process the change of the hub and of its ports.  */
+            _ux_host_class_hub_change_process(hub);
+        }
+    }
+}
+
@@ -0,0 +1,106 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */ 
+/** USBX Component                                                        */ 
+/**                                                                       */
+/**   Hub Class                                                           */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_class_hub.h"
+#include "ux_host_stack.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_class_hub_change_process                   PORTABLE C      */
+/*                                                           6.1.12       */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function processes a change reported by the interrupt endpoint */
+/*    of the hub and restarts its polling. Bit 0 of the change bit map is */
+/*    the hub itself, bit n is port n.                                    */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    hub                                   Pointer to hub class          */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_host_class_hub_hub_change_process Process hub change            */
+/*    _ux_host_class_hub_port_change_process                              */
+/*                                          Process port change           */
+/*    _ux_host_stack_transfer_request       Process transfer request      */
+/*    _ux_utility_short_get                 Get 16-bit value              */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_host_class_hub_change_detect      Detect hub change             */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_host_class_hub_change_process(UX_HOST_CLASS_HUB *hub)
+{
+
+UX_TRANSFER     *transfer_request;
+USHORT          port_change_bits;
+UINT            port_index;
+UINT            status;
+
+
+    /* Get the transfer request of the interrupt endpoint.  */
+    transfer_request =  &hub -> ux_host_class_hub_interrupt_endpoint -> ux_endpoint_transfer_request;
+
+    /* The change bit map is one byte up to 7 ports, two bytes above.  */
+    if (transfer_request -> ux_transfer_request_actual_length == 1)
+        port_change_bits =  (USHORT) *transfer_request -> ux_transfer_request_data_pointer;
+    else
+        port_change_bits =  (USHORT) _ux_utility_short_get(transfer_request -> ux_transfer_request_data_pointer);
+
+    /* Process the change of each port.  */
+    for (port_index = 1; port_index <= hub -> ux_host_class_hub_descriptor.bNbPorts; port_index++)
+    {
+
+        if (port_change_bits & (1 << port_index))
+            _ux_host_class_hub_port_change_process(hub, port_index);
+    }
+
+    /* Process the change of the hub itself.  */
+    if (port_change_bits & 1)
+        _ux_host_class_hub_hub_change_process(hub);
+
+    /* The actual length must be cleared for the next poll.  */
+    transfer_request -> ux_transfer_request_actual_length =  0;
+
+    /* Restart the polling.  */
+    status =  _ux_host_stack_transfer_request(transfer_request);
+
+    /* Return completion status.  */
+    return(status);
+}
+
@@ -0,0 +1,192 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */ 
+/** USBX Component                                                        */ 
+/**                                                                       */
+/**   Hub Class                                                           */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_class_hub.h"
+#include "ux_host_stack.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_class_hub_configure                        PORTABLE C      */
+/*                                                           6.1.12       */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function selects the configuration of the hub. The power       */
+/*    source reported by the hub in its device status replaces the one of */
+/*    its configuration descriptor, and a bus powered hub is refused on a */
+/*    bus powered parent hub.                                             */
+/*                                                                        */
+/*    The interface of the hub is kept in the hub instance, its interrupt */
+/*    endpoint reports the port changes.                                  */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    hub                                   Pointer to hub class          */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_host_semaphore_get                Get protection semaphore      */
+/*    _ux_host_semaphore_put                Release protection semaphore  */
+/*    _ux_host_stack_configuration_interface_get                          */
+/*                                          Get interface                 */
+/*    _ux_host_stack_device_configuration_get                             */
+/*                                          Get configuration             */
+/*    _ux_host_stack_device_configuration_select                          */
+/*                                          Select configuration          */
+/*    _ux_host_stack_transfer_request       Process transfer request      */
+/*    _ux_utility_memory_allocate           Allocate memory block         */
+/*    _ux_utility_memory_free               Free memory block             */
+/*    _ux_utility_short_get                 Get 16-bit value              */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_host_class_hub_activate           Activate hub class            */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_host_class_hub_configure(UX_HOST_CLASS_HUB *hub)
+{
+
+UINT                    status;
+UX_CONFIGURATION        *configuration;
+UX_DEVICE               *device;
+UX_ENDPOINT             *control_endpoint;
+UX_TRANSFER             *transfer_request;
+UCHAR                   *device_status_data;
+#if UX_MAX_DEVICES > 1
+UX_DEVICE               *parent_device;
+#endif
+
+
+    /* Get the device of the hub.  */
+    device =  hub -> ux_host_class_hub_device;
+
+    /* A hub has one configuration, retrieve it.  */
+    status =  _ux_host_stack_device_configuration_get(device, 0, &configuration);
+    if (status != UX_SUCCESS)
+    {
+
+        /* Error trap. */
+        _ux_system_error_handler(UX_SYSTEM_LEVEL_THREAD, UX_SYSTEM_CONTEXT_CLASS, UX_CONFIGURATION_HANDLE_UNKNOWN);
+
+        /* If trace is enabled, insert this event into the trace buffer.  */
+        UX_TRACE_IN_LINE_INSERT(UX_TRACE_ERROR, UX_CONFIGURATION_HANDLE_UNKNOWN, device, 0, 0, UX_TRACE_ERRORS, 0, 0)
+
+        return(UX_CONFIGURATION_HANDLE_UNKNOWN);
+    }
+
+    /* A hub may declare both power sources in its configuration descriptor, the device
+       status tells the one in use.  */
+    device_status_data =  _ux_utility_memory_allocate(UX_SAFE_ALIGN, UX_CACHE_SAFE_MEMORY, 2);
+    if (device_status_data == UX_NULL)
+        return(UX_MEMORY_INSUFFICIENT);
+
+    /* We need to get the default control endpoint transfer request pointer.  */
+    control_endpoint =  &device -> ux_device_control_endpoint;
+    transfer_request =  &control_endpoint -> ux_endpoint_transfer_request;
+
+    /* We need to prevent other threads from simultaneously using the control endpoint.  */
+    status =  _ux_host_semaphore_get(&device -> ux_device_protection_semaphore, UX_WAIT_FOREVER);
+    if (status != UX_SUCCESS)
+    {
+
+        /* Free the buffer of the device status.  */
+        _ux_utility_memory_free(device_status_data);
+        return(status);
+    }
+
+    /* Create a transfer request for the GET_STATUS request.  */
+    transfer_request -> ux_transfer_request_data_pointer =      device_status_data;
+    transfer_request -> ux_transfer_request_requested_length =  2;
+    transfer_request -> ux_transfer_request_function =          UX_GET_STATUS;
+    transfer_request -> ux_transfer_request_type =              UX_REQUEST_IN | UX_REQUEST_TYPE_STANDARD | UX_REQUEST_TARGET_DEVICE;
+    transfer_request -> ux_transfer_request_value =             0;
+    transfer_request -> ux_transfer_request_index =             0;
+
+    /* Send request to HCD layer.  */
+    status =  _ux_host_stack_transfer_request(transfer_request);
+
+    /* Release the protection semaphore.  */
+    _ux_host_semaphore_put(&device -> ux_device_protection_semaphore);
+
+    /* Without an answer the power source of the configuration descriptor is kept.  */
+    if ((status == UX_SUCCESS) && (transfer_request -> ux_transfer_request_actual_length == 2))
+    {
+
+        /* Update the power source of the hub.  */
+        if (_ux_utility_short_get(device_status_data) & UX_STATUS_DEVICE_SELF_POWERED)
+            device -> ux_device_power_source =  UX_DEVICE_SELF_POWERED;
+        else
+            device -> ux_device_power_source =  UX_DEVICE_BUS_POWERED;
+    }
+
+    /* Free the buffer of the device status.  */
+    _ux_utility_memory_free(device_status_data);
+
+#if UX_MAX_DEVICES > 1
+    /* A bus powered hub cannot supply its ports from a bus powered parent hub.  */
+    if (device -> ux_device_power_source == UX_DEVICE_BUS_POWERED)
+    {
+
+        /* Pickup pointer to parent device.  */
+        parent_device =  device -> ux_device_parent;
+
+        /* If the device is NULL, the parent is the root hub and we don't have to worry
+           if the parent is not the root hub, check for its power source.  */
+        if ((parent_device != UX_NULL) && (parent_device -> ux_device_power_source == UX_DEVICE_BUS_POWERED))
+        {
+
+            /* Error trap. */
+            _ux_system_error_handler(UX_SYSTEM_LEVEL_THREAD, UX_SYSTEM_CONTEXT_CLASS, UX_CONNECTION_INCOMPATIBLE);
+
+            /* If trace is enabled, insert this event into the trace buffer.  */
+            UX_TRACE_IN_LINE_INSERT(UX_TRACE_ERROR, UX_CONNECTION_INCOMPATIBLE, hub, 0, 0, UX_TRACE_ERRORS, 0, 0)
+
+            return(UX_CONNECTION_INCOMPATIBLE);
+        }
+    }
+#endif
+
+    /* We have the valid configuration. Ask the USBX stack to set this configuration.  */
+    status =  _ux_host_stack_device_configuration_select(configuration);
+    if (status != UX_SUCCESS)
+        return(status);
+
+    /* The hub has one interface, its interrupt endpoint reports the port changes.  */
+    status =  _ux_host_stack_configuration_interface_get(configuration, 0, 0, &hub -> ux_host_class_hub_interface);
+
+    /* Return completion status.  */
+    return(status);
+}
+
@@ -0,0 +1,126 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */ 
+/** USBX Component                                                        */ 
+/**                                                                       */
+/**   Hub Class                                                           */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_class_hub.h"
+#include "ux_host_stack.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_class_hub_deactivate                       PORTABLE C      */
+/*                                                           6.1.12       */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function deactivates the hub class when the hub is removed.    */
+/*    The polling of the hub is stopped and the devices of its ports are  */
+/*    removed first, their classes are deactivated before the hub         */
+/*    instance is freed.                                                  */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    command                               Pointer to class command      */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_host_stack_class_instance_destroy Destroy class instance        */
+/*    _ux_host_stack_device_remove          Remove device                 */
+/*    _ux_host_stack_endpoint_transfer_abort                              */
+/*                                          Abort transfer                */
+/*    _ux_utility_memory_free               Free memory block             */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_host_class_hub_entry              Entry of the hub class        */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_host_class_hub_deactivate(UX_HOST_CLASS_COMMAND *command)
+{
+
+UX_HOST_CLASS_HUB   *hub;
+UX_HCD              *hcd;
+UX_TRANSFER         *transfer_request;
+UINT                port_index;
+
+
+    /* Get the instance to the class.  */
+    hub =  (UX_HOST_CLASS_HUB *) command -> ux_host_class_command_instance;
+
+    /* Get the controller of the hub.  */
+    hcd =  UX_DEVICE_HCD_GET(hub -> ux_host_class_hub_device);
+
+    /* The hub is being shut down.  */
+    hub -> ux_host_class_hub_state =  UX_HOST_CLASS_INSTANCE_SHUTDOWN;
+
+    /* Stop the polling so that no change is reported while the ports are removed.  */
+    _ux_host_stack_endpoint_transfer_abort(hub -> ux_host_class_hub_interrupt_endpoint);
+
+    /* Remove the devices of the ports, their classes are deactivated.  */
+    for (port_index = 1; port_index <= hub -> ux_host_class_hub_descriptor.bNbPorts; port_index++)
+    {
+
+        if (hub -> ux_host_class_hub_port_state & (UINT)(1 << port_index))
+            _ux_host_stack_device_remove(hcd, hub -> ux_host_class_hub_device, port_index);
+    }
+    hub -> ux_host_class_hub_port_state =  0;
+
+    /* If the application has registered a call back, inform it of the removal.  */
+    if (_ux_system_host -> ux_system_host_change_function != UX_NULL)
+    {
+
+        /* Call system change function.  */
+        _ux_system_host ->  ux_system_host_change_function(UX_DEVICE_REMOVAL, hub -> ux_host_class_hub_class, (VOID *) hub);
+    }
+
+    /* Free the buffer of the change bit map.  */
+    transfer_request =  &hub -> ux_host_class_hub_interrupt_endpoint -> ux_endpoint_transfer_request;
+    _ux_utility_memory_free(transfer_request -> ux_transfer_request_data_pointer);
+    transfer_request -> ux_transfer_request_data_pointer =  UX_NULL;
+
+    /* Destroy the instance.  */
+    _ux_host_stack_class_instance_destroy(hub -> ux_host_class_hub_class, (VOID *) hub);
+
+    /* The device no longer has a class instance.  */
+    hub -> ux_host_class_hub_device -> ux_device_class_instance =  UX_NULL;
+
+    /* If trace is enabled, register this object.  */
+    UX_TRACE_OBJECT_UNREGISTER(hub);
+
+    /* Free the hub instance.  */
+    _ux_utility_memory_free(hub);
+
+    /* Return successful completion.  */
+    return(UX_SUCCESS);
+}
+
@@ -0,0 +1,185 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */ 
+/** USBX Component                                                        */ 
+/**                                                                       */
+/**   Hub Class                                                           */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_class_hub.h"
+#include "ux_host_stack.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_class_hub_descriptor_get                   PORTABLE C      */
+/*                                                           6.1.12       */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function reads the hub descriptor and keeps it in the hub      */
+/*    instance. The transaction translators of a high speed hub are set   */
+/*    up for the full and low speed devices of its ports.                 */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    hub                                   Pointer to hub class          */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_host_semaphore_get                Get protection semaphore      */
+/*    _ux_host_semaphore_put                Release protection semaphore  */
+/*    _ux_host_stack_transfer_request       Process transfer request      */
+/*    _ux_utility_descriptor_parse          Parse descriptor              */
+/*    _ux_utility_memory_allocate           Allocate memory block         */
+/*    _ux_utility_memory_free               Free memory block             */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_host_class_hub_activate           Activate hub class            */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_host_class_hub_descriptor_get(UX_HOST_CLASS_HUB *hub)
+{
+
+UX_DEVICE       *device;
+UX_ENDPOINT     *control_endpoint;
+UX_TRANSFER     *transfer_request;
+UCHAR           *descriptor;
+UINT            status;
+#if UX_MAX_DEVICES > 1
+UINT            tt_index;
+#endif
+
+
+    /* We need to get the default control endpoint transfer request pointer.  */
+    device =  hub -> ux_host_class_hub_device;
+    control_endpoint =  &device -> ux_device_control_endpoint;
+    transfer_request =  &control_endpoint -> ux_endpoint_transfer_request;
+
+    /* Need memory for the descriptor.  */
+    descriptor =  _ux_utility_memory_allocate(UX_SAFE_ALIGN, UX_CACHE_SAFE_MEMORY, UX_HUB_DESCRIPTOR_LENGTH);
+    if (descriptor == UX_NULL)
+        return(UX_MEMORY_INSUFFICIENT);
+
+    /* We need to prevent other threads from simultaneously using the control endpoint.  */
+    status =  _ux_host_semaphore_get(&device -> ux_device_protection_semaphore, UX_WAIT_FOREVER);
+    if (status != UX_SUCCESS)
+    {
+
+        /* Free the descriptor buffer.  */
+        _ux_utility_memory_free(descriptor);
+        return(status);
+    }
+
+    /* Create a transfer request for the GET_DESCRIPTOR request. A hub of more than 7 ports
+       has a longer descriptor, only its port masks are cut.  */
+    transfer_request -> ux_transfer_request_data_pointer =      descriptor;
+    transfer_request -> ux_transfer_request_requested_length =  UX_HUB_DESCRIPTOR_LENGTH;
+    transfer_request -> ux_transfer_request_function =          UX_HOST_CLASS_HUB_GET_DESCRIPTOR;
+    transfer_request -> ux_transfer_request_type =              UX_REQUEST_IN | UX_REQUEST_TYPE_CLASS | UX_REQUEST_TARGET_DEVICE;
+    transfer_request -> ux_transfer_request_value =             (UX_HUB_DESCRIPTOR_ITEM << 8);
+    transfer_request -> ux_transfer_request_index =             0;
+
+    /* Send request to HCD layer.  */
+    status =  _ux_host_stack_transfer_request(transfer_request);
+
+    /* Release the protection semaphore.  */
+    _ux_host_semaphore_put(&device -> ux_device_protection_semaphore);
+
+    /* Check for correct transfer and entire descriptor returned.  */
+    if ((status == UX_SUCCESS) && (transfer_request -> ux_transfer_request_actual_length != UX_HUB_DESCRIPTOR_LENGTH))
+        status =  UX_DESCRIPTOR_CORRUPTED;
+
+    if (status == UX_SUCCESS)
+    {
+
+        /* Parse the descriptor into the hub instance.  */
+        _ux_utility_descriptor_parse(descriptor, _ux_system_hub_descriptor_structure,
+                        UX_HUB_DESCRIPTOR_ENTRIES, (UCHAR *) &hub -> ux_host_class_hub_descriptor);
+
+        /* The port state and power are bit masks of the ports 1 to UX_MAX_HUB_PORTS.  */
+        if (hub -> ux_host_class_hub_descriptor.bNbPorts == 0)
+            status =  UX_DESCRIPTOR_CORRUPTED;
+        else if (hub -> ux_host_class_hub_descriptor.bNbPorts > UX_MAX_HUB_PORTS)
+            status =  UX_TOO_MANY_HUB_PORTS;
+    }
+
+    /* Free the descriptor buffer.  */
+    _ux_utility_memory_free(descriptor);
+
+    if ((status == UX_DESCRIPTOR_CORRUPTED) || (status == UX_TOO_MANY_HUB_PORTS))
+    {
+
+        /* Error trap. */
+        _ux_system_error_handler(UX_SYSTEM_LEVEL_THREAD, UX_SYSTEM_CONTEXT_HUB, status);
+
+        /* If trace is enabled, insert this event into the trace buffer.  */
+        UX_TRACE_IN_LINE_INSERT(UX_TRACE_ERROR, status, hub, 0, 0, UX_TRACE_ERRORS, 0, 0)
+    }
+
+#if UX_MAX_DEVICES > 1
+    if (status == UX_SUCCESS)
+    {
+
+        /* The protocol of a high speed hub tells if one transaction translator serves all
+           its ports or if each port has its own.  */
+        switch (device -> ux_device_descriptor.bDeviceProtocol)
+        {
+
+        case UX_HOST_CLASS_HUB_PROTOCOL_SINGLE_TT:
+
+            /* All the ports share the translator.  */
+            device -> ux_device_hub_tt[0].ux_hub_tt_port_mapping =   UX_TT_MASK;
+            device -> ux_device_hub_tt[0].ux_hub_tt_max_bandwidth =  UX_TT_BANDWIDTH;
+            break;
+
+        case UX_HOST_CLASS_HUB_PROTOCOL_MULTIPLE_TT:
+
+            /* One translator per port, bit 0 of the mapping is port 1.  */
+            for (tt_index = 0; (tt_index < hub -> ux_host_class_hub_descriptor.bNbPorts) && (tt_index < UX_MAX_TT); tt_index++)
+            {
+
+                device -> ux_device_hub_tt[tt_index].ux_hub_tt_port_mapping =   (ULONG)(1 << tt_index);
+                device -> ux_device_hub_tt[tt_index].ux_hub_tt_max_bandwidth =  UX_TT_BANDWIDTH;
+            }
+            break;
+
+        default:
+
+            /* A full speed hub has no translator.  */
+            break;
+        }
+    }
+#endif
+
+    /* Return completion status.  */
+    return(status);
+}
+
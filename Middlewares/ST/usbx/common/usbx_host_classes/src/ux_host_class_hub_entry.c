@@ -0,0 +1,122 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */ 
+/** USBX Component                                                        */ 
+/**                                                                       */
+/**   Hub Class                                                           */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_class_hub.h"
+#include "ux_host_stack.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_class_hub_entry                            PORTABLE C      */
+/*                                                           6.1.12       */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function is the entry point of the hub class. It will be       */
+/*    called by the USBX stack enumeration module when there is a new hub */
+/*    on the bus or when the hub is removed.                              */
+/*                                                                        */
+/*    The first hub activated hooks the hub change detection in the       */
+/*    enumeration thread.                                                 */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    command                               Pointer to class command      */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_host_class_hub_activate           Activate hub class            */
+/*    _ux_host_class_hub_deactivate         Deactivate hub class          */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Host Stack                                                          */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_host_class_hub_entry(UX_HOST_CLASS_COMMAND *command)
+{
+
+UINT        status;
+
+
+    /* The command request will tell us we need to do here, either a enumeration
+       query, an activation or a deactivation.  */
+    switch (command -> ux_host_class_command_request)
+    {
+
+    case UX_HOST_CLASS_COMMAND_QUERY:
+
+        /* The query command is used to let the stack enumeration process know if we want to own
+           this device or not.  A hub is recognized by the class of its device descriptor.  */
+        if ((command -> ux_host_class_command_usage == UX_HOST_CLASS_COMMAND_USAGE_DCSP) &&
+                            (command -> ux_host_class_command_class == UX_HOST_CLASS_HUB_CLASS))
+            return(UX_SUCCESS);
+        else
+            return(UX_NO_CLASS_MATCH);
+
+    case UX_HOST_CLASS_COMMAND_ACTIVATE:
+
+        /* The enumeration thread checks the hubs for a port change when it is awaken,
+           as the root hub.  */
+        _ux_system_host -> ux_system_host_enum_hub_function =  _ux_host_class_hub_change_detect;
+
+        /* The activate command is used when the device inserted has found a parent and
+           is ready to complete the enumeration.  */
+        status =  _ux_host_class_hub_activate(command);
+        return(status);
+
+    case UX_HOST_CLASS_COMMAND_DEACTIVATE:
+
+        /* The deactivate command is used when the device has been extracted either
+           directly or when its parents has been extracted.  */
+        status =  _ux_host_class_hub_deactivate(command);
+        return(status);
+
+    case UX_HOST_CLASS_COMMAND_DESTROY:
+
+        /* Nothing is allocated for the class itself, only for its instances.  */
+        return(UX_SUCCESS);
+
+    default:
+
+        /* Error trap. */
+        _ux_system_error_handler(UX_SYSTEM_LEVEL_THREAD, UX_SYSTEM_CONTEXT_CLASS, UX_FUNCTION_NOT_SUPPORTED);
+
+        /* If trace is enabled, insert this event into the trace buffer.  */
+        UX_TRACE_IN_LINE_INSERT(UX_TRACE_ERROR, UX_FUNCTION_NOT_SUPPORTED, 0, 0, 0, UX_TRACE_ERRORS, 0, 0)
+
+        return(UX_FUNCTION_NOT_SUPPORTED);
+    }
+}
+
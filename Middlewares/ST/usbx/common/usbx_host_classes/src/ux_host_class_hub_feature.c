@@ -0,0 +1,110 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */ 
+/** USBX Component                                                        */ 
+/**                                                                       */
+/**   Hub Class                                                           */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_class_hub.h"
+#include "ux_host_stack.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_class_hub_feature                          PORTABLE C      */
+/*                                                           6.1.12       */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function sets or clears a feature of the hub, port 0, or of    */
+/*    one of its ports.                                                   */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    hub                                   Pointer to hub class          */
+/*    port                                  Port, 0 for the hub           */
+/*    command                               SET or CLEAR_FEATURE          */
+/*    function                              Feature selector              */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_host_semaphore_get                Get protection semaphore      */
+/*    _ux_host_semaphore_put                Release protection semaphore  */
+/*    _ux_host_stack_transfer_request       Process transfer request      */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    HUB Class                                                           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_host_class_hub_feature(UX_HOST_CLASS_HUB *hub, UINT port, UINT command, UINT function)
+{
+
+UX_DEVICE       *device;
+UX_ENDPOINT     *control_endpoint;
+UX_TRANSFER     *transfer_request;
+UINT            target;
+UINT            status;
+
+
+    /* We need to get the default control endpoint transfer request pointer.  */
+    device =  hub -> ux_host_class_hub_device;
+    control_endpoint =  &device -> ux_device_control_endpoint;
+    transfer_request =  &control_endpoint -> ux_endpoint_transfer_request;
+
+    /* The feature of port 0 is a feature of the hub itself.  */
+    if (port == 0)
+        target =  UX_REQUEST_TARGET_DEVICE;
+    else
+        target =  UX_REQUEST_TARGET_OTHER;
+
+    /* We need to prevent other threads from simultaneously using the control endpoint.  */
+    status =  _ux_host_semaphore_get(&device -> ux_device_protection_semaphore, UX_WAIT_FOREVER);
+    if (status != UX_SUCCESS)
+        return(status);
+
+    /* Create a transfer request for the SET or CLEAR_FEATURE request.  */
+    transfer_request -> ux_transfer_request_data_pointer =      UX_NULL;
+    transfer_request -> ux_transfer_request_requested_length =  0;
+    transfer_request -> ux_transfer_request_function =          command;
+    transfer_request -> ux_transfer_request_type =              UX_REQUEST_OUT | UX_REQUEST_TYPE_CLASS | target;
+    transfer_request -> ux_transfer_request_value =             function;
+    transfer_request -> ux_transfer_request_index =             port;
+
+    /* Send request to HCD layer.  */
+    status =  _ux_host_stack_transfer_request(transfer_request);
+
+    /* Release the protection semaphore.  */
+    _ux_host_semaphore_put(&device -> ux_device_protection_semaphore);
+
+    /* Return completion status.  */
+    return(status);
+}
+
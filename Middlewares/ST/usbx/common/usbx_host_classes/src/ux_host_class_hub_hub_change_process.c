@@ -0,0 +1,105 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */ 
+/** USBX Component                                                        */ 
+/**                                                                       */
+/**   Hub Class                                                           */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_class_hub.h"
+#include "ux_host_stack.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_class_hub_hub_change_process               PORTABLE C      */
+/*                                                           6.1.12       */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function processes a change of the hub itself. The change bits */
+/*    are acknowledged, and the ports are powered again after an over     */
+/*    current of the hub.                                                 */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    hub                                   Pointer to hub class          */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_host_class_hub_feature            Set or clear a hub feature    */
+/*    _ux_host_class_hub_ports_power        Power the hub ports           */
+/*    _ux_host_class_hub_status_get         Get status of the hub         */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_host_class_hub_change_process     Process hub change            */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_host_class_hub_hub_change_process(UX_HOST_CLASS_HUB *hub)
+{
+
+USHORT      hub_status;
+USHORT      hub_change;
+UINT        status;
+
+
+    /* Get the status of the hub, port 0.  */
+    status =  _ux_host_class_hub_status_get(hub, 0, &hub_status, &hub_change);
+    if (status != UX_SUCCESS)
+        return(status);
+
+    /* Acknowledge a change of the local power supply.  */
+    if (hub_change & UX_HOST_CLASS_HUB_CHANGE_LOCAL_POWER)
+        _ux_host_class_hub_feature(hub, 0, UX_HOST_CLASS_HUB_CLEAR_FEATURE, UX_HOST_CLASS_HUB_C_HUB_LOCAL_POWER);
+
+    /* Acknowledge an over current of the hub.  */
+    if (hub_change & UX_HOST_CLASS_HUB_CHANGE_OVER_CURRENT)
+    {
+
+        _ux_host_class_hub_feature(hub, 0, UX_HOST_CLASS_HUB_CLEAR_FEATURE, UX_HOST_CLASS_HUB_C_HUB_OVER_CURRENT);
+
+        /* The over current removed the power of the ports, power them again once it is over.  */
+        if ((hub_status & UX_HOST_CLASS_HUB_STATUS_OVER_CURRENT) == 0)
+            _ux_host_class_hub_ports_power(hub);
+        else
+        {
+
+            /* Error trap. */
+            _ux_system_error_handler(UX_SYSTEM_LEVEL_THREAD, UX_SYSTEM_CONTEXT_HUB, UX_OVER_CURRENT_CONDITION);
+
+            /* If trace is enabled, insert this event into the trace buffer.  */
+            UX_TRACE_IN_LINE_INSERT(UX_TRACE_ERROR, UX_OVER_CURRENT_CONDITION, hub, 0, 0, UX_TRACE_ERRORS, 0, 0)
+        }
+    }
+
+    /* Return successful completion.  */
+    return(UX_SUCCESS);
+}
+
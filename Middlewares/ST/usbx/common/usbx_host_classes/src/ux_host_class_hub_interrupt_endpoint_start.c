@@ -0,0 +1,121 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */ 
+/** USBX Component                                                        */ 
+/**                                                                       */
+/**   Hub Class                                                           */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_class_hub.h"
+#include "ux_host_stack.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_class_hub_interrupt_endpoint_start         PORTABLE C      */
+/*                                                           6.1.12       */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function searches the interrupt endpoint of the hub and starts */
+/*    polling it. The hub answers the poll with a bit map of the ports    */
+/*    that have a change, bit 0 for the hub itself.                       */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    hub                                   Pointer to hub class          */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_host_stack_interface_endpoint_get Get interface endpoint        */
+/*    _ux_host_stack_transfer_request       Process transfer request      */
+/*    _ux_utility_memory_allocate           Allocate memory block         */
+/*    _ux_utility_memory_free               Free memory block             */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_host_class_hub_activate           Activate hub class            */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_host_class_hub_interrupt_endpoint_start(UX_HOST_CLASS_HUB *hub)
+{
+
+UX_ENDPOINT     *endpoint;
+UX_TRANSFER     *transfer_request;
+UINT            status;
+
+
+    /* The interrupt endpoint is the only endpoint of the hub interface.  */
+    status =  _ux_host_stack_interface_endpoint_get(hub -> ux_host_class_hub_interface, 0, &endpoint);
+    if (status != UX_SUCCESS)
+        return(status);
+
+    /* It must be an interrupt IN endpoint.  */
+    if (((endpoint -> ux_endpoint_descriptor.bEndpointAddress & UX_ENDPOINT_DIRECTION) != UX_ENDPOINT_IN) ||
+        ((endpoint -> ux_endpoint_descriptor.bmAttributes & UX_MASK_ENDPOINT_TYPE) != UX_INTERRUPT_ENDPOINT))
+    {
+
+        /* Error trap. */
+        _ux_system_error_handler(UX_SYSTEM_LEVEL_THREAD, UX_SYSTEM_CONTEXT_HUB, UX_ENDPOINT_HANDLE_UNKNOWN);
+
+        /* If trace is enabled, insert this event into the trace buffer.  */
+        UX_TRACE_IN_LINE_INSERT(UX_TRACE_ERROR, UX_ENDPOINT_HANDLE_UNKNOWN, endpoint, 0, 0, UX_TRACE_ERRORS, 0, 0)
+
+        return(UX_ENDPOINT_HANDLE_UNKNOWN);
+    }
+
+    /* Save the endpoint in the hub instance.  */
+    hub -> ux_host_class_hub_interrupt_endpoint =  endpoint;
+
+    /* Fill in the transfer request with the hub instance and the completion routine.  */
+    transfer_request =  &endpoint -> ux_endpoint_transfer_request;
+    transfer_request -> ux_transfer_request_class_instance =       (VOID *) hub;
+    transfer_request -> ux_transfer_request_requested_length =     endpoint -> ux_endpoint_descriptor.wMaxPacketSize;
+    transfer_request -> ux_transfer_request_completion_function =  _ux_host_class_hub_transfer_request_completed;
+
+    /* Need memory for the change bit map.  */
+    transfer_request -> ux_transfer_request_data_pointer =
+                    _ux_utility_memory_allocate(UX_SAFE_ALIGN, UX_CACHE_SAFE_MEMORY, transfer_request -> ux_transfer_request_requested_length);
+    if (transfer_request -> ux_transfer_request_data_pointer == UX_NULL)
+        return(UX_MEMORY_INSUFFICIENT);
+
+    /* Start the polling, the request completes when a port changes.  */
+    status =  _ux_host_stack_transfer_request(transfer_request);
+    if (status != UX_SUCCESS)
+    {
+
+        /* Free the buffer of the change bit map.  */
+        _ux_utility_memory_free(transfer_request -> ux_transfer_request_data_pointer);
+        transfer_request -> ux_transfer_request_data_pointer =  UX_NULL;
+    }
+
+    /* Return completion status.  */
+    return(status);
+}
+
@@ -0,0 +1,199 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */ 
+/** USBX Component                                                        */ 
+/**                                                                       */
+/**   Hub Class                                                           */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_class_hub.h"
+#include "ux_host_stack.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_class_hub_port_change_connection_process   PORTABLE C      */
+/*                                                           6.1.12       */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function processes a connection change of a port of the hub. A */
+/*    device that was on the port is removed first, then a device now on  */
+/*    the port is reset and enumerated with the hub as its parent.        */
+/*                                                                        */
+/*    As for the root hub, a device that does not answer after the reset  */
+/*    of the port is given more tries, with a new reset each time.        */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    hub                                   Pointer to hub class          */
+/*    port                                  Port number                   */
+/*    port_status                           Port status                   */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_host_class_hub_feature            Set or clear a hub feature    */
+/*    _ux_host_class_hub_port_reset         Reset the port                */
+/*    _ux_host_class_hub_status_get         Get status of the port        */
+/*    _ux_host_stack_device_remove          Remove device                 */
+/*    _ux_host_stack_new_device_create      Create new device             */
+/*    _ux_utility_delay_ms                  Thread sleep                  */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_host_class_hub_port_change_process                              */
+/*                                          Process port change           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_host_class_hub_port_change_connection_process(UX_HOST_CLASS_HUB *hub, UINT port, UINT port_status)
+{
+
+UX_HCD          *hcd;
+UX_DEVICE       *device =  UX_NULL;
+UINT            device_speed;
+UINT            device_power;
+UINT            index_loop;
+USHORT          reset_status;
+USHORT          reset_change;
+UINT            status;
+
+
+    /* Get the controller of the hub.  */
+    hcd =  UX_DEVICE_HCD_GET(hub -> ux_host_class_hub_device);
+
+    /* Acknowledge the connection change.  */
+    _ux_host_class_hub_feature(hub, port, UX_HOST_CLASS_HUB_CLEAR_FEATURE, UX_HOST_CLASS_HUB_C_PORT_CONNECTION);
+
+    /* A device known on this port has been removed, or replaced in between two polls.  */
+    if (hub -> ux_host_class_hub_port_state & (UINT)(1 << port))
+    {
+
+        /* Remove the device, its class is deactivated.  */
+        _ux_host_stack_device_remove(hcd, hub -> ux_host_class_hub_device, port);
+
+        /* The port is now empty.  */
+        hub -> ux_host_class_hub_port_state &=  (UINT)~(1 << port);
+    }
+
+    /* Nothing more to do if no device is on the port.  */
+    if ((port_status & UX_HOST_CLASS_HUB_PORT_STATUS_CONNECTION) == 0)
+        return;
+
+    /* A self powered hub gives its ports the self powered budget.  */
+    if (hub -> ux_host_class_hub_device -> ux_device_power_source == UX_DEVICE_SELF_POWERED)
+        device_power =  UX_MAX_SELF_POWER;
+    else
+        device_power =  UX_MAX_BUS_POWER;
+
+    /* A debounce interval on attach.  */
+    _ux_utility_delay_ms(UX_HOST_CLASS_HUB_ENUMERATION_DEBOUNCE_DELAY);
+
+    /* The first attempts to do a device enumeration may fail. In this case, we reset
+       the port again and retry.  */
+    for (index_loop = 0; index_loop < UX_HOST_CLASS_HUB_ENUMERATION_RETRY; index_loop++)
+    {
+
+        /* Reset the port, the hub enables it at the end of the reset.  */
+        status =  _ux_host_class_hub_port_reset(hub, port);
+        if (status == UX_SUCCESS)
+        {
+
+            /* Let the device recover from the reset.  */
+            _ux_utility_delay_ms(UX_HOST_CLASS_HUB_ENUMERATION_RESET_RECOVERY_DELAY);
+
+            /* The status after the reset gives the speed of the device.  */
+            status =  _ux_host_class_hub_status_get(hub, port, &reset_status, &reset_change);
+            if (status != UX_SUCCESS)
+                break;
+
+            /* The device may have been removed during the retries.  */
+            if ((reset_status & UX_HOST_CLASS_HUB_PORT_STATUS_CONNECTION) == 0)
+                return;
+
+            /* Set the device speed.  */
+            if (reset_status & UX_HOST_CLASS_HUB_PORT_STATUS_LOW_SPEED)
+                device_speed =  UX_LOW_SPEED_DEVICE;
+            else if (reset_status & UX_HOST_CLASS_HUB_PORT_STATUS_HIGH_SPEED)
+                device_speed =  UX_HIGH_SPEED_DEVICE;
+            else
+                device_speed =  UX_FULL_SPEED_DEVICE;
+
+            /* Ask the USB stack to enumerate this device, the hub is its parent.  */
+            status =  _ux_host_stack_new_device_create(hcd, hub -> ux_host_class_hub_device, port,
+                                                        device_speed, device_power, &device);
+            if (status == UX_SUCCESS)
+            {
+
+                /* The device has been mounted properly, remember it so that it is removed
+                   with the hub or when the port changes.  */
+                hub -> ux_host_class_hub_port_state |=  (UINT)(1 << port);
+
+                /* If the device instance is ready, notify application for connection.  */
+                if (_ux_system_host -> ux_system_host_change_function)
+                {
+                    _ux_system_host -> ux_system_host_change_function(UX_DEVICE_CONNECTION, UX_NULL, (VOID*)device);
+                }
+
+                return;
+            }
+
+            /* Stop if the controller is dead.  */
+            if (hcd -> ux_hcd_status != UX_HCD_STATUS_OPERATIONAL)
+                return;
+
+            /* No retry if there are too many devices or if there is no class found.  */
+            if ((status == UX_TOO_MANY_DEVICES) || (status == UX_NO_CLASS_MATCH))
+                break;
+
+            /* Simulate remove to free allocated resources if retry.  */
+            if (index_loop < UX_HOST_CLASS_HUB_ENUMERATION_RETRY - 1)
+                _ux_host_stack_device_remove(hcd, hub -> ux_host_class_hub_device, port);
+        }
+
+        /* We get here if something did not go well, try again.  */
+        _ux_utility_delay_ms(UX_HOST_CLASS_HUB_ENUMERATION_RETRY_DELAY);
+    }
+
+    /* The device did not enumerate completely. It is still attached, remember the port
+       so that what was allocated for it is freed when it is removed.  */
+    hub -> ux_host_class_hub_port_state |=  (UINT)(1 << port);
+
+    /* Notify application for a physical connection failed to be enumerated.  */
+    if (_ux_system_host -> ux_system_host_change_function)
+    {
+        _ux_system_host -> ux_system_host_change_function(UX_DEVICE_CONNECTION, UX_NULL, (VOID*)device);
+    }
+
+    /* Error trap. */
+    _ux_system_error_handler(UX_SYSTEM_LEVEL_THREAD, UX_SYSTEM_CONTEXT_HUB, UX_DEVICE_ENUMERATION_FAILURE);
+
+    /* If trace is enabled, insert this event into the trace buffer.  */
+    UX_TRACE_IN_LINE_INSERT(UX_TRACE_ERROR, UX_DEVICE_ENUMERATION_FAILURE, port, 0, 0, UX_TRACE_ERRORS, 0, 0)
+}
+
@@ -0,0 +1,89 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */ 
+/** USBX Component                                                        */ 
+/**                                                                       */
+/**   Hub Class                                                           */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_class_hub.h"
+#include "ux_host_stack.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_class_hub_port_change_over_current_process PORTABLE C      */
+/*                                                           6.1.12       */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function processes an over current change of a port of the     */
+/*    hub. The change is acknowledged, and the port is powered again once */
+/*    the over current is over.                                           */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    hub                                   Pointer to hub class          */
+/*    port                                  Port number                   */
+/*    port_status                           Port status                   */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_host_class_hub_feature            Set or clear a hub feature    */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_host_class_hub_port_change_process                              */
+/*                                          Process port change           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_host_class_hub_port_change_over_current_process(UX_HOST_CLASS_HUB *hub, UINT port, UINT port_status)
+{
+
+    /* Acknowledge the over current change.  */
+    _ux_host_class_hub_feature(hub, port, UX_HOST_CLASS_HUB_CLEAR_FEATURE, UX_HOST_CLASS_HUB_C_PORT_OVER_CURRENT);
+
+    /* The port is still in over current.  */
+    if (port_status & UX_HOST_CLASS_HUB_PORT_STATUS_OVER_CURRENT)
+    {
+
+        /* Error trap. */
+        _ux_system_error_handler(UX_SYSTEM_LEVEL_THREAD, UX_SYSTEM_CONTEXT_HUB, UX_OVER_CURRENT_CONDITION);
+
+        /* If trace is enabled, insert this event into the trace buffer.  */
+        UX_TRACE_IN_LINE_INSERT(UX_TRACE_ERROR, UX_OVER_CURRENT_CONDITION, hub, port, 0, UX_TRACE_ERRORS, 0, 0)
+
+        return;
+    }
+
+    /* The over current is over, the hub removed the power of the port: power it again.  */
+    if ((port_status & UX_HOST_CLASS_HUB_PORT_STATUS_POWER) == 0)
+        _ux_host_class_hub_feature(hub, port, UX_HOST_CLASS_HUB_SET_FEATURE, UX_HOST_CLASS_HUB_PORT_POWER);
+}
+
@@ -0,0 +1,109 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */ 
+/** USBX Component                                                        */ 
+/**                                                                       */
+/**   Hub Class                                                           */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_class_hub.h"
+#include "ux_host_stack.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_class_hub_port_change_process              PORTABLE C      */
+/*                                                           6.1.12       */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function processes a change of a port of the hub. Each change  */
+/*    bit reported by the port status is processed and acknowledged.      */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    hub                                   Pointer to hub class          */
+/*    port                                  Port number                   */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_host_class_hub_port_change_connection_process                   */
+/*                                          Process connection            */
+/*    _ux_host_class_hub_port_change_enable_process                       */
+/*                                          Process enable                */
+/*    _ux_host_class_hub_port_change_over_current_process                 */
+/*                                          Process over current          */
+/*    _ux_host_class_hub_port_change_reset_process                        */
+/*                                          Process reset                 */
+/*    _ux_host_class_hub_port_change_suspend_process                      */
+/*                                          Process suspend               */
+/*    _ux_host_class_hub_status_get         Get status of the port        */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_host_class_hub_change_process     Process hub change            */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_host_class_hub_port_change_process(UX_HOST_CLASS_HUB *hub, UINT port)
+{
+
+USHORT      port_status;
+USHORT      port_change;
+UINT        status;
+
+
+    /* Get the status and the change bits of the port.  */
+    status =  _ux_host_class_hub_status_get(hub, port, &port_status, &port_change);
+    if (status != UX_SUCCESS)
+        return(status);
+
+    /* A device was inserted or removed.  */
+    if (port_change & UX_HOST_CLASS_HUB_PORT_CHANGE_CONNECTION)
+        _ux_host_class_hub_port_change_connection_process(hub, port, port_status);
+
+    /* The port was disabled by the hub.  */
+    if (port_change & UX_HOST_CLASS_HUB_PORT_CHANGE_ENABLE)
+        _ux_host_class_hub_port_change_enable_process(hub, port, port_status);
+
+    /* The device of the port resumed.  */
+    if (port_change & UX_HOST_CLASS_HUB_PORT_CHANGE_SUSPEND)
+        _ux_host_class_hub_port_change_suspend_process(hub, port, port_status);
+
+    /* The port had an over current.  */
+    if (port_change & UX_HOST_CLASS_HUB_PORT_CHANGE_OVER_CURRENT)
+        _ux_host_class_hub_port_change_over_current_process(hub, port, port_status);
+
+    /* A reset of the port completed outside of an enumeration.  */
+    if (port_change & UX_HOST_CLASS_HUB_PORT_CHANGE_RESET)
+        _ux_host_class_hub_port_change_reset_process(hub, port, port_status);
+
+    /* Return successful completion.  */
+    return(UX_SUCCESS);
+}
+
@@ -0,0 +1,115 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */ 
+/** USBX Component                                                        */ 
+/**                                                                       */
+/**   Hub Class                                                           */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_class_hub.h"
+#include "ux_host_stack.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_class_hub_port_reset                       PORTABLE C      */
+/*                                                           6.1.12       */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function resets a port of the hub and waits for the end of the */
+/*    reset, reported by the reset change of the port. The hub enables    */
+/*    the port at the end of the reset.                                   */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    hub                                   Pointer to hub class          */
+/*    port                                  Port number                   */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_host_class_hub_feature            Set or clear a hub feature    */
+/*    _ux_host_class_hub_status_get         Get status of the port        */
+/*    _ux_utility_delay_ms                  Thread sleep                  */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_host_class_hub_port_change_connection_process                   */
+/*                                          Process connection            */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_host_class_hub_port_reset(UX_HOST_CLASS_HUB *hub, UINT port)
+{
+
+USHORT      port_status;
+USHORT      port_change;
+UINT        index_loop;
+UINT        status;
+
+
+    /* Start the reset of the port.  */
+    status =  _ux_host_class_hub_feature(hub, port, UX_HOST_CLASS_HUB_SET_FEATURE, UX_HOST_CLASS_HUB_PORT_RESET);
+    if (status != UX_SUCCESS)
+        return(status);
+
+    /* Wait for the reset change of the port.  */
+    for (index_loop = 0; index_loop < UX_HOST_CLASS_HUB_ENABLE_RETRY_COUNT; index_loop++)
+    {
+
+        /* Let the reset run.  */
+        _ux_utility_delay_ms(UX_HOST_CLASS_HUB_ENABLE_RETRY_DELAY);
+
+        /* Get the status and the change bits of the port.  */
+        status =  _ux_host_class_hub_status_get(hub, port, &port_status, &port_change);
+        if (status != UX_SUCCESS)
+            return(status);
+
+        /* The reset is over when the reset change is set.  */
+        if (port_change & UX_HOST_CLASS_HUB_PORT_CHANGE_RESET)
+        {
+
+            /* Acknowledge the reset change.  */
+            _ux_host_class_hub_feature(hub, port, UX_HOST_CLASS_HUB_CLEAR_FEATURE, UX_HOST_CLASS_HUB_C_PORT_RESET);
+
+            /* The port must be enabled at the end of the reset.  */
+            if (port_status & UX_HOST_CLASS_HUB_PORT_STATUS_ENABLE)
+                return(UX_SUCCESS);
+            break;
+        }
+    }
+
+    /* Error trap. */
+    _ux_system_error_handler(UX_SYSTEM_LEVEL_THREAD, UX_SYSTEM_CONTEXT_HUB, UX_PORT_RESET_FAILED);
+
+    /* If trace is enabled, insert this event into the trace buffer.  */
+    UX_TRACE_IN_LINE_INSERT(UX_TRACE_ERROR, UX_PORT_RESET_FAILED, hub, port, 0, UX_TRACE_ERRORS, 0, 0)
+
+    return(UX_PORT_RESET_FAILED);
+}
+
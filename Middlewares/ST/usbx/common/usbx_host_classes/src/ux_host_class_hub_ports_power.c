@@ -0,0 +1,101 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */ 
+/** USBX Component                                                        */ 
+/**                                                                       */
+/**   Hub Class                                                           */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_class_hub.h"
+#include "ux_host_stack.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_class_hub_ports_power                      PORTABLE C      */
+/*                                                           6.1.12       */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function powers the downstream ports of the hub and waits for  */
+/*    the power to be good on them. A port that does not power is         */
+/*    reported and left out, the others are still usable.                 */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    hub                                   Pointer to hub class          */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_host_class_hub_feature            Set or clear a hub feature    */
+/*    _ux_utility_delay_ms                  Thread sleep                  */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_host_class_hub_activate           Activate hub class            */
+/*    _ux_host_class_hub_hub_change_process Process hub change            */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_host_class_hub_ports_power(UX_HOST_CLASS_HUB *hub)
+{
+
+UINT        port_index;
+UINT        status;
+
+
+    /* Power each port. A hub without power switching ignores the request.  */
+    for (port_index = 1; port_index <= hub -> ux_host_class_hub_descriptor.bNbPorts; port_index++)
+    {
+
+        /* Set the PORT_POWER feature of the port.  */
+        status =  _ux_host_class_hub_feature(hub, port_index, UX_HOST_CLASS_HUB_SET_FEATURE, UX_HOST_CLASS_HUB_PORT_POWER);
+        if (status == UX_SUCCESS)
+        {
+
+            /* Remember the port is powered.  */
+            hub -> ux_host_class_hub_port_power |=  (UINT)(1 << port_index);
+        }
+        else
+        {
+
+            /* Error trap. */
+            _ux_system_error_handler(UX_SYSTEM_LEVEL_THREAD, UX_SYSTEM_CONTEXT_HUB, status);
+
+            /* If trace is enabled, insert this event into the trace buffer.  */
+            UX_TRACE_IN_LINE_INSERT(UX_TRACE_ERROR, status, hub, port_index, 0, UX_TRACE_ERRORS, 0, 0)
+        }
+    }
+
+    /* Wait for the power to be good on the ports, bPwrOn2PwrGood is in units of 2 ms.  */
+    _ux_utility_delay_ms(hub -> ux_host_class_hub_descriptor.bPwrOn2PwrGood * 2);
+
+    /* The ports that powered are usable.  */
+    return(UX_SUCCESS);
+}
+
@@ -0,0 +1,138 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */ 
+/** USBX Component                                                        */ 
+/**                                                                       */
+/**   Hub Class                                                           */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_class_hub.h"
+#include "ux_host_stack.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_class_hub_status_get                       PORTABLE C      */
+/*                                                           6.1.12       */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function gets the status and the change bits of the hub, port  */
+/*    0, or of one of its ports.                                          */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    hub                                   Pointer to hub class          */
+/*    port                                  Port, 0 for the hub           */
+/*    port_status                           Returned status               */
+/*    port_change                           Returned change bits          */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_host_semaphore_get                Get protection semaphore      */
+/*    _ux_host_semaphore_put                Release protection semaphore  */
+/*    _ux_host_stack_transfer_request       Process transfer request      */
+/*    _ux_utility_memory_allocate           Allocate memory block         */
+/*    _ux_utility_memory_free               Free memory block             */
+/*    _ux_utility_short_get                 Get 16-bit value              */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    HUB Class                                                           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_host_class_hub_status_get(UX_HOST_CLASS_HUB *hub, UINT port, USHORT *port_status, USHORT *port_change)
+{
+
+UX_DEVICE       *device;
+UX_ENDPOINT     *control_endpoint;
+UX_TRANSFER     *transfer_request;
+UCHAR           *port_data;
+UINT            target;
+UINT            status;
+
+
+    /* We need to get the default control endpoint transfer request pointer.  */
+    device =  hub -> ux_host_class_hub_device;
+    control_endpoint =  &device -> ux_device_control_endpoint;
+    transfer_request =  &control_endpoint -> ux_endpoint_transfer_request;
+
+    /* The status of port 0 is the status of the hub itself.  */
+    if (port == 0)
+        target =  UX_REQUEST_TARGET_DEVICE;
+    else
+        target =  UX_REQUEST_TARGET_OTHER;
+
+    /* Need memory for the status and change words.  */
+    port_data =  _ux_utility_memory_allocate(UX_SAFE_ALIGN, UX_CACHE_SAFE_MEMORY, 4);
+    if (port_data == UX_NULL)
+        return(UX_MEMORY_INSUFFICIENT);
+
+    /* We need to prevent other threads from simultaneously using the control endpoint.  */
+    status =  _ux_host_semaphore_get(&device -> ux_device_protection_semaphore, UX_WAIT_FOREVER);
+    if (status != UX_SUCCESS)
+    {
+
+        /* Free the status buffer.  */
+        _ux_utility_memory_free(port_data);
+        return(status);
+    }
+
+    /* Create a transfer request for the GET_STATUS request.  */
+    transfer_request -> ux_transfer_request_data_pointer =      port_data;
+    transfer_request -> ux_transfer_request_requested_length =  4;
+    transfer_request -> ux_transfer_request_function =          UX_HOST_CLASS_HUB_GET_STATUS;
+    transfer_request -> ux_transfer_request_type =              UX_REQUEST_IN | UX_REQUEST_TYPE_CLASS | target;
+    transfer_request -> ux_transfer_request_value =             0;
+    transfer_request -> ux_transfer_request_index =             port;
+
+    /* Send request to HCD layer.  */
+    status =  _ux_host_stack_transfer_request(transfer_request);
+
+    /* Release the protection semaphore.  */
+    _ux_host_semaphore_put(&device -> ux_device_protection_semaphore);
+
+    /* Check for correct transfer and the two words returned.  */
+    if ((status == UX_SUCCESS) && (transfer_request -> ux_transfer_request_actual_length == 4))
+    {
+
+        /* The status word is followed by the change word.  */
+        *port_status =  (USHORT) _ux_utility_short_get(port_data);
+        *port_change =  (USHORT) _ux_utility_short_get(port_data + 2);
+    }
+    else if (status == UX_SUCCESS)
+        status =  UX_TRANSFER_DATA_LESS_THAN_EXPECTED;
+
+    /* Free the status buffer.  */
+    _ux_utility_memory_free(port_data);
+
+    /* Return completion status.  */
+    return(status);
+}
+
@@ -0,0 +1,99 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */ 
+/** USBX Component                                                        */ 
+/**                                                                       */
+/**   Hub Class                                                           */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_class_hub.h"
+#include "ux_host_stack.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_class_hub_transfer_request_completed       PORTABLE C      */
+/*                                                           6.1.12       */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function is called by the completion thread when the interrupt */
+/*    endpoint of the hub completes. A change of the hub is counted in    */
+/*    the hub instance and the enumeration thread is awaken to process    */
+/*    it, the polling is restarted once the change is processed.          */
+/*                                                                        */
+/*    A failed poll is restarted here unless the hub is shutting down or  */
+/*    the transfer was aborted.                                           */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    transfer_request                      Pointer to transfer request   */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_host_semaphore_put                Put the enumeration semaphore */
+/*    _ux_host_stack_transfer_request       Process transfer request      */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    HCD                                                                 */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_host_class_hub_transfer_request_completed(UX_TRANSFER *transfer_request)
+{
+
+UX_HOST_CLASS_HUB       *hub;
+
+
+    /* Get the class instance for this transfer request.  */
+    hub =  (UX_HOST_CLASS_HUB *) transfer_request -> ux_transfer_request_class_instance;
+
+    /* Check the state of the transfer.  If there is an error, we do not proceed with this report.  */
+    if (transfer_request -> ux_transfer_request_completion_code != UX_SUCCESS)
+    {
+
+        /* We do not restart the polling if the hub is shutting down or if the transfer
+           was aborted or got no answer, the hub is then being removed.  */
+        if ((hub -> ux_host_class_hub_state == UX_HOST_CLASS_INSTANCE_SHUTDOWN) ||
+            (transfer_request -> ux_transfer_request_completion_code == UX_TRANSFER_STATUS_ABORT) ||
+            (transfer_request -> ux_transfer_request_completion_code == UX_TRANSFER_NO_ANSWER))
+            return;
+
+        /* Restart the polling.  */
+        _ux_host_stack_transfer_request(transfer_request);
+        return;
+    }
+
+    /* Count the change on this hub instance, the enumeration thread processes it.  */
+    hub -> ux_host_class_hub_change_semaphore++;
+
+    /* Wake up the enumeration thread.  */
+    _ux_host_semaphore_put(&_ux_system_host -> ux_system_host_enum_semaphore);
+}
+
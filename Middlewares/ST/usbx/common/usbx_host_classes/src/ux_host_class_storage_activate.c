@@ -116,6 +116,12 @@ UINT                    status;
     /* This instance of the device must also be stored in the interface container.  */
     interface_ptr -> ux_interface_class_instance =  (VOID *) storage;
 
+#if defined(UX_HOST_CLASS_STORAGE_ADAPTIVE_POLL_ENABLE)
+
+    /* Remember when the device showed up, the media mounted from now on are timed from here.  */
+    storage -> ux_host_class_storage_presence_time =  _ux_utility_time_get();
+#endif
+
 #if defined(UX_HOST_STANDALONE)
 
     /* Check class,sub class, protocol.  */
@@ -196,6 +202,12 @@ UINT                    status;
         _ux_system_host ->  ux_system_host_change_function(UX_DEVICE_INSERTION, storage -> ux_host_class_storage_class, (VOID *) storage);
     }
 
+#if defined(UX_HOST_CLASS_STORAGE_ADAPTIVE_POLL_ENABLE)
+
+    /* Poll the new device fast, its media may not be ready yet.  */
+    _ux_host_class_storage_presence_recheck(storage);
+#endif
+
     /* If trace is enabled, insert this event into the trace buffer.  */
     UX_TRACE_IN_LINE_INSERT(UX_TRACE_HOST_CLASS_STORAGE_ACTIVATE, storage, 0, 0, 0, UX_TRACE_HOST_CLASS_EVENTS, 0, 0)
 
@@ -56,9 +56,12 @@
 /*                                                                        */ 
 /*  CALLS                                                                 */ 
 /*                                                                        */ 
+/*    ux_media_abort                        Abort media                   */ 
 /*    ux_media_close                        Close media                   */ 
 /*    _ux_host_stack_endpoint_transfer_abort Abort transfer request       */ 
 /*    _ux_host_stack_class_instance_destroy Destroy class instance        */ 
+/*    _ux_host_class_storage_media_resources_free                         */
+/*                                          Free media resources          */
 /*    _ux_utility_memory_free               Free memory block             */ 
 /*    _ux_host_semaphore_get                Get protection semaphore      */ 
 /*    _ux_host_semaphore_delete             Delete protection semaphore   */ 
@@ -102,7 +105,6 @@ UX_HOST_CLASS                   *class_inst;
 UINT                            inst_index;
 #if !defined(UX_HOST_CLASS_STORAGE_NO_FILEX)
 UX_MEDIA                        *media;
-VOID                            *memory;
 #endif
 
 
@@ -173,11 +175,17 @@ VOID                            *memory;
             if (storage_media -> ux_host_class_storage_media_status == UX_HOST_CLASS_STORAGE_MEDIA_MOUNTED)
             {
             
-                /* We preserve the memory used by this media.  */
-                memory =  storage_media -> ux_host_class_storage_media_memory;
+#if defined(UX_HOST_CLASS_STORAGE_FAST_REMOVAL_ENABLE)
+
+                /* The device is gone, nothing can be flushed to it. Ask UX_MEDIA (default FileX)
+                   to abort the partition: the open files are marked aborted and the threads
+                   waiting for the media are released at once.  */
+                ux_media_abort(media);
+#else
 
                 /* Ask UX_MEDIA (default FileX) to unmount the partition.  */
                 ux_media_close(media);
+#endif
 
                 /* This device is now unmounted.  */
                 storage_media -> ux_host_class_storage_media_status =  UX_HOST_CLASS_STORAGE_MEDIA_UNMOUNTED;
@@ -185,8 +193,8 @@ VOID                            *memory;
                 /* Reset the media ID.  */
                 ux_media_id_set(media, 0);
                                 
-                /* Free the memory block used for data transfer on behalf of UX_MEDIA (default FileX).  */
-                _ux_utility_memory_free(memory);
+                /* Free the memory used on behalf of UX_MEDIA (default FileX).  */
+                _ux_host_class_storage_media_resources_free(storage_media);
             }                
         }
 #else
@@ -116,7 +116,13 @@ VOID    _ux_host_class_storage_driver_entry(UX_MEDIA *media);
 /*    _ux_host_class_storage_sense_code_translate                         */
 /*                                          Translate error status codes  */
 /*    _ux_host_class_storage_media_read     Read sector(s)                */
+/*    _ux_host_class_storage_media_read_ahead                             */
+/*                                          Read sector(s) via read-ahead */
 /*    _ux_host_class_storage_media_write    Write sector(s)               */
+/*    _ux_host_class_storage_media_write_coalesce                         */
+/*                                          Write sector(s) via buffer    */
+/*    _ux_host_class_storage_media_write_flush                            */
+/*                                          Write pending sector(s)       */
 /*    _ux_host_semaphore_get                Get protection semaphore      */
 /*    _ux_host_semaphore_put                Release protection semaphore  */
 /*                                                                        */
@@ -204,12 +210,9 @@ ULONG                           partition_start;
     storage -> ux_host_class_storage_sector_size =
                 storage_media -> ux_host_class_storage_media_sector_size;
 
-#if defined(UX_HOST_CLASS_STORAGE_NO_FILEX)
-
     /* Restore current used last sector number.  */
     storage -> ux_host_class_storage_last_sector_number =
                 storage_media -> ux_host_class_storage_media_number_sectors - 1;
-#endif
 
     /* Look at the request specified by the FileX caller.  */
     switch (media -> fx_media_driver_request)
@@ -217,11 +220,31 @@ ULONG                           partition_start;
 
     case FX_DRIVER_READ:
 
+#if defined(UX_HOST_CLASS_STORAGE_WRITE_COALESCE_ENABLE)
+
+        /* Sectors pending in the write-coalescing buffer must reach the media before they are read.  */
+        status =  UX_SUCCESS;
+        if (_ux_host_class_storage_media_write_pending(storage_media,
+                                media -> fx_media_driver_logical_sector + partition_start,
+                                media -> fx_media_driver_sectors))
+            status =  _ux_host_class_storage_media_write_flush(storage, storage_media);
+        if (status == UX_SUCCESS)
+#endif
+#if defined(UX_HOST_CLASS_STORAGE_READ_AHEAD_ENABLE)
+
+        /* Read one or more sectors, through the read-ahead window.  */
+        status =  _ux_host_class_storage_media_read_ahead(storage, storage_media,
+                                media -> fx_media_driver_logical_sector + partition_start,
+                                media -> fx_media_driver_sectors,
+                                media -> fx_media_driver_buffer);
+#else
+
         /* Read one or more sectors.  */
         status =  _ux_host_class_storage_media_read(storage,
                                 media -> fx_media_driver_logical_sector + partition_start,
                                 media -> fx_media_driver_sectors,
                                 media -> fx_media_driver_buffer);
+#endif
 
         /* Check completion status.  */
         if (status == UX_SUCCESS)
@@ -243,11 +266,27 @@ ULONG                           partition_start;
 
     case FX_DRIVER_WRITE:
 
+#if defined(UX_HOST_CLASS_STORAGE_READ_AHEAD_ENABLE)
+
+        /* The read-ahead window may hold old content of these sectors.  */
+        _ux_host_class_storage_media_read_ahead_invalidate(storage_media);
+#endif
+
+#if defined(UX_HOST_CLASS_STORAGE_WRITE_COALESCE_ENABLE)
+
+        /* Write one or more sectors, through the write-coalescing buffer.  */
+        status =  _ux_host_class_storage_media_write_coalesce(storage, storage_media,
+                                media -> fx_media_driver_logical_sector + partition_start,
+                                media -> fx_media_driver_sectors,
+                                media -> fx_media_driver_buffer);
+#else
+
         /* Write one or more sectors.  */
         status =  _ux_host_class_storage_media_write(storage,
                                 media -> fx_media_driver_logical_sector + partition_start,
                                 media -> fx_media_driver_sectors,
                                 media -> fx_media_driver_buffer);
+#endif
 
         /* Check completion status.  */
         if (status == UX_SUCCESS)
@@ -269,14 +308,41 @@ ULONG                           partition_start;
 
     case FX_DRIVER_FLUSH:
 
+#if defined(UX_HOST_CLASS_STORAGE_WRITE_COALESCE_ENABLE)
+
+        /* Write the sectors pending in the write-coalescing buffer.  */
+        status =  _ux_host_class_storage_media_write_flush(storage, storage_media);
+
+        /* Check completion status.  */
+        if (status == UX_SUCCESS)
+            media -> fx_media_driver_status =  FX_SUCCESS;
+        else
+            media -> fx_media_driver_status =
+                _ux_host_class_storage_sense_code_translate(storage,status);
+#else
+
         /* Nothing to do. Just return a good status!  */
         media -> fx_media_driver_status =  FX_SUCCESS;
+#endif
         break;
 
 
     case FX_DRIVER_ABORT:
 
-        /* Nothing to do. Just return a good status!  */
+#if defined(UX_HOST_CLASS_STORAGE_READ_AHEAD_ENABLE)
+
+        /* Forget the content of the read-ahead window.  */
+        _ux_host_class_storage_media_read_ahead_invalidate(storage_media);
+#endif
+
+#if defined(UX_HOST_CLASS_STORAGE_WRITE_COALESCE_ENABLE)
+
+        /* Try to write the pending sectors, whatever the outcome they are dropped.  */
+        _ux_host_class_storage_media_write_flush(storage, storage_media);
+        _ux_host_class_storage_media_write_discard(storage_media);
+#endif
+
+        /* Nothing else to do. Just return a good status!  */
         media -> fx_media_driver_status =  FX_SUCCESS;
         break;
 
@@ -289,6 +355,18 @@ ULONG                           partition_start;
             _ux_host_class_storage_media_check(storage);
 #endif
 
+#if defined(UX_HOST_CLASS_STORAGE_READ_AHEAD_ENABLE)
+
+        /* Start with an empty read-ahead window.  */
+        _ux_host_class_storage_media_read_ahead_invalidate(storage_media);
+#endif
+
+#if defined(UX_HOST_CLASS_STORAGE_WRITE_COALESCE_ENABLE)
+
+        /* Start with an empty write-coalescing buffer.  */
+        _ux_host_class_storage_media_write_discard(storage_media);
+#endif
+
         /* Check for media protection.  We must do this operation here because FileX clears all the
            media fields before init.  */
         if (storage -> ux_host_class_storage_write_protected_media ==  UX_TRUE)
@@ -303,6 +381,12 @@ ULONG                           partition_start;
 
     case FX_DRIVER_UNINIT:
 
+#if defined(UX_HOST_CLASS_STORAGE_WRITE_COALESCE_ENABLE)
+
+        /* The media was flushed before, nothing can be pending anymore.  */
+        _ux_host_class_storage_media_write_discard(storage_media);
+#endif
+
         /* Nothing to do. Just return a good status!  */
         media -> fx_media_driver_status =  FX_SUCCESS;
         break;
@@ -310,6 +394,15 @@ ULONG                           partition_start;
 
     case FX_DRIVER_BOOT_READ:
 
+#if defined(UX_HOST_CLASS_STORAGE_WRITE_COALESCE_ENABLE)
+
+        /* The boot sector may be pending in the write-coalescing buffer.  */
+        status =  UX_SUCCESS;
+        if (_ux_host_class_storage_media_write_pending(storage_media, partition_start, 1))
+            status =  _ux_host_class_storage_media_write_flush(storage, storage_media);
+        if (status == UX_SUCCESS)
+#endif
+
         /* Read the media boot sector.  */
         status =  _ux_host_class_storage_media_read(storage,
                 partition_start, 1, media -> fx_media_driver_buffer);
@@ -334,6 +427,19 @@ ULONG                           partition_start;
 
     case FX_DRIVER_BOOT_WRITE:
 
+#if defined(UX_HOST_CLASS_STORAGE_READ_AHEAD_ENABLE)
+
+        /* The read-ahead window may hold old content of the boot sector.  */
+        _ux_host_class_storage_media_read_ahead_invalidate(storage_media);
+#endif
+
+#if defined(UX_HOST_CLASS_STORAGE_WRITE_COALESCE_ENABLE)
+
+        /* Keep the write order, the pending sectors go to the media before the boot sector.  */
+        status =  _ux_host_class_storage_media_write_flush(storage, storage_media);
+        if (status == UX_SUCCESS)
+#endif
+
         /* Write the boot sector.  */
         status =  _ux_host_class_storage_media_write(storage,
                 partition_start, 1, media -> fx_media_driver_buffer);
@@ -161,6 +161,22 @@ UX_HOST_CLASS_STORAGE_EXT   *class_ext;
                 return(UX_THREAD_ERROR);
             }
 
+#if defined(UX_HOST_CLASS_STORAGE_ADAPTIVE_POLL_ENABLE)
+
+            /* Create the semaphore used to wake up the storage class thread before its poll delay.  */
+            status =  _ux_host_semaphore_create(&class_ext -> ux_host_class_storage_poll_semaphore, "ux_host_storage_poll_semaphore", 0);
+            if (status != UX_SUCCESS)
+            {
+                _ux_host_thread_delete(&class_ext -> ux_host_class_thread);
+                _ux_utility_memory_free(class_ext);
+                class_inst -> ux_host_class_ext = UX_NULL;
+                return(UX_SEMAPHORE_ERROR);
+            }
+
+            /* Start with the fastest polling.  */
+            class_ext -> ux_host_class_storage_poll_delay =  UX_HOST_CLASS_STORAGE_THREAD_SLEEP_TIME_MIN;
+#endif
+
             /* Set thead ext ptr.  */
             UX_THREAD_EXTENSION_PTR_SET(&(class_ext -> ux_host_class_thread), class_inst);
 
@@ -183,7 +199,7 @@ UX_HOST_CLASS_STORAGE_EXT   *class_ext;
             * is checked outside of function.
             */
             class_inst -> ux_host_class_media =
-                    _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY,
+                    _ux_utility_memory_allocate(UX_NO_ALIGN, UX_HOST_CLASS_STORAGE_MEDIA_MEMORY,
                             UX_HOST_CLASS_STORAGE_MAX_MEDIA*sizeof(UX_HOST_CLASS_STORAGE_MEDIA));
 
             /* Check the completion status.  */
@@ -239,6 +255,12 @@ UX_HOST_CLASS_STORAGE_EXT   *class_ext;
             /* Delete storage thread.  */
             _ux_host_thread_delete(&class_ext -> ux_host_class_thread);
 
+#if defined(UX_HOST_CLASS_STORAGE_ADAPTIVE_POLL_ENABLE)
+
+            /* Delete the storage thread poll semaphore.  */
+            _ux_host_semaphore_delete(&class_ext -> ux_host_class_storage_poll_semaphore);
+#endif
+
             /* Free class extension memory.  */
             _ux_utility_memory_free(class_ext);
 
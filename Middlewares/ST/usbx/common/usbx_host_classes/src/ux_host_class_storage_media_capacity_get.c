@@ -183,10 +183,8 @@ ULONG           command_retry;
         if (storage -> ux_host_class_storage_sense_code == UX_SUCCESS)
         {
 
-#if defined(UX_HOST_CLASS_STORAGE_NO_FILEX)
             /* Save the number of sectors.  */
             storage -> ux_host_class_storage_last_sector_number = _ux_utility_long_get_big_endian(capacity_response + UX_HOST_CLASS_STORAGE_READ_CAPACITY_DATA_LBA);
-#endif
 
             /* The data is valid, save the sector size.  */
             storage -> ux_host_class_storage_sector_size =  _ux_utility_long_get_big_endian(capacity_response + UX_HOST_CLASS_STORAGE_READ_CAPACITY_DATA_SECTOR_SIZE);
@@ -57,11 +57,17 @@
 /*                                                                        */ 
 /*  CALLS                                                                 */ 
 /*                                                                        */ 
+/*    ux_media_cluster_bitmap_set           Supply cluster bitmap buffer  */
 /*    ux_media_open                         Media open                    */ 
 /*    _ux_host_class_storage_media_protection_check                       */
 /*                                          Check for protection          */ 
+/*    _ux_host_class_storage_media_read     Read the boot sector          */
+/*    _ux_utility_long_get                  Get 32-bit value              */
 /*    _ux_utility_memory_allocate           Allocate memory block         */ 
 /*    _ux_utility_memory_free               Free memory block             */
+/*    _ux_utility_short_get                 Get 16-bit value              */
+/*    _ux_host_class_storage_media_resources_free                         */
+/*                                          Free media resources          */
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
 /*                                                                        */ 
@@ -99,6 +105,14 @@ UINT                                media_index;
 UX_HOST_CLASS_STORAGE_MEDIA         *storage_media;
 UX_MEDIA                            *media;
 UX_HOST_CLASS                       *class_inst;
+ULONG                               memory_size;
+#if defined(UX_HOST_CLASS_STORAGE_MEDIA_CACHE_ENABLE)
+ULONG                               memory_reserved;
+#endif
+#if defined(UX_HOST_CLASS_STORAGE_CLUSTER_BITMAP_ENABLE)
+UCHAR                               *boot_sector;
+ULONG                               bitmap_size;
+#endif
     
 
     /* We need the class container.  */
@@ -130,6 +144,9 @@ UX_HOST_CLASS                       *class_inst;
             /* Save the Sector size in the storage media instance.  */
             storage_media -> ux_host_class_storage_media_sector_size =  storage -> ux_host_class_storage_sector_size;
 
+            /* Save the number of sectors of the LUN, each LUN has its own capacity.  */
+            storage_media -> ux_host_class_storage_media_number_sectors =  storage -> ux_host_class_storage_last_sector_number + 1;
+
             /* Check if media setting can support the sector size.  */
             if (storage -> ux_host_class_storage_sector_size > UX_HOST_CLASS_STORAGE_MEMORY_BUFFER_SIZE)
             {
@@ -149,26 +166,180 @@ UX_HOST_CLASS                       *class_inst;
                the media sector size (which should be 512 bytes). Because USB devices are SCSI 
                devices and there is a great deal of overhead when doing read/writes, it is better   
                to leave the default buffer size or even increase it. */
-            storage_media -> ux_host_class_storage_media_memory =  _ux_utility_memory_allocate(UX_SAFE_ALIGN, UX_CACHE_SAFE_MEMORY, UX_HOST_CLASS_STORAGE_MEMORY_BUFFER_SIZE);
+#if defined(UX_HOST_CLASS_STORAGE_MEDIA_CACHE_ENABLE)
+
+            /* The buffer is the sector cache of UX_MEDIA, start with the configured cache size but
+               do not go over the number of sectors FileX can cache.  */
+            memory_size =  UX_HOST_CLASS_STORAGE_MEDIA_CACHE_SIZE;
+            if (memory_size > FX_MAX_SECTOR_CACHE * storage -> ux_host_class_storage_sector_size)
+                memory_size =  FX_MAX_SECTOR_CACHE * storage -> ux_host_class_storage_sector_size;
+
+            /* Several media share the same pool, halve the cache until it fits in the free memory
+               while leaving room for the other buffers of this media.  */
+            memory_reserved =  0;
+#if defined(UX_HOST_CLASS_STORAGE_READ_AHEAD_ENABLE)
+            memory_reserved +=  UX_HOST_CLASS_STORAGE_READ_AHEAD_BUFFER_SIZE + UX_SAFE_ALIGN + sizeof(UX_MEMORY_BLOCK);
+#endif
+#if defined(UX_HOST_CLASS_STORAGE_WRITE_COALESCE_ENABLE)
+            memory_reserved +=  UX_HOST_CLASS_STORAGE_WRITE_COALESCE_BUFFER_SIZE + UX_SAFE_ALIGN + sizeof(UX_MEMORY_BLOCK);
+#endif
+            while ((memory_size > UX_HOST_CLASS_STORAGE_MEMORY_BUFFER_SIZE) &&
+                   (memory_size + memory_reserved + UX_SAFE_ALIGN + sizeof(UX_MEMORY_BLOCK) > _ux_system -> ux_system_cache_safe_memory_pool_free))
+                memory_size =  memory_size >> 1;
+            if (memory_size < UX_HOST_CLASS_STORAGE_MEMORY_BUFFER_SIZE)
+                memory_size =  UX_HOST_CLASS_STORAGE_MEMORY_BUFFER_SIZE;
+#else
+            memory_size =  UX_HOST_CLASS_STORAGE_MEMORY_BUFFER_SIZE;
+#endif
+            storage_media -> ux_host_class_storage_media_memory =  _ux_utility_memory_allocate(UX_SAFE_ALIGN, UX_CACHE_SAFE_MEMORY, memory_size);
             if (storage_media -> ux_host_class_storage_media_memory == UX_NULL)
                 return(UX_MEMORY_INSUFFICIENT);
 
+            /* Save the size of the sector cache.  */
+            storage_media -> ux_host_class_storage_media_memory_size =  memory_size;
+
+#if defined(UX_HOST_CLASS_STORAGE_READ_AHEAD_ENABLE)
+
+            /* Check if the read-ahead window can hold at least one sector.  */
+            if (storage -> ux_host_class_storage_sector_size > UX_HOST_CLASS_STORAGE_READ_AHEAD_BUFFER_SIZE)
+            {
+
+                /* Free the memory resources.  */
+                _ux_host_class_storage_media_resources_free(storage_media);
+
+                /* Error trap.  */
+                _ux_system_error_handler(UX_SYSTEM_LEVEL_THREAD, UX_SYSTEM_CONTEXT_CLASS, UX_HOST_CLASS_MEMORY_ERROR);
+
+                /* Required memory is over system setting.  */
+                return(UX_HOST_CLASS_MEMORY_ERROR);
+            }
+
+            /* Allocate the read-ahead window used for sequential reads.  */
+            storage_media -> ux_host_class_storage_media_read_ahead_buffer =  _ux_utility_memory_allocate(UX_SAFE_ALIGN, UX_CACHE_SAFE_MEMORY, UX_HOST_CLASS_STORAGE_READ_AHEAD_BUFFER_SIZE);
+            if (storage_media -> ux_host_class_storage_media_read_ahead_buffer == UX_NULL)
+            {
+
+                /* Free the memory resources.  */
+                _ux_host_class_storage_media_resources_free(storage_media);
+                return(UX_MEMORY_INSUFFICIENT);
+            }
+
+            /* The window is empty and statistics start from this media.  */
+            storage_media -> ux_host_class_storage_media_read_ahead_sectors =  0;
+            storage_media -> ux_host_class_storage_media_read_ahead_next_sector =  0;
+            storage_media -> ux_host_class_storage_media_read_ahead_hits =  0;
+            storage_media -> ux_host_class_storage_media_read_ahead_misses =  0;
+#endif
+
+#if defined(UX_HOST_CLASS_STORAGE_WRITE_COALESCE_ENABLE)
+
+            /* Check if the write-coalescing buffer can hold at least one sector.  */
+            if (storage -> ux_host_class_storage_sector_size > UX_HOST_CLASS_STORAGE_WRITE_COALESCE_BUFFER_SIZE)
+            {
+
+                /* Free the memory resources.  */
+                _ux_host_class_storage_media_resources_free(storage_media);
+
+                /* Error trap.  */
+                _ux_system_error_handler(UX_SYSTEM_LEVEL_THREAD, UX_SYSTEM_CONTEXT_CLASS, UX_HOST_CLASS_MEMORY_ERROR);
+
+                /* Required memory is over system setting.  */
+                return(UX_HOST_CLASS_MEMORY_ERROR);
+            }
+
+            /* Allocate the write-coalescing buffer used to merge adjacent writes.  */
+            storage_media -> ux_host_class_storage_media_write_buffer =  _ux_utility_memory_allocate(UX_SAFE_ALIGN, UX_CACHE_SAFE_MEMORY, UX_HOST_CLASS_STORAGE_WRITE_COALESCE_BUFFER_SIZE);
+            if (storage_media -> ux_host_class_storage_media_write_buffer == UX_NULL)
+            {
+
+                /* Free the memory resources.  */
+                _ux_host_class_storage_media_resources_free(storage_media);
+                return(UX_MEMORY_INSUFFICIENT);
+            }
+
+            /* Nothing is pending and statistics start from this media.  */
+            storage_media -> ux_host_class_storage_media_write_sectors =  0;
+            storage_media -> ux_host_class_storage_media_write_merges =  0;
+            storage_media -> ux_host_class_storage_media_write_flushes =  0;
+#endif
+
+#if defined(UX_HOST_CLASS_STORAGE_CLUSTER_BITMAP_ENABLE)
+
+            /* Give FileX a free cluster bitmap, one bit per cluster, if the volume is small enough and
+               the pool can hold it. FileX fills it in the FAT pass of the open. The clusters are bounded
+               by the sectors of the volume over the sectors per cluster of the boot sector, read into
+               the sector cache before FileX uses it. exFAT has no sectors per cluster there and keeps
+               its own allocation bitmap.  */
+            storage_media -> ux_host_class_storage_media_cluster_bitmap =  UX_NULL;
+            boot_sector =  (UCHAR *) storage_media -> ux_host_class_storage_media_memory;
+            if ((_ux_host_class_storage_media_read(storage, hidden_sectors, 1, boot_sector) == UX_SUCCESS) &&
+                (*(boot_sector + 0x0d) != 0))
+            {
+
+                /* Pickup the 16-bit sector count, or the 32-bit one if it is 0.  */
+                bitmap_size =  _ux_utility_short_get(boot_sector + 0x13);
+                if (bitmap_size == 0)
+                    bitmap_size =  _ux_utility_long_get(boot_sector + 0x20);
+                bitmap_size =  ((bitmap_size / *(boot_sector + 0x0d) + 2 + 31) >> 5) * sizeof(ULONG);
+                if (bitmap_size <= UX_HOST_CLASS_STORAGE_CLUSTER_BITMAP_SIZE_MAX)
+                {
+                    storage_media -> ux_host_class_storage_media_cluster_bitmap =  _ux_utility_memory_allocate(UX_SAFE_ALIGN, UX_CACHE_SAFE_MEMORY, bitmap_size);
+                    if (storage_media -> ux_host_class_storage_media_cluster_bitmap != UX_NULL)
+                        ux_media_cluster_bitmap_set(media, storage_media -> ux_host_class_storage_media_cluster_bitmap, bitmap_size);
+                }
+            }
+#endif
+
             /* If trace is enabled, insert this event into the trace buffer.  */
             UX_TRACE_IN_LINE_INSERT(UX_TRACE_HOST_CLASS_STORAGE_MEDIA_OPEN, storage, media, 0, 0, UX_TRACE_HOST_CLASS_EVENTS, 0, 0)
 
             /* Ask UX_MEDIA (default FileX) to mount the partition.  */
             status =  ux_media_open(media, UX_HOST_CLASS_STORAGE_MEDIA_NAME, _ux_host_class_storage_driver_entry,
                                         storage, storage_media -> ux_host_class_storage_media_memory, 
-                                        UX_HOST_CLASS_STORAGE_MEMORY_BUFFER_SIZE);
+                                        memory_size);
 
             /* If the media is mounted, update the status for the application.  */
             if (status == UX_SUCCESS)
+            {
                 storage_media -> ux_host_class_storage_media_status = UX_HOST_CLASS_STORAGE_MEDIA_MOUNTED;
+#if defined(UX_HOST_CLASS_STORAGE_CLUSTER_BITMAP_ENABLE)
+
+                /* Free the bitmap if FileX did not take it.  */
+                if ((storage_media -> ux_host_class_storage_media_cluster_bitmap != UX_NULL) &&
+                    (ux_media_cluster_bitmap_buffer_get(media) == UX_NULL))
+                {
+                    _ux_utility_memory_free(storage_media -> ux_host_class_storage_media_cluster_bitmap);
+                    storage_media -> ux_host_class_storage_media_cluster_bitmap =  UX_NULL;
+                }
+#endif
+#if defined(UX_HOST_CLASS_STORAGE_DIRECTORY_INDEX_ENABLE)
+
+                /* Give FileX a buffer for the name index of its most recently searched directories,
+                   if the pool can hold it. Otherwise directories are searched linearly.  */
+                storage_media -> ux_host_class_storage_media_directory_index =  _ux_utility_memory_allocate(UX_SAFE_ALIGN, UX_CACHE_SAFE_MEMORY,
+                                                                                                            UX_HOST_CLASS_STORAGE_DIRECTORY_INDEX_SIZE);
+                if ((storage_media -> ux_host_class_storage_media_directory_index != UX_NULL) &&
+                    (ux_media_directory_index_enable(media, storage_media -> ux_host_class_storage_media_directory_index,
+                                                     UX_HOST_CLASS_STORAGE_DIRECTORY_INDEX_SIZE) != UX_SUCCESS))
+                {
+                    _ux_utility_memory_free(storage_media -> ux_host_class_storage_media_directory_index);
+                    storage_media -> ux_host_class_storage_media_directory_index =  UX_NULL;
+                }
+#endif
+#if defined(UX_HOST_CLASS_STORAGE_ADAPTIVE_POLL_ENABLE)
+
+                /* Time stamp the media, from presence detected to mounted.  */
+                storage_media -> ux_host_class_storage_media_insert_time =  storage -> ux_host_class_storage_presence_time;
+                storage_media -> ux_host_class_storage_media_mount_time =  _ux_utility_time_get();
+#endif
+            }
 
             else
+            {
 
                 /* Free the memory resources.  */
-                _ux_utility_memory_free(storage_media -> ux_host_class_storage_media_memory);
+                _ux_host_class_storage_media_resources_free(storage_media);
+            }
 
             /* Return completion status.  */
             return(status);         
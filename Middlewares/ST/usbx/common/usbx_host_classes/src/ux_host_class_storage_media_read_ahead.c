@@ -0,0 +1,211 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Storage Class                                                       */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_class_storage.h"
+#include "ux_host_stack.h"
+
+
+#if defined(UX_HOST_CLASS_STORAGE_READ_AHEAD_ENABLE)
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_class_storage_media_read_ahead             PORTABLE C      */
+/*                                                           6.1.12       */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function reads one or more logical sectors from the media      */
+/*    through the read-ahead window of the storage media instance.        */
+/*                                                                        */
+/*    Sectors already in the window are copied without any transfer on    */
+/*    the bus. When a miss continues the previous read (sequential        */
+/*    access), a whole window starting at the requested sector is read    */
+/*    in a single command and the request is served from it. Other        */
+/*    misses, and requests as large as the window, are read directly      */
+/*    into the caller buffer when it is word aligned. Otherwise they are  */
+/*    read a window at a time into the window buffer and copied, so the   */
+/*    RX FIFO is always emptied a word at a time into an aligned buffer.  */
+/*    The window never covers sectors still pending in the write-         */
+/*    coalescing buffer, the media holds their old content.               */
+/*                                                                        */
+/*    The caller must own the storage instance lock and have restored     */
+/*    the LUN, sector size and last sector number of the media in the     */
+/*    storage instance.                                                   */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    storage                               Pointer to storage class      */
+/*    storage_media                         Pointer to storage media      */
+/*    sector_start                          Starting sector               */
+/*    sector_count                          Number of sectors to read     */
+/*    data_pointer                          Pointer to data to read       */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_host_class_storage_media_read     Read sector(s)                */
+/*    _ux_host_class_storage_media_write_flush                            */
+/*                                          Write buffered sector(s)      */
+/*    _ux_utility_memory_copy               Copy memory block             */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_host_class_storage_driver_entry   Storage driver entry          */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_host_class_storage_media_read_ahead(UX_HOST_CLASS_STORAGE *storage,
+                                    UX_HOST_CLASS_STORAGE_MEDIA *storage_media,
+                                    ULONG sector_start, ULONG sector_count, UCHAR *data_pointer)
+{
+
+UINT            status;
+ULONG           sector_size;
+ULONG           window_sectors;
+ULONG           window_start;
+ULONG           window_end;
+ULONG           bounce_sectors;
+
+
+    /* Get the sector size of the media.  */
+    sector_size =  storage -> ux_host_class_storage_sector_size;
+
+    /* Get the sectors currently held in the read-ahead window.  */
+    window_start =  storage_media -> ux_host_class_storage_media_read_ahead_sector;
+    window_end =  window_start + storage_media -> ux_host_class_storage_media_read_ahead_sectors;
+
+    /* Check if the whole request is inside the window.  */
+    if ((sector_start >= window_start) && (sector_start + sector_count <= window_end))
+    {
+
+        /* Copy the sectors from the window, no bus transfer is needed.  */
+        _ux_utility_memory_copy(data_pointer,
+                    storage_media -> ux_host_class_storage_media_read_ahead_buffer + (sector_start - window_start) * sector_size,
+                    sector_count * sector_size); /* Use case of memcpy is verified. */
+
+        /* One more hit.  */
+        storage_media -> ux_host_class_storage_media_read_ahead_hits++;
+
+        /* Remember where the next sequential read should start.  */
+        storage_media -> ux_host_class_storage_media_read_ahead_next_sector =  sector_start + sector_count;
+        return(UX_SUCCESS);
+    }
+
+    /* The window cannot serve this request.  */
+    storage_media -> ux_host_class_storage_media_read_ahead_misses++;
+
+    /* Compute the number of sectors the window holds.  */
+    window_sectors =  UX_HOST_CLASS_STORAGE_READ_AHEAD_BUFFER_SIZE / sector_size;
+
+    /* Do not read ahead past the last sector of the media.  */
+    if (sector_start > storage -> ux_host_class_storage_last_sector_number)
+        window_sectors =  0;
+    else if (window_sectors > storage -> ux_host_class_storage_last_sector_number - sector_start + 1)
+        window_sectors =  storage -> ux_host_class_storage_last_sector_number - sector_start + 1;
+
+#if defined(UX_HOST_CLASS_STORAGE_WRITE_COALESCE_ENABLE)
+
+    /* The media still holds the old content of the sectors pending in the write-coalescing buffer.  */
+    if (_ux_host_class_storage_media_write_pending(storage_media, sector_start, window_sectors))
+    {
+
+        /* Stop the window before the pending sectors if they follow the request.  */
+        if (storage_media -> ux_host_class_storage_media_write_sector > sector_start)
+            window_sectors =  storage_media -> ux_host_class_storage_media_write_sector - sector_start;
+        else
+        {
+
+            /* Otherwise they must reach the media before it is read.  */
+            status =  _ux_host_class_storage_media_write_flush(storage, storage_media);
+            if (status != UX_SUCCESS)
+                return(status);
+        }
+    }
+#endif
+
+    /* Read ahead only if the access is sequential and the window holds more than the request.  */
+    if ((sector_start != storage_media -> ux_host_class_storage_media_read_ahead_next_sector) ||
+        (sector_count >= window_sectors))
+    {
+
+        /* The next sequential read starts after this one.  */
+        storage_media -> ux_host_class_storage_media_read_ahead_next_sector =  sector_start + sector_count;
+
+        /* Read the sectors directly into a word aligned caller buffer.  */
+        if (((ALIGN_TYPE) data_pointer & 3U) == 0U)
+            return(_ux_host_class_storage_media_read(storage, sector_start, sector_count, data_pointer));
+
+        /* Otherwise bounce them through the window buffer, its content is replaced.  */
+        storage_media -> ux_host_class_storage_media_read_ahead_sectors =  0;
+        while (sector_count != 0)
+        {
+
+            /* Read at most a window of sectors.  */
+            bounce_sectors =  UX_MIN(sector_count, UX_HOST_CLASS_STORAGE_READ_AHEAD_BUFFER_SIZE / sector_size);
+            status =  _ux_host_class_storage_media_read(storage, sector_start, bounce_sectors,
+                                            storage_media -> ux_host_class_storage_media_read_ahead_buffer);
+            if (status != UX_SUCCESS)
+                return(status);
+
+            /* Copy them to the caller buffer.  */
+            _ux_utility_memory_copy(data_pointer, storage_media -> ux_host_class_storage_media_read_ahead_buffer,
+                            bounce_sectors * sector_size); /* Use case of memcpy is verified. */
+            data_pointer +=  bounce_sectors * sector_size;
+            sector_start +=  bounce_sectors;
+            sector_count -=  bounce_sectors;
+        }
+        return(UX_SUCCESS);
+    }
+
+    /* The window content is going to be replaced.  */
+    storage_media -> ux_host_class_storage_media_read_ahead_sectors =  0;
+
+    /* Fill the window with a single read.  */
+    status =  _ux_host_class_storage_media_read(storage, sector_start, window_sectors,
+                                    storage_media -> ux_host_class_storage_media_read_ahead_buffer);
+    if (status != UX_SUCCESS)
+        return(status);
+
+    /* The window is valid.  */
+    storage_media -> ux_host_class_storage_media_read_ahead_sector =  sector_start;
+    storage_media -> ux_host_class_storage_media_read_ahead_sectors =  window_sectors;
+
+    /* Serve the request from the window.  */
+    _ux_utility_memory_copy(data_pointer, storage_media -> ux_host_class_storage_media_read_ahead_buffer,
+                    sector_count * sector_size); /* Use case of memcpy is verified. */
+
+    /* Remember where the next sequential read should start.  */
+    storage_media -> ux_host_class_storage_media_read_ahead_next_sector =  sector_start + sector_count;
+
+    /* Return completion status.  */
+    return(UX_SUCCESS);
+}
+#endif
@@ -0,0 +1,120 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Storage Class                                                       */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_class_storage.h"
+#include "ux_host_stack.h"
+
+
+
+#if !defined(UX_HOST_CLASS_STORAGE_NO_FILEX)
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_class_storage_media_resources_free         PORTABLE C      */
+/*                                                           6.1.12       */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function frees the memory allocated for a storage media        */
+/*    instance when its UX_MEDIA (default FileX) was opened: the sector   */
+/*    cache, the read-ahead window, the write-coalescing buffer, the free */
+/*    cluster bitmap and the directory index. Sectors still pending in    */
+/*    the write-coalescing buffer are dropped.                            */
+/*                                                                        */
+/*    The UX_MEDIA must be closed or aborted, or its open must have       */
+/*    failed. Resources not allocated are skipped.                        */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    storage_media                         Pointer to storage media      */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_utility_memory_free               Free memory block             */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_host_class_storage_deactivate     Deactivate storage class      */
+/*    _ux_host_class_storage_media_open     Open storage media            */
+/*    _ux_host_class_storage_thread_entry   Storage class thread          */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_host_class_storage_media_resources_free(UX_HOST_CLASS_STORAGE_MEDIA *storage_media)
+{
+
+    /* Free the memory block used for data transfer on behalf of UX_MEDIA (default FileX).  */
+    if (storage_media -> ux_host_class_storage_media_memory != UX_NULL)
+    {
+        _ux_utility_memory_free(storage_media -> ux_host_class_storage_media_memory);
+        storage_media -> ux_host_class_storage_media_memory =  UX_NULL;
+    }
+#if defined(UX_HOST_CLASS_STORAGE_READ_AHEAD_ENABLE)
+
+    /* Free the read-ahead window.  */
+    if (storage_media -> ux_host_class_storage_media_read_ahead_buffer != UX_NULL)
+    {
+        _ux_host_class_storage_media_read_ahead_invalidate(storage_media);
+        _ux_utility_memory_free(storage_media -> ux_host_class_storage_media_read_ahead_buffer);
+        storage_media -> ux_host_class_storage_media_read_ahead_buffer =  UX_NULL;
+    }
+#endif
+#if defined(UX_HOST_CLASS_STORAGE_WRITE_COALESCE_ENABLE)
+
+    /* Free the write-coalescing buffer, the sectors still pending are lost.  */
+    if (storage_media -> ux_host_class_storage_media_write_buffer != UX_NULL)
+    {
+        _ux_host_class_storage_media_write_discard(storage_media);
+        _ux_utility_memory_free(storage_media -> ux_host_class_storage_media_write_buffer);
+        storage_media -> ux_host_class_storage_media_write_buffer =  UX_NULL;
+    }
+#endif
+#if defined(UX_HOST_CLASS_STORAGE_CLUSTER_BITMAP_ENABLE)
+
+    /* Free the free cluster bitmap.  */
+    if (storage_media -> ux_host_class_storage_media_cluster_bitmap != UX_NULL)
+    {
+        _ux_utility_memory_free(storage_media -> ux_host_class_storage_media_cluster_bitmap);
+        storage_media -> ux_host_class_storage_media_cluster_bitmap =  UX_NULL;
+    }
+#endif
+#if defined(UX_HOST_CLASS_STORAGE_DIRECTORY_INDEX_ENABLE)
+
+    /* Free the directory index.  */
+    if (storage_media -> ux_host_class_storage_media_directory_index != UX_NULL)
+    {
+        _ux_utility_memory_free(storage_media -> ux_host_class_storage_media_directory_index);
+        storage_media -> ux_host_class_storage_media_directory_index =  UX_NULL;
+    }
+#endif
+}
+#endif
@@ -0,0 +1,142 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Storage Class                                                       */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_class_storage.h"
+#include "ux_host_stack.h"
+
+
+
+#if defined(UX_HOST_CLASS_STORAGE_WRITE_COALESCE_ENABLE)
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_class_storage_media_write_coalesce         PORTABLE C      */
+/*                                                           6.1.12       */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function writes one or more logical sectors to the media       */
+/*    through the write-coalescing buffer of the storage media instance.  */
+/*                                                                        */
+/*    A write that is contiguous with, or overlaps, the sectors pending   */
+/*    in the buffer is merged into them as long as the buffer can hold    */
+/*    the result. Otherwise the pending sectors are written to the media  */
+/*    with a single command first. A write as large as the buffer goes    */
+/*    directly to the media.                                              */
+/*                                                                        */
+/*    Pending sectors reach the media only when they are flushed, the     */
+/*    caller must flush the buffer to make the data durable.              */
+/*                                                                        */
+/*    The caller must own the storage instance lock and have restored     */
+/*    the LUN and sector size of the media in the storage instance.       */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    storage                               Pointer to storage class      */
+/*    storage_media                         Pointer to storage media      */
+/*    sector_start                          Starting sector               */
+/*    sector_count                          Number of sectors to write    */
+/*    data_pointer                          Pointer to data to write      */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_host_class_storage_media_write    Write sector(s)               */
+/*    _ux_host_class_storage_media_write_flush                            */
+/*                                          Write pending sector(s)       */
+/*    _ux_utility_memory_copy               Copy memory block             */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_host_class_storage_driver_entry   Storage driver entry          */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_host_class_storage_media_write_coalesce(UX_HOST_CLASS_STORAGE *storage,
+                                    UX_HOST_CLASS_STORAGE_MEDIA *storage_media,
+                                    ULONG sector_start, ULONG sector_count, UCHAR *data_pointer)
+{
+
+UINT            status;
+ULONG           sector_size;
+ULONG           buffer_sectors;
+ULONG           pending_start;
+ULONG           pending_end;
+
+
+    /* Get the sector size of the media.  */
+    sector_size =  storage -> ux_host_class_storage_sector_size;
+
+    /* Compute the number of sectors the buffer holds.  */
+    buffer_sectors =  UX_HOST_CLASS_STORAGE_WRITE_COALESCE_BUFFER_SIZE / sector_size;
+
+    /* Get the sectors pending in the buffer.  */
+    pending_start =  storage_media -> ux_host_class_storage_media_write_sector;
+    pending_end =  pending_start + storage_media -> ux_host_class_storage_media_write_sectors;
+
+    /* Check if the write can be merged with the pending sectors.  */
+    if ((storage_media -> ux_host_class_storage_media_write_sectors != 0) &&
+        (sector_start >= pending_start) && (sector_start <= pending_end) &&
+        (sector_start + sector_count - pending_start <= buffer_sectors))
+    {
+
+        /* Merge the sectors into the buffer, newer data replaces the overlapped sectors.  */
+        _ux_utility_memory_copy(storage_media -> ux_host_class_storage_media_write_buffer + (sector_start - pending_start) * sector_size,
+                    data_pointer, sector_count * sector_size); /* Use case of memcpy is verified. */
+
+        /* Extend the pending sectors if the write goes past them.  */
+        if (sector_start + sector_count > pending_end)
+            storage_media -> ux_host_class_storage_media_write_sectors =  sector_start + sector_count - pending_start;
+
+        /* One more write saved on the bus.  */
+        storage_media -> ux_host_class_storage_media_write_merges++;
+        return(UX_SUCCESS);
+    }
+
+    /* The pending sectors must reach the media before this write.  */
+    status =  _ux_host_class_storage_media_write_flush(storage, storage_media);
+    if (status != UX_SUCCESS)
+        return(status);
+
+    /* A write as large as the buffer is not worth buffering.  */
+    if (sector_count >= buffer_sectors)
+        return(_ux_host_class_storage_media_write(storage, sector_start, sector_count, data_pointer));
+
+    /* Start a new run of pending sectors with this write.  */
+    _ux_utility_memory_copy(storage_media -> ux_host_class_storage_media_write_buffer,
+                    data_pointer, sector_count * sector_size); /* Use case of memcpy is verified. */
+    storage_media -> ux_host_class_storage_media_write_sector =  sector_start;
+    storage_media -> ux_host_class_storage_media_write_sectors =  sector_count;
+
+    /* Return completion status.  */
+    return(UX_SUCCESS);
+}
+#endif
@@ -0,0 +1,104 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Storage Class                                                       */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_class_storage.h"
+#include "ux_host_stack.h"
+
+
+
+#if defined(UX_HOST_CLASS_STORAGE_WRITE_COALESCE_ENABLE)
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_class_storage_media_write_flush            PORTABLE C      */
+/*                                                           6.1.12       */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function writes the sectors pending in the write-coalescing    */
+/*    buffer of the storage media instance to the media, with a single    */
+/*    command. If the write fails the sectors stay pending.               */
+/*                                                                        */
+/*    The caller must own the storage instance lock and have restored     */
+/*    the LUN and sector size of the media in the storage instance.       */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    storage                               Pointer to storage class      */
+/*    storage_media                         Pointer to storage media      */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_host_class_storage_media_write    Write sector(s)               */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_host_class_storage_driver_entry   Storage driver entry          */
+/*    _ux_host_class_storage_media_write_coalesce                         */
+/*                                          Write sector(s) via buffer    */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_host_class_storage_media_write_flush(UX_HOST_CLASS_STORAGE *storage,
+                                    UX_HOST_CLASS_STORAGE_MEDIA *storage_media)
+{
+
+UINT            status;
+
+
+    /* Check if there is anything to write.  */
+    if (storage_media -> ux_host_class_storage_media_write_sectors == 0)
+        return(UX_SUCCESS);
+
+#if defined(UX_HOST_CLASS_STORAGE_READ_AHEAD_ENABLE)
+
+    /* The read-ahead window may hold the old content of the pending sectors.  */
+    _ux_host_class_storage_media_read_ahead_invalidate(storage_media);
+#endif
+
+    /* Write all the pending sectors at once.  */
+    status =  _ux_host_class_storage_media_write(storage,
+                                    storage_media -> ux_host_class_storage_media_write_sector,
+                                    storage_media -> ux_host_class_storage_media_write_sectors,
+                                    storage_media -> ux_host_class_storage_media_write_buffer);
+
+    /* The buffer is empty once the sectors are on the media.  */
+    if (status == UX_SUCCESS)
+    {
+        storage_media -> ux_host_class_storage_media_write_sectors =  0;
+        storage_media -> ux_host_class_storage_media_write_flushes++;
+    }
+
+    /* Return completion status.  */
+    return(status);
+}
+#endif
@@ -0,0 +1,86 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Storage Class                                                       */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_class_storage.h"
+#include "ux_host_stack.h"
+
+
+
+#if defined(UX_HOST_CLASS_STORAGE_ADAPTIVE_POLL_ENABLE)
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_class_storage_presence_recheck             PORTABLE C      */
+/*                                                           6.1.12       */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function asks the storage class thread to check the media      */
+/*    presence of all the storage instances now, and to go back to the    */
+/*    fastest polling rate. It is used after the enumeration of a new     */
+/*    storage device and when a transfer fails with a NOT READY or UNIT   */
+/*    ATTENTION sense key.                                                */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    storage                               Pointer to storage class      */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_host_semaphore_put                Release poll semaphore        */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_host_class_storage_activate       Activate storage class        */
+/*    _ux_host_class_storage_sense_code_translate                         */
+/*                                          Translate error status codes  */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_host_class_storage_presence_recheck(UX_HOST_CLASS_STORAGE *storage)
+{
+
+UX_HOST_CLASS_STORAGE_EXT       *class_ext;
+
+
+    /* Get the storage class extension, where the class thread polling state is.  */
+    class_ext =  (UX_HOST_CLASS_STORAGE_EXT *) storage -> ux_host_class_storage_class -> ux_host_class_ext;
+    if (class_ext == UX_NULL)
+        return;
+
+    /* Poll at the fastest rate again.  */
+    class_ext -> ux_host_class_storage_poll_delay =  UX_HOST_CLASS_STORAGE_THREAD_SLEEP_TIME_MIN;
+
+    /* Wake up the class thread.  */
+    _ux_host_semaphore_put(&class_ext -> ux_host_class_storage_poll_semaphore);
+}
+#endif
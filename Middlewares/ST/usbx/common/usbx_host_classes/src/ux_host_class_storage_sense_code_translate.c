@@ -56,7 +56,8 @@
 /*                                                                        */ 
 /*  CALLS                                                                 */ 
 /*                                                                        */ 
-/*    None                                                                */ 
+/*    _ux_host_class_storage_presence_recheck                             */
+/*                                          Recheck media presence now    */
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
 /*                                                                        */ 
@@ -74,7 +75,17 @@
 UINT  _ux_host_class_storage_sense_code_translate(UX_HOST_CLASS_STORAGE *storage, UINT status)
 {
 
+#if defined(UX_HOST_CLASS_STORAGE_ADAPTIVE_POLL_ENABLE)
+
+    /* A media that is not ready or has changed is a job for the class thread,
+       do not wait for the next poll to find it out.  */
+    if ((status != UX_SUCCESS) &&
+        (((storage -> ux_host_class_storage_sense_code >> 16) == UX_HOST_CLASS_STORAGE_SENSE_KEY_NOT_READY) ||
+         ((storage -> ux_host_class_storage_sense_code >> 16) == UX_HOST_CLASS_STORAGE_SENSE_KEY_UNIT_ATTENTION)))
+        _ux_host_class_storage_presence_recheck(storage);
+#else
     UX_PARAMETER_NOT_USED(storage);
+#endif
 
     /* Return status.  */
     return(status);
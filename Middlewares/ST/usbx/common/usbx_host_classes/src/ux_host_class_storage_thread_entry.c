@@ -70,7 +70,8 @@
 /*                                          Get media characteristics     */
 /*    _ux_host_class_storage_media_format_capacity_get                    */
 /*                                          Get media format capacity     */
-/*    _ux_utility_memory_free               Free memory block             */
+/*    _ux_host_class_storage_media_resources_free                         */
+/*                                          Free media resources          */
 /*    _ux_host_semaphore_get                Get a semaphore               */
 /*    _ux_host_semaphore_put                Put a semaphore               */
 /*    _ux_utility_delay_ms                  Thread sleep                  */
@@ -112,7 +113,9 @@ UX_HOST_CLASS_STORAGE_MEDIA     *storage_media;
 UINT                            media_index;
 #if !defined(UX_HOST_CLASS_STORAGE_NO_FILEX)
 UX_MEDIA                        *media;
-UCHAR                           *memory;
+#endif
+#if defined(UX_HOST_CLASS_STORAGE_ADAPTIVE_POLL_ENABLE)
+UX_HOST_CLASS_STORAGE_EXT       *class_ext;
 #endif
 
 
@@ -123,8 +126,38 @@ UCHAR                           *memory;
     while(1)
     {
 
+#if defined(UX_HOST_CLASS_STORAGE_ADAPTIVE_POLL_ENABLE)
+
+        /* Get the class extension with the polling state.  */
+        class_ext =  (UX_HOST_CLASS_STORAGE_EXT *) class_inst -> ux_host_class_ext;
+
+        /* Wait for the poll delay, or less if the presence must be checked now.  */
+        status =  _ux_host_semaphore_get(&class_ext -> ux_host_class_storage_poll_semaphore,
+                                UX_MS_TO_TICK_NON_ZERO(class_ext -> ux_host_class_storage_poll_delay));
+        if (status == UX_SUCCESS)
+        {
+
+            /* A recheck was requested. This poll serves all the requests made so far, drop the
+               ones still counted so they do not cause extra polls.  */
+            while (_ux_host_semaphore_get(&class_ext -> ux_host_class_storage_poll_semaphore, UX_NO_WAIT) == UX_SUCCESS)
+                ;
+
+            /* Keep polling at the fastest rate after the recheck.  */
+            class_ext -> ux_host_class_storage_poll_delay =  UX_HOST_CLASS_STORAGE_THREAD_SLEEP_TIME_MIN;
+        }
+        else
+        {
+
+            /* Back off while nothing changes, a media change brings the delay down again.  */
+            class_ext -> ux_host_class_storage_poll_delay =  class_ext -> ux_host_class_storage_poll_delay << 1;
+            if (class_ext -> ux_host_class_storage_poll_delay > UX_HOST_CLASS_STORAGE_THREAD_SLEEP_TIME_MAX)
+                class_ext -> ux_host_class_storage_poll_delay =  UX_HOST_CLASS_STORAGE_THREAD_SLEEP_TIME_MAX;
+        }
+#else
+
         /* We need to wake every 2 seconds or so.  */
         _ux_utility_delay_ms(UX_HOST_CLASS_STORAGE_THREAD_SLEEP_TIME);
+#endif
 
         /* We need to parse all the storage instances and check for a removable
            media flag.  */
@@ -197,9 +230,6 @@ UCHAR                           *memory;
                                     (storage_media -> ux_host_class_storage_media_lun == storage -> ux_host_class_storage_lun))
                                 {
 
-                                    /* We preserve the memory used by this media.  */
-                                    memory =  storage_media -> ux_host_class_storage_media_memory;
-
                                     /* Let UX_MEDIA (default FileX) use this instance.  */
                                     _ux_host_semaphore_put(&storage -> ux_host_class_storage_semaphore);
 
@@ -211,14 +241,28 @@ UCHAR                           *memory;
 
                                     /* Reset the media ID.  */
                                     ux_media_id_set(media, 0);
+#if defined(UX_HOST_CLASS_STORAGE_ADAPTIVE_POLL_ENABLE)
+
+                                    /* The media is gone, poll fast for the next one.  */
+                                    class_ext -> ux_host_class_storage_poll_delay =  UX_HOST_CLASS_STORAGE_THREAD_SLEEP_TIME_MIN;
+
+                                    /* Invoke callback for media removal.  */
+                                    if (_ux_system_host -> ux_system_host_change_function != UX_NULL)
+                                    {
+
+                                        /* Call system change function.  */
+                                        _ux_system_host ->  ux_system_host_change_function(UX_STORAGE_MEDIA_REMOVAL,
+                                                            storage -> ux_host_class_storage_class, (VOID *) storage_media);
+                                    }
+#endif
 
                                     /* Now, we protect the storage instance.  */
                                     status =  _ux_host_semaphore_get(&storage -> ux_host_class_storage_semaphore, UX_WAIT_FOREVER);
                                     if (status != UX_SUCCESS)
                                         break;
 
-                                    /* Free the memory block used for data transfer on behalf of UX_MEDIA (default FileX).  */
-                                    _ux_utility_memory_free(memory);
+                                    /* Free the memory used on behalf of UX_MEDIA (default FileX).  */
+                                    _ux_host_class_storage_media_resources_free(storage_media);
                                 }
 #else
 
@@ -274,9 +318,6 @@ UCHAR                           *memory;
                                             (storage_media -> ux_host_class_storage_media_lun == storage -> ux_host_class_storage_lun))
                                     {
 
-                                        /* We preserve the memory used by this media.  */
-                                        memory =  storage_media -> ux_host_class_storage_media_memory;
-
                                         /* Let UX_MEDIA (default FileX) use this instance.  */
                                         _ux_host_semaphore_put(&storage -> ux_host_class_storage_semaphore);
 
@@ -288,14 +329,28 @@ UCHAR                           *memory;
 
                                         /* Reset the media ID.  */
                                         ux_media_id_set(media, 0);
+#if defined(UX_HOST_CLASS_STORAGE_ADAPTIVE_POLL_ENABLE)
+
+                                        /* The media changed, poll fast until it settles.  */
+                                        class_ext -> ux_host_class_storage_poll_delay =  UX_HOST_CLASS_STORAGE_THREAD_SLEEP_TIME_MIN;
+
+                                        /* Invoke callback for media removal.  */
+                                        if (_ux_system_host -> ux_system_host_change_function != UX_NULL)
+                                        {
+
+                                            /* Call system change function.  */
+                                            _ux_system_host ->  ux_system_host_change_function(UX_STORAGE_MEDIA_REMOVAL,
+                                                                storage -> ux_host_class_storage_class, (VOID *) storage_media);
+                                        }
+#endif
 
                                         /* Now, we protect the storage instance.  */
                                         status =  _ux_host_semaphore_get(&storage -> ux_host_class_storage_semaphore, UX_WAIT_FOREVER);
                                         if (status != UX_SUCCESS)
                                             break;
 
-                                        /* Free the memory block used for data transfer on behalf of FileX.  */
-                                        _ux_utility_memory_free(memory);
+                                        /* Free the memory used on behalf of UX_MEDIA (default FileX).  */
+                                        _ux_host_class_storage_media_resources_free(storage_media);
                                     }
 #else
 
@@ -345,6 +400,12 @@ UCHAR                           *memory;
                                 if (storage -> ux_host_class_storage_sense_code == 0)
                                 {
 
+#if defined(UX_HOST_CLASS_STORAGE_ADAPTIVE_POLL_ENABLE)
+
+                                    /* The media is present, the time to mount it is measured from here.  */
+                                    storage -> ux_host_class_storage_presence_time =  _ux_utility_time_get();
+#endif
+
                                     /* Get the media type supported by this storage device.  */
                                     status =  _ux_host_class_storage_media_characteristics_get(storage);
                                     if (status != UX_SUCCESS)
@@ -362,6 +423,34 @@ UCHAR                           *memory;
 
                                     /* The device seems to have been inserted, try to mount it.  */
                                     _ux_host_class_storage_media_mount(storage, 0);
+#if defined(UX_HOST_CLASS_STORAGE_ADAPTIVE_POLL_ENABLE)
+
+                                    /* A new media, poll fast until it settles.  */
+                                    class_ext -> ux_host_class_storage_poll_delay =  UX_HOST_CLASS_STORAGE_THREAD_SLEEP_TIME_MIN;
+
+                                    /* Find the media mounted for this LUN.  */
+                                    storage_media =  (UX_HOST_CLASS_STORAGE_MEDIA *) class_inst -> ux_host_class_media;
+                                    for (media_index = 0; media_index < UX_HOST_CLASS_STORAGE_MAX_MEDIA;
+                                        storage_media ++, media_index ++)
+                                    {
+
+                                        /* Check for the storage instance, lun number and mounted status.  */
+                                        media =  &storage_media -> ux_host_class_storage_media;
+                                        if ((ux_media_driver_info_get(media) != (VOID *) storage) ||
+                                            (storage_media -> ux_host_class_storage_media_lun != storage -> ux_host_class_storage_lun) ||
+                                            (storage_media -> ux_host_class_storage_media_status != UX_HOST_CLASS_STORAGE_MEDIA_MOUNTED))
+                                            continue;
+
+                                        /* Invoke callback for media insertion, the media carries its time stamps.  */
+                                        if (_ux_system_host -> ux_system_host_change_function != UX_NULL)
+                                        {
+
+                                            /* Call system change function.  */
+                                            _ux_system_host ->  ux_system_host_change_function(UX_STORAGE_MEDIA_INSERTION,
+                                                                storage -> ux_host_class_storage_class, (VOID *) storage_media);
+                                        }
+                                    }
+#endif
 #else
 
                                     /* Find a free media slot for inserted media.  */
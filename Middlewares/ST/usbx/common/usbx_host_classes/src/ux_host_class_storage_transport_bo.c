@@ -93,6 +93,7 @@ UCHAR           *cbw;
 UINT            retry;
 ULONG           data_phase_requested_length;
 ULONG           data_phase_transfer_size;
+ULONG           data_phase_max_length;
 UCHAR           *get_status_response;
 
 
@@ -148,6 +149,13 @@ UCHAR           *get_status_response;
             /* Jump to the data stage.  */
             break;
 
+#if defined(UX_HOST_CLASS_STORAGE_FAST_REMOVAL_ENABLE)
+
+        /* The device is gone, there is nothing to recover.  */
+        if (transfer_request -> ux_transfer_request_completion_code == UX_TRANSFER_DEVICE_REMOVED)
+            return(UX_TRANSFER_DEVICE_REMOVED);
+#endif /* UX_HOST_CLASS_STORAGE_FAST_REMOVAL_ENABLE */
+
         /* The transfer stalled. Is this the first time?  */
         if (retry == 0)
         {
@@ -172,15 +180,43 @@ UCHAR           *get_status_response;
     /* Reset the data phase memory size.  */
     storage -> ux_host_class_storage_data_phase_length =  0;
 
+#if defined(UX_HOST_CLASS_STORAGE_LARGE_TRANSFER_ENABLE)
+
+    /* Get the data phase size limit set for this instance.  */
+    data_phase_max_length =  storage -> ux_host_class_storage_max_transfer_size;
+
+    /* If there is no limit set, the data phase is only split when it does not fit
+       in a single transfer request of the data endpoint.  */
+    if (data_phase_max_length == 0)
+    {
+
+        /* Check the direction and determine which endpoint is used.  */
+        if (*(cbw + UX_HOST_CLASS_STORAGE_CBW_FLAGS) == UX_HOST_CLASS_STORAGE_DATA_IN)
+            data_phase_max_length =  storage -> ux_host_class_storage_bulk_in_endpoint ->
+                                        ux_endpoint_transfer_request.ux_transfer_request_maximum_length;
+        else
+            data_phase_max_length =  storage -> ux_host_class_storage_bulk_out_endpoint ->
+                                        ux_endpoint_transfer_request.ux_transfer_request_maximum_length;
+
+        /* The controller did not report a limit, keep the default one.  */
+        if (data_phase_max_length == 0)
+            data_phase_max_length =  UX_HOST_CLASS_STORAGE_MAX_TRANSFER_SIZE;
+    }
+#else
+
+    /* The data phase is split into chunks of fixed size.  */
+    data_phase_max_length =  UX_HOST_CLASS_STORAGE_MAX_TRANSFER_SIZE;
+#endif
+
     /* Perform the data stage - if there is any.  */
     while (data_phase_requested_length != 0)
     {
 
         /* Check if we can finish the transaction with one data phase.  */
-        if (data_phase_requested_length > UX_HOST_CLASS_STORAGE_MAX_TRANSFER_SIZE)
+        if (data_phase_requested_length > data_phase_max_length)
 
             /* We have too much data to send in one phase. Split into smaller chunks.  */
-            data_phase_transfer_size =  UX_HOST_CLASS_STORAGE_MAX_TRANSFER_SIZE;
+            data_phase_transfer_size =  data_phase_max_length;
 
         else
 
@@ -232,6 +268,13 @@ UCHAR           *get_status_response;
         if (transfer_request -> ux_transfer_request_completion_code != UX_SUCCESS)
         {
 
+#if defined(UX_HOST_CLASS_STORAGE_FAST_REMOVAL_ENABLE)
+
+            /* The device is gone, there is nothing to recover.  */
+            if (transfer_request -> ux_transfer_request_completion_code == UX_TRANSFER_DEVICE_REMOVED)
+                return(UX_TRANSFER_DEVICE_REMOVED);
+#endif /* UX_HOST_CLASS_STORAGE_FAST_REMOVAL_ENABLE */
+
             /* This is most likely a STALL. We must clear it and go straight
                to reading the CSW. Note this doesn't necessarily mean the transfer
                failed completely failed. For example, if this was a read, it
@@ -381,6 +424,13 @@ UCHAR           *get_status_response;
             return(UX_SUCCESS);
         }
 
+#if defined(UX_HOST_CLASS_STORAGE_FAST_REMOVAL_ENABLE)
+
+        /* The device is gone, there is nothing to recover.  */
+        if (transfer_request -> ux_transfer_request_completion_code == UX_TRANSFER_DEVICE_REMOVED)
+            return(UX_TRANSFER_DEVICE_REMOVED);
+#endif /* UX_HOST_CLASS_STORAGE_FAST_REMOVAL_ENABLE */
+
         /* The transfer stalled. We must clear the stall and attempt to read
            the CSW again.  */
         _ux_host_stack_endpoint_reset(storage -> ux_host_class_storage_bulk_in_endpoint);
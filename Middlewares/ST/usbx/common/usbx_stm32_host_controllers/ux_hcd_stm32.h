@@ -92,11 +92,144 @@
 #define UX_HCD_STM32_ED_STATUS_TRANSFER_DONE                    0x10U
 
 
+/* Define the bulk OUT FIFO refill mode.  Without DMA, a bulk OUT transfer is submitted once for
+   all its packets instead of one submission per packet.  Whole packets are written to the
+   non-periodic TX FIFO at submission and from the non-periodic TX FIFO empty interrupt.  One bulk
+   OUT transfer at a time streams this way, the others are sent packet by packet.
+   The mode is enabled with UX_HCD_STM32_BULK_OUT_REFILL_ENABLE.  */
+
+
+/* Define the NAK back-off of control and bulk channels.  A NAK is retried at once until
+   UX_HCD_STM32_NAK_BACKOFF_THRESHOLD consecutive NAKs without progress, the retry is then
+   deferred to the next SOF and the deferral doubles on each NAK that follows, up to
+   UX_HCD_STM32_NAK_BACKOFF_FRAMES_MAX frames.
+   The back-off is enabled with UX_HCD_STM32_NAK_BACKOFF_ENABLE.  */
+
+#if defined(UX_HCD_STM32_NAK_BACKOFF_ENABLE)
+#ifndef UX_HCD_STM32_NAK_BACKOFF_THRESHOLD
+#define UX_HCD_STM32_NAK_BACKOFF_THRESHOLD                      8U
+#endif /* UX_HCD_STM32_NAK_BACKOFF_THRESHOLD */
+
+#ifndef UX_HCD_STM32_NAK_BACKOFF_FRAMES_MAX
+#define UX_HCD_STM32_NAK_BACKOFF_FRAMES_MAX                     8U
+#endif /* UX_HCD_STM32_NAK_BACKOFF_FRAMES_MAX */
+#endif /* UX_HCD_STM32_NAK_BACKOFF_ENABLE */
+
+
+/* Define the deferred URB processing.  The channel interrupt only records the URB state changes
+   in a single producer single consumer ring, the HCD thread processes them: transfer lengths,
+   retries, request chaining and completion.  A channel has at most one NAK (URB_NOTREADY) event
+   pending, the NAKs that follow are merged into it, so the ring holds two events per channel.
+   If the ring is full the URB is processed in the interrupt, after the events of its channel
+   still in the ring, which are marked processed.  When the deferred processing is switched off
+   at run time the ring is drained first, then the URBs are processed in the interrupt.
+   The deferred processing is enabled with UX_HCD_STM32_DEFERRED_URB_ENABLE.  */
+
+#if defined(UX_HCD_STM32_DEFERRED_URB_ENABLE)
+#ifndef UX_HCD_STM32_URB_EVENT_RING_SIZE
+#define UX_HCD_STM32_URB_EVENT_RING_SIZE                        32U
+#endif /* UX_HCD_STM32_URB_EVENT_RING_SIZE */
+
+#if (UX_HCD_STM32_URB_EVENT_RING_SIZE & (UX_HCD_STM32_URB_EVENT_RING_SIZE - 1U)) != 0U
+#error "UX_HCD_STM32_URB_EVENT_RING_SIZE must be a power of 2"
+#endif
+
+#if UX_HCD_STM32_URB_EVENT_RING_SIZE < (2U * UX_HCD_STM32_MAX_NB_CHANNELS)
+#error "UX_HCD_STM32_URB_EVENT_RING_SIZE must hold two events per channel"
+#endif
+
+/* Channel of an event already processed.  */
+#define UX_HCD_STM32_URB_EVENT_PROCESSED                        0xFFU
+
+#if UX_HCD_STM32_MAX_NB_CHANNELS > 32U
+#error "The pending NAK events of the channels are a 32 bit mask"
+#endif
+#endif /* UX_HCD_STM32_DEFERRED_URB_ENABLE */
+
+
+/* Define the bitmap allocation.  The free EDs and the free channels are kept in bitmaps, the
+   lowest free one is found with a count leading zeros instruction.  The periodic load of each
+   frame slot is kept up to date when a periodic ED is created or destroyed, the least loaded slot
+   is found without parsing the periodic ED list, and the periodic ED list is doubly linked.
+   The bitmap allocation is enabled with UX_HCD_STM32_BITMAP_ALLOCATION_ENABLE.  */
+
+#if defined(UX_HCD_STM32_BITMAP_ALLOCATION_ENABLE)
+#define UX_HCD_STM32_ED_BITMAP_WORDS                            ((UX_MAX_ED + 31U) / 32U)
+#define UX_HCD_STM32_PERIODIC_SLOTS                             32U
+#define UX_HCD_STM32_LOWEST_BIT(bits)                           (31U - __CLZ((bits) & (~(bits) + 1U)))
+#endif /* UX_HCD_STM32_BITMAP_ALLOCATION_ENABLE */
+
+
+/* Define the SOF interrupt gating.  The SOF interrupt only serves the periodic scheduler and the
+   NAK back-off, it is masked while the periodic ED list is empty and no NAKed retry is deferred,
+   and unmasked as soon as an interrupt or isochronous ED is created or a retry is deferred.  The
+   core keeps sending the SOF tokens on the bus.
+   The gating is enabled with UX_HCD_STM32_SOF_GATING_ENABLE.  */
+
+
+/* Define the ED statistics.  Each ED counts its transfers, bytes, NAKs, retries after a transaction
+   error, errors, stalls and aborts, and keeps a log2 histogram of the time from the submission of a
+   transfer to its completion, in microseconds of the DWT cycle counter: bucket n counts the times
+   from 2^(n-1) to 2^n - 1 us, the last bucket all the longer ones.  A control transfer is timed
+   from its SETUP stage to its status stage.  Without the statistics, the timing macro is empty.
+   The statistics are enabled with UX_HCD_STM32_ED_STATISTICS_ENABLE.  */
+
+#if defined(UX_HCD_STM32_ED_STATISTICS_ENABLE)
+#ifndef UX_HCD_STM32_LATENCY_BUCKETS
+#define UX_HCD_STM32_LATENCY_BUCKETS                            20U
+#endif /* UX_HCD_STM32_LATENCY_BUCKETS */
+
+#define UX_HCD_STM32_ED_STATISTICS_START(ed)                    (ed) -> ux_stm32_ed_statistics_start =  DWT -> CYCCNT
+#else
+#define UX_HCD_STM32_ED_STATISTICS_START(ed)
+#endif /* UX_HCD_STM32_ED_STATISTICS_ENABLE */
+
+
+/* Define the fast removal.  When the root port reports a disconnection, the transfers pending on
+   all the EDs are completed at once, from the interrupt, with UX_TRANSFER_DEVICE_REMOVED.  The
+   class waiting on a transfer returns without waiting for its timeout, long before the root hub
+   thread removes the device.
+   The fast removal is enabled with UX_HCD_STM32_FAST_REMOVAL_ENABLE.  */
+
+
 /* Define STM32 static definition.  */
 
 #define UX_HCD_STM32_AVAILABLE_BANDWIDTH                        6000U
 
 
+/* Define STM32 URB event structure.  */
+
+typedef struct UX_HCD_STM32_URB_EVENT_STRUCT
+{
+
+    struct UX_HCD_STM32_ED_STRUCT       *ux_hcd_stm32_urb_event_ed;
+    struct UX_TRANSFER_STRUCT           *ux_hcd_stm32_urb_event_transfer;
+    ULONG                               ux_hcd_stm32_urb_event_xfer_count;
+    UCHAR                               ux_hcd_stm32_urb_event_channel;
+    UCHAR                               ux_hcd_stm32_urb_event_state;
+    UCHAR                               reserved[2];
+} UX_HCD_STM32_URB_EVENT;
+
+
+/* Define STM32 ED statistics structure.  */
+
+#if defined(UX_HCD_STM32_ED_STATISTICS_ENABLE)
+typedef struct UX_HCD_STM32_ED_STATISTICS_STRUCT
+{
+
+    ULONG                               ux_hcd_stm32_ed_statistics_transfers;
+    ULONG                               ux_hcd_stm32_ed_statistics_bytes;
+    ULONG                               ux_hcd_stm32_ed_statistics_naks;
+    ULONG                               ux_hcd_stm32_ed_statistics_retries;
+    ULONG                               ux_hcd_stm32_ed_statistics_errors;
+    ULONG                               ux_hcd_stm32_ed_statistics_stalls;
+    ULONG                               ux_hcd_stm32_ed_statistics_aborts;
+    ULONG                               ux_hcd_stm32_ed_statistics_latency_max;
+    ULONG                               ux_hcd_stm32_ed_statistics_latency[UX_HCD_STM32_LATENCY_BUCKETS];
+} UX_HCD_STM32_ED_STATISTICS;
+#endif
+
+
 /* Define STM32 structure.  */
 
 typedef struct UX_HCD_STM32_STRUCT
@@ -111,6 +244,28 @@ typedef struct UX_HCD_STM32_STRUCT
     ULONG                               ux_hcd_stm32_controller_flag;
     HCD_HandleTypeDef                   *hcd_handle;
     struct UX_HCD_STM32_ED_STRUCT       *ux_hcd_stm32_periodic_ed_head;
+#if defined(UX_HCD_STM32_BULK_OUT_REFILL_ENABLE)
+    struct UX_HCD_STM32_ED_STRUCT       *ux_hcd_stm32_refill_ed;
+#endif
+#if defined(UX_HCD_STM32_NAK_BACKOFF_ENABLE)
+    ULONG                               ux_hcd_stm32_nak_deferred;
+    ULONG                               ux_hcd_stm32_channel_naks[UX_HCD_STM32_MAX_NB_CHANNELS];
+    ULONG                               ux_hcd_stm32_channel_nak_deferrals[UX_HCD_STM32_MAX_NB_CHANNELS];
+#endif
+#if defined(UX_HCD_STM32_DEFERRED_URB_ENABLE)
+    UINT                                ux_hcd_stm32_urb_deferred;
+    UX_HCD_STM32_URB_EVENT              ux_hcd_stm32_urb_events[UX_HCD_STM32_URB_EVENT_RING_SIZE];
+    volatile ULONG                      ux_hcd_stm32_urb_event_head;
+    volatile ULONG                      ux_hcd_stm32_urb_event_tail;
+    ULONG                               ux_hcd_stm32_urb_notready_pending;
+    ULONG                               ux_hcd_stm32_urb_event_overflows;
+    ULONG                               ux_hcd_stm32_urb_event_depth_max;
+#endif
+#if defined(UX_HCD_STM32_BITMAP_ALLOCATION_ENABLE)
+    ULONG                               ux_hcd_stm32_free_channels;
+    ULONG                               ux_hcd_stm32_free_eds[UX_HCD_STM32_ED_BITMAP_WORDS];
+    ULONG                               ux_hcd_stm32_periodic_load[UX_HCD_STM32_PERIODIC_SLOTS];
+#endif
 } UX_HCD_STM32;
 
 
@@ -137,6 +292,24 @@ typedef struct UX_HCD_STM32_ED_STRUCT
     UCHAR                               ux_stm32_ed_type;
     UCHAR                               ux_stm32_ed_sch_mode;
     UCHAR                               reserved[2];
+#if defined(UX_HCD_STM32_BULK_OUT_REFILL_ENABLE)
+    UCHAR                               *ux_stm32_ed_refill_buffer;
+    ULONG                               ux_stm32_ed_refill_remaining;
+    ULONG                               ux_stm32_ed_refill_packets;
+#endif
+#if defined(UX_HCD_STM32_NAK_BACKOFF_ENABLE)
+    ULONG                               ux_stm32_ed_nak_count;
+    ULONG                               ux_stm32_ed_nak_progress;
+    ULONG                               ux_stm32_ed_nak_backoff;
+    ULONG                               ux_stm32_ed_nak_frames;
+#endif
+#if defined(UX_HCD_STM32_BITMAP_ALLOCATION_ENABLE)
+    struct UX_HCD_STM32_ED_STRUCT       *ux_stm32_ed_previous_ed;
+#endif
+#if defined(UX_HCD_STM32_ED_STATISTICS_ENABLE)
+    ULONG                               ux_stm32_ed_statistics_start;
+    UX_HCD_STM32_ED_STATISTICS          ux_stm32_ed_statistics;
+#endif
 } UX_HCD_STM32_ED;
 
 
@@ -146,8 +319,16 @@ typedef struct UX_HCD_STM32_ED_STRUCT
 
 /* Define STM32 function prototypes.  */
 
+VOID                _ux_hcd_stm32_bulk_out_refill(UX_HCD_STM32 *hcd_stm32);
+UINT                _ux_hcd_stm32_bulk_out_refill_start(UX_HCD_STM32 *hcd_stm32, UX_HCD_STM32_ED *ed, UCHAR *data_pointer, ULONG length);
+ULONG               _ux_hcd_stm32_bulk_out_refill_stop(UX_HCD_STM32 *hcd_stm32, UX_HCD_STM32_ED *ed);
+ULONG               _ux_hcd_stm32_channel_obtain(UX_HCD_STM32 *hcd_stm32, UX_HCD_STM32_ED *ed);
+VOID                _ux_hcd_stm32_channel_release(UX_HCD_STM32 *hcd_stm32, UX_HCD_STM32_ED *ed);
 UINT                _ux_hcd_stm32_controller_disable(UX_HCD_STM32 *hcd_stm32);
 UX_HCD_STM32_ED *   _ux_hcd_stm32_ed_obtain(UX_HCD_STM32 *hcd_stm32);
+VOID                _ux_hcd_stm32_ed_release(UX_HCD_STM32 *hcd_stm32, UX_HCD_STM32_ED *ed);
+VOID                _ux_hcd_stm32_ed_statistics_reset(UX_HCD_STM32 *hcd_stm32);
+VOID                _ux_hcd_stm32_ed_statistics_update(UX_HCD_STM32_ED *ed, UX_TRANSFER *transfer_request);
 UINT                _ux_hcd_stm32_endpoint_create(UX_HCD_STM32 *hcd_stm32, UX_ENDPOINT *endpoint);
 UINT                _ux_hcd_stm32_endpoint_destroy(UX_HCD_STM32 *hcd_stm32, UX_ENDPOINT *endpoint);
 UINT                _ux_hcd_stm32_endpoint_reset(UX_HCD_STM32 *hcd_stm32, UX_ENDPOINT *endpoint);
@@ -156,6 +337,11 @@ UINT                _ux_hcd_stm32_frame_number_get(UX_HCD_STM32 *hcd_stm32, ULON
 UINT                _ux_hcd_stm32_initialize(UX_HCD *hcd);
 VOID                _ux_hcd_stm32_interrupt_handler(VOID);
 UINT                _ux_hcd_stm32_least_traffic_list_get(UX_HCD_STM32 *hcd_stm32);
+UINT                _ux_hcd_stm32_nak_backoff(UX_HCD_STM32 *hcd_stm32, UX_HCD_STM32_ED *ed);
+VOID                _ux_hcd_stm32_nak_cancel(UX_HCD_STM32 *hcd_stm32, UX_HCD_STM32_ED *ed);
+VOID                _ux_hcd_stm32_nak_resume(UX_HCD_STM32 *hcd_stm32);
+VOID                _ux_hcd_stm32_nak_retry(UX_HCD_STM32 *hcd_stm32, UX_HCD_STM32_ED *ed);
+VOID                _ux_hcd_stm32_periodic_load_update(UX_HCD_STM32 *hcd_stm32, UX_HCD_STM32_ED *ed, LONG load);
 UINT                _ux_hcd_stm32_periodic_schedule(UX_HCD_STM32 *hcd_stm32);
 UINT                _ux_hcd_stm32_port_disable(UX_HCD_STM32 *hcd_stm32, ULONG port_index);
 UINT                _ux_hcd_stm32_port_enable(UX_HCD_STM32 *hcd_stm32, ULONG port_index);
@@ -165,16 +351,24 @@ ULONG               _ux_hcd_stm32_port_status_get(UX_HCD_STM32 *hcd_stm32, ULONG
 UINT                _ux_hcd_stm32_port_suspend(UX_HCD_STM32 *hcd_stm32, ULONG port_index);
 UINT                _ux_hcd_stm32_power_down_port(UX_HCD_STM32 *hcd_stm32, ULONG port_index);
 UINT                _ux_hcd_stm32_power_on_port(UX_HCD_STM32 *hcd_stm32, ULONG port_index);
+VOID                _ux_hcd_stm32_removal_abort(UX_HCD_STM32 *hcd_stm32);
 UINT                _ux_hcd_stm32_request_bulk_transfer(UX_HCD_STM32 *hcd_stm32, UX_TRANSFER *transfer_request);
 UINT                _ux_hcd_stm32_request_control_transfer(UX_HCD_STM32 *hcd_stm32, UX_TRANSFER *transfer_request);
 UINT                _ux_hcd_stm32_request_periodic_transfer(UX_HCD_STM32 *hcd_stm32, UX_TRANSFER *transfer_request);
 UINT                _ux_hcd_stm32_request_transfer(UX_HCD_STM32 *hcd_stm32, UX_TRANSFER *transfer_request);
 UINT                _ux_hcd_stm32_request_trans_prepare(UX_HCD_STM32 *hcd_stm32, UX_HCD_STM32_ED *ed, UX_TRANSFER *transfer);
 VOID                _ux_hcd_stm32_request_trans_finish(UX_HCD_STM32 *hcd_stm32, UX_HCD_STM32_ED *ed);
+VOID                _ux_hcd_stm32_sof_update(UX_HCD_STM32 *hcd_stm32);
 UINT                _ux_hcd_stm32_transfer_abort(UX_HCD_STM32 *hcd_stm32, UX_TRANSFER *transfer_request);
+VOID                _ux_hcd_stm32_urb_deferred_set(UX_HCD_STM32 *hcd_stm32, UINT deferred);
+VOID                _ux_hcd_stm32_urb_event_process(UX_HCD_STM32 *hcd_stm32, UX_HCD_STM32_URB_EVENT *urb_event);
+VOID                _ux_hcd_stm32_urb_events_process(UX_HCD_STM32 *hcd_stm32);
+VOID                _ux_hcd_stm32_urb_process(HCD_HandleTypeDef *hhcd, uint8_t chnum, HCD_URBStateTypeDef urb_state, ULONG xfer_count);
 
 #define ux_hcd_stm32_initialize                      _ux_hcd_stm32_initialize
 #define ux_hcd_stm32_interrupt_handler               _ux_hcd_stm32_interrupt_handler
+#define ux_hcd_stm32_ed_statistics_reset             _ux_hcd_stm32_ed_statistics_reset
+#define ux_hcd_stm32_urb_deferred_set                _ux_hcd_stm32_urb_deferred_set
 
 
 #endif
@@ -0,0 +1,123 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   STM32 Controller Driver                                             */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+#define UX_HCD_STM32_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_hcd_stm32.h"
+#include "ux_host_stack.h"
+
+
+#if defined(UX_HCD_STM32_BULK_OUT_REFILL_ENABLE)
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_hcd_stm32_bulk_out_refill                       PORTABLE C      */
+/*                                                           6.1.10       */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function writes the next packets of the streaming bulk OUT     */
+/*    transfer to the non-periodic TX FIFO. Whole packets are written as  */
+/*    long as the FIFO and its request queue have room. The non-periodic  */
+/*    TX FIFO empty interrupt is enabled while data is left to write.     */
+/*                                                                        */
+/*    It is called with interrupts disabled or from the interrupt.        */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    hcd_stm32                             Pointer to STM32 controller   */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    USB_WritePacket                       Write packet to TX FIFO       */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_hcd_stm32_bulk_out_refill_start   Start streaming bulk OUT      */
+/*    HAL_HCD_NPTxFifoEmpty_Callback        TX FIFO empty callback        */
+/*                                                                        */
+/**************************************************************************/
+__USB_RAM_FUNC
+VOID  _ux_hcd_stm32_bulk_out_refill(UX_HCD_STM32 *hcd_stm32)
+{
+
+USB_OTG_GlobalTypeDef   *USBx;
+UX_HCD_STM32_ED         *ed;
+ULONG                   max_packet;
+ULONG                   packet_length;
+ULONG                   fifo_status;
+
+
+    /* Get the controller registers.  */
+    USBx =  hcd_stm32 -> hcd_handle -> Instance;
+
+    /* Get the streaming ED.  */
+    ed =  hcd_stm32 -> ux_hcd_stm32_refill_ed;
+    if (ed != UX_NULL)
+    {
+
+        /* Get the packet size of the channel.  */
+        max_packet =  hcd_stm32 -> hcd_handle -> hc[ed -> ux_stm32_ed_channel].max_packet;
+
+        /* Write whole packets while the FIFO can take them.  */
+        while (ed -> ux_stm32_ed_refill_remaining > 0)
+        {
+
+            /* Get the size of the next packet.  */
+            packet_length =  UX_MIN(max_packet, ed -> ux_stm32_ed_refill_remaining);
+
+            /* Check the free words of the FIFO and the free request queue entries.  */
+            fifo_status =  USBx -> HNPTXSTS;
+            if (((fifo_status & USB_OTG_GNPTXSTS_NPTQXSAV) == 0U) ||
+                (((packet_length + 3U) / 4U) > (fifo_status & USB_OTG_GNPTXSTS_NPTXFSAV)))
+                break;
+
+            /* Write the packet.  */
+            USB_WritePacket(USBx, ed -> ux_stm32_ed_refill_buffer, ed -> ux_stm32_ed_channel, (uint16_t)packet_length);
+
+            /* Move to the next packet.  */
+            ed -> ux_stm32_ed_refill_buffer +=  packet_length;
+            ed -> ux_stm32_ed_refill_remaining -=  packet_length;
+        }
+
+        /* Wait for FIFO room if there is data left.  */
+        if (ed -> ux_stm32_ed_refill_remaining > 0)
+        {
+            USBx -> GINTMSK |=  USB_OTG_GINTMSK_NPTXFEM;
+            return;
+        }
+    }
+
+    /* Nothing left to write.  */
+    USBx -> GINTMSK &=  ~USB_OTG_GINTMSK_NPTXFEM;
+}
+#endif
@@ -0,0 +1,148 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   STM32 Controller Driver                                             */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+#define UX_HCD_STM32_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_hcd_stm32.h"
+#include "ux_host_stack.h"
+
+
+#if defined(UX_HCD_STM32_BULK_OUT_REFILL_ENABLE)
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_hcd_stm32_bulk_out_refill_start                 PORTABLE C      */
+/*                                                           6.1.10       */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function starts a multi-packet bulk OUT transfer on the        */
+/*    channel of the ED without DMA. The channel is programmed for all    */
+/*    the packets at once and the TX FIFO is filled with as many packets  */
+/*    as it can take, the rest is written from the non-periodic TX FIFO   */
+/*    empty interrupt.                                                    */
+/*                                                                        */
+/*    The channel state is set as HAL_HCD_HC_SubmitRequest does, so the   */
+/*    HAL channel interrupt handling completes the transfer.              */
+/*                                                                        */
+/*    One ED streams at a time. The ED is claimed with interrupts         */
+/*    disabled, if another ED streams nothing is started and the caller   */
+/*    submits the transfer one packet at a time.                          */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    hcd_stm32                             Pointer to STM32 controller   */
+/*    ed                                    Pointer to STM32 ED           */
+/*    data_pointer                          Pointer to data to send       */
+/*    length                                Length of data, at most       */
+/*                                            HC_MAX_PKT_CNT packets      */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    UX_SUCCESS if started, UX_BUSY if another ED streams                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_hcd_stm32_bulk_out_refill         Write packets to TX FIFO      */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_hcd_stm32_request_bulk_transfer   Request bulk transfer         */
+/*    _ux_hcd_stm32_urb_process             Process URB state change      */
+/*    _ux_hcd_stm32_nak_retry               Retry a deferred NAK          */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_hcd_stm32_bulk_out_refill_start(UX_HCD_STM32 *hcd_stm32, UX_HCD_STM32_ED *ed,
+                                          UCHAR *data_pointer, ULONG length)
+{
+
+UX_INTERRUPT_SAVE_AREA
+USB_OTG_GlobalTypeDef   *USBx;
+uint32_t                USBx_BASE;
+HCD_HCTypeDef           *hc;
+ULONG                   channel;
+ULONG                   packets;
+ULONG                   hcchar;
+
+
+    /* Get the controller registers and the HAL channel.  */
+    USBx =  hcd_stm32 -> hcd_handle -> Instance;
+    USBx_BASE =  (uint32_t) USBx;
+    channel =  ed -> ux_stm32_ed_channel;
+    hc =  &hcd_stm32 -> hcd_handle -> hc[channel];
+
+    /* Compute the number of packets of the transfer.  */
+    packets =  (length + hc -> max_packet - 1U) / hc -> max_packet;
+
+    UX_DISABLE
+
+    /* Claim the FIFO streaming, only one ED streams at a time.  */
+    if (hcd_stm32 -> ux_hcd_stm32_refill_ed != UX_NULL)
+    {
+        UX_RESTORE
+        return(UX_BUSY);
+    }
+    hcd_stm32 -> ux_hcd_stm32_refill_ed =  ed;
+
+    /* Set the channel state as HAL_HCD_HC_SubmitRequest does for a bulk OUT.  */
+    hc -> ep_is_in =  0U;
+    hc -> ep_type =  EP_TYPE_BULK;
+    hc -> data_pid =  (hc -> toggle_out == 0U) ? HC_PID_DATA0 : HC_PID_DATA1;
+    hc -> xfer_buff =  data_pointer;
+    hc -> xfer_len =  length;
+    hc -> XferSize =  length;
+    hc -> urb_state =  URB_IDLE;
+    hc -> xfer_count =  0U;
+    hc -> ch_num =  (uint8_t) channel;
+    hc -> state =  HC_IDLE;
+
+    /* This ED is now the one streaming to the FIFO.  */
+    ed -> ux_stm32_ed_refill_buffer =  data_pointer;
+    ed -> ux_stm32_ed_refill_remaining =  length;
+    ed -> ux_stm32_ed_refill_packets =  packets;
+
+    /* Program all the packets of the transfer.  */
+    USBx_HC(channel) -> HCTSIZ =  (length & USB_OTG_HCTSIZ_XFRSIZ) |
+                                  ((packets << 19) & USB_OTG_HCTSIZ_PKTCNT) |
+                                  (((ULONG) hc -> data_pid << 29) & USB_OTG_HCTSIZ_DPID);
+
+    /* Enable the channel for an OUT transfer.  */
+    hcchar =  USBx_HC(channel) -> HCCHAR;
+    hcchar &=  ~(USB_OTG_HCCHAR_CHDIS | USB_OTG_HCCHAR_EPDIR);
+    hcchar |=  USB_OTG_HCCHAR_CHENA;
+    USBx_HC(channel) -> HCCHAR =  hcchar;
+
+    /* Fill the FIFO.  */
+    _ux_hcd_stm32_bulk_out_refill(hcd_stm32);
+
+    UX_RESTORE
+
+    /* The transfer streams.  */
+    return(UX_SUCCESS);
+}
+#endif
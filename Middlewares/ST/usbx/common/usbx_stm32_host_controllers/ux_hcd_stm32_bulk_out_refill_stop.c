@@ -0,0 +1,147 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   STM32 Controller Driver                                             */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+#define UX_HCD_STM32_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_hcd_stm32.h"
+#include "ux_host_stack.h"
+
+
+#if defined(UX_HCD_STM32_BULK_OUT_REFILL_ENABLE)
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_hcd_stm32_bulk_out_refill_stop                  PORTABLE C      */
+/*                                                           6.1.10       */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function ends the streaming bulk OUT transfer of the ED once   */
+/*    its channel is halted: on completion, NAK, error or abort.          */
+/*                                                                        */
+/*    The packets the device did not acknowledge are left in the channel  */
+/*    packet count, and the channel PID is the toggle of the next packet. */
+/*    The OUT toggle of the channel is restored from it. Packets written  */
+/*    to the FIFO but not sent are flushed, unless another OUT channel    */
+/*    is using the FIFO.                                                  */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    hcd_stm32                             Pointer to STM32 controller   */
+/*    ed                                    Pointer to STM32 ED           */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Number of bytes acknowledged by the device                          */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    USB_FlushTxFifo                       Flush TX FIFO                 */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    HAL_HCD_HC_NotifyURBChange_Callback   URB change callback           */
+/*    _ux_hcd_stm32_transfer_abort          Abort transfer                */
+/*    _ux_hcd_stm32_endpoint_destroy        Destroy endpoint              */
+/*    _ux_hcd_stm32_removal_abort           Abort transfers on removal    */
+/*                                                                        */
+/**************************************************************************/
+__USB_RAM_FUNC
+ULONG  _ux_hcd_stm32_bulk_out_refill_stop(UX_HCD_STM32 *hcd_stm32, UX_HCD_STM32_ED *ed)
+{
+
+UX_INTERRUPT_SAVE_AREA
+USB_OTG_GlobalTypeDef   *USBx;
+uint32_t                USBx_BASE;
+HCD_HCTypeDef           *hc;
+ULONG                   channel;
+ULONG                   hctsiz;
+ULONG                   packets_left;
+ULONG                   sent_length;
+ULONG                   channel_index;
+UINT                    fifo_shared;
+
+
+    UX_DISABLE
+
+    /* Check if the ED is the one streaming.  */
+    if (hcd_stm32 -> ux_hcd_stm32_refill_ed != ed)
+    {
+        UX_RESTORE
+        return(0);
+    }
+
+    /* No more streaming.  */
+    hcd_stm32 -> ux_hcd_stm32_refill_ed =  UX_NULL;
+
+    /* Get the controller registers and the HAL channel.  */
+    USBx =  hcd_stm32 -> hcd_handle -> Instance;
+    USBx_BASE =  (uint32_t) USBx;
+    channel =  ed -> ux_stm32_ed_channel;
+    hc =  &hcd_stm32 -> hcd_handle -> hc[channel];
+
+    /* Nothing to write anymore.  */
+    USBx -> GINTMSK &=  ~USB_OTG_GINTMSK_NPTXFEM;
+
+    /* Get the packets not acknowledged and the PID of the next packet.  */
+    hctsiz =  USBx_HC(channel) -> HCTSIZ;
+    packets_left =  (hctsiz & USB_OTG_HCTSIZ_PKTCNT) >> 19;
+    hc -> toggle_out =  (((hctsiz & USB_OTG_HCTSIZ_DPID) >> 29) == HC_PID_DATA1) ? 1U : 0U;
+
+    /* Compute the length acknowledged by the device.  */
+    if (packets_left > ed -> ux_stm32_ed_refill_packets)
+        packets_left =  ed -> ux_stm32_ed_refill_packets;
+    sent_length =  (ed -> ux_stm32_ed_refill_packets - packets_left) * hc -> max_packet;
+    if (sent_length > hc -> xfer_len)
+        sent_length =  hc -> xfer_len;
+
+    /* Flush packets written to the FIFO and not sent, if the FIFO is not used by another OUT channel.  */
+    if (hc -> xfer_len - ed -> ux_stm32_ed_refill_remaining > sent_length)
+    {
+        fifo_shared =  UX_FALSE;
+        for (channel_index = 0; channel_index < hcd_stm32 -> ux_hcd_stm32_nb_channels; channel_index++)
+        {
+            if ((channel_index != channel) &&
+                (hcd_stm32 -> hcd_handle -> hc[channel_index].ep_is_in == 0U) &&
+                (hcd_stm32 -> hcd_handle -> hc[channel_index].urb_state == URB_IDLE) &&
+                ((hcd_stm32 -> hcd_handle -> hc[channel_index].ep_type == EP_TYPE_CTRL) ||
+                 (hcd_stm32 -> hcd_handle -> hc[channel_index].ep_type == EP_TYPE_BULK)) &&
+                (hcd_stm32 -> ux_hcd_stm32_channels_ed[channel_index] != UX_NULL))
+                fifo_shared =  UX_TRUE;
+        }
+        if (fifo_shared == UX_FALSE)
+            USB_FlushTxFifo(USBx, 0U);
+    }
+    ed -> ux_stm32_ed_refill_remaining =  0;
+
+    UX_RESTORE
+
+    /* Return the length acknowledged.  */
+    return(sent_length);
+}
+#endif
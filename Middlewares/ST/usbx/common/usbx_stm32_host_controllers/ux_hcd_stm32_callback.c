@@ -118,6 +118,7 @@ UX_HCD_STM32        *hcd_stm32;
 /*                                                                        */
 /*  CALLS                                                                 */
 /*                                                                        */
+/*    _ux_hcd_stm32_removal_abort           Abort transfers on removal    */
 /*    _ux_utility_semaphore_put             Put semaphore                 */
 /*                                                                        */
 /*  CALLED BY                                                             */
@@ -152,6 +153,12 @@ UX_HCD_STM32        *hcd_stm32;
     hcd_stm32 -> ux_hcd_stm32_controller_flag |= UX_HCD_STM32_CONTROLLER_FLAG_DEVICE_DETACHED;
     hcd_stm32 -> ux_hcd_stm32_controller_flag &= ~UX_HCD_STM32_CONTROLLER_FLAG_DEVICE_ATTACHED;
 
+#if defined(UX_HCD_STM32_FAST_REMOVAL_ENABLE)
+
+    /* Do not let the classes wait for the timeout of their pending transfers.  */
+    _ux_hcd_stm32_removal_abort(hcd_stm32);
+#endif /* UX_HCD_STM32_FAST_REMOVAL_ENABLE */
+
     /* Wake up the root hub thread.  */
     _ux_host_semaphore_put(&_ux_system_host -> ux_system_host_enum_semaphore);
 }
@@ -161,7 +168,7 @@ UX_HCD_STM32        *hcd_stm32;
 /*                                                                        */
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
-/*    HAL_HCD_Disconnect_Callback                         PORTABLE C      */
+/*    _ux_hcd_stm32_urb_process                           PORTABLE C      */
 /*                                                           6.1.12       */
 /*  AUTHOR                                                                */
 /*                                                                        */
@@ -169,11 +176,16 @@ UX_HCD_STM32        *hcd_stm32;
 /*                                                                        */
 /*  DESCRIPTION                                                           */
 /*                                                                        */
-/*    This function handles callback from HAL driver.                     */
+/*    This function processes an URB state change of a channel reported   */
+/*    by HAL driver, in the interrupt or from the HCD thread when the     */
+/*    URB processing is deferred.                                         */
 /*                                                                        */
 /*  INPUT                                                                 */
 /*                                                                        */
 /*    hhcd                                  Pointer to HCD handle         */
+/*    chnum                                 Channel number                */
+/*    urb_state                             URB state                     */
+/*    xfer_count                            Channel transfer count        */
 /*                                                                        */
 /*  OUTPUT                                                                */
 /*                                                                        */
@@ -181,14 +193,16 @@ UX_HCD_STM32        *hcd_stm32;
 /*                                                                        */
 /*  CALLS                                                                 */
 /*                                                                        */
+/*    _ux_hcd_stm32_ed_statistics_update    Account transfer statistics   */
+/*    _ux_hcd_stm32_nak_cancel              Cancel deferred NAK retry     */
 /*    _ux_utility_semaphore_put             Put semaphore                 */
 /*    HAL_HCD_HC_SubmitRequest              Submit request                */
 /*    HAL_HCD_HC_Halt                       Halt channel                  */
-/*    HAL_HCD_HC_GetXferCount               Get transfer count            */
 /*                                                                        */
 /*  CALLED BY                                                             */
 /*                                                                        */
-/*    stm32 Controller Driver                                             */
+/*    HAL_HCD_HC_NotifyURBChange_Callback   URB change callback           */
+/*    _ux_hcd_stm32_urb_events_process      Process deferred URB events   */
 /*                                                                        */
 /*  RELEASE HISTORY                                                       */
 /*                                                                        */
@@ -204,7 +218,8 @@ UX_HCD_STM32        *hcd_stm32;
 /*                                            resulting in version 6.1.12 */
 /*                                                                        */
 /**************************************************************************/
-void HAL_HCD_HC_NotifyURBChange_Callback(HCD_HandleTypeDef *hhcd, uint8_t chnum, HCD_URBStateTypeDef urb_state)
+__USB_RAM_FUNC
+VOID  _ux_hcd_stm32_urb_process(HCD_HandleTypeDef *hhcd, uint8_t chnum, HCD_URBStateTypeDef urb_state, ULONG xfer_count)
 {
 
 UX_HCD              *hcd;
@@ -212,6 +227,9 @@ UX_HCD_STM32        *hcd_stm32;
 UX_HCD_STM32_ED     *ed;
 UX_TRANSFER         *transfer_request;
 UX_TRANSFER         *transfer_next;
+#if defined(UX_HCD_STM32_BULK_OUT_REFILL_ENABLE)
+UINT                refill;
+#endif
 
 
     /* Check the URB state.  */
@@ -244,6 +262,65 @@ UX_TRANSFER         *transfer_next;
             return;
         }
 
+#if defined(UX_HCD_STM32_NAK_BACKOFF_ENABLE)
+
+        /* The transfer moved on: a deferred retry is dropped and the next NAK starts a new count.  */
+        if (urb_state != URB_NOTREADY)
+            _ux_hcd_stm32_nak_cancel(hcd_stm32, ed);
+#endif /* UX_HCD_STM32_NAK_BACKOFF_ENABLE */
+
+#if defined(UX_HCD_STM32_BULK_OUT_REFILL_ENABLE)
+
+        /* Check if the ED was streaming to the FIFO, the channel is halted.  */
+        refill =  (hcd_stm32 -> ux_hcd_stm32_refill_ed == ed) ? UX_TRUE : UX_FALSE;
+        if (refill)
+        {
+
+            /* Account the data acknowledged by the device.  */
+            transfer_request -> ux_transfer_request_actual_length +=  _ux_hcd_stm32_bulk_out_refill_stop(hcd_stm32, ed);
+
+            /* After a completion or a NAK, continue with the data left.  */
+            if (((urb_state == URB_DONE) || (urb_state == URB_NOTREADY)) &&
+                (transfer_request -> ux_transfer_request_requested_length >
+                 transfer_request -> ux_transfer_request_actual_length))
+            {
+
+                /* Adjust the transmit length.  */
+                ed -> ux_stm32_ed_packet_length =
+                    UX_MIN(HC_MAX_PKT_CNT * ed -> ux_stm32_ed_endpoint -> ux_endpoint_descriptor.wMaxPacketSize,
+                           transfer_request -> ux_transfer_request_requested_length -
+                           transfer_request -> ux_transfer_request_actual_length);
+
+#if defined(UX_HCD_STM32_NAK_BACKOFF_ENABLE)
+
+                /* A NAKed transfer may be retried from the SOF.  */
+                if ((urb_state == URB_NOTREADY) && (_ux_hcd_stm32_nak_backoff(hcd_stm32, ed) == UX_TRUE))
+                    return;
+#endif /* UX_HCD_STM32_NAK_BACKOFF_ENABLE */
+
+                /* Stream several packets again. A last short packet, or the data left if another
+                   transfer took the FIFO meanwhile, is submitted one packet at a time.  */
+                if ((ed -> ux_stm32_ed_packet_length <= ed -> ux_stm32_ed_endpoint -> ux_endpoint_descriptor.wMaxPacketSize) ||
+                    (_ux_hcd_stm32_bulk_out_refill_start(hcd_stm32, ed,
+                                                         ed -> ux_stm32_ed_data + transfer_request -> ux_transfer_request_actual_length,
+                                                         ed -> ux_stm32_ed_packet_length) != UX_SUCCESS))
+                {
+                    ed -> ux_stm32_ed_packet_length =  UX_MIN(ed -> ux_stm32_ed_packet_length,
+                                                              ed -> ux_stm32_ed_endpoint -> ux_endpoint_descriptor.wMaxPacketSize);
+                    HAL_HCD_HC_SubmitRequest(hcd_stm32 -> hcd_handle, ed -> ux_stm32_ed_channel,
+                                             0, EP_TYPE_BULK, USBH_PID_DATA,
+                                             ed -> ux_stm32_ed_data + transfer_request -> ux_transfer_request_actual_length,
+                                             ed -> ux_stm32_ed_packet_length, 0);
+                }
+                return;
+            }
+
+            /* All the data is acknowledged.  */
+            if (urb_state == URB_NOTREADY)
+                urb_state =  URB_DONE;
+        }
+#endif /* UX_HCD_STM32_BULK_OUT_REFILL_ENABLE */
+
         /* Check if URB state is not URB_NOTREADY.  */
         if (urb_state != URB_NOTREADY)
         {
@@ -265,11 +342,11 @@ UX_TRANSFER         *transfer_next;
                   if ((ed -> ux_stm32_ed_type == EP_TYPE_CTRL) || (ed -> ux_stm32_ed_type == EP_TYPE_BULK))
                   {
                     /* Get transfer size for receiving direction. */
-                    transfer_request -> ux_transfer_request_actual_length += HAL_HCD_HC_GetXferCount(hcd_stm32 -> hcd_handle, ed -> ux_stm32_ed_channel);
+                    transfer_request -> ux_transfer_request_actual_length += xfer_count;
 
                     /* Check if there is more data to be received. */
                     if ((transfer_request -> ux_transfer_request_requested_length > transfer_request -> ux_transfer_request_actual_length) &&
-                       (HAL_HCD_HC_GetXferCount(hcd_stm32 -> hcd_handle, ed -> ux_stm32_ed_channel) == ed->ux_stm32_ed_endpoint->ux_endpoint_descriptor.wMaxPacketSize))
+                       (xfer_count == ed->ux_stm32_ed_endpoint->ux_endpoint_descriptor.wMaxPacketSize))
                     {
                       /* Adjust the transmit length.  */
                       ed -> ux_stm32_ed_packet_length = UX_MIN(ed->ux_stm32_ed_endpoint->ux_endpoint_descriptor.wMaxPacketSize,
@@ -288,12 +365,17 @@ UX_TRANSFER         *transfer_next;
                   else
                   {
                     /* Get transfer size for receiving direction. */
-                    transfer_request -> ux_transfer_request_actual_length = HAL_HCD_HC_GetXferCount(hcd_stm32 -> hcd_handle, ed -> ux_stm32_ed_channel);
+                    transfer_request -> ux_transfer_request_actual_length = xfer_count;
                   }
                 }
 
                 /* Check if the request is for OUT transfer.  */
+#if defined(UX_HCD_STM32_BULK_OUT_REFILL_ENABLE)
+                /* A streamed OUT transfer is already accounted.  */
+                if ((ed -> ux_stm32_ed_dir == 0U) && (refill == UX_FALSE))
+#else
                 if (ed -> ux_stm32_ed_dir == 0U)
+#endif /* UX_HCD_STM32_BULK_OUT_REFILL_ENABLE */
                 {
 
 #if defined (USBH_HAL_HUB_SPLIT_SUPPORTED)
@@ -360,6 +442,12 @@ UX_TRANSFER         *transfer_next;
                 transfer_request -> ux_transfer_request_completion_code =  UX_TRANSFER_ERROR;
             }
 
+#if defined(UX_HCD_STM32_ED_STATISTICS_ENABLE)
+
+            /* Account the transfer in the ED statistics.  */
+            _ux_hcd_stm32_ed_statistics_update(ed, transfer_request);
+#endif /* UX_HCD_STM32_ED_STATISTICS_ENABLE */
+
             /* Finish current transfer.  */
             _ux_hcd_stm32_request_trans_finish(hcd_stm32, ed);
 
@@ -426,6 +514,13 @@ UX_TRANSFER         *transfer_next;
                 (ed -> ux_stm32_ed_status == UX_HCD_STM32_ED_STATUS_BULK_OUT))
             {
 
+#if defined(UX_HCD_STM32_NAK_BACKOFF_ENABLE)
+
+                /* A NAKed transfer may be retried from the SOF.  */
+                if (_ux_hcd_stm32_nak_backoff(hcd_stm32, ed) == UX_TRUE)
+                    return;
+#endif /* UX_HCD_STM32_NAK_BACKOFF_ENABLE */
+
                 /* Submit the transmit request.  */
                 HAL_HCD_HC_SubmitRequest(hcd_stm32 -> hcd_handle, ed -> ux_stm32_ed_channel, 0,
                                         ((ed -> ux_stm32_ed_endpoint -> ux_endpoint_descriptor.bmAttributes) & UX_MASK_ENDPOINT_TYPE) == UX_BULK_ENDPOINT ? EP_TYPE_BULK : EP_TYPE_CTRL,
@@ -433,9 +528,183 @@ UX_TRANSFER         *transfer_next;
                                          ed -> ux_stm32_ed_data + transfer_request -> ux_transfer_request_actual_length,
                                          ed -> ux_stm32_ed_packet_length, 0);
             }
+#if defined(UX_HCD_STM32_NAK_BACKOFF_ENABLE)
+            else if ((ed -> ux_stm32_ed_status == UX_HCD_STM32_ED_STATUS_CONTROL_DATA_IN) ||
+                     (ed -> ux_stm32_ed_status == UX_HCD_STM32_ED_STATUS_CONTROL_STATUS_IN) ||
+                     (ed -> ux_stm32_ed_status == UX_HCD_STM32_ED_STATUS_BULK_IN))
+            {
+
+                /* HAL has retried the IN at once, it may be deferred to the SOF instead.  */
+                _ux_hcd_stm32_nak_backoff(hcd_stm32, ed);
+            }
+#endif /* UX_HCD_STM32_NAK_BACKOFF_ENABLE */
+
+        }
+    }
+}
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    HAL_HCD_HC_NotifyURBChange_Callback                 PORTABLE C      */
+/*                                                           6.1.10       */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function handles the URB change callback from HAL driver.      */
+/*                                                                        */
+/*    When the URB processing is deferred, the channel, URB state and     */
+/*    transfer count are pushed in the URB event ring and the HCD thread  */
+/*    is woken up if the ring was empty. The interrupt is the only        */
+/*    producer and the HCD thread the only consumer. A NAK of a channel   */
+/*    that already has a NAK event pending is merged into it. If the ring */
+/*    is full the URB is processed here, after the events of its channel  */
+/*    still in the ring so the channel events stay in order. These are    */
+/*    marked processed, the HCD thread skips them.                        */
+/*                                                                        */
+/*    The streaming bulk OUT channel is halted by any URB state change,   */
+/*    the FIFO refill is stopped at once until the HCD thread takes over. */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    hhcd                                  Pointer to HCD handle         */
+/*    chnum                                 Channel number                */
+/*    urb_state                             URB state                     */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_hcd_stm32_urb_event_process       Process URB event             */
+/*    _ux_hcd_stm32_urb_process             Process URB state change      */
+/*    _ux_utility_semaphore_put             Put semaphore                 */
+/*    HAL_HCD_HC_GetXferCount               Get transfer count            */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    stm32 Controller Driver                                             */
+/*                                                                        */
+/**************************************************************************/
+__USB_RAM_FUNC
+void HAL_HCD_HC_NotifyURBChange_Callback(HCD_HandleTypeDef *hhcd, uint8_t chnum, HCD_URBStateTypeDef urb_state)
+{
+
+#if defined(UX_HCD_STM32_DEFERRED_URB_ENABLE) || defined(UX_HCD_STM32_ED_STATISTICS_ENABLE)
+UX_HCD                  *hcd;
+UX_HCD_STM32            *hcd_stm32;
+#endif
+#if defined(UX_HCD_STM32_DEFERRED_URB_ENABLE)
+UX_HCD_STM32_URB_EVENT  *urb_event;
+ULONG                   head;
+ULONG                   tail;
+ULONG                   depth;
+#endif
+#if defined(UX_HCD_STM32_DEFERRED_URB_ENABLE) || defined(UX_HCD_STM32_ED_STATISTICS_ENABLE)
+UX_HCD_STM32_ED         *ed;
+#endif
+
+
+#if defined(UX_HCD_STM32_DEFERRED_URB_ENABLE) || defined(UX_HCD_STM32_ED_STATISTICS_ENABLE)
+    /* Get the pointer to the HCD & HCD_STM32.  */
+    hcd = (UX_HCD*)hhcd -> pData;
+    hcd_stm32 = (UX_HCD_STM32*)hcd -> ux_hcd_controller_hardware;
+#endif
+
+#if defined(UX_HCD_STM32_ED_STATISTICS_ENABLE)
+
+    /* The channel error count tells a retried transaction error from a NAK,
+       it must be read now before the next transaction changes it.  */
+    if ((urb_state == URB_NOTREADY) && (hcd_stm32 != UX_NULL))
+    {
+        ed =  hcd_stm32 -> ux_hcd_stm32_channels_ed[chnum];
+        if (ed != UX_NULL)
+        {
+            if (hhcd -> hc[chnum].ErrCnt != 0U)
+                ed -> ux_stm32_ed_statistics.ux_hcd_stm32_ed_statistics_retries++;
+            else
+                ed -> ux_stm32_ed_statistics.ux_hcd_stm32_ed_statistics_naks++;
+        }
+    }
+#endif /* UX_HCD_STM32_ED_STATISTICS_ENABLE */
+
+#if defined(UX_HCD_STM32_DEFERRED_URB_ENABLE)
+    /* Check if the URB processing is deferred to the HCD thread.  */
+    if ((hcd_stm32 != UX_NULL) && (hcd_stm32 -> ux_hcd_stm32_urb_deferred))
+    {
+
+#if defined(UX_HCD_STM32_BULK_OUT_REFILL_ENABLE)
+
+        /* The streaming channel is halted, stop writing the FIFO for it.  */
+        ed =  hcd_stm32 -> ux_hcd_stm32_refill_ed;
+        if ((ed != UX_NULL) && (ed -> ux_stm32_ed_channel == chnum))
+            hhcd -> Instance -> GINTMSK &=  ~USB_OTG_GINTMSK_NPTXFEM;
+#endif /* UX_HCD_STM32_BULK_OUT_REFILL_ENABLE */
+
+        /* A NAK is merged into the NAK event pending for the channel.  */
+        if (urb_state == URB_NOTREADY)
+        {
+            if (hcd_stm32 -> ux_hcd_stm32_urb_notready_pending & (1UL << chnum))
+                return;
+        }
+
+        /* Check for room in the ring.  */
+        head =  hcd_stm32 -> ux_hcd_stm32_urb_event_head;
+        depth =  head - hcd_stm32 -> ux_hcd_stm32_urb_event_tail;
+        if (depth < UX_HCD_STM32_URB_EVENT_RING_SIZE)
+        {
+
+            /* Record the URB state change with the ED and transfer it is for.  */
+            ed =  hcd_stm32 -> ux_hcd_stm32_channels_ed[chnum];
+            urb_event =  &hcd_stm32 -> ux_hcd_stm32_urb_events[head & (UX_HCD_STM32_URB_EVENT_RING_SIZE - 1U)];
+            urb_event -> ux_hcd_stm32_urb_event_ed =  ed;
+            urb_event -> ux_hcd_stm32_urb_event_transfer =  (ed != UX_NULL) ? ed -> ux_stm32_ed_transfer_request : UX_NULL;
+            urb_event -> ux_hcd_stm32_urb_event_channel =  chnum;
+            urb_event -> ux_hcd_stm32_urb_event_state =  (UCHAR) urb_state;
+            urb_event -> ux_hcd_stm32_urb_event_xfer_count =  HAL_HCD_HC_GetXferCount(hhcd, chnum);
+
+            /* The channel has a NAK event pending.  */
+            if (urb_state == URB_NOTREADY)
+                hcd_stm32 -> ux_hcd_stm32_urb_notready_pending |=  (1UL << chnum);
+
+            /* Publish the event.  */
+            hcd_stm32 -> ux_hcd_stm32_urb_event_head =  head + 1U;
+
+            /* Keep the deepest ring level seen.  */
+            if (depth + 1U > hcd_stm32 -> ux_hcd_stm32_urb_event_depth_max)
+                hcd_stm32 -> ux_hcd_stm32_urb_event_depth_max =  depth + 1U;
+
+            /* The HCD thread drains the ring until empty, wake it up only if it was empty.  */
+            if (depth == 0U)
+            {
+                hcd -> ux_hcd_thread_signal++;
+                _ux_host_semaphore_put(&_ux_system_host -> ux_system_host_hcd_semaphore);
+            }
+            return;
+        }
 
+        /* The ring is full, the URB is processed here.  */
+        hcd_stm32 -> ux_hcd_stm32_urb_event_overflows++;
+
+        /* The events of its channel still in the ring are processed first, in order.  */
+        for (tail =  hcd_stm32 -> ux_hcd_stm32_urb_event_tail; tail != head; tail++)
+        {
+            urb_event =  &hcd_stm32 -> ux_hcd_stm32_urb_events[tail & (UX_HCD_STM32_URB_EVENT_RING_SIZE - 1U)];
+            if (urb_event -> ux_hcd_stm32_urb_event_channel == chnum)
+                _ux_hcd_stm32_urb_event_process(hcd_stm32, urb_event);
         }
+
+        /* A NAK is stale if the older events submitted the channel again.  */
+        if ((urb_state == URB_NOTREADY) && (HAL_HCD_HC_GetURBState(hhcd, chnum) != URB_NOTREADY))
+            return;
     }
+#endif /* UX_HCD_STM32_DEFERRED_URB_ENABLE */
+
+    /* Process the URB state change.  */
+    _ux_hcd_stm32_urb_process(hhcd, chnum, urb_state, HAL_HCD_HC_GetXferCount(hhcd, chnum));
 }
 
 
@@ -479,6 +748,7 @@ UX_TRANSFER         *transfer_next;
 /*                                            resulting in version 6.1.10 */
 /*                                                                        */
 /**************************************************************************/
+__USB_RAM_FUNC
 void HAL_HCD_SOF_Callback(HCD_HandleTypeDef *hhcd)
 {
 
@@ -490,6 +760,13 @@ UX_HCD_STM32        *hcd_stm32;
     hcd = (UX_HCD*)hhcd -> pData;
     hcd_stm32 = (UX_HCD_STM32*)hcd -> ux_hcd_controller_hardware;
 
+#if defined(UX_HCD_STM32_NAK_BACKOFF_ENABLE)
+
+    /* Retry the NAKed transfers that are due.  */
+    if (hcd_stm32 -> ux_hcd_stm32_nak_deferred != 0)
+        _ux_hcd_stm32_nak_resume(hcd_stm32);
+#endif /* UX_HCD_STM32_NAK_BACKOFF_ENABLE */
+
     if ((hcd_stm32 -> ux_hcd_stm32_controller_flag & UX_HCD_STM32_CONTROLLER_FLAG_SOF) == 0)
     {
         hcd_stm32 -> ux_hcd_stm32_controller_flag |= UX_HCD_STM32_CONTROLLER_FLAG_SOF;
@@ -499,3 +776,58 @@ UX_HCD_STM32        *hcd_stm32;
         _ux_host_semaphore_put(&_ux_system_host -> ux_system_host_hcd_semaphore);
     }
 }
+
+
+#if defined(UX_HCD_STM32_BULK_OUT_REFILL_ENABLE)
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    HAL_HCD_NPTxFifoEmpty_Callback                      PORTABLE C      */
+/*                                                           6.1.10       */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function handles the non-periodic TX FIFO empty callback from  */
+/*    HAL driver, the FIFO is refilled with the streaming bulk OUT data.  */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    hhcd                                  Pointer to HCD handle         */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_hcd_stm32_bulk_out_refill         Refill bulk OUT FIFO          */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    stm32 Controller Driver                                             */
+/*                                                                        */
+/**************************************************************************/
+__USB_RAM_FUNC
+void HAL_HCD_NPTxFifoEmpty_Callback(HCD_HandleTypeDef *hhcd)
+{
+
+UX_HCD              *hcd;
+UX_HCD_STM32        *hcd_stm32;
+
+
+    /* Get the pointer to the HCD & HCD_STM32.  */
+    hcd = (UX_HCD*)hhcd -> pData;
+    hcd_stm32 = (UX_HCD_STM32*)hcd -> ux_hcd_controller_hardware;
+
+    /* Check if driver is still valid.  */
+    if (hcd_stm32 == UX_NULL)
+    {
+        hhcd -> Instance -> GINTMSK &=  ~USB_OTG_GINTMSK_NPTXFEM;
+        return;
+    }
+
+    /* Write the FIFO.  */
+    _ux_hcd_stm32_bulk_out_refill(hcd_stm32);
+}
+#endif /* UX_HCD_STM32_BULK_OUT_REFILL_ENABLE */
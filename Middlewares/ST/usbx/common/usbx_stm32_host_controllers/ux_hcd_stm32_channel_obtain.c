@@ -0,0 +1,107 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   STM32 Controller Driver                                             */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+#define UX_HCD_STM32_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_hcd_stm32.h"
+#include "ux_host_stack.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_hcd_stm32_channel_obtain                        PORTABLE C      */
+/*                                                           6.1.10       */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function obtains a free host channel for an ED. The channel is */
+/*    saved in the ED and the ED in the channel table.                    */
+/*                                                                        */
+/*    With the bitmap allocation, the lowest free channel is taken from   */
+/*    the free channel bitmap in constant time. Otherwise the channel     */
+/*    table is parsed.                                                    */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    hcd_stm32                             Pointer to STM32 controller   */
+/*    ed                                    Pointer to STM32 ED           */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Channel index or UX_HCD_STM32_NO_CHANNEL_ASSIGNED                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_hcd_stm32_endpoint_create         Create endpoint               */
+/*                                                                        */
+/**************************************************************************/
+ULONG  _ux_hcd_stm32_channel_obtain(UX_HCD_STM32 *hcd_stm32, UX_HCD_STM32_ED *ed)
+{
+
+ULONG       channel_index;
+
+
+#if defined(UX_HCD_STM32_BITMAP_ALLOCATION_ENABLE)
+
+    /* Check if there is a free channel.  */
+    if (hcd_stm32 -> ux_hcd_stm32_free_channels == 0)
+        return(UX_HCD_STM32_NO_CHANNEL_ASSIGNED);
+
+    /* Take the lowest free channel.  */
+    channel_index =  UX_HCD_STM32_LOWEST_BIT(hcd_stm32 -> ux_hcd_stm32_free_channels);
+    hcd_stm32 -> ux_hcd_stm32_free_channels &=  ~(1UL << channel_index);
+#else
+
+    /* Look for a free channel.  */
+    for (channel_index = 0; channel_index < hcd_stm32 -> ux_hcd_stm32_nb_channels; channel_index++)
+    {
+
+        /* Check if that Channel is free.  */
+        if (hcd_stm32 -> ux_hcd_stm32_channels_ed[channel_index]  == UX_NULL)
+            break;
+    }
+
+    /* Check if there is a free channel.  */
+    if (channel_index == hcd_stm32 -> ux_hcd_stm32_nb_channels)
+        return(UX_HCD_STM32_NO_CHANNEL_ASSIGNED);
+#endif /* UX_HCD_STM32_BITMAP_ALLOCATION_ENABLE */
+
+    /* We have a channel. Save it. */
+    hcd_stm32 -> ux_hcd_stm32_channels_ed[channel_index] = ed;
+
+    /* And in the endpoint too. */
+    ed -> ux_stm32_ed_channel = (UCHAR) channel_index;
+
+    /* Return the channel.  */
+    return(channel_index);
+}
@@ -0,0 +1,74 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   STM32 Controller Driver                                             */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+#define UX_HCD_STM32_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_hcd_stm32.h"
+#include "ux_host_stack.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_hcd_stm32_channel_release                       PORTABLE C      */
+/*                                                           6.1.10       */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function frees the host channel of an ED.                      */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    hcd_stm32                             Pointer to STM32 controller   */
+/*    ed                                    Pointer to STM32 ED           */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_hcd_stm32_endpoint_destroy        Destroy endpoint              */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_hcd_stm32_channel_release(UX_HCD_STM32 *hcd_stm32, UX_HCD_STM32_ED *ed)
+{
+
+    /* We need to free the channel.  */
+    hcd_stm32 -> ux_hcd_stm32_channels_ed[ed -> ux_stm32_ed_channel] =  UX_NULL;
+
+#if defined(UX_HCD_STM32_BITMAP_ALLOCATION_ENABLE)
+
+    /* The channel can be obtained again.  */
+    hcd_stm32 -> ux_hcd_stm32_free_channels |=  1UL << ed -> ux_stm32_ed_channel;
+#endif /* UX_HCD_STM32_BITMAP_ALLOCATION_ENABLE */
+}
@@ -73,6 +73,41 @@ UX_HCD_STM32_ED  *_ux_hcd_stm32_ed_obtain(UX_HCD_STM32 *hcd_stm32)
 
 UX_HCD_STM32_ED       *ed;
 ULONG                 ed_index;
+#if defined(UX_HCD_STM32_BITMAP_ALLOCATION_ENABLE)
+ULONG                 word_index;
+ULONG                 free_eds;
+
+
+    /* Look for a bitmap word with a free ED.  */
+    for (word_index = 0; word_index < UX_HCD_STM32_ED_BITMAP_WORDS; word_index++)
+    {
+
+        /* Check if the word has a free ED.  */
+        free_eds =  hcd_stm32 -> ux_hcd_stm32_free_eds[word_index];
+        if (free_eds == 0)
+            continue;
+
+        /* Take the lowest free ED of the word.  */
+        ed_index =  UX_HCD_STM32_LOWEST_BIT(free_eds);
+        hcd_stm32 -> ux_hcd_stm32_free_eds[word_index] &=  ~(1UL << ed_index);
+        ed =  hcd_stm32 -> ux_hcd_stm32_ed_list + (word_index << 5) + ed_index;
+
+        /* The ED may have been used, so we reset all fields.  */
+        _ux_utility_memory_set(ed, 0, sizeof(UX_HCD_STM32_ED));
+
+        /* This ED is now marked as ALLOCATED.  */
+        ed -> ux_stm32_ed_status =  UX_HCD_STM32_ED_STATUS_ALLOCATED;
+
+        /* Reset the channel.  */
+        ed -> ux_stm32_ed_channel =  UX_HCD_STM32_NO_CHANNEL_ASSIGNED;
+
+        /* Return ED pointer.  */
+        return(ed);
+    }
+
+    /* There is no available ED in the ED list.  */
+    return(UX_NULL);
+#else
 
 
     /* Start the search from the beginning of the list.  */
@@ -103,5 +138,6 @@ ULONG                 ed_index;
 
     /* There is no available ED in the ED list.  */
     return(UX_NULL);
+#endif /* UX_HCD_STM32_BITMAP_ALLOCATION_ENABLE */
 }
 
@@ -0,0 +1,80 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   STM32 Controller Driver                                             */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+#define UX_HCD_STM32_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_hcd_stm32.h"
+#include "ux_host_stack.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_hcd_stm32_ed_release                            PORTABLE C      */
+/*                                                           6.1.10       */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function frees an ED obtained with _ux_hcd_stm32_ed_obtain.    */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    hcd_stm32                             Pointer to STM32 controller   */
+/*    ed                                    Pointer to STM32 ED           */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_hcd_stm32_endpoint_create         Create endpoint               */
+/*    _ux_hcd_stm32_endpoint_destroy        Destroy endpoint              */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_hcd_stm32_ed_release(UX_HCD_STM32 *hcd_stm32, UX_HCD_STM32_ED *ed)
+{
+
+#if defined(UX_HCD_STM32_BITMAP_ALLOCATION_ENABLE)
+ULONG       ed_index;
+
+
+    /* The ED can be obtained again.  */
+    ed_index =  (ULONG) (ed - hcd_stm32 -> ux_hcd_stm32_ed_list);
+    hcd_stm32 -> ux_hcd_stm32_free_eds[ed_index >> 5] |=  1UL << (ed_index & 31U);
+#else
+    UX_PARAMETER_NOT_USED(hcd_stm32);
+#endif /* UX_HCD_STM32_BITMAP_ALLOCATION_ENABLE */
+
+    /* The ED is free.  */
+    ed -> ux_stm32_ed_status =  UX_HCD_STM32_ED_STATUS_FREE;
+}
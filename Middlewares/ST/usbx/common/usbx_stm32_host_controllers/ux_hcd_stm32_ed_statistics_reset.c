@@ -0,0 +1,86 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   STM32 Controller Driver                                             */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+#define UX_HCD_STM32_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_hcd_stm32.h"
+#include "ux_host_stack.h"
+
+
+#if defined(UX_HCD_STM32_ED_STATISTICS_ENABLE)
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_hcd_stm32_ed_statistics_reset                   PORTABLE C      */
+/*                                                           6.1.10       */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function clears the statistics of all the EDs. The statistics  */
+/*    of an ED are also cleared when the ED is obtained.                  */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    hcd_stm32                             Pointer to STM32 controller   */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_utility_memory_set                Set memory block              */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application                                                         */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_hcd_stm32_ed_statistics_reset(UX_HCD_STM32 *hcd_stm32)
+{
+
+UX_HCD_STM32_ED     *ed;
+ULONG               ed_index;
+UX_INTERRUPT_SAVE_AREA
+
+
+    /* Parse all the EDs.  */
+    ed =  hcd_stm32 -> ux_hcd_stm32_ed_list;
+    for (ed_index = 0; ed_index < _ux_system_host -> ux_system_host_max_ed; ed_index++)
+    {
+
+        /* The interrupt updates the statistics, clear them at once.  */
+        UX_DISABLE
+        _ux_utility_memory_set(&ed -> ux_stm32_ed_statistics, 0, sizeof(UX_HCD_STM32_ED_STATISTICS)); /* Use case of memset is verified. */
+        UX_RESTORE
+
+        /* Point to the next ED.  */
+        ed++;
+    }
+}
+#endif /* UX_HCD_STM32_ED_STATISTICS_ENABLE */
@@ -0,0 +1,125 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   STM32 Controller Driver                                             */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+#define UX_HCD_STM32_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_hcd_stm32.h"
+#include "ux_host_stack.h"
+
+
+#if defined(UX_HCD_STM32_ED_STATISTICS_ENABLE)
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_hcd_stm32_ed_statistics_update                  PORTABLE C      */
+/*                                                           6.1.10       */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function accounts a completed transfer in the statistics of    */
+/*    its ED: transfer and byte counts, errors and stalls, and the time   */
+/*    since its submission in the log2 latency histogram. The SETUP and   */
+/*    data stages of a successful control transfer are not accounted,     */
+/*    its status stage accounts the whole transfer.                       */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    ed                                    Pointer to STM32 ED           */
+/*    transfer_request                      Pointer to transfer request   */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_hcd_stm32_urb_process             Process URB state change      */
+/*                                                                        */
+/**************************************************************************/
+__USB_RAM_FUNC
+VOID  _ux_hcd_stm32_ed_statistics_update(UX_HCD_STM32_ED *ed, UX_TRANSFER *transfer_request)
+{
+
+UX_HCD_STM32_ED_STATISTICS  *statistics;
+ULONG                       latency;
+ULONG                       bucket;
+
+
+    /* A successful control transfer ends with its status stage.  */
+    if ((ed -> ux_stm32_ed_type == EP_TYPE_CTRL) &&
+        (transfer_request -> ux_transfer_request_completion_code == UX_SUCCESS) &&
+        (ed -> ux_stm32_ed_status != UX_HCD_STM32_ED_STATUS_CONTROL_STATUS_IN) &&
+        (ed -> ux_stm32_ed_status != UX_HCD_STM32_ED_STATUS_CONTROL_STATUS_OUT))
+        return;
+
+    /* Get the statistics of the ED.  */
+    statistics =  &ed -> ux_stm32_ed_statistics;
+
+    /* One more transfer.  */
+    statistics -> ux_hcd_stm32_ed_statistics_transfers++;
+
+    /* Account the completion.  */
+    switch (transfer_request -> ux_transfer_request_completion_code)
+    {
+
+    case UX_SUCCESS:
+
+        /* The data of a control transfer was saved before its status stage.  */
+        if (ed -> ux_stm32_ed_type == EP_TYPE_CTRL)
+            statistics -> ux_hcd_stm32_ed_statistics_bytes +=  ed -> ux_stm32_ed_saved_actual_length;
+        else
+            statistics -> ux_hcd_stm32_ed_statistics_bytes +=  transfer_request -> ux_transfer_request_actual_length;
+        break;
+
+    case UX_TRANSFER_STALLED:
+
+        statistics -> ux_hcd_stm32_ed_statistics_stalls++;
+        break;
+
+    default:
+
+        statistics -> ux_hcd_stm32_ed_statistics_errors++;
+        break;
+    }
+
+    /* Get the time since the submission in microseconds.  */
+    latency =  (DWT -> CYCCNT - ed -> ux_stm32_ed_statistics_start) / (SystemCoreClock / 1000000U);
+    if (latency > statistics -> ux_hcd_stm32_ed_statistics_latency_max)
+        statistics -> ux_hcd_stm32_ed_statistics_latency_max =  latency;
+
+    /* Bucket n holds the times of n significant bits.  */
+    bucket =  32U - __CLZ(latency);
+    if (bucket >= UX_HCD_STM32_LATENCY_BUCKETS)
+        bucket =  UX_HCD_STM32_LATENCY_BUCKETS - 1U;
+    statistics -> ux_hcd_stm32_ed_statistics_latency[bucket]++;
+}
+#endif /* UX_HCD_STM32_ED_STATISTICS_ENABLE */
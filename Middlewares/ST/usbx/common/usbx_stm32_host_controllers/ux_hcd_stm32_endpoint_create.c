@@ -57,7 +57,11 @@
 /*  CALLS                                                                 */
 /*                                                                        */
 /*    _ux_hcd_stm32_ed_obtain                 Obtain STM32 ED             */
+/*    _ux_hcd_stm32_ed_release                Release STM32 ED            */
+/*    _ux_hcd_stm32_channel_obtain            Obtain host channel         */
+/*    _ux_hcd_stm32_periodic_load_update      Update periodic load        */
 /*    _ux_hcd_stm32_least_traffic_list_get    Get least traffic list      */
+/*    _ux_hcd_stm32_sof_update                Update SOF interrupt mask   */
 /*                                                                        */
 /*  CALLED BY                                                             */
 /*                                                                        */
@@ -133,31 +137,14 @@ ULONG                   endpoint_bInterval;
         return(UX_NO_ED_AVAILABLE);
 
     /* And get a channel. */
-    for (channel_index = 0; channel_index < hcd_stm32 -> ux_hcd_stm32_nb_channels; channel_index++)
-    {
-
-        /* Check if that Channel is free.  */
-        if (hcd_stm32 -> ux_hcd_stm32_channels_ed[channel_index]  == UX_NULL)
-        {
-
-            /* We have a channel. Save it. */
-            hcd_stm32 -> ux_hcd_stm32_channels_ed[channel_index] = ed;
-
-            /* And in the endpoint too. */
-            ed -> ux_stm32_ed_channel = channel_index;
-
-            /* Done here.  */
-            break;
-
-        }
-    }
+    channel_index =  _ux_hcd_stm32_channel_obtain(hcd_stm32, ed);
 
     /* Check for channel assignment.  */
     if (ed -> ux_stm32_ed_channel ==  UX_HCD_STM32_NO_CHANNEL_ASSIGNED)
     {
 
         /* Free the ED.  */
-        ed -> ux_stm32_ed_status =  UX_HCD_STM32_ED_STATUS_FREE;
+        _ux_hcd_stm32_ed_release(hcd_stm32, ed);
 
         /* Could not allocate a channel.  */
         return(UX_NO_ED_AVAILABLE);
@@ -215,8 +202,25 @@ ULONG                   endpoint_bInterval;
         ed -> ux_stm32_ed_next_ed = hcd_stm32 -> ux_hcd_stm32_periodic_ed_head;
         hcd_stm32 -> ux_hcd_stm32_periodic_ed_head = ed;
 
+#if defined(UX_HCD_STM32_BITMAP_ALLOCATION_ENABLE)
+
+        /* Link the previous head back to the ED.  */
+        if (ed -> ux_stm32_ed_next_ed != UX_NULL)
+            ed -> ux_stm32_ed_next_ed -> ux_stm32_ed_previous_ed = ed;
+
+        /* Add the ED load to the slots it is scheduled in.  */
+        _ux_hcd_stm32_periodic_load_update(hcd_stm32, ed,
+                    (LONG) (endpoint -> ux_endpoint_descriptor.wMaxPacketSize));
+#endif /* UX_HCD_STM32_BITMAP_ALLOCATION_ENABLE */
+
         /* Activate periodic scheduler.  */
         hcd_stm32 -> ux_hcd_stm32_periodic_scheduler_active ++;
+
+#if defined(UX_HCD_STM32_SOF_GATING_ENABLE)
+
+        /* The periodic scheduler needs the SOF interrupt.  */
+        _ux_hcd_stm32_sof_update(hcd_stm32);
+#endif /* UX_HCD_STM32_SOF_GATING_ENABLE */
     }
 
     /* Attach the ED to the endpoint container.  */
@@ -232,7 +236,7 @@ ULONG                   endpoint_bInterval;
     {
 
         /* Free the ED.  */
-        ed -> ux_stm32_ed_status =  UX_HCD_STM32_ED_STATUS_FREE;
+        _ux_hcd_stm32_ed_release(hcd_stm32, ed);
 
         /* High bandwidth are not supported for now.  */
         return(UX_FUNCTION_NOT_SUPPORTED);
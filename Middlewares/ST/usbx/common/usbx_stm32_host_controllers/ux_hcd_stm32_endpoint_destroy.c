@@ -58,6 +58,12 @@
 /*                                                                        */
 /*    _ux_utility_virtual_address           Get virtual address           */
 /*    _ux_utility_delay_ms                  Delay ms                      */
+/*    _ux_hcd_stm32_bulk_out_refill_stop    Stop streaming bulk OUT       */
+/*    _ux_hcd_stm32_channel_release         Release host channel          */
+/*    _ux_hcd_stm32_ed_release              Release STM32 ED              */
+/*    _ux_hcd_stm32_periodic_load_update    Update periodic load          */
+/*    _ux_hcd_stm32_nak_cancel              Cancel NAK retry              */
+/*    _ux_hcd_stm32_sof_update              Update SOF interrupt mask     */
 /*                                                                        */
 /*  CALLED BY                                                             */
 /*                                                                        */
@@ -110,8 +116,19 @@ UINT                   endpoint_type;
     _ux_utility_delay_ms(1);
 #endif /* defined(UX_HOST_STANDALONE) */
 
+#if defined(UX_HCD_STM32_BULK_OUT_REFILL_ENABLE)
+
+    /* The ED must not stream to the FIFO anymore.  */
+    _ux_hcd_stm32_bulk_out_refill_stop(hcd_stm32, ed);
+#endif /* UX_HCD_STM32_BULK_OUT_REFILL_ENABLE */
+#if defined(UX_HCD_STM32_NAK_BACKOFF_ENABLE)
+
+    /* The SOF must not retry the ED anymore.  */
+    _ux_hcd_stm32_nak_cancel(hcd_stm32, ed);
+#endif /* UX_HCD_STM32_NAK_BACKOFF_ENABLE */
+
     /* We need to free the channel.  */
-    hcd_stm32 -> ux_hcd_stm32_channels_ed[ed -> ux_stm32_ed_channel] =  UX_NULL;
+    _ux_hcd_stm32_channel_release(hcd_stm32, ed);
 
     /* Get endpoint type.  */
     endpoint_type = (endpoint -> ux_endpoint_descriptor.bmAttributes) & UX_MASK_ENDPOINT_TYPE;
@@ -120,6 +137,21 @@ UINT                   endpoint_type;
     if ((endpoint_type == UX_INTERRUPT_ENDPOINT) || (endpoint_type == UX_ISOCHRONOUS_ENDPOINT))
     {
 
+#if defined(UX_HCD_STM32_BITMAP_ALLOCATION_ENABLE)
+
+        /* Remove the ED load from the slots it is scheduled in.  */
+        _ux_hcd_stm32_periodic_load_update(hcd_stm32, ed,
+                    -(LONG) (endpoint -> ux_endpoint_descriptor.wMaxPacketSize));
+
+        /* Unlink the ED from its neighbours in the periodic ED list.  */
+        if (ed -> ux_stm32_ed_previous_ed == UX_NULL)
+            hcd_stm32 -> ux_hcd_stm32_periodic_ed_head = ed -> ux_stm32_ed_next_ed;
+        else
+            ed -> ux_stm32_ed_previous_ed -> ux_stm32_ed_next_ed = ed -> ux_stm32_ed_next_ed;
+        if (ed -> ux_stm32_ed_next_ed != UX_NULL)
+            ed -> ux_stm32_ed_next_ed -> ux_stm32_ed_previous_ed = ed -> ux_stm32_ed_previous_ed;
+#else
+
         /* Remove the ED from periodic ED list.  */
         if (hcd_stm32 -> ux_hcd_stm32_periodic_ed_head == ed)
         {
@@ -149,13 +181,20 @@ UINT                   endpoint_type;
                 next_ed -> ux_stm32_ed_next_ed = next_ed -> ux_stm32_ed_next_ed -> ux_stm32_ed_next_ed;
             }
         }
+#endif /* UX_HCD_STM32_BITMAP_ALLOCATION_ENABLE */
 
         /* Decrease the periodic active count.  */
         hcd_stm32 -> ux_hcd_stm32_periodic_scheduler_active --;
+
+#if defined(UX_HCD_STM32_SOF_GATING_ENABLE)
+
+        /* Mask the SOF interrupt if this was the last periodic ED.  */
+        _ux_hcd_stm32_sof_update(hcd_stm32);
+#endif /* UX_HCD_STM32_SOF_GATING_ENABLE */
     }
 
     /* Now we can safely make the ED free.  */
-    ed -> ux_stm32_ed_status =  UX_HCD_STM32_ED_STATUS_FREE;
+    _ux_hcd_stm32_ed_release(hcd_stm32, ed);
 
 #if defined (USBH_HAL_HUB_SPLIT_SUPPORTED)
     HAL_HCD_HC_ClearHubInfo(hcd_stm32->hcd_handle, ed -> ux_stm32_ed_channel);
@@ -65,6 +65,7 @@
 /*    _ux_hcd_stm32_interrupt_endpoint_create     Create endpoint         */
 /*    _ux_hcd_stm32_periodic_endpoint_destroy     Destroy endpoint        */
 /*    _ux_hcd_stm32_periodic_schedule             Schedule periodic       */
+/*    _ux_hcd_stm32_urb_events_process            Process URB events      */
 /*    _ux_hcd_stm32_port_enable                   Enable port             */
 /*    _ux_hcd_stm32_port_disable                  Disable port            */
 /*    _ux_hcd_stm32_port_reset                    Reset port              */
@@ -207,6 +208,12 @@ UX_INTERRUPT_SAVE_AREA
 
     case UX_HCD_PROCESS_DONE_QUEUE:
 
+#if defined(UX_HCD_STM32_DEFERRED_URB_ENABLE)
+
+        /* Process the URB state changes recorded by the interrupt.  */
+        _ux_hcd_stm32_urb_events_process(hcd_stm32);
+
+#endif /* UX_HCD_STM32_DEFERRED_URB_ENABLE */
         /* Process periodic queue.  */
         _ux_hcd_stm32_periodic_schedule(hcd_stm32);
 
@@ -59,6 +59,7 @@
 /*  CALLS                                                                 */
 /*                                                                        */
 /*    _ux_utility_memory_allocate             Allocate memory block       */
+/*    _ux_hcd_stm32_sof_update                Update SOF interrupt mask   */
 /*                                                                        */
 /*  CALLED BY                                                             */
 /*                                                                        */
@@ -75,6 +76,9 @@ UINT  _ux_hcd_stm32_initialize(UX_HCD *hcd)
 {
 
 UX_HCD_STM32          *hcd_stm32;
+#if defined(UX_HCD_STM32_BITMAP_ALLOCATION_ENABLE)
+ULONG                 ed_index;
+#endif
 
 
     /* The controller initialized here is of STM32 type.  */
@@ -125,6 +129,16 @@ UX_HCD_STM32          *hcd_stm32;
         return(UX_MEMORY_INSUFFICIENT);
     }
 
+#if defined(UX_HCD_STM32_BITMAP_ALLOCATION_ENABLE)
+
+    /* All the channels are free.  */
+    hcd_stm32 -> ux_hcd_stm32_free_channels =  (1UL << hcd_stm32 -> ux_hcd_stm32_nb_channels) - 1U;
+
+    /* All the EDs are free.  */
+    for (ed_index = 0; ed_index < _ux_system_host -> ux_system_host_max_ed; ed_index++)
+        hcd_stm32 -> ux_hcd_stm32_free_eds[ed_index >> 5] |=  1UL << (ed_index & 31U);
+#endif /* UX_HCD_STM32_BITMAP_ALLOCATION_ENABLE */
+
     /* Since we know this is a high-speed controller, we can hardwire the version.  */
 #if UX_MAX_DEVICES > 1
     hcd -> ux_hcd_version =  0x200;
@@ -143,6 +157,18 @@ UX_HCD_STM32          *hcd_stm32;
     /* The periodic scheduler is not active.  */
     hcd_stm32 -> ux_hcd_stm32_periodic_scheduler_active =  0;
 
+#if defined(UX_HCD_STM32_DEFERRED_URB_ENABLE)
+
+    /* The URB state changes are processed by the HCD thread.  */
+    hcd_stm32 -> ux_hcd_stm32_urb_deferred =  UX_TRUE;
+#endif /* UX_HCD_STM32_DEFERRED_URB_ENABLE */
+
+#if defined(UX_HCD_STM32_SOF_GATING_ENABLE)
+
+    /* No periodic ED yet, the SOF interrupt is not needed.  */
+    _ux_hcd_stm32_sof_update(hcd_stm32);
+#endif /* UX_HCD_STM32_SOF_GATING_ENABLE */
+
     /* Set the host controller into the operational state.  */
     hcd -> ux_hcd_status =  UX_HCD_STATUS_OPERATIONAL;
 
@@ -72,7 +72,9 @@
 UINT  _ux_hcd_stm32_least_traffic_list_get(UX_HCD_STM32 *hcd_stm32)
 {
 
+#if !defined(UX_HCD_STM32_BITMAP_ALLOCATION_ENABLE)
 UX_HCD_STM32_ED     *ed;
+#endif
 UINT                list_index;
 ULONG               min_bandwidth_used;
 ULONG               bandwidth_used;
@@ -85,6 +87,16 @@ UINT                min_bandwidth_slot;
     /* The first ED is the list candidate for now.  */
     min_bandwidth_slot =  0;
 
+#if defined(UX_HCD_STM32_BITMAP_ALLOCATION_ENABLE)
+
+    /* The load of each slot is kept up to date, compare the slots.  */
+    for (list_index = 0; list_index < UX_HCD_STM32_PERIODIC_SLOTS; list_index++)
+    {
+
+        /* Get the bandwidth used by this list.  */
+        bandwidth_used =  hcd_stm32 -> ux_hcd_stm32_periodic_load[list_index];
+#else
+
     /* All list will be scanned.  */
     for (list_index = 0; list_index < 32; list_index++)
     {
@@ -109,6 +121,7 @@ UINT                min_bandwidth_slot;
             /* Move to next ED.  */
             ed =  ed -> ux_stm32_ed_next_ed;
         }
+#endif /* UX_HCD_STM32_BITMAP_ALLOCATION_ENABLE */
 
         /* We have processed a list, check the bandwidth used by this list.
            If this bandwidth is the minimum, we memorize the ED.  */
@@ -0,0 +1,139 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   STM32 Controller Driver                                             */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+#define UX_HCD_STM32_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_hcd_stm32.h"
+#include "ux_host_stack.h"
+
+
+#if defined(UX_HCD_STM32_NAK_BACKOFF_ENABLE)
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_hcd_stm32_nak_backoff                           PORTABLE C      */
+/*                                                           6.1.10       */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function accounts a NAK of a control or bulk channel and       */
+/*    decides if the retry is deferred.                                   */
+/*                                                                        */
+/*    The NAKs are counted until the transfer makes progress. Below       */
+/*    UX_HCD_STM32_NAK_BACKOFF_THRESHOLD consecutive NAKs the caller      */
+/*    retries at once. Past it, the retry is deferred to the next SOF,    */
+/*    then twice as many frames on each NAK that follows, up to           */
+/*    UX_HCD_STM32_NAK_BACKOFF_FRAMES_MAX frames. An IN channel is        */
+/*    re-enabled by HAL on NAK, it is halted until the deferred retry.    */
+/*                                                                        */
+/*    Transaction errors are not NAKs, they are always retried at once.   */
+/*    A NAK reported while the retry of the ED is already deferred leaves */
+/*    the deferral as it is.                                              */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    hcd_stm32                             Pointer to STM32 controller   */
+/*    ed                                    Pointer to STM32 ED           */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    UX_TRUE if the retry is deferred, UX_FALSE to retry at once         */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    USB_HC_Halt                           Halt host channel             */
+/*    _ux_hcd_stm32_sof_update              Update SOF interrupt mask     */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    HAL_HCD_HC_NotifyURBChange_Callback   URB change callback           */
+/*                                                                        */
+/**************************************************************************/
+__USB_RAM_FUNC
+UINT  _ux_hcd_stm32_nak_backoff(UX_HCD_STM32 *hcd_stm32, UX_HCD_STM32_ED *ed)
+{
+
+HCD_HCTypeDef       *hc;
+ULONG               channel;
+ULONG               progress;
+
+
+    /* Get the HAL channel.  */
+    channel =  ed -> ux_stm32_ed_channel;
+    hc =  &hcd_stm32 -> hcd_handle -> hc[channel];
+
+    /* The retry is already deferred, do not count the ED twice.  */
+    if (ed -> ux_stm32_ed_nak_frames != 0)
+        return(UX_TRUE);
+
+    /* A transaction error is retried at once, HAL counts them.  */
+    if (hc -> ErrCnt != 0U)
+        return(UX_FALSE);
+
+    /* One more NAK on the channel.  */
+    hcd_stm32 -> ux_hcd_stm32_channel_naks[channel]++;
+
+    /* Restart the count if data moved since the last NAK.  */
+    progress =  ed -> ux_stm32_ed_transfer_request -> ux_transfer_request_actual_length + hc -> xfer_count;
+    if (progress != ed -> ux_stm32_ed_nak_progress)
+    {
+        ed -> ux_stm32_ed_nak_progress =  progress;
+        ed -> ux_stm32_ed_nak_count =  0;
+        ed -> ux_stm32_ed_nak_backoff =  0;
+    }
+
+    /* Retry at once below the threshold.  */
+    ed -> ux_stm32_ed_nak_count++;
+    if (ed -> ux_stm32_ed_nak_count < UX_HCD_STM32_NAK_BACKOFF_THRESHOLD)
+        return(UX_FALSE);
+
+    /* Wait one frame first, then double the wait on each NAK.  */
+    if (ed -> ux_stm32_ed_nak_backoff == 0)
+        ed -> ux_stm32_ed_nak_backoff =  1;
+    else
+        ed -> ux_stm32_ed_nak_backoff =  UX_MIN(ed -> ux_stm32_ed_nak_backoff << 1, UX_HCD_STM32_NAK_BACKOFF_FRAMES_MAX);
+
+    /* The retry is done from the SOF.  */
+    ed -> ux_stm32_ed_nak_frames =  ed -> ux_stm32_ed_nak_backoff;
+    hcd_stm32 -> ux_hcd_stm32_nak_deferred++;
+    hcd_stm32 -> ux_hcd_stm32_channel_nak_deferrals[channel]++;
+
+#if defined(UX_HCD_STM32_SOF_GATING_ENABLE)
+
+    /* The deferral is counted down on each SOF.  */
+    _ux_hcd_stm32_sof_update(hcd_stm32);
+#endif /* UX_HCD_STM32_SOF_GATING_ENABLE */
+
+    /* HAL has already re-enabled an IN channel, stop it until then.  */
+    if (ed -> ux_stm32_ed_dir == 1U)
+        USB_HC_Halt(hcd_stm32 -> hcd_handle -> Instance, (uint8_t) channel);
+
+    /* The retry is deferred.  */
+    return(UX_TRUE);
+}
+#endif
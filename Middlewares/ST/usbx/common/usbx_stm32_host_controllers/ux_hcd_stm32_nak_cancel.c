@@ -0,0 +1,98 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   STM32 Controller Driver                                             */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+#define UX_HCD_STM32_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_hcd_stm32.h"
+#include "ux_host_stack.h"
+
+
+#if defined(UX_HCD_STM32_NAK_BACKOFF_ENABLE)
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_hcd_stm32_nak_cancel                            PORTABLE C      */
+/*                                                           6.1.10       */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function cancels the deferred NAK retry of the ED, if any, and */
+/*    resets its NAK count. It is called when the transfer of the ED is   */
+/*    aborted, when the ED is destroyed and on any URB state but a NAK.   */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    hcd_stm32                             Pointer to STM32 controller   */
+/*    ed                                    Pointer to STM32 ED           */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_hcd_stm32_sof_update              Update SOF interrupt mask     */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_hcd_stm32_transfer_abort          Abort transfer                */
+/*    _ux_hcd_stm32_endpoint_destroy        Destroy endpoint              */
+/*    _ux_hcd_stm32_removal_abort           Abort transfers on removal    */
+/*    _ux_hcd_stm32_urb_process             Process URB state change      */
+/*                                                                        */
+/**************************************************************************/
+__USB_RAM_FUNC
+VOID  _ux_hcd_stm32_nak_cancel(UX_HCD_STM32 *hcd_stm32, UX_HCD_STM32_ED *ed)
+{
+
+UX_INTERRUPT_SAVE_AREA
+
+
+    UX_DISABLE
+
+    /* The SOF must not retry the ED anymore.  */
+    if (ed -> ux_stm32_ed_nak_frames != 0)
+    {
+        ed -> ux_stm32_ed_nak_frames =  0;
+        hcd_stm32 -> ux_hcd_stm32_nak_deferred--;
+
+#if defined(UX_HCD_STM32_SOF_GATING_ENABLE)
+
+        /* Mask the SOF interrupt if it is not needed anymore.  */
+        if (hcd_stm32 -> ux_hcd_stm32_nak_deferred == 0)
+            _ux_hcd_stm32_sof_update(hcd_stm32);
+#endif /* UX_HCD_STM32_SOF_GATING_ENABLE */
+    }
+
+    /* Start the next transfer with no NAK.  */
+    ed -> ux_stm32_ed_nak_count =  0;
+    ed -> ux_stm32_ed_nak_backoff =  0;
+
+    UX_RESTORE
+}
+#endif
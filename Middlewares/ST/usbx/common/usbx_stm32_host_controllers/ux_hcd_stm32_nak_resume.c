@@ -0,0 +1,103 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   STM32 Controller Driver                                             */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+#define UX_HCD_STM32_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_hcd_stm32.h"
+#include "ux_host_stack.h"
+
+
+#if defined(UX_HCD_STM32_NAK_BACKOFF_ENABLE)
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_hcd_stm32_nak_resume                            PORTABLE C      */
+/*                                                           6.1.10       */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function is called on each SOF while retries are deferred by   */
+/*    the NAK back-off. It counts down the frames of each deferred ED and */
+/*    retries the transfer of the EDs that are due.                       */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    hcd_stm32                             Pointer to STM32 controller   */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_hcd_stm32_nak_retry               Retry NAKed transfer          */
+/*    _ux_hcd_stm32_sof_update              Update SOF interrupt mask     */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    HAL_HCD_SOF_Callback                  SOF callback                  */
+/*                                                                        */
+/**************************************************************************/
+__USB_RAM_FUNC
+VOID  _ux_hcd_stm32_nak_resume(UX_HCD_STM32 *hcd_stm32)
+{
+
+UX_HCD_STM32_ED     *ed;
+ULONG               channel;
+
+
+    /* Look for the deferred EDs.  */
+    for (channel = 0; channel < hcd_stm32 -> ux_hcd_stm32_nb_channels; channel++)
+    {
+
+        /* Check if the channel waits for its retry.  */
+        ed =  hcd_stm32 -> ux_hcd_stm32_channels_ed[channel];
+        if ((ed == UX_NULL) || (ed -> ux_stm32_ed_nak_frames == 0))
+            continue;
+
+        /* One frame less to wait.  */
+        ed -> ux_stm32_ed_nak_frames--;
+        if (ed -> ux_stm32_ed_nak_frames != 0)
+            continue;
+
+        /* The ED is not deferred anymore.  */
+        hcd_stm32 -> ux_hcd_stm32_nak_deferred--;
+
+        /* Retry if the transfer is still there.  */
+        if (ed -> ux_stm32_ed_transfer_request != UX_NULL)
+            _ux_hcd_stm32_nak_retry(hcd_stm32, ed);
+    }
+
+#if defined(UX_HCD_STM32_SOF_GATING_ENABLE)
+
+    /* Mask the SOF interrupt if it is not needed anymore.  */
+    if (hcd_stm32 -> ux_hcd_stm32_nak_deferred == 0)
+        _ux_hcd_stm32_sof_update(hcd_stm32);
+#endif /* UX_HCD_STM32_SOF_GATING_ENABLE */
+}
+#endif
@@ -0,0 +1,118 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   STM32 Controller Driver                                             */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+#define UX_HCD_STM32_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_hcd_stm32.h"
+#include "ux_host_stack.h"
+
+
+#if defined(UX_HCD_STM32_NAK_BACKOFF_ENABLE)
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_hcd_stm32_nak_retry                             PORTABLE C      */
+/*                                                           6.1.10       */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function retries the transfer of an ED that was NAKed, after   */
+/*    its NAK back-off.                                                   */
+/*                                                                        */
+/*    An OUT transfer is submitted again from the data not acknowledged,  */
+/*    as the URB callback does for an immediate retry. An IN channel was  */
+/*    halted with its remaining size, it is enabled again.                */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    hcd_stm32                             Pointer to STM32 controller   */
+/*    ed                                    Pointer to STM32 ED           */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    HAL_HCD_HC_SubmitRequest              Submit request                */
+/*    _ux_hcd_stm32_bulk_out_refill_start   Start streaming bulk OUT      */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_hcd_stm32_nak_resume              Resume deferred retries       */
+/*                                                                        */
+/**************************************************************************/
+__USB_RAM_FUNC
+VOID  _ux_hcd_stm32_nak_retry(UX_HCD_STM32 *hcd_stm32, UX_HCD_STM32_ED *ed)
+{
+
+UX_TRANSFER         *transfer_request;
+uint32_t            USBx_BASE;
+ULONG               hcchar;
+
+
+    /* Get the transfer request.  */
+    transfer_request =  ed -> ux_stm32_ed_transfer_request;
+
+    /* Check the request direction.  */
+    if (ed -> ux_stm32_ed_dir == 1U)
+    {
+
+        /* Enable the channel again, it continues with the data left.  */
+        USBx_BASE =  (uint32_t) hcd_stm32 -> hcd_handle -> Instance;
+        hcchar =  USBx_HC(ed -> ux_stm32_ed_channel) -> HCCHAR;
+        hcchar &=  ~USB_OTG_HCCHAR_CHDIS;
+        hcchar |=  USB_OTG_HCCHAR_CHENA;
+        USBx_HC(ed -> ux_stm32_ed_channel) -> HCCHAR =  hcchar;
+        return;
+    }
+
+#if defined(UX_HCD_STM32_BULK_OUT_REFILL_ENABLE)
+
+    /* Stream a multi-packet bulk OUT again.  */
+    if ((ed -> ux_stm32_ed_status == UX_HCD_STM32_ED_STATUS_BULK_OUT) &&
+        (ed -> ux_stm32_ed_packet_length > ed -> ux_stm32_ed_endpoint -> ux_endpoint_descriptor.wMaxPacketSize))
+    {
+        if (_ux_hcd_stm32_bulk_out_refill_start(hcd_stm32, ed,
+                                                ed -> ux_stm32_ed_data + transfer_request -> ux_transfer_request_actual_length,
+                                                ed -> ux_stm32_ed_packet_length) == UX_SUCCESS)
+            return;
+
+        /* Another transfer streams, send one packet at a time.  */
+        ed -> ux_stm32_ed_packet_length =  ed -> ux_stm32_ed_endpoint -> ux_endpoint_descriptor.wMaxPacketSize;
+    }
+#endif /* UX_HCD_STM32_BULK_OUT_REFILL_ENABLE */
+
+    /* Submit the transmit request.  */
+    HAL_HCD_HC_SubmitRequest(hcd_stm32 -> hcd_handle, ed -> ux_stm32_ed_channel, 0,
+                            ((ed -> ux_stm32_ed_endpoint -> ux_endpoint_descriptor.bmAttributes) & UX_MASK_ENDPOINT_TYPE) == UX_BULK_ENDPOINT ? EP_TYPE_BULK : EP_TYPE_CTRL,
+                             ed -> ux_stm32_ed_status == UX_HCD_STM32_ED_STATUS_CONTROL_SETUP ? USBH_PID_SETUP : USBH_PID_DATA,
+                             ed -> ux_stm32_ed_data + transfer_request -> ux_transfer_request_actual_length,
+                             ed -> ux_stm32_ed_packet_length, 0);
+}
+#endif
@@ -0,0 +1,81 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   STM32 Controller Driver                                             */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+#define UX_HCD_STM32_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_hcd_stm32.h"
+#include "ux_host_stack.h"
+
+
+#if defined(UX_HCD_STM32_BITMAP_ALLOCATION_ENABLE)
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_hcd_stm32_periodic_load_update                  PORTABLE C      */
+/*                                                           6.1.10       */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function adds the load of a periodic ED to the frame slots it  */
+/*    is scheduled in, or removes it with a negative load. The slots are  */
+/*    the ones _ux_hcd_stm32_least_traffic_list_get compares.             */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    hcd_stm32                             Pointer to STM32 controller   */
+/*    ed                                    Pointer to STM32 ED           */
+/*    load                                  Bytes per frame to add        */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_hcd_stm32_endpoint_create         Create endpoint               */
+/*    _ux_hcd_stm32_endpoint_destroy        Destroy endpoint              */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_hcd_stm32_periodic_load_update(UX_HCD_STM32 *hcd_stm32, UX_HCD_STM32_ED *ed, LONG load)
+{
+
+ULONG       slot;
+
+
+    /* Update each slot the ED is scheduled in.  */
+    for (slot = 0; slot < UX_HCD_STM32_PERIODIC_SLOTS; slot++)
+    {
+        if ((slot & ed -> ux_stm32_ed_interval_mask) == ed -> ux_stm32_ed_interval_position)
+            hcd_stm32 -> ux_hcd_stm32_periodic_load[slot] +=  (ULONG) load;
+    }
+}
+#endif
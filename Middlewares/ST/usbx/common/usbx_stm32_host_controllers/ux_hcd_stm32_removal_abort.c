@@ -0,0 +1,137 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   STM32 Controller Driver                                             */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+#define UX_HCD_STM32_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_hcd_stm32.h"
+#include "ux_host_stack.h"
+
+
+#if defined(UX_HCD_STM32_FAST_REMOVAL_ENABLE)
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_hcd_stm32_removal_abort                         PORTABLE C      */
+/*                                                           6.1.10       */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function completes the transfers pending on all the EDs with   */
+/*    UX_TRANSFER_DEVICE_REMOVED when the root port is disconnected. The  */
+/*    channels are halted and the threads waiting on the transfers are    */
+/*    woken up at once instead of at the end of their timeout.            */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    hcd_stm32                             Pointer to STM32 controller   */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    HAL_HCD_HC_Halt                       Halt host channel             */
+/*    _ux_hcd_stm32_bulk_out_refill_stop    Stop streaming bulk OUT       */
+/*    _ux_hcd_stm32_nak_cancel              Cancel NAK retry              */
+/*    _ux_hcd_stm32_request_trans_finish    Finish transfer               */
+/*    _ux_host_semaphore_put                Put semaphore                 */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    HAL_HCD_Disconnect_Callback           Disconnect callback           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_hcd_stm32_removal_abort(UX_HCD_STM32 *hcd_stm32)
+{
+
+UX_HCD_STM32_ED     *ed;
+UX_TRANSFER         *transfer_request;
+UX_TRANSFER         *transfer_next;
+ULONG               ed_index;
+
+
+    /* Parse all the EDs, the devices behind a hub are gone too.  */
+    ed =  hcd_stm32 -> ux_hcd_stm32_ed_list;
+    for (ed_index = 0; ed_index < _ux_system_host -> ux_system_host_max_ed; ed_index++, ed++)
+    {
+
+        /* Check if a transfer is pending on the ED.  */
+        transfer_request =  ed -> ux_stm32_ed_transfer_request;
+        if ((ed -> ux_stm32_ed_status == UX_HCD_STM32_ED_STATUS_FREE) || (transfer_request == UX_NULL))
+            continue;
+
+        /* Halt the host channel.  */
+        if (ed -> ux_stm32_ed_channel != UX_HCD_STM32_NO_CHANNEL_ASSIGNED)
+            HAL_HCD_HC_Halt(hcd_stm32 -> hcd_handle, ed -> ux_stm32_ed_channel);
+
+#if defined(UX_HCD_STM32_BULK_OUT_REFILL_ENABLE)
+
+        /* Stop streaming to the FIFO.  */
+        _ux_hcd_stm32_bulk_out_refill_stop(hcd_stm32, ed);
+#endif /* UX_HCD_STM32_BULK_OUT_REFILL_ENABLE */
+#if defined(UX_HCD_STM32_NAK_BACKOFF_ENABLE)
+
+        /* Cancel a NAK retry waiting for the SOF.  */
+        _ux_hcd_stm32_nak_cancel(hcd_stm32, ed);
+#endif /* UX_HCD_STM32_NAK_BACKOFF_ENABLE */
+#if defined(UX_HCD_STM32_ED_STATISTICS_ENABLE)
+
+        /* Count the abort of the pending transfer.  */
+        ed -> ux_stm32_ed_statistics.ux_hcd_stm32_ed_statistics_aborts++;
+#endif /* UX_HCD_STM32_ED_STATISTICS_ENABLE */
+
+        /* Finish current transfer.  */
+        _ux_hcd_stm32_request_trans_finish(hcd_stm32, ed);
+
+        /* Late URB state changes of the channel must find no transfer.  */
+        ed -> ux_stm32_ed_transfer_request =  UX_NULL;
+        ed -> ux_stm32_ed_status =  UX_HCD_STM32_ED_STATUS_ABORTED;
+
+        /* Complete the transfer and the ones linked to it.  */
+        while (transfer_request != UX_NULL)
+        {
+
+            /* Get the next transfer before the class reuses this one.  */
+            transfer_next =  transfer_request -> ux_transfer_request_next_transfer_request;
+
+            /* The device is gone.  */
+            transfer_request -> ux_transfer_request_completion_code =  UX_TRANSFER_DEVICE_REMOVED;
+
+            /* Invoke callback function.  */
+            if (transfer_request -> ux_transfer_request_completion_function)
+                transfer_request -> ux_transfer_request_completion_function(transfer_request);
+
+            /* Wake up the transfer request thread.  */
+            _ux_host_semaphore_put(&transfer_request -> ux_transfer_request_semaphore);
+
+            transfer_request =  transfer_next;
+        }
+    }
+}
+#endif /* UX_HCD_STM32_FAST_REMOVAL_ENABLE */
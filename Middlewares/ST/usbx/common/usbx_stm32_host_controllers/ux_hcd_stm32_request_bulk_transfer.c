@@ -61,6 +61,7 @@
 /*  CALLS                                                                 */
 /*                                                                        */
 /*    _ux_hcd_stm32_regular_td_obtain     Obtain regular TD               */
+/*    _ux_hcd_stm32_bulk_out_refill_start Start streaming bulk OUT        */
 /*                                                                        */
 /*  CALLED BY                                                             */
 /*                                                                        */
@@ -185,6 +186,37 @@ UINT                length;
     /* Prepare transactions.  */
     _ux_hcd_stm32_request_trans_prepare(hcd_stm32, ed, transfer_request);
 
+#if defined(UX_HCD_STM32_BULK_OUT_REFILL_ENABLE)
+
+    /* Without DMA, stream a multi-packet OUT transfer through the FIFO.  */
+    if ((direction == 0) && (hcd_stm32 -> hcd_handle -> Init.dma_enable == 0U) &&
+        (transfer_request -> ux_transfer_request_requested_length > endpoint -> ux_endpoint_descriptor.wMaxPacketSize)
+#if defined (USBH_HAL_HUB_SPLIT_SUPPORTED)
+        && (hcd_stm32->hcd_handle->hc[ed -> ux_stm32_ed_channel].do_ssplit == 0U)
+#endif /* USBH_HAL_HUB_SPLIT_SUPPORTED */
+        )
+    {
+
+        /* Send as many packets as the channel can count.  */
+        ed -> ux_stm32_ed_packet_length =  UX_MIN(transfer_request -> ux_transfer_request_requested_length,
+                                                  HC_MAX_PKT_CNT * endpoint -> ux_endpoint_descriptor.wMaxPacketSize);
+
+        /* Start the transfer, the FIFO is refilled from the interrupt.  */
+        if (_ux_hcd_stm32_bulk_out_refill_start(hcd_stm32, ed, ed -> ux_stm32_ed_data, ed -> ux_stm32_ed_packet_length) != UX_SUCCESS)
+        {
+
+            /* Another transfer streams, send one packet at a time.  */
+            ed -> ux_stm32_ed_packet_length = length;
+            HAL_HCD_HC_SubmitRequest(hcd_stm32 -> hcd_handle, ed -> ux_stm32_ed_channel,
+                                     direction,
+                                     EP_TYPE_BULK, USBH_PID_DATA,
+                                     ed -> ux_stm32_ed_data,
+                                     length, 0);
+        }
+    }
+    else
+#endif /* UX_HCD_STM32_BULK_OUT_REFILL_ENABLE */
+
     /* Submit the transfer request.  */
     HAL_HCD_HC_SubmitRequest(hcd_stm32 -> hcd_handle, ed -> ux_stm32_ed_channel,
                              direction,
@@ -409,6 +409,7 @@ UCHAR                   *setup_request;
 #endif /* USBH_HAL_HUB_SPLIT_SUPPORTED */
 
     /* Send the SETUP packet.  */
+    UX_HCD_STM32_ED_STATISTICS_START(ed);
     HAL_HCD_HC_SubmitRequest(hcd_stm32 -> hcd_handle, ed -> ux_stm32_ed_channel,
                              0, EP_TYPE_CTRL, USBH_PID_SETUP, setup_request, 8, 0);
 }
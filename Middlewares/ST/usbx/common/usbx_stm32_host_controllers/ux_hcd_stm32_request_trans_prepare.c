@@ -78,6 +78,10 @@ UINT  _ux_hcd_stm32_request_trans_prepare(UX_HCD_STM32 *hcd_stm32, UX_HCD_STM32_
     /* Save transfer data pointer.  */
     ed -> ux_stm32_ed_data = transfer -> ux_transfer_request_data_pointer;
 
+    /* Control transfers are timed from their SETUP stage.  */
+    if (ed -> ux_stm32_ed_type != EP_TYPE_CTRL)
+        UX_HCD_STM32_ED_STATISTICS_START(ed);
+
     /* If DMA not enabled, nothing to do.  */
     if (!hcd_stm32 -> hcd_handle -> Init.dma_enable)
         return(UX_SUCCESS);
@@ -0,0 +1,103 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   STM32 Controller Driver                                             */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+#define UX_HCD_STM32_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_hcd_stm32.h"
+#include "ux_host_stack.h"
+
+
+#if defined(UX_HCD_STM32_SOF_GATING_ENABLE)
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_hcd_stm32_sof_update                            PORTABLE C      */
+/*                                                           6.1.10       */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function unmasks the SOF interrupt of the controller when the  */
+/*    periodic ED list is not empty or a NAKed retry is deferred, and     */
+/*    masks it otherwise. It must be called each time one of these       */
+/*    conditions may have changed.                                        */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    hcd_stm32                             Pointer to STM32 controller   */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_hcd_stm32_endpoint_create         Create endpoint               */
+/*    _ux_hcd_stm32_endpoint_destroy        Destroy endpoint              */
+/*    _ux_hcd_stm32_initialize              Initialize controller         */
+/*    _ux_hcd_stm32_nak_backoff             Back off NAKed retry          */
+/*    _ux_hcd_stm32_nak_cancel              Cancel NAKed retry            */
+/*    _ux_hcd_stm32_nak_resume              Resume NAKed retries          */
+/*                                                                        */
+/**************************************************************************/
+__USB_RAM_FUNC
+VOID  _ux_hcd_stm32_sof_update(UX_HCD_STM32 *hcd_stm32)
+{
+
+USB_OTG_GlobalTypeDef   *USBx;
+UINT                    sof_needed;
+UX_INTERRUPT_SAVE_AREA
+
+
+    /* Get the controller registers.  */
+    USBx =  hcd_stm32 -> hcd_handle -> Instance;
+
+    UX_DISABLE
+
+    /* The periodic scheduler runs on each SOF.  */
+    sof_needed =  (hcd_stm32 -> ux_hcd_stm32_periodic_ed_head != UX_NULL) ? UX_TRUE : UX_FALSE;
+
+#if defined(UX_HCD_STM32_NAK_BACKOFF_ENABLE)
+
+    /* The deferred NAKed retries are counted down on each SOF.  */
+    if (hcd_stm32 -> ux_hcd_stm32_nak_deferred != 0)
+        sof_needed =  UX_TRUE;
+#endif /* UX_HCD_STM32_NAK_BACKOFF_ENABLE */
+
+    /* Mask or unmask the SOF interrupt.  */
+    if (sof_needed == UX_TRUE)
+        USBx -> GINTMSK |=  USB_OTG_GINTMSK_SOFM;
+    else
+        USBx -> GINTMSK &=  ~USB_OTG_GINTMSK_SOFM;
+
+    UX_RESTORE
+}
+#endif
@@ -62,6 +62,8 @@
 /*                                                                        */
 /*    _ux_utility_delay_ms                   Delay                        */
 /*    HAL_HCD_HC_Halt                        Halt host channel            */
+/*    _ux_hcd_stm32_bulk_out_refill_stop     Stop streaming bulk OUT      */
+/*    _ux_hcd_stm32_nak_cancel               Cancel NAK retry             */
 /*                                                                        */
 /*  CALLED BY                                                             */
 /*                                                                        */
@@ -109,6 +111,24 @@ UX_INTERRUPT_SAVE_AREA
     /* Halt the host channel.  */
     HAL_HCD_HC_Halt(hcd_stm32 -> hcd_handle, ed -> ux_stm32_ed_channel);
 
+#if defined(UX_HCD_STM32_BULK_OUT_REFILL_ENABLE)
+
+    /* Stop streaming to the FIFO.  */
+    _ux_hcd_stm32_bulk_out_refill_stop(hcd_stm32, ed);
+#endif /* UX_HCD_STM32_BULK_OUT_REFILL_ENABLE */
+#if defined(UX_HCD_STM32_NAK_BACKOFF_ENABLE)
+
+    /* Cancel a NAK retry waiting for the SOF.  */
+    _ux_hcd_stm32_nak_cancel(hcd_stm32, ed);
+#endif /* UX_HCD_STM32_NAK_BACKOFF_ENABLE */
+
+#if defined(UX_HCD_STM32_ED_STATISTICS_ENABLE)
+
+    /* Count the abort of a pending transfer.  */
+    if (ed -> ux_stm32_ed_transfer_request != UX_NULL)
+        ed -> ux_stm32_ed_statistics.ux_hcd_stm32_ed_statistics_aborts++;
+#endif /* UX_HCD_STM32_ED_STATISTICS_ENABLE */
+
     /* Save the transfer status in the ED.  */
     ed -> ux_stm32_ed_status = UX_HCD_STM32_ED_STATUS_ABORTED;
 
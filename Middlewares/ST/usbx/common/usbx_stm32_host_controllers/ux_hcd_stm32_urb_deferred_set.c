@@ -0,0 +1,92 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   STM32 Controller Driver                                             */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+#define UX_HCD_STM32_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_hcd_stm32.h"
+#include "ux_host_stack.h"
+
+#if defined(UX_HCD_STM32_DEFERRED_URB_ENABLE)
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_hcd_stm32_urb_deferred_set                      PORTABLE C      */
+/*                                                           6.1.10       */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function switches the URB processing between the HCD thread    */
+/*    and the channel interrupt at run time.                              */
+/*                                                                        */
+/*    When the processing moves to the interrupt, the events left in the */
+/*    URB event ring are processed here first, with interrupts disabled, */
+/*    so a channel URB is never processed ahead of an older event of the  */
+/*    same channel.                                                       */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    hcd_stm32                             Pointer to STM32 controller   */
+/*    deferred                              UX_TRUE for the HCD thread,   */
+/*                                            UX_FALSE for the interrupt  */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_hcd_stm32_urb_event_process       Process URB event             */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application                                                         */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_hcd_stm32_urb_deferred_set(UX_HCD_STM32 *hcd_stm32, UINT deferred)
+{
+
+UX_INTERRUPT_SAVE_AREA
+ULONG                   tail;
+
+
+    UX_DISABLE
+
+    /* Set the processing mode.  */
+    hcd_stm32 -> ux_hcd_stm32_urb_deferred =  deferred;
+
+    /* Drain the ring before the interrupt processes the URBs itself.  */
+    if (deferred == UX_FALSE)
+    {
+        for (tail =  hcd_stm32 -> ux_hcd_stm32_urb_event_tail; tail != hcd_stm32 -> ux_hcd_stm32_urb_event_head; tail++)
+            _ux_hcd_stm32_urb_event_process(hcd_stm32, &hcd_stm32 -> ux_hcd_stm32_urb_events[tail & (UX_HCD_STM32_URB_EVENT_RING_SIZE - 1U)]);
+        hcd_stm32 -> ux_hcd_stm32_urb_event_tail =  tail;
+    }
+
+    UX_RESTORE
+}
+#endif
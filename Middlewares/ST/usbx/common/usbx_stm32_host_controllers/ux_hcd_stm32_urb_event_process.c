@@ -0,0 +1,109 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   STM32 Controller Driver                                             */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+#define UX_HCD_STM32_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_hcd_stm32.h"
+#include "ux_host_stack.h"
+
+#if defined(UX_HCD_STM32_DEFERRED_URB_ENABLE)
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_hcd_stm32_urb_event_process                     PORTABLE C      */
+/*                                                           6.1.10       */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function processes one event of the URB event ring and marks   */
+/*    it processed, an event already processed is skipped. The caller     */
+/*    masks the controller interrupt or is the controller interrupt.      */
+/*                                                                        */
+/*    An event is dropped if its channel moved to another ED or its ED to */
+/*    another transfer since it was recorded. A NAK event is dropped too  */
+/*    if the channel has completed or was submitted again since, HAL URB  */
+/*    state of the channel is then no longer URB_NOTREADY.                */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    hcd_stm32                             Pointer to STM32 controller   */
+/*    urb_event                             Pointer to URB event          */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_hcd_stm32_urb_process             Process URB state change      */
+/*    HAL_HCD_HC_GetURBState                Get URB state                 */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_hcd_stm32_urb_events_process      Process deferred URB events   */
+/*    _ux_hcd_stm32_urb_deferred_set        Set URB processing mode       */
+/*    HAL_HCD_HC_NotifyURBChange_Callback   URB change callback           */
+/*                                                                        */
+/**************************************************************************/
+__USB_RAM_FUNC
+VOID  _ux_hcd_stm32_urb_event_process(UX_HCD_STM32 *hcd_stm32, UX_HCD_STM32_URB_EVENT *urb_event)
+{
+
+UX_HCD_STM32_ED         *ed;
+UCHAR                   channel;
+UINT                    stale;
+
+
+    /* Check if the event was already processed.  */
+    channel =  urb_event -> ux_hcd_stm32_urb_event_channel;
+    if (channel == UX_HCD_STM32_URB_EVENT_PROCESSED)
+        return;
+
+    /* The event is processed now, it must not be processed again.  */
+    urb_event -> ux_hcd_stm32_urb_event_channel =  UX_HCD_STM32_URB_EVENT_PROCESSED;
+
+    /* Check the event is still for the ED and the transfer of the channel.  */
+    ed =  hcd_stm32 -> ux_hcd_stm32_channels_ed[channel];
+    stale =  ((ed == UX_NULL) || (ed != urb_event -> ux_hcd_stm32_urb_event_ed) ||
+              (ed -> ux_stm32_ed_transfer_request != urb_event -> ux_hcd_stm32_urb_event_transfer)) ? UX_TRUE : UX_FALSE;
+
+    /* A NAK event is no longer pending, check the channel is still NAKed.  */
+    if (urb_event -> ux_hcd_stm32_urb_event_state == (UCHAR) URB_NOTREADY)
+    {
+        hcd_stm32 -> ux_hcd_stm32_urb_notready_pending &=  ~(1UL << channel);
+        if (HAL_HCD_HC_GetURBState(hcd_stm32 -> hcd_handle, channel) != URB_NOTREADY)
+            stale =  UX_TRUE;
+    }
+
+    /* Process the URB state change.  */
+    if (stale == UX_FALSE)
+        _ux_hcd_stm32_urb_process(hcd_stm32 -> hcd_handle, channel,
+                                  (HCD_URBStateTypeDef) urb_event -> ux_hcd_stm32_urb_event_state,
+                                  urb_event -> ux_hcd_stm32_urb_event_xfer_count);
+}
+#endif
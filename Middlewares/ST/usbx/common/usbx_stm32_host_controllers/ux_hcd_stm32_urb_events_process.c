@@ -0,0 +1,101 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   STM32 Controller Driver                                             */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+#define UX_HCD_STM32_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_hcd_stm32.h"
+#include "ux_host_stack.h"
+
+
+#if defined(UX_HCD_STM32_DEFERRED_URB_ENABLE)
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_hcd_stm32_urb_events_process                    PORTABLE C      */
+/*                                                           6.1.10       */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function drains the URB event ring from the HCD thread, each   */
+/*    URB state change recorded by the channel interrupt is processed     */
+/*    in order until the ring is empty.                                   */
+/*                                                                        */
+/*    An event already processed from the interrupt, when the ring was    */
+/*    full, is skipped. See _ux_hcd_stm32_urb_event_process for the       */
+/*    events that are dropped.                                            */
+/*                                                                        */
+/*    The controller interrupt is masked while an event is processed, so */
+/*    the processing cannot race with the interrupt on the channels, the  */
+/*    FIFO refill or the NAK retries. The interrupts of other peripherals */
+/*    are not masked.                                                     */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    hcd_stm32                             Pointer to STM32 controller   */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_hcd_stm32_urb_event_process       Process URB event             */
+/*    USB_DisableGlobalInt                  Mask controller interrupt     */
+/*    USB_EnableGlobalInt                   Unmask controller interrupt   */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_hcd_stm32_entry                   HCD entry function            */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_hcd_stm32_urb_events_process(UX_HCD_STM32 *hcd_stm32)
+{
+
+UX_HCD_STM32_URB_EVENT  *urb_event;
+ULONG                   tail;
+
+
+    /* Process the events until the ring is empty.  */
+    tail =  hcd_stm32 -> ux_hcd_stm32_urb_event_tail;
+    while (tail != hcd_stm32 -> ux_hcd_stm32_urb_event_head)
+    {
+
+        /* Get the oldest event.  */
+        urb_event =  &hcd_stm32 -> ux_hcd_stm32_urb_events[tail & (UX_HCD_STM32_URB_EVENT_RING_SIZE - 1U)];
+
+        /* Process the URB state change with the controller interrupt masked.  */
+        USB_DisableGlobalInt(hcd_stm32 -> hcd_handle -> Instance);
+        _ux_hcd_stm32_urb_event_process(hcd_stm32, urb_event);
+        USB_EnableGlobalInt(hcd_stm32 -> hcd_handle -> Instance);
+
+        /* Release the event, the interrupt can reuse its slot.  */
+        tail++;
+        hcd_stm32 -> ux_hcd_stm32_urb_event_tail =  tail;
+    }
+}
+#endif
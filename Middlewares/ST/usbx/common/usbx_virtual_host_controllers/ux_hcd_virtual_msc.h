@@ -0,0 +1,197 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Virtual Mass Storage Controller Driver                              */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  COMPONENT DEFINITION                                   RELEASE        */
+/*                                                                        */
+/*    ux_hcd_virtual_msc.h                                PORTABLE C      */
+/*                                                           6.1.10       */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This file contains all the header and extern functions used by the  */
+/*    USBX host virtual mass storage controller. The controller has no    */
+/*    hardware: it emulates one bulk-only mass storage device attached    */
+/*    to its root port, backed by a disk image. The USBX storage class,   */
+/*    FileX and the application can run and be benchmarked on a host      */
+/*    that has no USB controller.                                         */
+/*                                                                        */
+/**************************************************************************/
+
+#ifndef UX_HCD_VIRTUAL_MSC_H
+#define UX_HCD_VIRTUAL_MSC_H
+
+
+/* Define virtual MSC HCD generic definitions.  */
+
+#define UX_HCD_VIRTUAL_MSC_CONTROLLER                           7U
+#define UX_HCD_VIRTUAL_MSC_NB_ROOT_PORTS                        1U
+#define UX_HCD_VIRTUAL_MSC_MAX_PACKET_COUNT                     256U
+#define UX_HCD_VIRTUAL_MSC_CONTROL_MAX_PACKET_SIZE              64U
+#define UX_HCD_VIRTUAL_MSC_FULL_SPEED_MAX_PACKET_SIZE           64U
+#define UX_HCD_VIRTUAL_MSC_HIGH_SPEED_MAX_PACKET_SIZE           512U
+#define UX_HCD_VIRTUAL_MSC_BULK_IN_ADDRESS                      0x81U
+#define UX_HCD_VIRTUAL_MSC_BULK_OUT_ADDRESS                     0x02U
+#define UX_HCD_VIRTUAL_MSC_NO_STALL                             0xFFFFFFFFUL
+
+#define UX_HCD_VIRTUAL_MSC_DEVICE_DESCRIPTOR_LENGTH             18U
+#define UX_HCD_VIRTUAL_MSC_CONFIGURATION_DESCRIPTOR_LENGTH      32U
+#define UX_HCD_VIRTUAL_MSC_RESPONSE_LENGTH                      36U
+
+
+/* Define the bulk-only transport emulation.  */
+
+#define UX_HCD_VIRTUAL_MSC_BOT_RESET                            0xFFU
+#define UX_HCD_VIRTUAL_MSC_BOT_GET_MAX_LUN                      0xFEU
+
+#define UX_HCD_VIRTUAL_MSC_CBW_SIGNATURE                        0x43425355UL
+#define UX_HCD_VIRTUAL_MSC_CSW_SIGNATURE                        0x53425355UL
+#define UX_HCD_VIRTUAL_MSC_CBW_LENGTH                           31U
+#define UX_HCD_VIRTUAL_MSC_CSW_LENGTH                           13U
+#define UX_HCD_VIRTUAL_MSC_CBW_TAG                              4U
+#define UX_HCD_VIRTUAL_MSC_CBW_DATA_LENGTH                      8U
+#define UX_HCD_VIRTUAL_MSC_CBW_FLAGS                            12U
+#define UX_HCD_VIRTUAL_MSC_CBW_CB                               15U
+#define UX_HCD_VIRTUAL_MSC_CSW_PASSED                           0U
+#define UX_HCD_VIRTUAL_MSC_CSW_FAILED                           1U
+#define UX_HCD_VIRTUAL_MSC_CSW_PHASE_ERROR                      2U
+
+#define UX_HCD_VIRTUAL_MSC_STATE_CBW                            0U
+#define UX_HCD_VIRTUAL_MSC_STATE_DATA_IN                        1U
+#define UX_HCD_VIRTUAL_MSC_STATE_DATA_OUT                       2U
+#define UX_HCD_VIRTUAL_MSC_STATE_CSW                            3U
+
+
+/* Define the emulated SCSI commands and sense data.  */
+
+#define UX_HCD_VIRTUAL_MSC_SCSI_TEST_READY                      0x00U
+#define UX_HCD_VIRTUAL_MSC_SCSI_REQUEST_SENSE                   0x03U
+#define UX_HCD_VIRTUAL_MSC_SCSI_INQUIRY                         0x12U
+#define UX_HCD_VIRTUAL_MSC_SCSI_MODE_SENSE_SHORT                0x1AU
+#define UX_HCD_VIRTUAL_MSC_SCSI_START_STOP                      0x1BU
+#define UX_HCD_VIRTUAL_MSC_SCSI_PREVENT_ALLOW                   0x1EU
+#define UX_HCD_VIRTUAL_MSC_SCSI_READ_FORMAT_CAPACITY            0x23U
+#define UX_HCD_VIRTUAL_MSC_SCSI_READ_CAPACITY                   0x25U
+#define UX_HCD_VIRTUAL_MSC_SCSI_READ10                          0x28U
+#define UX_HCD_VIRTUAL_MSC_SCSI_WRITE10                         0x2AU
+#define UX_HCD_VIRTUAL_MSC_SCSI_VERIFY                          0x2FU
+#define UX_HCD_VIRTUAL_MSC_SCSI_SYNCHRONIZE_CACHE               0x35U
+#define UX_HCD_VIRTUAL_MSC_SCSI_MODE_SENSE                      0x5AU
+
+#define UX_HCD_VIRTUAL_MSC_SENSE_KEY_NO_SENSE                   0x00U
+#define UX_HCD_VIRTUAL_MSC_SENSE_KEY_MEDIUM_ERROR               0x03U
+#define UX_HCD_VIRTUAL_MSC_SENSE_KEY_ILLEGAL_REQUEST            0x05U
+#define UX_HCD_VIRTUAL_MSC_SENSE_KEY_DATA_PROTECT               0x07U
+#define UX_HCD_VIRTUAL_MSC_SENSE_CODE_INVALID_COMMAND           0x20U
+#define UX_HCD_VIRTUAL_MSC_SENSE_CODE_LBA_OUT_OF_RANGE          0x21U
+#define UX_HCD_VIRTUAL_MSC_SENSE_CODE_WRITE_PROTECTED           0x27U
+#define UX_HCD_VIRTUAL_MSC_SENSE_CODE_UNRECOVERED_READ          0x11U
+#define UX_HCD_VIRTUAL_MSC_SENSE_CODE_WRITE_FAULT               0x03U
+
+
+/* Define the disk image file backend.  The image is a file opened by the application with the
+   standard C library, the FILE pointer is the image context.  This backend is only meant for a
+   build on a host with a file system.
+   The backend is enabled with UX_HCD_VIRTUAL_MSC_FILE_IMAGE_ENABLE.  */
+
+
+/* Define virtual MSC configuration structure.  The structure is given to ux_host_stack_hcd_register
+   as the second HCD parameter and must stay valid as long as the controller is registered.  The
+   latency, NAK and stall fields may be changed at any time, they are read on each transfer.
+   Without read and write functions, the image is the RAM block at ux_hcd_virtual_msc_config_image.  */
+
+typedef struct UX_HCD_VIRTUAL_MSC_CONFIG_STRUCT
+{
+
+    UCHAR                               *ux_hcd_virtual_msc_config_image;
+    VOID                                *ux_hcd_virtual_msc_config_image_context;
+    UINT                                (*ux_hcd_virtual_msc_config_image_read)(VOID *context, ULONG offset, UCHAR *buffer, ULONG length);
+    UINT                                (*ux_hcd_virtual_msc_config_image_write)(VOID *context, ULONG offset, UCHAR *buffer, ULONG length);
+    ULONG                               ux_hcd_virtual_msc_config_block_count;
+    ULONG                               ux_hcd_virtual_msc_config_block_size;
+    ULONG                               ux_hcd_virtual_msc_config_max_packet_size;
+    ULONG                               ux_hcd_virtual_msc_config_latency_ms;
+    ULONG                               ux_hcd_virtual_msc_config_nak_period;
+    ULONG                               ux_hcd_virtual_msc_config_nak_frames;
+    ULONG                               ux_hcd_virtual_msc_config_stall_opcode;
+    UINT                                ux_hcd_virtual_msc_config_write_protected;
+} UX_HCD_VIRTUAL_MSC_CONFIG;
+
+
+/* Define virtual MSC structure.  */
+
+typedef struct UX_HCD_VIRTUAL_MSC_STRUCT
+{
+
+    struct UX_HCD_STRUCT                *ux_hcd_virtual_msc_hcd_owner;
+    UX_HCD_VIRTUAL_MSC_CONFIG           *ux_hcd_virtual_msc_config;
+    UINT                                ux_hcd_virtual_msc_connected;
+    UINT                                ux_hcd_virtual_msc_address;
+    UINT                                ux_hcd_virtual_msc_configuration;
+    UINT                                ux_hcd_virtual_msc_in_halted;
+    UINT                                ux_hcd_virtual_msc_out_halted;
+    UINT                                ux_hcd_virtual_msc_state;
+    ULONG                               ux_hcd_virtual_msc_tag;
+    ULONG                               ux_hcd_virtual_msc_data_length;
+    ULONG                               ux_hcd_virtual_msc_data_done;
+    ULONG                               ux_hcd_virtual_msc_data_available;
+    ULONG                               ux_hcd_virtual_msc_media_offset;
+    UINT                                ux_hcd_virtual_msc_media_access;
+    UINT                                ux_hcd_virtual_msc_stall_data;
+    UCHAR                               ux_hcd_virtual_msc_csw_status;
+    UCHAR                               ux_hcd_virtual_msc_sense_key;
+    UCHAR                               ux_hcd_virtual_msc_sense_code;
+    UCHAR                               reserved;
+    UCHAR                               ux_hcd_virtual_msc_response[UX_HCD_VIRTUAL_MSC_RESPONSE_LENGTH];
+    ULONG                               ux_hcd_virtual_msc_bulk_transfers;
+    ULONG                               ux_hcd_virtual_msc_commands;
+    ULONG                               ux_hcd_virtual_msc_commands_failed;
+    ULONG                               ux_hcd_virtual_msc_bytes_read;
+    ULONG                               ux_hcd_virtual_msc_bytes_written;
+    ULONG                               ux_hcd_virtual_msc_naks;
+    ULONG                               ux_hcd_virtual_msc_stalls;
+} UX_HCD_VIRTUAL_MSC;
+
+
+/* Define virtual MSC function prototypes.  */
+
+UINT                _ux_hcd_virtual_msc_bulk_in(UX_HCD_VIRTUAL_MSC *hcd_virtual_msc, UX_TRANSFER *transfer_request);
+UINT                _ux_hcd_virtual_msc_bulk_out(UX_HCD_VIRTUAL_MSC *hcd_virtual_msc, UX_TRANSFER *transfer_request);
+UINT                _ux_hcd_virtual_msc_command(UX_HCD_VIRTUAL_MSC *hcd_virtual_msc, UCHAR *cbw);
+UINT                _ux_hcd_virtual_msc_control_request(UX_HCD_VIRTUAL_MSC *hcd_virtual_msc, UX_TRANSFER *transfer_request);
+VOID                _ux_hcd_virtual_msc_device_connect(UX_HCD *hcd, UINT connected);
+UINT                _ux_hcd_virtual_msc_endpoint_create(UX_HCD_VIRTUAL_MSC *hcd_virtual_msc, UX_ENDPOINT *endpoint);
+UINT                _ux_hcd_virtual_msc_entry(UX_HCD *hcd, UINT function, VOID *parameter);
+UINT                _ux_hcd_virtual_msc_initialize(UX_HCD *hcd);
+UINT                _ux_hcd_virtual_msc_request_transfer(UX_HCD_VIRTUAL_MSC *hcd_virtual_msc, UX_TRANSFER *transfer_request);
+#if defined(UX_HCD_VIRTUAL_MSC_FILE_IMAGE_ENABLE)
+UINT                _ux_hcd_virtual_msc_file_read(VOID *context, ULONG offset, UCHAR *buffer, ULONG length);
+UINT                _ux_hcd_virtual_msc_file_write(VOID *context, ULONG offset, UCHAR *buffer, ULONG length);
+#endif
+
+#define ux_hcd_virtual_msc_initialize                _ux_hcd_virtual_msc_initialize
+#define ux_hcd_virtual_msc_device_connect            _ux_hcd_virtual_msc_device_connect
+
+
+#endif
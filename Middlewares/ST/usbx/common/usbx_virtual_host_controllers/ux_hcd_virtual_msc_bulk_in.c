@@ -0,0 +1,175 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Virtual Mass Storage Controller Driver                              */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+#define UX_HCD_VIRTUAL_MSC_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_hcd_virtual_msc.h"
+#include "ux_host_stack.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_hcd_virtual_msc_bulk_in                         PORTABLE C      */
+/*                                                           6.1.10       */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function answers a bulk IN transfer as the emulated device: a  */
+/*    piece of the data stage of the current command, or its CSW. The     */
+/*    data stage is read from the disk image or from the device response  */
+/*    buffer. The endpoint is halted, and the transfer stalled, when the  */
+/*    device has no data to send.                                         */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    hcd_virtual_msc                       Pointer to virtual MSC HCD    */
+/*    transfer_request                      Pointer to transfer request   */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_utility_long_put                  Put 32-bit value              */
+/*    _ux_utility_memory_copy               Copy memory block             */
+/*    (image read function)                 Read the disk image           */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_hcd_virtual_msc_request_transfer  Request transfer              */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_hcd_virtual_msc_bulk_in(UX_HCD_VIRTUAL_MSC *hcd_virtual_msc, UX_TRANSFER *transfer_request)
+{
+
+UX_HCD_VIRTUAL_MSC_CONFIG   *config;
+UCHAR                       *data_pointer;
+ULONG                       length;
+UINT                        status;
+
+
+    /* Get the configuration of the device and the buffer of the transfer.  */
+    config =  hcd_virtual_msc -> ux_hcd_virtual_msc_config;
+    data_pointer =  transfer_request -> ux_transfer_request_data_pointer;
+
+    /* A halted endpoint stalls until its halt is cleared.  */
+    if (hcd_virtual_msc -> ux_hcd_virtual_msc_in_halted)
+    {
+        hcd_virtual_msc -> ux_hcd_virtual_msc_stalls++;
+        return(UX_TRANSFER_STALLED);
+    }
+
+    /* Check the stage of the transport.  */
+    switch (hcd_virtual_msc -> ux_hcd_virtual_msc_state)
+    {
+
+    case UX_HCD_VIRTUAL_MSC_STATE_DATA_IN:
+
+        /* Get what is left to send.  */
+        length =  hcd_virtual_msc -> ux_hcd_virtual_msc_data_available - hcd_virtual_msc -> ux_hcd_virtual_msc_data_done;
+        if (length > transfer_request -> ux_transfer_request_requested_length)
+            length =  transfer_request -> ux_transfer_request_requested_length;
+
+        /* Nothing to send, or a failed command: the data stage is stalled.  */
+        if ((length == 0) || hcd_virtual_msc -> ux_hcd_virtual_msc_stall_data)
+            break;
+
+        /* Read the data from the image or from the response.  */
+        if (hcd_virtual_msc -> ux_hcd_virtual_msc_media_access)
+        {
+            if (config -> ux_hcd_virtual_msc_config_image_read)
+                status =  config -> ux_hcd_virtual_msc_config_image_read(config -> ux_hcd_virtual_msc_config_image_context,
+                                        hcd_virtual_msc -> ux_hcd_virtual_msc_media_offset + hcd_virtual_msc -> ux_hcd_virtual_msc_data_done,
+                                        data_pointer, length);
+            else
+            {
+                _ux_utility_memory_copy(data_pointer, config -> ux_hcd_virtual_msc_config_image +
+                                        hcd_virtual_msc -> ux_hcd_virtual_msc_media_offset + hcd_virtual_msc -> ux_hcd_virtual_msc_data_done,
+                                        length); /* Use case of memcpy is verified. */
+                status =  UX_SUCCESS;
+            }
+
+            /* A failed read ends the command in error.  */
+            if (status != UX_SUCCESS)
+            {
+                hcd_virtual_msc -> ux_hcd_virtual_msc_commands_failed++;
+                hcd_virtual_msc -> ux_hcd_virtual_msc_csw_status =  UX_HCD_VIRTUAL_MSC_CSW_FAILED;
+                hcd_virtual_msc -> ux_hcd_virtual_msc_sense_key =  UX_HCD_VIRTUAL_MSC_SENSE_KEY_MEDIUM_ERROR;
+                hcd_virtual_msc -> ux_hcd_virtual_msc_sense_code =  UX_HCD_VIRTUAL_MSC_SENSE_CODE_UNRECOVERED_READ;
+                break;
+            }
+
+            hcd_virtual_msc -> ux_hcd_virtual_msc_bytes_read +=  length;
+        }
+        else
+            _ux_utility_memory_copy(data_pointer, hcd_virtual_msc -> ux_hcd_virtual_msc_response +
+                                    hcd_virtual_msc -> ux_hcd_virtual_msc_data_done, length); /* Use case of memcpy is verified. */
+
+        /* The data is sent.  */
+        hcd_virtual_msc -> ux_hcd_virtual_msc_data_done +=  length;
+        transfer_request -> ux_transfer_request_actual_length =  length;
+
+        /* The CSW follows the last data.  */
+        if (hcd_virtual_msc -> ux_hcd_virtual_msc_data_done == hcd_virtual_msc -> ux_hcd_virtual_msc_data_available)
+            hcd_virtual_msc -> ux_hcd_virtual_msc_state =  UX_HCD_VIRTUAL_MSC_STATE_CSW;
+        return(UX_SUCCESS);
+
+    case UX_HCD_VIRTUAL_MSC_STATE_CSW:
+
+        /* The CSW must fit in the transfer.  */
+        if (transfer_request -> ux_transfer_request_requested_length < UX_HCD_VIRTUAL_MSC_CSW_LENGTH)
+            break;
+
+        /* Build the CSW of the command.  */
+        _ux_utility_long_put(data_pointer, UX_HCD_VIRTUAL_MSC_CSW_SIGNATURE);
+        _ux_utility_long_put(data_pointer + 4, hcd_virtual_msc -> ux_hcd_virtual_msc_tag);
+        _ux_utility_long_put(data_pointer + 8, hcd_virtual_msc -> ux_hcd_virtual_msc_data_length -
+                                               hcd_virtual_msc -> ux_hcd_virtual_msc_data_done);
+        data_pointer[12] =  hcd_virtual_msc -> ux_hcd_virtual_msc_csw_status;
+        transfer_request -> ux_transfer_request_actual_length =  UX_HCD_VIRTUAL_MSC_CSW_LENGTH;
+
+        /* The device waits for the next command.  */
+        hcd_virtual_msc -> ux_hcd_virtual_msc_state =  UX_HCD_VIRTUAL_MSC_STATE_CBW;
+        return(UX_SUCCESS);
+
+    default:
+
+        /* The device expects nothing on this endpoint.  */
+        break;
+    }
+
+    /* Halt the endpoint, the CSW is sent once the halt is cleared.  */
+    if (hcd_virtual_msc -> ux_hcd_virtual_msc_state == UX_HCD_VIRTUAL_MSC_STATE_DATA_IN)
+        hcd_virtual_msc -> ux_hcd_virtual_msc_state =  UX_HCD_VIRTUAL_MSC_STATE_CSW;
+    hcd_virtual_msc -> ux_hcd_virtual_msc_stall_data =  UX_FALSE;
+    hcd_virtual_msc -> ux_hcd_virtual_msc_in_halted =  UX_TRUE;
+    hcd_virtual_msc -> ux_hcd_virtual_msc_stalls++;
+    return(UX_TRANSFER_STALLED);
+}
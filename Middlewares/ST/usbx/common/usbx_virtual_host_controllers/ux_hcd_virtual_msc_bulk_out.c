@@ -0,0 +1,172 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Virtual Mass Storage Controller Driver                              */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+#define UX_HCD_VIRTUAL_MSC_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_hcd_virtual_msc.h"
+#include "ux_host_stack.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_hcd_virtual_msc_bulk_out                        PORTABLE C      */
+/*                                                           6.1.10       */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function receives a bulk OUT transfer as the emulated device:  */
+/*    the CBW of a new command, or a piece of the data stage of the       */
+/*    current one, written to the disk image. An invalid CBW halts both   */
+/*    bulk endpoints until the host resets the device.                    */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    hcd_virtual_msc                       Pointer to virtual MSC HCD    */
+/*    transfer_request                      Pointer to transfer request   */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_hcd_virtual_msc_command           Decode SCSI command           */
+/*    _ux_utility_long_get                  Get 32-bit value              */
+/*    _ux_utility_memory_copy               Copy memory block             */
+/*    (image write function)                Write the disk image          */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_hcd_virtual_msc_request_transfer  Request transfer              */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_hcd_virtual_msc_bulk_out(UX_HCD_VIRTUAL_MSC *hcd_virtual_msc, UX_TRANSFER *transfer_request)
+{
+
+UX_HCD_VIRTUAL_MSC_CONFIG   *config;
+UCHAR                       *data_pointer;
+ULONG                       length;
+UINT                        status;
+
+
+    /* Get the configuration of the device and the buffer of the transfer.  */
+    config =  hcd_virtual_msc -> ux_hcd_virtual_msc_config;
+    data_pointer =  transfer_request -> ux_transfer_request_data_pointer;
+
+    /* A halted endpoint stalls until its halt is cleared.  */
+    if (hcd_virtual_msc -> ux_hcd_virtual_msc_out_halted)
+    {
+        hcd_virtual_msc -> ux_hcd_virtual_msc_stalls++;
+        return(UX_TRANSFER_STALLED);
+    }
+
+    /* Check the stage of the transport.  */
+    switch (hcd_virtual_msc -> ux_hcd_virtual_msc_state)
+    {
+
+    case UX_HCD_VIRTUAL_MSC_STATE_CBW:
+
+        /* Check the CBW is valid.  */
+        if ((transfer_request -> ux_transfer_request_requested_length != UX_HCD_VIRTUAL_MSC_CBW_LENGTH) ||
+            (_ux_utility_long_get(data_pointer) != UX_HCD_VIRTUAL_MSC_CBW_SIGNATURE))
+        {
+
+            /* Both endpoints stay halted until the reset recovery.  */
+            hcd_virtual_msc -> ux_hcd_virtual_msc_in_halted =  UX_TRUE;
+            hcd_virtual_msc -> ux_hcd_virtual_msc_out_halted =  UX_TRUE;
+            hcd_virtual_msc -> ux_hcd_virtual_msc_stalls++;
+            return(UX_TRANSFER_STALLED);
+        }
+
+        /* The CBW is received, decode its command.  */
+        transfer_request -> ux_transfer_request_actual_length =  UX_HCD_VIRTUAL_MSC_CBW_LENGTH;
+        return(_ux_hcd_virtual_msc_command(hcd_virtual_msc, data_pointer));
+
+    case UX_HCD_VIRTUAL_MSC_STATE_DATA_OUT:
+
+        /* Get what is left to receive.  */
+        length =  hcd_virtual_msc -> ux_hcd_virtual_msc_data_available - hcd_virtual_msc -> ux_hcd_virtual_msc_data_done;
+        if (length > transfer_request -> ux_transfer_request_requested_length)
+            length =  transfer_request -> ux_transfer_request_requested_length;
+
+        /* Nothing to receive, or a failed command: the data stage is stalled.  */
+        if ((length == 0) || hcd_virtual_msc -> ux_hcd_virtual_msc_stall_data)
+            break;
+
+        /* Write the data to the image, data for another command is dropped.  */
+        if (hcd_virtual_msc -> ux_hcd_virtual_msc_media_access)
+        {
+            if (config -> ux_hcd_virtual_msc_config_image_write)
+                status =  config -> ux_hcd_virtual_msc_config_image_write(config -> ux_hcd_virtual_msc_config_image_context,
+                                        hcd_virtual_msc -> ux_hcd_virtual_msc_media_offset + hcd_virtual_msc -> ux_hcd_virtual_msc_data_done,
+                                        data_pointer, length);
+            else
+            {
+                _ux_utility_memory_copy(config -> ux_hcd_virtual_msc_config_image +
+                                        hcd_virtual_msc -> ux_hcd_virtual_msc_media_offset + hcd_virtual_msc -> ux_hcd_virtual_msc_data_done,
+                                        data_pointer, length); /* Use case of memcpy is verified. */
+                status =  UX_SUCCESS;
+            }
+
+            /* A failed write ends the command in error.  */
+            if (status != UX_SUCCESS)
+            {
+                hcd_virtual_msc -> ux_hcd_virtual_msc_commands_failed++;
+                hcd_virtual_msc -> ux_hcd_virtual_msc_csw_status =  UX_HCD_VIRTUAL_MSC_CSW_FAILED;
+                hcd_virtual_msc -> ux_hcd_virtual_msc_sense_key =  UX_HCD_VIRTUAL_MSC_SENSE_KEY_MEDIUM_ERROR;
+                hcd_virtual_msc -> ux_hcd_virtual_msc_sense_code =  UX_HCD_VIRTUAL_MSC_SENSE_CODE_WRITE_FAULT;
+                break;
+            }
+
+            hcd_virtual_msc -> ux_hcd_virtual_msc_bytes_written +=  length;
+        }
+
+        /* The data is received.  */
+        hcd_virtual_msc -> ux_hcd_virtual_msc_data_done +=  length;
+        transfer_request -> ux_transfer_request_actual_length =  length;
+
+        /* The CSW follows the last data.  */
+        if (hcd_virtual_msc -> ux_hcd_virtual_msc_data_done == hcd_virtual_msc -> ux_hcd_virtual_msc_data_available)
+            hcd_virtual_msc -> ux_hcd_virtual_msc_state =  UX_HCD_VIRTUAL_MSC_STATE_CSW;
+        return(UX_SUCCESS);
+
+    default:
+
+        /* The device expects nothing on this endpoint.  */
+        break;
+    }
+
+    /* Halt the endpoint, the CSW is sent once the halt is cleared.  */
+    if (hcd_virtual_msc -> ux_hcd_virtual_msc_state == UX_HCD_VIRTUAL_MSC_STATE_DATA_OUT)
+        hcd_virtual_msc -> ux_hcd_virtual_msc_state =  UX_HCD_VIRTUAL_MSC_STATE_CSW;
+    hcd_virtual_msc -> ux_hcd_virtual_msc_stall_data =  UX_FALSE;
+    hcd_virtual_msc -> ux_hcd_virtual_msc_out_halted =  UX_TRUE;
+    hcd_virtual_msc -> ux_hcd_virtual_msc_stalls++;
+    return(UX_TRANSFER_STALLED);
+}
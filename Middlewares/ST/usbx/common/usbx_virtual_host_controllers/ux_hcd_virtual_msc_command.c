@@ -0,0 +1,266 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Virtual Mass Storage Controller Driver                              */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+#define UX_HCD_VIRTUAL_MSC_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_hcd_virtual_msc.h"
+#include "ux_host_stack.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_hcd_virtual_msc_command                         PORTABLE C      */
+/*                                                           6.1.10       */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function decodes the SCSI command of a CBW and prepares the    */
+/*    data and status stages of the emulated device. The small answers    */
+/*    are built in the device response buffer, READ(10) and WRITE(10)     */
+/*    stream the data stage from or to the disk image.                    */
+/*                                                                        */
+/*    A command that fails, including the command whose operation code    */
+/*    is the configured stall operation code, stalls its data stage and   */
+/*    reports the failure in the CSW, with the sense data kept for the    */
+/*    next REQUEST SENSE.                                                 */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    hcd_virtual_msc                       Pointer to virtual MSC HCD    */
+/*    cbw                                   Pointer to CBW                */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_utility_long_get                  Get 32-bit value              */
+/*    _ux_utility_long_get_big_endian       Get 32-bit big endian value   */
+/*    _ux_utility_long_put_big_endian       Put 32-bit big endian value   */
+/*    _ux_utility_memory_copy               Copy memory block             */
+/*    _ux_utility_memory_set                Set memory block              */
+/*    _ux_utility_short_get_big_endian      Get 16-bit big endian value   */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_hcd_virtual_msc_bulk_out          Emulate bulk OUT transfer     */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_hcd_virtual_msc_command(UX_HCD_VIRTUAL_MSC *hcd_virtual_msc, UCHAR *cbw)
+{
+
+UX_HCD_VIRTUAL_MSC_CONFIG   *config;
+UCHAR                       *command;
+UCHAR                       *response;
+ULONG                       block_address;
+ULONG                       block_count;
+UCHAR                       sense_key;
+UCHAR                       sense_code;
+
+
+    /* Get the configuration of the device and the command block.  */
+    config =  hcd_virtual_msc -> ux_hcd_virtual_msc_config;
+    command =  cbw + UX_HCD_VIRTUAL_MSC_CBW_CB;
+    response =  hcd_virtual_msc -> ux_hcd_virtual_msc_response;
+
+    /* One more command.  */
+    hcd_virtual_msc -> ux_hcd_virtual_msc_commands++;
+
+    /* Start the command.  */
+    hcd_virtual_msc -> ux_hcd_virtual_msc_tag =  _ux_utility_long_get(cbw + UX_HCD_VIRTUAL_MSC_CBW_TAG);
+    hcd_virtual_msc -> ux_hcd_virtual_msc_data_length =  _ux_utility_long_get(cbw + UX_HCD_VIRTUAL_MSC_CBW_DATA_LENGTH);
+    hcd_virtual_msc -> ux_hcd_virtual_msc_data_done =  0;
+    hcd_virtual_msc -> ux_hcd_virtual_msc_data_available =  0;
+    hcd_virtual_msc -> ux_hcd_virtual_msc_media_access =  UX_FALSE;
+    hcd_virtual_msc -> ux_hcd_virtual_msc_stall_data =  UX_FALSE;
+    hcd_virtual_msc -> ux_hcd_virtual_msc_csw_status =  UX_HCD_VIRTUAL_MSC_CSW_PASSED;
+    _ux_utility_memory_set(response, 0, UX_HCD_VIRTUAL_MSC_RESPONSE_LENGTH); /* Use case of memset is verified. */
+
+    /* Keep the sense data of the previous command for REQUEST SENSE.  */
+    sense_key =  hcd_virtual_msc -> ux_hcd_virtual_msc_sense_key;
+    sense_code =  hcd_virtual_msc -> ux_hcd_virtual_msc_sense_code;
+    hcd_virtual_msc -> ux_hcd_virtual_msc_sense_key =  UX_HCD_VIRTUAL_MSC_SENSE_KEY_NO_SENSE;
+    hcd_virtual_msc -> ux_hcd_virtual_msc_sense_code =  0;
+
+    /* Check if this command is the one to stall.  */
+    if ((ULONG) command[0] == config -> ux_hcd_virtual_msc_config_stall_opcode)
+    {
+
+        /* Fail the command as an unsupported one.  */
+        hcd_virtual_msc -> ux_hcd_virtual_msc_sense_key =  UX_HCD_VIRTUAL_MSC_SENSE_KEY_ILLEGAL_REQUEST;
+        hcd_virtual_msc -> ux_hcd_virtual_msc_sense_code =  UX_HCD_VIRTUAL_MSC_SENSE_CODE_INVALID_COMMAND;
+    }
+    else
+    {
+
+        /* Decode the command.  */
+        switch (command[0])
+        {
+
+        case UX_HCD_VIRTUAL_MSC_SCSI_TEST_READY:
+        case UX_HCD_VIRTUAL_MSC_SCSI_START_STOP:
+        case UX_HCD_VIRTUAL_MSC_SCSI_PREVENT_ALLOW:
+        case UX_HCD_VIRTUAL_MSC_SCSI_VERIFY:
+        case UX_HCD_VIRTUAL_MSC_SCSI_SYNCHRONIZE_CACHE:
+
+            /* The image is always ready, nothing to do.  */
+            break;
+
+        case UX_HCD_VIRTUAL_MSC_SCSI_REQUEST_SENSE:
+
+            /* Fixed format sense data.  */
+            response[0] =  0x70;
+            response[2] =  sense_key;
+            response[7] =  10;
+            response[12] =  sense_code;
+            hcd_virtual_msc -> ux_hcd_virtual_msc_data_available =  18;
+            break;
+
+        case UX_HCD_VIRTUAL_MSC_SCSI_INQUIRY:
+
+            /* Removable direct access device.  */
+            response[0] =  0x00;
+            response[1] =  0x80;
+            response[2] =  0x02;
+            response[3] =  0x02;
+            response[4] =  UX_HCD_VIRTUAL_MSC_RESPONSE_LENGTH - 5;
+            _ux_utility_memory_copy(&response[8], (UCHAR *) "USBX    Virtual MSC     1.00", 28); /* Use case of memcpy is verified. */
+            hcd_virtual_msc -> ux_hcd_virtual_msc_data_available =  UX_HCD_VIRTUAL_MSC_RESPONSE_LENGTH;
+            break;
+
+        case UX_HCD_VIRTUAL_MSC_SCSI_READ_FORMAT_CAPACITY:
+
+            /* One formatted media descriptor.  */
+            response[3] =  8;
+            _ux_utility_long_put_big_endian(&response[4], config -> ux_hcd_virtual_msc_config_block_count);
+            _ux_utility_long_put_big_endian(&response[8], config -> ux_hcd_virtual_msc_config_block_size);
+            response[8] =  0x02;
+            hcd_virtual_msc -> ux_hcd_virtual_msc_data_available =  12;
+            break;
+
+        case UX_HCD_VIRTUAL_MSC_SCSI_READ_CAPACITY:
+
+            /* Last block address and block size.  */
+            _ux_utility_long_put_big_endian(&response[0], config -> ux_hcd_virtual_msc_config_block_count - 1);
+            _ux_utility_long_put_big_endian(&response[4], config -> ux_hcd_virtual_msc_config_block_size);
+            hcd_virtual_msc -> ux_hcd_virtual_msc_data_available =  8;
+            break;
+
+        case UX_HCD_VIRTUAL_MSC_SCSI_MODE_SENSE_SHORT:
+
+            /* Mode parameter header only, with the write protect flag.  */
+            response[0] =  3;
+            response[2] =  config -> ux_hcd_virtual_msc_config_write_protected ? 0x80 : 0;
+            hcd_virtual_msc -> ux_hcd_virtual_msc_data_available =  4;
+            break;
+
+        case UX_HCD_VIRTUAL_MSC_SCSI_MODE_SENSE:
+
+            /* Mode parameter header only, with the write protect flag.  */
+            response[1] =  6;
+            response[3] =  config -> ux_hcd_virtual_msc_config_write_protected ? 0x80 : 0;
+            hcd_virtual_msc -> ux_hcd_virtual_msc_data_available =  8;
+            break;
+
+        case UX_HCD_VIRTUAL_MSC_SCSI_READ10:
+        case UX_HCD_VIRTUAL_MSC_SCSI_WRITE10:
+
+            /* Get the blocks to transfer.  */
+            block_address =  _ux_utility_long_get_big_endian(&command[2]);
+            block_count =  _ux_utility_short_get_big_endian(&command[7]);
+
+            /* Check the blocks are in the image.  */
+            if ((block_address >= config -> ux_hcd_virtual_msc_config_block_count) ||
+                (block_count > config -> ux_hcd_virtual_msc_config_block_count - block_address))
+            {
+                hcd_virtual_msc -> ux_hcd_virtual_msc_sense_key =  UX_HCD_VIRTUAL_MSC_SENSE_KEY_ILLEGAL_REQUEST;
+                hcd_virtual_msc -> ux_hcd_virtual_msc_sense_code =  UX_HCD_VIRTUAL_MSC_SENSE_CODE_LBA_OUT_OF_RANGE;
+                break;
+            }
+
+            /* Check the host moves the data the way the command does.  */
+            if ((hcd_virtual_msc -> ux_hcd_virtual_msc_data_length != 0) &&
+                ((command[0] == UX_HCD_VIRTUAL_MSC_SCSI_READ10) != ((cbw[UX_HCD_VIRTUAL_MSC_CBW_FLAGS] & UX_ENDPOINT_DIRECTION) != 0)))
+            {
+                hcd_virtual_msc -> ux_hcd_virtual_msc_sense_key =  UX_HCD_VIRTUAL_MSC_SENSE_KEY_ILLEGAL_REQUEST;
+                hcd_virtual_msc -> ux_hcd_virtual_msc_sense_code =  UX_HCD_VIRTUAL_MSC_SENSE_CODE_INVALID_COMMAND;
+                break;
+            }
+
+            /* Check the image may be written.  */
+            if ((command[0] == UX_HCD_VIRTUAL_MSC_SCSI_WRITE10) && config -> ux_hcd_virtual_msc_config_write_protected)
+            {
+                hcd_virtual_msc -> ux_hcd_virtual_msc_sense_key =  UX_HCD_VIRTUAL_MSC_SENSE_KEY_DATA_PROTECT;
+                hcd_virtual_msc -> ux_hcd_virtual_msc_sense_code =  UX_HCD_VIRTUAL_MSC_SENSE_CODE_WRITE_PROTECTED;
+                break;
+            }
+
+            /* The data stage streams the blocks.  */
+            hcd_virtual_msc -> ux_hcd_virtual_msc_media_access =  UX_TRUE;
+            hcd_virtual_msc -> ux_hcd_virtual_msc_media_offset =  block_address * config -> ux_hcd_virtual_msc_config_block_size;
+            hcd_virtual_msc -> ux_hcd_virtual_msc_data_available =  block_count * config -> ux_hcd_virtual_msc_config_block_size;
+            break;
+
+        default:
+
+            /* Command not supported.  */
+            hcd_virtual_msc -> ux_hcd_virtual_msc_sense_key =  UX_HCD_VIRTUAL_MSC_SENSE_KEY_ILLEGAL_REQUEST;
+            hcd_virtual_msc -> ux_hcd_virtual_msc_sense_code =  UX_HCD_VIRTUAL_MSC_SENSE_CODE_INVALID_COMMAND;
+            break;
+        }
+    }
+
+    /* Check if the command failed.  */
+    if (hcd_virtual_msc -> ux_hcd_virtual_msc_sense_key != UX_HCD_VIRTUAL_MSC_SENSE_KEY_NO_SENSE)
+    {
+
+        /* No data, the data stage is stalled and the CSW reports the failure.  */
+        hcd_virtual_msc -> ux_hcd_virtual_msc_commands_failed++;
+        hcd_virtual_msc -> ux_hcd_virtual_msc_csw_status =  UX_HCD_VIRTUAL_MSC_CSW_FAILED;
+        hcd_virtual_msc -> ux_hcd_virtual_msc_media_access =  UX_FALSE;
+        hcd_virtual_msc -> ux_hcd_virtual_msc_data_available =  0;
+        hcd_virtual_msc -> ux_hcd_virtual_msc_stall_data =  UX_TRUE;
+    }
+
+    /* The device never sends or receives more than the host expects.  */
+    if (hcd_virtual_msc -> ux_hcd_virtual_msc_data_available > hcd_virtual_msc -> ux_hcd_virtual_msc_data_length)
+        hcd_virtual_msc -> ux_hcd_virtual_msc_data_available =  hcd_virtual_msc -> ux_hcd_virtual_msc_data_length;
+
+    /* Set the next stage of the transport.  */
+    if (hcd_virtual_msc -> ux_hcd_virtual_msc_data_length == 0)
+        hcd_virtual_msc -> ux_hcd_virtual_msc_state =  UX_HCD_VIRTUAL_MSC_STATE_CSW;
+    else if (cbw[UX_HCD_VIRTUAL_MSC_CBW_FLAGS] & UX_ENDPOINT_DIRECTION)
+        hcd_virtual_msc -> ux_hcd_virtual_msc_state =  UX_HCD_VIRTUAL_MSC_STATE_DATA_IN;
+    else
+        hcd_virtual_msc -> ux_hcd_virtual_msc_state =  UX_HCD_VIRTUAL_MSC_STATE_DATA_OUT;
+
+    /* Return successful completion.  */
+    return(UX_SUCCESS);
+}
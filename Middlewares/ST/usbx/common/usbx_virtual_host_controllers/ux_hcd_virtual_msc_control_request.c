@@ -0,0 +1,269 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Virtual Mass Storage Controller Driver                              */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+#define UX_HCD_VIRTUAL_MSC_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_hcd_virtual_msc.h"
+#include "ux_host_stack.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_hcd_virtual_msc_control_request                 PORTABLE C      */
+/*                                                           6.1.10       */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function answers a control request as the emulated device.     */
+/*    The standard requests needed to enumerate and configure the device, */
+/*    the clear of a halted bulk endpoint and the bulk-only class         */
+/*    requests are supported, any other request is stalled.               */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    hcd_virtual_msc                       Pointer to virtual MSC HCD    */
+/*    transfer_request                      Pointer to transfer request   */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_utility_memory_copy               Copy memory block             */
+/*    _ux_utility_short_put                 Put 16-bit value              */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_hcd_virtual_msc_request_transfer  Request transfer              */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_hcd_virtual_msc_control_request(UX_HCD_VIRTUAL_MSC *hcd_virtual_msc, UX_TRANSFER *transfer_request)
+{
+
+UCHAR           descriptor[UX_HCD_VIRTUAL_MSC_CONFIGURATION_DESCRIPTOR_LENGTH];
+ULONG           descriptor_length;
+ULONG           packet_size;
+UINT            request_type;
+UINT            halted;
+
+
+    /* Get the type and recipient of the request.  */
+    request_type =  transfer_request -> ux_transfer_request_type & (UX_REQUEST_TYPE | UX_REQUEST_TARGET);
+
+    /* Most requests have no data stage.  */
+    descriptor_length =  0;
+
+    /* Check the request.  */
+    if (request_type == (UX_REQUEST_TYPE_CLASS | UX_REQUEST_TARGET_INTERFACE))
+    {
+
+        switch (transfer_request -> ux_transfer_request_function)
+        {
+
+        case UX_HCD_VIRTUAL_MSC_BOT_GET_MAX_LUN:
+
+            /* The device has a single LUN.  */
+            descriptor[0] =  0;
+            descriptor_length =  1;
+            break;
+
+        case UX_HCD_VIRTUAL_MSC_BOT_RESET:
+
+            /* The device waits for a new command, the halted endpoints stay halted.  */
+            hcd_virtual_msc -> ux_hcd_virtual_msc_state =  UX_HCD_VIRTUAL_MSC_STATE_CBW;
+            hcd_virtual_msc -> ux_hcd_virtual_msc_stall_data =  UX_FALSE;
+            break;
+
+        default:
+
+            /* Request not supported.  */
+            hcd_virtual_msc -> ux_hcd_virtual_msc_stalls++;
+            return(UX_TRANSFER_STALLED);
+        }
+    }
+    else if ((request_type & UX_REQUEST_TYPE) == UX_REQUEST_TYPE_STANDARD)
+    {
+
+        switch (transfer_request -> ux_transfer_request_function)
+        {
+
+        case UX_GET_DESCRIPTOR:
+
+            /* Get the bulk packet size of the device.  */
+            packet_size =  hcd_virtual_msc -> ux_hcd_virtual_msc_config -> ux_hcd_virtual_msc_config_max_packet_size;
+
+            /* Check the descriptor type.  */
+            switch (transfer_request -> ux_transfer_request_value >> 8)
+            {
+
+            case UX_DEVICE_DESCRIPTOR_ITEM:
+
+                /* USB 2.0 device, the class is given by the interface, no string.  */
+                descriptor[0] =  UX_HCD_VIRTUAL_MSC_DEVICE_DESCRIPTOR_LENGTH;
+                descriptor[1] =  UX_DEVICE_DESCRIPTOR_ITEM;
+                _ux_utility_short_put(&descriptor[2], 0x0200);
+                descriptor[4] =  0;
+                descriptor[5] =  0;
+                descriptor[6] =  0;
+                descriptor[7] =  UX_HCD_VIRTUAL_MSC_CONTROL_MAX_PACKET_SIZE;
+                _ux_utility_short_put(&descriptor[8], 0x0483);
+                _ux_utility_short_put(&descriptor[10], 0x5720);
+                _ux_utility_short_put(&descriptor[12], 0x0100);
+                descriptor[14] =  0;
+                descriptor[15] =  0;
+                descriptor[16] =  0;
+                descriptor[17] =  1;
+                descriptor_length =  UX_HCD_VIRTUAL_MSC_DEVICE_DESCRIPTOR_LENGTH;
+                break;
+
+            case UX_CONFIGURATION_DESCRIPTOR_ITEM:
+
+                /* One bus powered configuration.  */
+                descriptor[0] =  9;
+                descriptor[1] =  UX_CONFIGURATION_DESCRIPTOR_ITEM;
+                _ux_utility_short_put(&descriptor[2], UX_HCD_VIRTUAL_MSC_CONFIGURATION_DESCRIPTOR_LENGTH);
+                descriptor[4] =  1;
+                descriptor[5] =  1;
+                descriptor[6] =  0;
+                descriptor[7] =  0x80;
+                descriptor[8] =  50;
+
+                /* One mass storage interface, SCSI transparent command set, bulk-only transport.  */
+                descriptor[9] =  9;
+                descriptor[10] =  UX_INTERFACE_DESCRIPTOR_ITEM;
+                descriptor[11] =  0;
+                descriptor[12] =  0;
+                descriptor[13] =  2;
+                descriptor[14] =  0x08;
+                descriptor[15] =  0x06;
+                descriptor[16] =  0x50;
+                descriptor[17] =  0;
+
+                /* The bulk IN endpoint.  */
+                descriptor[18] =  7;
+                descriptor[19] =  UX_ENDPOINT_DESCRIPTOR_ITEM;
+                descriptor[20] =  UX_HCD_VIRTUAL_MSC_BULK_IN_ADDRESS;
+                descriptor[21] =  UX_BULK_ENDPOINT;
+                _ux_utility_short_put(&descriptor[22], (USHORT) packet_size);
+                descriptor[24] =  0;
+
+                /* The bulk OUT endpoint.  */
+                descriptor[25] =  7;
+                descriptor[26] =  UX_ENDPOINT_DESCRIPTOR_ITEM;
+                descriptor[27] =  UX_HCD_VIRTUAL_MSC_BULK_OUT_ADDRESS;
+                descriptor[28] =  UX_BULK_ENDPOINT;
+                _ux_utility_short_put(&descriptor[29], (USHORT) packet_size);
+                descriptor[31] =  0;
+                descriptor_length =  UX_HCD_VIRTUAL_MSC_CONFIGURATION_DESCRIPTOR_LENGTH;
+                break;
+
+            default:
+
+                /* No string or other descriptor.  */
+                hcd_virtual_msc -> ux_hcd_virtual_msc_stalls++;
+                return(UX_TRANSFER_STALLED);
+            }
+            break;
+
+        case UX_SET_ADDRESS:
+
+            hcd_virtual_msc -> ux_hcd_virtual_msc_address =  transfer_request -> ux_transfer_request_value;
+            break;
+
+        case UX_SET_CONFIGURATION:
+
+            hcd_virtual_msc -> ux_hcd_virtual_msc_configuration =  transfer_request -> ux_transfer_request_value;
+            break;
+
+        case UX_GET_CONFIGURATION:
+
+            descriptor[0] =  (UCHAR) hcd_virtual_msc -> ux_hcd_virtual_msc_configuration;
+            descriptor_length =  1;
+            break;
+
+        case UX_SET_INTERFACE:
+
+            /* The interface has no alternate setting to select.  */
+            break;
+
+        case UX_GET_STATUS:
+
+            /* An endpoint reports its halt, the device reports nothing.  */
+            halted =  UX_FALSE;
+            if ((request_type & UX_REQUEST_TARGET) == UX_REQUEST_TARGET_ENDPOINT)
+            {
+                if (transfer_request -> ux_transfer_request_index == UX_HCD_VIRTUAL_MSC_BULK_IN_ADDRESS)
+                    halted =  hcd_virtual_msc -> ux_hcd_virtual_msc_in_halted;
+                else if (transfer_request -> ux_transfer_request_index == UX_HCD_VIRTUAL_MSC_BULK_OUT_ADDRESS)
+                    halted =  hcd_virtual_msc -> ux_hcd_virtual_msc_out_halted;
+            }
+            _ux_utility_short_put(descriptor, halted ? 1 : 0);
+            descriptor_length =  2;
+            break;
+
+        case UX_CLEAR_FEATURE:
+
+            /* Only the halt of a bulk endpoint can be cleared.  */
+            if (((request_type & UX_REQUEST_TARGET) == UX_REQUEST_TARGET_ENDPOINT) &&
+                (transfer_request -> ux_transfer_request_value == UX_ENDPOINT_HALT))
+            {
+                if (transfer_request -> ux_transfer_request_index == UX_HCD_VIRTUAL_MSC_BULK_IN_ADDRESS)
+                    hcd_virtual_msc -> ux_hcd_virtual_msc_in_halted =  UX_FALSE;
+                else if (transfer_request -> ux_transfer_request_index == UX_HCD_VIRTUAL_MSC_BULK_OUT_ADDRESS)
+                    hcd_virtual_msc -> ux_hcd_virtual_msc_out_halted =  UX_FALSE;
+            }
+            break;
+
+        default:
+
+            /* Request not supported.  */
+            hcd_virtual_msc -> ux_hcd_virtual_msc_stalls++;
+            return(UX_TRANSFER_STALLED);
+        }
+    }
+    else
+    {
+
+        /* Vendor requests and class requests to another recipient are not supported.  */
+        hcd_virtual_msc -> ux_hcd_virtual_msc_stalls++;
+        return(UX_TRANSFER_STALLED);
+    }
+
+    /* Return the data stage, no longer than requested.  */
+    if (descriptor_length > transfer_request -> ux_transfer_request_requested_length)
+        descriptor_length =  transfer_request -> ux_transfer_request_requested_length;
+    if (descriptor_length != 0)
+        _ux_utility_memory_copy(transfer_request -> ux_transfer_request_data_pointer,
+                                descriptor, descriptor_length); /* Use case of memcpy is verified. */
+    transfer_request -> ux_transfer_request_actual_length =  descriptor_length;
+
+    /* Return successful completion.  */
+    return(UX_SUCCESS);
+}
@@ -0,0 +1,93 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Virtual Mass Storage Controller Driver                              */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+#define UX_HCD_VIRTUAL_MSC_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_hcd_virtual_msc.h"
+#include "ux_host_stack.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_hcd_virtual_msc_device_connect                  PORTABLE C      */
+/*                                                           6.1.10       */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function attaches the emulated device to the root port or      */
+/*    detaches it, and signals the change to the enumeration thread. A    */
+/*    detach is how a surprise removal of the device is tested: the       */
+/*    transfers that follow it get no answer.                             */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    hcd                                   Pointer to HCD                */
+/*    connected                             UX_TRUE to attach the device  */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_host_semaphore_put                Put semaphore                 */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_hcd_virtual_msc_initialize        Initialize controller         */
+/*    Application                                                         */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_hcd_virtual_msc_device_connect(UX_HCD *hcd, UINT connected)
+{
+
+UX_HCD_VIRTUAL_MSC  *hcd_virtual_msc;
+
+
+    /* Get the pointer to the virtual MSC HCD.  */
+    hcd_virtual_msc =  (UX_HCD_VIRTUAL_MSC *) hcd -> ux_hcd_controller_hardware;
+
+    /* Nothing to signal if the port does not change.  */
+    if (hcd_virtual_msc -> ux_hcd_virtual_msc_connected == connected)
+        return;
+
+    /* Update the port and start the device from the default state.  */
+    hcd_virtual_msc -> ux_hcd_virtual_msc_connected =  connected;
+    hcd_virtual_msc -> ux_hcd_virtual_msc_address =  0;
+    hcd_virtual_msc -> ux_hcd_virtual_msc_configuration =  0;
+    hcd_virtual_msc -> ux_hcd_virtual_msc_in_halted =  UX_FALSE;
+    hcd_virtual_msc -> ux_hcd_virtual_msc_out_halted =  UX_FALSE;
+    hcd_virtual_msc -> ux_hcd_virtual_msc_state =  UX_HCD_VIRTUAL_MSC_STATE_CBW;
+
+    /* Something happened on this port. Signal it to the root hub thread.  */
+    hcd -> ux_hcd_root_hub_signal[0]++;
+
+    /* Wake up the root hub thread.  */
+    _ux_host_semaphore_put(&_ux_system_host -> ux_system_host_enum_semaphore);
+}
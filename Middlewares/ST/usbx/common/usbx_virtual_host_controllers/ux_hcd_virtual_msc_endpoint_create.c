@@ -0,0 +1,106 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Virtual Mass Storage Controller Driver                              */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+#define UX_HCD_VIRTUAL_MSC_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_hcd_virtual_msc.h"
+#include "ux_host_stack.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_hcd_virtual_msc_endpoint_create                 PORTABLE C      */
+/*                                                           6.1.10       */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function creates an endpoint on the virtual MSC controller.    */
+/*    Only the control and bulk endpoints of the emulated device exist.   */
+/*    A bulk transfer request may carry as many packets as a channel of   */
+/*    the STM32 controller, so the storage class splits its data phases   */
+/*    the same way on both controllers.                                   */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    hcd_virtual_msc                       Pointer to virtual MSC HCD    */
+/*    endpoint                              Pointer to endpoint           */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_hcd_virtual_msc_entry             Virtual MSC HCD entry         */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_hcd_virtual_msc_endpoint_create(UX_HCD_VIRTUAL_MSC *hcd_virtual_msc, UX_ENDPOINT *endpoint)
+{
+
+ULONG           packet_size;
+
+
+    /* Only control and bulk endpoints are emulated.  */
+    switch (endpoint -> ux_endpoint_descriptor.bmAttributes & UX_MASK_ENDPOINT_TYPE)
+    {
+
+    case UX_CONTROL_ENDPOINT:
+
+        /* Control transfers are never split by the controller.  */
+        break;
+
+    case UX_BULK_ENDPOINT:
+
+        /* Get the packet size of the endpoint.  */
+        packet_size =  endpoint -> ux_endpoint_descriptor.wMaxPacketSize & UX_MAX_PACKET_SIZE_MASK;
+        if (packet_size == 0)
+            packet_size =  hcd_virtual_msc -> ux_hcd_virtual_msc_config -> ux_hcd_virtual_msc_config_max_packet_size;
+
+        /* Set the largest transfer a single request may carry.  */
+        endpoint -> ux_endpoint_transfer_request.ux_transfer_request_maximum_length =  UX_HCD_VIRTUAL_MSC_MAX_PACKET_COUNT * packet_size;
+        break;
+
+    default:
+
+        /* Error trap. */
+        _ux_system_error_handler(UX_SYSTEM_LEVEL_THREAD, UX_SYSTEM_CONTEXT_HCD, UX_FUNCTION_NOT_SUPPORTED);
+
+        return(UX_FUNCTION_NOT_SUPPORTED);
+    }
+
+    /* Attach the controller to the endpoint.  */
+    endpoint -> ux_endpoint_ed =  (VOID *) hcd_virtual_msc;
+
+    /* Return successful completion.  */
+    return(UX_SUCCESS);
+}
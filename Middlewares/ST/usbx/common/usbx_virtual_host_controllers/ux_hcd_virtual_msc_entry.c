@@ -0,0 +1,213 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Virtual Mass Storage Controller Driver                              */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+#define UX_HCD_VIRTUAL_MSC_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_hcd_virtual_msc.h"
+#include "ux_host_stack.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_hcd_virtual_msc_entry                           PORTABLE C      */
+/*                                                           6.1.10       */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function dispatches the HCD function internally to the virtual */
+/*    MSC controller. The root port has no hardware behind it, the port   */
+/*    functions only report the emulated device.                          */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    hcd                                   Pointer to HCD                */
+/*    function                              Function for driver to perform*/
+/*    parameter                             Pointer to parameter(s)       */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_hcd_virtual_msc_endpoint_create   Create endpoint               */
+/*    _ux_hcd_virtual_msc_request_transfer  Request transfer              */
+/*    _ux_utility_memory_free               Free memory block             */
+/*    _ux_utility_time_get                  Get system time               */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Host Stack                                                          */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_hcd_virtual_msc_entry(UX_HCD *hcd, UINT function, VOID *parameter)
+{
+
+UINT                status;
+ULONG               port_status;
+UX_HCD_VIRTUAL_MSC  *hcd_virtual_msc;
+
+
+    /* Check the status of the controller.  */
+    if (hcd -> ux_hcd_status == UX_UNUSED)
+    {
+
+        /* Error trap. */
+        _ux_system_error_handler(UX_SYSTEM_LEVEL_THREAD, UX_SYSTEM_CONTEXT_HCD, UX_CONTROLLER_UNKNOWN);
+
+        /* If trace is enabled, insert this event into the trace buffer.  */
+        UX_TRACE_IN_LINE_INSERT(UX_TRACE_ERROR, UX_CONTROLLER_UNKNOWN, 0, 0, 0, UX_TRACE_ERRORS, 0, 0)
+
+        return(UX_CONTROLLER_UNKNOWN);
+    }
+
+    /* Get the pointer to the virtual MSC HCD.  */
+    hcd_virtual_msc =  (UX_HCD_VIRTUAL_MSC *) hcd -> ux_hcd_controller_hardware;
+
+    /* look at the function and route it.  */
+    switch(function)
+    {
+
+    case UX_HCD_GET_PORT_STATUS:
+
+        /* Check to see if this port is valid on this controller.  */
+        if ((ALIGN_TYPE) parameter >= UX_HCD_VIRTUAL_MSC_NB_ROOT_PORTS)
+        {
+
+            /* Error trap. */
+            _ux_system_error_handler(UX_SYSTEM_LEVEL_THREAD, UX_SYSTEM_CONTEXT_HCD, UX_PORT_INDEX_UNKNOWN);
+
+            /* If trace is enabled, insert this event into the trace buffer.  */
+            UX_TRACE_IN_LINE_INSERT(UX_TRACE_ERROR, UX_PORT_INDEX_UNKNOWN, parameter, 0, 0, UX_TRACE_ERRORS, 0, 0)
+
+            return(UX_PORT_INDEX_UNKNOWN);
+        }
+
+        /* The emulated device is full speed, unless its bulk packets are high speed ones.  */
+        if (hcd_virtual_msc -> ux_hcd_virtual_msc_config -> ux_hcd_virtual_msc_config_max_packet_size > UX_HCD_VIRTUAL_MSC_FULL_SPEED_MAX_PACKET_SIZE)
+            port_status =  UX_PS_DS_HS;
+        else
+            port_status =  UX_PS_DS_FS;
+
+        /* Device Connection Status.  */
+        if (hcd_virtual_msc -> ux_hcd_virtual_msc_connected)
+            port_status |=  UX_PS_CCS | UX_PS_PES | UX_PS_PPS;
+
+        /* The port status is returned as the completion status.  */
+        status =  (UINT) port_status;
+        break;
+
+
+    case UX_HCD_DISABLE_CONTROLLER:
+    case UX_HCD_ENABLE_PORT:
+    case UX_HCD_DISABLE_PORT:
+    case UX_HCD_POWER_ON_PORT:
+    case UX_HCD_POWER_DOWN_PORT:
+    case UX_HCD_SUSPEND_PORT:
+    case UX_HCD_RESUME_PORT:
+    case UX_HCD_PROCESS_DONE_QUEUE:
+
+        /* Nothing to do on a virtual port.  */
+        status =  UX_SUCCESS;
+        break;
+
+
+    case UX_HCD_RESET_PORT:
+
+        /* A bus reset returns the device to the default state.  */
+        hcd_virtual_msc -> ux_hcd_virtual_msc_address =  0;
+        hcd_virtual_msc -> ux_hcd_virtual_msc_configuration =  0;
+        hcd_virtual_msc -> ux_hcd_virtual_msc_in_halted =  UX_FALSE;
+        hcd_virtual_msc -> ux_hcd_virtual_msc_out_halted =  UX_FALSE;
+        hcd_virtual_msc -> ux_hcd_virtual_msc_state =  UX_HCD_VIRTUAL_MSC_STATE_CBW;
+        status =  UX_SUCCESS;
+        break;
+
+
+    case UX_HCD_GET_FRAME_NUMBER:
+
+        /* One frame per millisecond of system time.  */
+        *((ULONG *) parameter) =  (ULONG) ((_ux_utility_time_get() * 1000UL) / UX_PERIODIC_RATE) & 0x7FFU;
+        status =  UX_SUCCESS;
+        break;
+
+
+    case UX_HCD_TRANSFER_REQUEST:
+
+        status =  _ux_hcd_virtual_msc_request_transfer(hcd_virtual_msc, (UX_TRANSFER *) parameter);
+        break;
+
+
+    case UX_HCD_TRANSFER_ABORT:
+
+        /* Transfers are completed when they are requested, there is never one to abort.  */
+        status =  UX_SUCCESS;
+        break;
+
+
+    case UX_HCD_CREATE_ENDPOINT:
+
+        status =  _ux_hcd_virtual_msc_endpoint_create(hcd_virtual_msc, (UX_ENDPOINT *) parameter);
+        break;
+
+
+    case UX_HCD_DESTROY_ENDPOINT:
+    case UX_HCD_RESET_ENDPOINT:
+
+        /* The halt of a bulk endpoint is cleared by the CLEAR_FEATURE request, not here.  */
+        status =  UX_SUCCESS;
+        break;
+
+
+    case UX_HCD_UNINITIALIZE:
+
+        /* free HCD resources */
+        if (hcd_virtual_msc != UX_NULL)
+            _ux_utility_memory_free(hcd_virtual_msc);
+
+        status =  UX_SUCCESS;
+        break;
+
+
+    default:
+
+        /* Error trap. */
+        _ux_system_error_handler(UX_SYSTEM_LEVEL_THREAD, UX_SYSTEM_CONTEXT_HCD, UX_FUNCTION_NOT_SUPPORTED);
+
+        /* If trace is enabled, insert this event into the trace buffer.  */
+        UX_TRACE_IN_LINE_INSERT(UX_TRACE_ERROR, UX_FUNCTION_NOT_SUPPORTED, 0, 0, 0, UX_TRACE_ERRORS, 0, 0)
+
+        /* Unknown request, return an error.  */
+        status =  UX_FUNCTION_NOT_SUPPORTED;
+        break;
+    }
+
+    /* Return completion status.  */
+    return(status);
+}
@@ -0,0 +1,92 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Virtual Mass Storage Controller Driver                              */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+#define UX_HCD_VIRTUAL_MSC_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_hcd_virtual_msc.h"
+#include "ux_host_stack.h"
+
+
+#if defined(UX_HCD_VIRTUAL_MSC_FILE_IMAGE_ENABLE)
+#include <stdio.h>
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_hcd_virtual_msc_file_read                       PORTABLE C      */
+/*                                                           6.1.10       */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function reads a part of a disk image file. It is the image    */
+/*    read function of the virtual MSC configuration when the image is a  */
+/*    file, the image context being the FILE pointer.                     */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    context                               FILE pointer of the image     */
+/*    offset                                Offset in the image           */
+/*    buffer                                Pointer to data to read       */
+/*    length                                Number of bytes to read       */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    fread                                 Read from file                */
+/*    fseek                                 Set file position             */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_hcd_virtual_msc_bulk_in           Emulate bulk IN transfer      */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_hcd_virtual_msc_file_read(VOID *context, ULONG offset, UCHAR *buffer, ULONG length)
+{
+
+FILE            *image;
+
+
+    /* Get the image file.  */
+    image =  (FILE *) context;
+
+    /* Position the file on the data.  */
+    if (fseek(image, (long) offset, SEEK_SET) != 0)
+        return(UX_ERROR);
+
+    /* Read the data.  */
+    if (fread(buffer, 1, length, image) != length)
+        return(UX_ERROR);
+
+    /* Return successful completion.  */
+    return(UX_SUCCESS);
+}
+#endif
@@ -0,0 +1,134 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Virtual Mass Storage Controller Driver                              */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+#define UX_HCD_VIRTUAL_MSC_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_hcd_virtual_msc.h"
+#include "ux_host_stack.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_hcd_virtual_msc_initialize                      PORTABLE C      */
+/*                                                           6.1.10       */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function initializes the virtual MSC host controller. The      */
+/*    configuration of the emulated device is the second parameter given  */
+/*    to ux_host_stack_hcd_register. The device is attached to the root   */
+/*    port at once.                                                       */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    HCD                                   Pointer to HCD                */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_hcd_virtual_msc_device_connect    Attach or detach the device   */
+/*    _ux_utility_memory_allocate           Allocate memory block         */
+/*    _ux_utility_memory_free               Free memory block             */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Host Stack                                                          */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_hcd_virtual_msc_initialize(UX_HCD *hcd)
+{
+
+UX_HCD_VIRTUAL_MSC          *hcd_virtual_msc;
+UX_HCD_VIRTUAL_MSC_CONFIG   *config;
+
+
+    /* The controller initialized here is of virtual MSC type.  */
+    hcd -> ux_hcd_controller_type =  UX_HCD_VIRTUAL_MSC_CONTROLLER;
+
+    /* Get the configuration of the emulated device from the parameter.  */
+    config =  (UX_HCD_VIRTUAL_MSC_CONFIG *) (ALIGN_TYPE) hcd -> ux_hcd_irq;
+
+    /* Check the configuration, the image must have blocks and a way to reach them.  */
+    if ((config == UX_NULL) || (config -> ux_hcd_virtual_msc_config_block_count == 0) ||
+        (config -> ux_hcd_virtual_msc_config_block_size == 0) ||
+        ((config -> ux_hcd_virtual_msc_config_image == UX_NULL) &&
+         ((config -> ux_hcd_virtual_msc_config_image_read == UX_NULL) ||
+          (config -> ux_hcd_virtual_msc_config_image_write == UX_NULL))))
+    {
+
+        /* Error trap. */
+        _ux_system_error_handler(UX_SYSTEM_LEVEL_THREAD, UX_SYSTEM_CONTEXT_HCD, UX_ERROR);
+
+        return(UX_ERROR);
+    }
+
+    /* The bulk packets are full speed ones unless a high speed size is given.  */
+    if (config -> ux_hcd_virtual_msc_config_max_packet_size == 0)
+        config -> ux_hcd_virtual_msc_config_max_packet_size =  UX_HCD_VIRTUAL_MSC_FULL_SPEED_MAX_PACKET_SIZE;
+    if (config -> ux_hcd_virtual_msc_config_max_packet_size > UX_HCD_VIRTUAL_MSC_HIGH_SPEED_MAX_PACKET_SIZE)
+        config -> ux_hcd_virtual_msc_config_max_packet_size =  UX_HCD_VIRTUAL_MSC_HIGH_SPEED_MAX_PACKET_SIZE;
+
+    /* Allocate memory for this virtual MSC HCD instance.  */
+    hcd_virtual_msc =  _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY, sizeof(UX_HCD_VIRTUAL_MSC));
+    if (hcd_virtual_msc == UX_NULL)
+        return(UX_MEMORY_INSUFFICIENT);
+
+    /* Set the pointer to the virtual MSC HCD.  */
+    hcd -> ux_hcd_controller_hardware =  (VOID *) hcd_virtual_msc;
+
+    /* Set the generic HCD owner and the configuration for the virtual MSC HCD.  */
+    hcd_virtual_msc -> ux_hcd_virtual_msc_hcd_owner =  hcd;
+    hcd_virtual_msc -> ux_hcd_virtual_msc_config =  config;
+
+    /* Initialize the function collector for this HCD.  */
+    hcd -> ux_hcd_entry_function =  _ux_hcd_virtual_msc_entry;
+
+    /* The version follows the speed of the emulated device.  */
+#if UX_MAX_DEVICES > 1
+    hcd -> ux_hcd_version =  0x200;
+#endif
+
+    /* The controller has a single root port.  */
+    hcd -> ux_hcd_nb_root_hubs =  UX_HCD_VIRTUAL_MSC_NB_ROOT_PORTS;
+
+    /* The emulated device waits for its first command.  */
+    hcd_virtual_msc -> ux_hcd_virtual_msc_state =  UX_HCD_VIRTUAL_MSC_STATE_CBW;
+
+    /* Set the host controller into the operational state.  */
+    hcd -> ux_hcd_status =  UX_HCD_STATUS_OPERATIONAL;
+
+    /* Attach the emulated device to the root port.  */
+    _ux_hcd_virtual_msc_device_connect(hcd, UX_TRUE);
+
+    /* Return successful completion.  */
+    return(UX_SUCCESS);
+}
@@ -0,0 +1,141 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Virtual Mass Storage Controller Driver                              */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+#define UX_HCD_VIRTUAL_MSC_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_hcd_virtual_msc.h"
+#include "ux_host_stack.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_hcd_virtual_msc_request_transfer                PORTABLE C      */
+/*                                                           6.1.10       */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function performs a transfer on the emulated device. The       */
+/*    transfer is completed before returning: a control transfer returns  */
+/*    its completion code like on the STM32 controller, a bulk transfer   */
+/*    puts its semaphore for the class waiting on it.                     */
+/*                                                                        */
+/*    Before a bulk transfer completes, the configured latency is spent   */
+/*    and, every NAK period transfers, the configured number of frames is */
+/*    spent NAKed.                                                        */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    hcd_virtual_msc                       Pointer to virtual MSC HCD    */
+/*    transfer_request                      Pointer to transfer request   */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_hcd_virtual_msc_bulk_in           Emulate bulk IN transfer      */
+/*    _ux_hcd_virtual_msc_bulk_out          Emulate bulk OUT transfer     */
+/*    _ux_hcd_virtual_msc_control_request   Emulate control transfer      */
+/*    _ux_host_semaphore_put                Put semaphore                 */
+/*    _ux_utility_delay_ms                  Delay                         */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_hcd_virtual_msc_entry             Virtual MSC HCD entry         */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_hcd_virtual_msc_request_transfer(UX_HCD_VIRTUAL_MSC *hcd_virtual_msc, UX_TRANSFER *transfer_request)
+{
+
+UX_ENDPOINT                 *endpoint;
+UX_HCD_VIRTUAL_MSC_CONFIG   *config;
+
+
+    /* Get the pointer to the endpoint and to the device configuration.  */
+    endpoint =  (UX_ENDPOINT *) transfer_request -> ux_transfer_request_endpoint;
+    config =  hcd_virtual_msc -> ux_hcd_virtual_msc_config;
+
+    /* Nothing transferred yet.  */
+    transfer_request -> ux_transfer_request_actual_length =  0;
+
+    /* Check the type of endpoint.  */
+    if ((endpoint -> ux_endpoint_descriptor.bmAttributes & UX_MASK_ENDPOINT_TYPE) == UX_CONTROL_ENDPOINT)
+    {
+
+        /* A detached device does not answer.  */
+        if (hcd_virtual_msc -> ux_hcd_virtual_msc_connected == UX_FALSE)
+            transfer_request -> ux_transfer_request_completion_code =  UX_TRANSFER_NO_ANSWER;
+        else
+            transfer_request -> ux_transfer_request_completion_code =
+                                    _ux_hcd_virtual_msc_control_request(hcd_virtual_msc, transfer_request);
+
+        /* Control transfers complete in the controller.  */
+        return(transfer_request -> ux_transfer_request_completion_code);
+    }
+
+    /* One more bulk transfer.  */
+    hcd_virtual_msc -> ux_hcd_virtual_msc_bulk_transfers++;
+
+    /* Check if this transfer is NAKed for a while.  */
+    if ((config -> ux_hcd_virtual_msc_config_nak_period != 0) && (config -> ux_hcd_virtual_msc_config_nak_frames != 0) &&
+        ((hcd_virtual_msc -> ux_hcd_virtual_msc_bulk_transfers % config -> ux_hcd_virtual_msc_config_nak_period) == 0))
+    {
+
+        /* One NAK per frame.  */
+        hcd_virtual_msc -> ux_hcd_virtual_msc_naks +=  config -> ux_hcd_virtual_msc_config_nak_frames;
+        _ux_utility_delay_ms(config -> ux_hcd_virtual_msc_config_nak_frames);
+    }
+
+    /* Spend the latency of the device.  */
+    if (config -> ux_hcd_virtual_msc_config_latency_ms != 0)
+        _ux_utility_delay_ms(config -> ux_hcd_virtual_msc_config_latency_ms);
+
+    /* A detached device does not answer, it may have been removed during the delays.  */
+    if (hcd_virtual_msc -> ux_hcd_virtual_msc_connected == UX_FALSE)
+        transfer_request -> ux_transfer_request_completion_code =  UX_TRANSFER_NO_ANSWER;
+
+    /* Check the direction of the transfer.  */
+    else if (endpoint -> ux_endpoint_descriptor.bEndpointAddress & UX_ENDPOINT_DIRECTION)
+        transfer_request -> ux_transfer_request_completion_code =
+                                    _ux_hcd_virtual_msc_bulk_in(hcd_virtual_msc, transfer_request);
+    else
+        transfer_request -> ux_transfer_request_completion_code =
+                                    _ux_hcd_virtual_msc_bulk_out(hcd_virtual_msc, transfer_request);
+
+    /* Wake up the class waiting on the transfer.  */
+    _ux_host_semaphore_put(&transfer_request -> ux_transfer_request_semaphore);
+
+    /* Invoke the completion function, if any.  */
+    if (transfer_request -> ux_transfer_request_completion_function)
+        transfer_request -> ux_transfer_request_completion_function(transfer_request);
+
+    /* The transfer is started, its outcome is in the completion code.  */
+    return(UX_SUCCESS);
+}
@@ -238,6 +238,31 @@ VOID    outpl(ULONG,ULONG);
 #define UX_RESTORE_INTS         tx_interrupt_control(old_interrupt_posture);
 
 
+/* Define the extension to hold the control block for 64-bit mode. A pointer
+   does not fit in the ULONG entry parameter of a thread or a timer, keep it
+   in the extension of the ThreadX object instead.  */
+
+#if defined(TX_64_BIT) && !defined(UX_STANDALONE)
+
+#ifndef UX_THREAD_EXTENSION_PTR_SET
+#define UX_THREAD_EXTENSION_PTR_SET(a, b)                   TX_THREAD_EXTENSION_PTR_SET(a, b)
+#endif
+
+#ifndef UX_THREAD_EXTENSION_PTR_GET
+#define UX_THREAD_EXTENSION_PTR_GET(a, b, c)                TX_THREAD_EXTENSION_PTR_GET(a, b, c)
+#endif
+
+#ifndef UX_TIMER_EXTENSION_PTR_SET
+#define UX_TIMER_EXTENSION_PTR_SET(a, b)                    TX_TIMER_EXTENSION_PTR_SET(a, b)
+#endif
+
+#ifndef UX_TIMER_EXTENSION_PTR_GET
+#define UX_TIMER_EXTENSION_PTR_GET(a, b, c)                 TX_TIMER_EXTENSION_PTR_GET(a, b, c)
+#endif
+
+#endif
+
+
 /* Define the version ID of USBX.  This may be utilized by the application.  */
 
 #ifdef  UX_SYSTEM_INIT
@@ -27,6 +27,22 @@
 //#include "fx_stm32_levelx_nand_driver.h"
 #include <stdlib.h>
 
+// Pipelined copy: reader thread and the queues between reader and writer - one pipelined copy at a time
+static TX_THREAD FileCopyReaderHandler;
+static uint8_t FileCopyReaderStack[FILE_COPY_READER_STACK_SIZE];
+static TX_QUEUE FileCopyFreeQueue;
+static TX_QUEUE FileCopyFullQueue;
+static ULONG FileCopyFreeQueueStorage[FILE_COPY_PIPELINE_DEPTH];
+static ULONG FileCopyFullQueueStorage[FILE_COPY_PIPELINE_DEPTH];
+static Type_FileCopyBlock FileCopyBlock[FILE_COPY_PIPELINE_DEPTH];
+static FX_FILE *FileCopySourceFile;
+static ULONG FileCopyBlockSize;
+static volatile bool FileCopyAbort;
+static volatile bool FileCopyBusy = false;
+
+static UINT fileCopyOpenFiles(FX_MEDIA *DestinationMedia, char *DestinationFileName, FX_FILE *DestinationFileHandle, FX_MEDIA *SourceMedia, char *SourceFileName, FX_FILE *SourceFileHandle, bool ForceOverwrite);
+static VOID fileCopyReaderTask(ULONG NotUsed);
+
 
 /*******************************************************************************************************
 * @brief Determine if a file is present on disk
@@ -81,15 +97,13 @@ bool FileX_FS_FileExists(FX_MEDIA *MediaDrive, char *FilePathName)
 * @param TotalBytesTransfered: The total bytes transferred is returned by reference
 * @param ForceOverwrite: Force (or not) overwrite if the destination file is already present
 *
-* @return See FileX FX return status for file read and write operations.  OK is FX_SUCCESS
+* @return See FileX FX return status for file read, write and media flush operations.  OK is FX_SUCCESS
 *
 * STEP 1: Verify Drives have been assigned with simple test
-* STEP 2: Open the source file
-* STEP 3: Create the destination file - check for overwrite if file exist
-* STEP 4: Open the destination file
-* STEP 5: Allocate memory buffer for file read write transfer
-* STEP 6: Copy the file contents from Source To Destination until all bytes copied
-* STEP 7: Free file handle and block resources
+* STEP 2: Open the source file, create and open the destination file - check for overwrite if file exist
+* STEP 3: Allocate memory buffer for file read write transfer
+* STEP 4: Copy the file contents from Source To Destination until all bytes copied
+* STEP 5: Free file handle and block resources, flush the destination media
 ********************************************************************************************************/
 UINT FileX_FS_FileCopyDriveToDrive(FX_MEDIA *DestinationMedia, char *DestinationFileName, FX_MEDIA *SourceMedia, char *SourceFileName, TX_BLOCK_POOL *BlockPool, ULONG BlockPoolBlockSize, uint32_t *TotalBytesTransfered, bool ForceOverwrite)
 {
@@ -102,40 +116,12 @@ UINT FileX_FS_FileCopyDriveToDrive(FX_MEDIA *DestinationMedia, char *Destination
     if ((DestinationMedia == NULL) || (SourceMedia == NULL))
         return(FX_PTR_ERROR);
 
-    // STEP 2: Open the source file
-    FileX_Status = fx_file_open(SourceMedia, &SourceFileHandle, SourceFileName, FX_OPEN_FOR_READ);
-    if (FileX_Status != FX_SUCCESS)
-        return(FileX_Status);
-    FileX_Status = fx_file_seek(&SourceFileHandle, 0);
-
-    // STEP 3: Create the destination file - check for overwrite if file exist
-    FileX_Status = fx_file_create(DestinationMedia, DestinationFileName);
-    if (FileX_Status == FX_ALREADY_CREATED)
-    {
-        if (!ForceOverwrite)
-        {
-            fx_file_close(&SourceFileHandle);
-            return(FileX_Status);
-        }
-        fx_file_delete(DestinationMedia, DestinationFileName);
-        FileX_Status = fx_file_create(DestinationMedia, DestinationFileName);
-        if (FileX_Status != FX_SUCCESS)
-        {
-            fx_file_close(&SourceFileHandle);
-            return(FileX_Status);
-        }
-    }
-
-    // STEP 4: Open the destination file
-    FileX_Status = fx_file_open(DestinationMedia, &DestinationFileHandle, DestinationFileName, FX_OPEN_FOR_WRITE);
+    // STEP 2: Open the source file, create and open the destination file - check for overwrite if file exist
+    FileX_Status = fileCopyOpenFiles(DestinationMedia, DestinationFileName, &DestinationFileHandle, SourceMedia, SourceFileName, &SourceFileHandle, ForceOverwrite);
     if (FileX_Status != FX_SUCCESS)
-    {
-        fx_file_close(&SourceFileHandle);
-        fx_file_close(&DestinationFileHandle);
         return(FileX_Status);
-    }
 
-    // STEP 5: Allocate memory buffer for file read write transfer from the block pool
+    // STEP 3: Allocate memory buffer for file read write transfer from the block pool
     uint8_t *FileBuffer;
     if (tx_block_allocate(BlockPool, (VOID **)&FileBuffer, TX_NO_WAIT) != TX_SUCCESS)
     {
@@ -144,11 +130,17 @@ UINT FileX_FS_FileCopyDriveToDrive(FX_MEDIA *DestinationMedia, char *Destination
         return(FX_PTR_ERROR);
     }
 
-    // STEP 6: Copy the file contents from Source To Destination until all bytes copied
+    // STEP 4: Copy the file contents from Source To Destination until all bytes copied
     ULONG BytesRead;
     do
     {
         FileX_Status = fx_file_read(&SourceFileHandle, FileBuffer, BlockPoolBlockSize, &BytesRead);
+        // The source ended on a block boundary (or is empty): nothing left to copy
+        if (FileX_Status == FX_END_OF_FILE)
+        {
+            FileX_Status = FX_SUCCESS;
+            BytesRead = 0;
+        }
         if ((FileX_Status == FX_SUCCESS) && BytesRead)
         {
             FileX_Status = fx_file_write(&DestinationFileHandle, FileBuffer, BytesRead);
@@ -159,11 +151,13 @@ UINT FileX_FS_FileCopyDriveToDrive(FX_MEDIA *DestinationMedia, char *Destination
         }
     } while ((FileX_Status == FX_SUCCESS) && (BytesRead >= BlockPoolBlockSize));
 
-    // STEP 7: Free file handle and block resources
+    // STEP 5: Free file handle and block resources, flush the destination media
     fx_file_close(&SourceFileHandle);
     fx_file_close(&DestinationFileHandle);
     tx_block_release(FileBuffer);
-    fx_media_flush(DestinationMedia);
+    UINT FlushStatus = fx_media_flush(DestinationMedia);
+    if (FileX_Status == FX_SUCCESS)
+        FileX_Status = FlushStatus;
 
     return(FileX_Status);
 
@@ -171,6 +165,255 @@ UINT FileX_FS_FileCopyDriveToDrive(FX_MEDIA *DestinationMedia, char *Destination
 
 
 
+/*******************************************************************************************************
+* @brief Copies a file from one drive (media) to another drive (media) with an option to overwrite if the
+* file is pre-exsisting on the destination media.  Same as FileX_FS_FileCopyDriveToDrive but the reads of
+* the source media overlap the writes of the destination media.
+*
+* @author original: Hab Collector \n
+*
+* @note: The FileX must be previously initialized
+* @note: Both Media drives must be previously opened
+* @note: A reader thread fills FILE_COPY_PIPELINE_DEPTH blocks from the source file while the calling
+* thread writes the filled blocks to the destination file.  The blocks ping-pong between the two through
+* a free queue and a full queue.  The reader runs at the priority of the caller.
+* @note: The block pool must have FILE_COPY_PIPELINE_DEPTH blocks free.  Only one pipelined copy at a time.
+* @note: The copy rate covers the whole call up to the flush of the destination media, the same span a caller
+* times around FileX_FS_FileCopyDriveToDrive
+*
+* @param DestinationMedia: Handle to the Destination Drive Media
+* @param DestinationFileName: File name of destination
+* @param SourceMedia: Handle to the Source Drive Media
+* @param SourceFileName: File name of source
+* @param BlockPool: Block pool from which memory will be allocated
+* @param BlockPoolBlockSize: The size of the block that can be allocated from the block pool
+* @param TotalBytesTransfered: The total bytes transferred is returned by reference
+* @param ForceOverwrite: Force (or not) overwrite if the destination file is already present
+* @param BytesPerSecond: The achieved copy rate is returned by reference
+*
+* @return See FileX FX return status for file read, write and media flush operations.  OK is FX_SUCCESS
+*
+* STEP 1: Verify Drives have been assigned with simple test and no other pipelined copy is running
+* STEP 2: Open the source file, create and open the destination file - check for overwrite if file exist
+* STEP 3: Allocate the pipeline memory buffers for file read write transfer
+* STEP 4: Create the pipeline queues and the reader thread - all blocks start in the free queue
+* STEP 5: Write the blocks filled by the reader until the reader reports the last block
+* STEP 6: Free reader, queues, file handle and block resources, flush the destination media
+* STEP 7: Report the copy rate
+********************************************************************************************************/
+UINT FileX_FS_FileCopyDriveToDrivePipelined(FX_MEDIA *DestinationMedia, char *DestinationFileName, FX_MEDIA *SourceMedia, char *SourceFileName, TX_BLOCK_POOL *BlockPool, ULONG BlockPoolBlockSize, uint32_t *TotalBytesTransfered, bool ForceOverwrite, uint32_t *BytesPerSecond)
+{
+    FX_FILE DestinationFileHandle;
+    FX_FILE SourceFileHandle;
+    UINT FileX_Status;
+
+    // STEP 1: Verify Drives have been assigned with simple test and no other pipelined copy is running
+    ULONG StartTime = tx_time_get();
+    *TotalBytesTransfered = 0;
+    *BytesPerSecond = 0;
+    if ((DestinationMedia == NULL) || (SourceMedia == NULL))
+        return(FX_PTR_ERROR);
+    UINT InterruptPosture = tx_interrupt_control(TX_INT_DISABLE);
+    bool CopyAlreadyRunning = FileCopyBusy;
+    FileCopyBusy = true;
+    tx_interrupt_control(InterruptPosture);
+    if (CopyAlreadyRunning)
+        return(FX_CALLER_ERROR);
+
+    // STEP 2: Open the source file, create and open the destination file - check for overwrite if file exist
+    FileX_Status = fileCopyOpenFiles(DestinationMedia, DestinationFileName, &DestinationFileHandle, SourceMedia, SourceFileName, &SourceFileHandle, ForceOverwrite);
+    if (FileX_Status != FX_SUCCESS)
+    {
+        FileCopyBusy = false;
+        return(FileX_Status);
+    }
+
+    // STEP 3: Allocate the pipeline memory buffers for file read write transfer
+    ULONG BlockIndex;
+    for (BlockIndex = 0; BlockIndex < FILE_COPY_PIPELINE_DEPTH; BlockIndex++)
+    {
+        if (tx_block_allocate(BlockPool, (VOID **)&FileCopyBlock[BlockIndex].Buffer, TX_NO_WAIT) != TX_SUCCESS)
+        {
+            while (BlockIndex--)
+                tx_block_release(FileCopyBlock[BlockIndex].Buffer);
+            fx_file_close(&SourceFileHandle);
+            fx_file_close(&DestinationFileHandle);
+            FileCopyBusy = false;
+            return(FX_PTR_ERROR);
+        }
+    }
+
+    // STEP 4: Create the pipeline queues and the reader thread - all blocks start in the free queue
+    UINT CallerPriority;
+    tx_thread_info_get(tx_thread_identify(), TX_NULL, TX_NULL, TX_NULL, &CallerPriority, TX_NULL, TX_NULL, TX_NULL, TX_NULL);
+    FileCopySourceFile = &SourceFileHandle;
+    FileCopyBlockSize = BlockPoolBlockSize;
+    FileCopyAbort = false;
+    tx_queue_create(&FileCopyFreeQueue, "File Copy Free", TX_1_ULONG, FileCopyFreeQueueStorage, sizeof(FileCopyFreeQueueStorage));
+    tx_queue_create(&FileCopyFullQueue, "File Copy Full", TX_1_ULONG, FileCopyFullQueueStorage, sizeof(FileCopyFullQueueStorage));
+    for (BlockIndex = 0; BlockIndex < FILE_COPY_PIPELINE_DEPTH; BlockIndex++)
+        tx_queue_send(&FileCopyFreeQueue, &BlockIndex, TX_NO_WAIT);
+    tx_thread_create(&FileCopyReaderHandler, "File Copy Reader", fileCopyReaderTask, 0, FileCopyReaderStack, sizeof(FileCopyReaderStack), CallerPriority, CallerPriority, TX_NO_TIME_SLICE, TX_AUTO_START);
+
+    // STEP 5: Write the blocks filled by the reader until the reader reports the last block
+    Type_FileCopyBlock *Block;
+    bool LastBlock = false;
+    FileX_Status = FX_SUCCESS;
+    while (!LastBlock)
+    {
+        tx_queue_receive(&FileCopyFullQueue, &BlockIndex, TX_WAIT_FOREVER);
+        Block = &FileCopyBlock[BlockIndex];
+        LastBlock = (Block->FileX_Status != FX_SUCCESS) || (Block->BytesRead < BlockPoolBlockSize);
+        // After a write error the remaining blocks are only given back to the reader
+        if (!FileCopyAbort)
+        {
+            FileX_Status = Block->FileX_Status;
+            if ((Block->FileX_Status == FX_SUCCESS) && Block->BytesRead)
+            {
+                FileX_Status = fx_file_write(&DestinationFileHandle, Block->Buffer, Block->BytesRead);
+                if (FileX_Status != FX_SUCCESS)
+                    FileCopyAbort = true;
+                else
+                    *TotalBytesTransfered += Block->BytesRead;
+            }
+        }
+        tx_queue_send(&FileCopyFreeQueue, &BlockIndex, TX_NO_WAIT);
+    }
+
+    // STEP 6: Free reader, queues, file handle and block resources, flush the destination media
+    tx_thread_terminate(&FileCopyReaderHandler);
+    tx_thread_delete(&FileCopyReaderHandler);
+    tx_queue_delete(&FileCopyFreeQueue);
+    tx_queue_delete(&FileCopyFullQueue);
+    fx_file_close(&SourceFileHandle);
+    fx_file_close(&DestinationFileHandle);
+    for (BlockIndex = 0; BlockIndex < FILE_COPY_PIPELINE_DEPTH; BlockIndex++)
+        tx_block_release(FileCopyBlock[BlockIndex].Buffer);
+    UINT FlushStatus = fx_media_flush(DestinationMedia);
+    if (FileX_Status == FX_SUCCESS)
+        FileX_Status = FlushStatus;
+    ULONG ElapsedTime = tx_time_get() - StartTime;
+    FileCopyBusy = false;
+
+    // STEP 7: Report the copy rate
+    if (ElapsedTime == 0)
+        ElapsedTime = 1;
+    *BytesPerSecond = (uint32_t)(((uint64_t)*TotalBytesTransfered * TX_TIMER_TICKS_PER_SECOND) / ElapsedTime);
+
+    return(FileX_Status);
+
+} // END OF FileX_FS_FileCopyDriveToDrivePipelined
+
+
+
+/*******************************************************************************************************
+* @brief Open the source file for read, create and open the destination file for write.  Used by the drive
+* to drive copy functions.
+*
+* @author original: Hab Collector \n
+*
+* @note: On error no file is left open
+*
+* @param DestinationMedia: Handle to the Destination Drive Media
+* @param DestinationFileName: File name of destination
+* @param DestinationFileHandle: Destination file handle to open
+* @param SourceMedia: Handle to the Source Drive Media
+* @param SourceFileName: File name of source
+* @param SourceFileHandle: Source file handle to open
+* @param ForceOverwrite: Force (or not) overwrite if the destination file is already present
+*
+* @return See FileX FX return status for file open and create operations.  OK is FX_SUCCESS
+*
+* STEP 1: Open the source file
+* STEP 2: Create the destination file - check for overwrite if file exist
+* STEP 3: Open the destination file
+********************************************************************************************************/
+static UINT fileCopyOpenFiles(FX_MEDIA *DestinationMedia, char *DestinationFileName, FX_FILE *DestinationFileHandle, FX_MEDIA *SourceMedia, char *SourceFileName, FX_FILE *SourceFileHandle, bool ForceOverwrite)
+{
+    UINT FileX_Status;
+
+    // STEP 1: Open the source file
+    FileX_Status = fx_file_open(SourceMedia, SourceFileHandle, SourceFileName, FX_OPEN_FOR_READ);
+    if (FileX_Status != FX_SUCCESS)
+        return(FileX_Status);
+    FileX_Status = fx_file_seek(SourceFileHandle, 0);
+
+    // STEP 2: Create the destination file - check for overwrite if file exist
+    FileX_Status = fx_file_create(DestinationMedia, DestinationFileName);
+    if (FileX_Status == FX_ALREADY_CREATED)
+    {
+        if (!ForceOverwrite)
+        {
+            fx_file_close(SourceFileHandle);
+            return(FileX_Status);
+        }
+        fx_file_delete(DestinationMedia, DestinationFileName);
+        FileX_Status = fx_file_create(DestinationMedia, DestinationFileName);
+        if (FileX_Status != FX_SUCCESS)
+        {
+            fx_file_close(SourceFileHandle);
+            return(FileX_Status);
+        }
+    }
+
+    // STEP 3: Open the destination file
+    FileX_Status = fx_file_open(DestinationMedia, DestinationFileHandle, DestinationFileName, FX_OPEN_FOR_WRITE);
+    if (FileX_Status != FX_SUCCESS)
+    {
+        fx_file_close(SourceFileHandle);
+        fx_file_close(DestinationFileHandle);
+        return(FileX_Status);
+    }
+
+    return(FX_SUCCESS);
+
+} // END OF fileCopyOpenFiles
+
+
+
+/*******************************************************************************************************
+* @brief Reader thread of the pipelined drive to drive copy.  Fills the free blocks from the source file
+* and passes them to the writer until the end of the file, a read error or an abort from the writer.
+*
+* @author original: Hab Collector \n
+*
+* @note: The last block sent is the one with a read error or with less than a full block of data
+*
+* @param NotUsed: Thread input not used
+*
+* @return void
+*
+* STEP 1: Wait for a free block
+* STEP 2: Fill the block from the source file unless the writer gave up
+* STEP 3: Pass the block to the writer
+********************************************************************************************************/
+static VOID fileCopyReaderTask(ULONG NotUsed)
+{
+    Type_FileCopyBlock *Block;
+    ULONG BlockIndex;
+
+    do
+    {
+        // STEP 1: Wait for a free block
+        tx_queue_receive(&FileCopyFreeQueue, &BlockIndex, TX_WAIT_FOREVER);
+        Block = &FileCopyBlock[BlockIndex];
+        Block->BytesRead = 0;
+
+        // STEP 2: Fill the block from the source file unless the writer gave up
+        if (FileCopyAbort)
+            Block->FileX_Status = FX_IO_ERROR;
+        else
+            Block->FileX_Status = fx_file_read(FileCopySourceFile, Block->Buffer, FileCopyBlockSize, &Block->BytesRead);
+        // The source ended on a block boundary (or is empty): an empty last block
+        if (Block->FileX_Status == FX_END_OF_FILE)
+        {
+            Block->FileX_Status = FX_SUCCESS;
+            Block->BytesRead = 0;
+        }
 
+        // STEP 3: Pass the block to the writer
+        tx_queue_send(&FileCopyFullQueue, &BlockIndex, TX_WAIT_FOREVER);
 
+    } while ((Block->FileX_Status == FX_SUCCESS) && (Block->BytesRead >= FileCopyBlockSize));
 
+} // END OF fileCopyReaderTask
@@ -36,14 +36,25 @@ extern"C" {
 
 // DEFINES
 #define FILE_TRANSFER_BUFFER_SIZE           1024U
+// Pipelined copy: number of blocks ping-ponged between the reader thread and the writer
+#define FILE_COPY_PIPELINE_DEPTH            2U
+#define FILE_COPY_READER_STACK_SIZE         2048U
 
 
 // TYPEDEFS AND ENUMS
+// Block of the pipelined copy: filled by the reader thread, written by the writer.  The queues pass the block index
+typedef struct
+{
+    uint8_t     *Buffer;
+    ULONG       BytesRead;
+    UINT        FileX_Status;
+}Type_FileCopyBlock;
 
 
 // FUNCTION PROTOTYPES
 bool FileX_FS_FileExists(FX_MEDIA *MediaDrive, char *FileName);
 UINT FileX_FS_FileCopyDriveToDrive(FX_MEDIA *DestinationMedia, char *DestinationFileName, FX_MEDIA *SourceMedia, char *SourceFileName, TX_BLOCK_POOL *BlockPool, ULONG BlockPoolBlockSize, uint32_t *TotalBytesTransfered, bool ForceOverwrite);
+UINT FileX_FS_FileCopyDriveToDrivePipelined(FX_MEDIA *DestinationMedia, char *DestinationFileName, FX_MEDIA *SourceMedia, char *SourceFileName, TX_BLOCK_POOL *BlockPool, ULONG BlockPoolBlockSize, uint32_t *TotalBytesTransfered, bool ForceOverwrite, uint32_t *BytesPerSecond);
 
 #ifdef __cplusplus
 }
@@ -27,6 +27,9 @@
 static UART * Registerd_UARTs[MAX_UARTS];
 static int Number_of_UARTs = 0;
 
+static bool uartTxStart(UART *Bus);
+static void uartRxStart(UART *Bus);
+
 
 /*******************************************************************************************************
 * @brief Ready the desire UART port for use.  By definition the UART is configured for DMA on a circular
@@ -49,12 +52,22 @@ void Init_UART_DMA(UART * Bus, UART_HandleTypeDef *UART_Handle)
 	Bus->Enable = true;
 	Bus->Rx_BufferTailPointer = 0;
 	Bus->Is_Transmitting = false;
+	Bus->Tx_BufferHead = 0;
+	Bus->Tx_BufferTail = 0;
+	Bus->Tx_DMA_Length = 0;
+	Bus->Tx_Policy = UART_TX_POLICY;
+	Bus->Tx_DroppedBytes = 0;
+	tx_mutex_create(&Bus->Tx_Lock, "UART Tx", TX_INHERIT);
+	tx_semaphore_create(&Bus->Tx_Space, "UART Tx Space", 0);
+	Bus->Rx_Bytes = 0;
+	Bus->Rx_Overruns = 0;
+	tx_event_flags_create(&Bus->Rx_Event, "UART Rx");
 
 	if(Number_of_UARTs < MAX_UARTS)
 		Registerd_UARTs[Number_of_UARTs++] = Bus;
 
 	// Ready DMA to receive
-	HAL_UART_Receive_DMA(Bus->Handle, Bus->Rx_Buffer, UART_RX_BUFFER_SIZE);
+	uartRxStart(Bus);
 } // END OF Init_UART_DMA
 
 
@@ -78,7 +91,7 @@ void UART_Enable(UART *Bus)
     {
         HAL_UART_MspInit(Bus->Handle);
         Bus->Enable = true;
-        HAL_UART_Receive_DMA(Bus->Handle, Bus->Rx_Buffer, UART_RX_BUFFER_SIZE);
+        uartRxStart(Bus);
     }
 
 } // END OF UART_Enable
@@ -109,59 +122,130 @@ void UART_Disable(UART *Bus)
 
 
 /*******************************************************************************************************
-* @brief UART Receive from DMA function, Receive Data via the UART DMA circular buffer
+* @brief UART Receive from DMA function, Receive Data via the UART DMA circular buffer without waiting
 *
 * @author original: Hab Collector \n
 *
-* @note: This essence of this function is copied from work originally done by Devin K. for use in the Devin OS.
-* It is generalize and adapted here. Mostly just variable name changes
-*
 * @param Bus: The UART specific handler
-* @param DataBuffer: Receive Buffer - user must allocated as necessary
+* @param DataBuffer: Receive Buffer - user must allocated UART_RX_BUFFER_SIZE bytes
 * @param DataBufferLength: Number of chars received - if 0 there is nothing
 *
 * @return The number of bytes received
 *
-* STEP 1: See work done by Devin K. in handling Rx DMA circular buffer
+* STEP 1: Read what the DMA has received, see UART_Receive
 ********************************************************************************************************/
 uint32_t UART_DMA_Receive(UART *Bus, uint8_t *DataBuffer, uint32_t *DataBufferLength)
 {
-    // STEP 1: See work done by Devin K. in handling Rx DMA circular buffer
-    *DataBufferLength = 0;
-    if(Bus->Handle->RxState == HAL_UART_STATE_BUSY_RX)
+    // STEP 1: Read what the DMA has received, see UART_Receive
+    *DataBufferLength = UART_Receive(Bus, DataBuffer, UART_RX_BUFFER_SIZE, TX_NO_WAIT);
+    return(*DataBufferLength);
+
+} // END OF UART_DMA_Receive
+
+
+
+/*******************************************************************************************************
+* @brief UART Receive, read the data received by the DMA in the circular Rx buffer.  The DMA half transfer,
+* transfer complete and idle line events signal the Rx event flag of the UART, so the caller can block until
+* data arrives instead of polling.
+*
+* @author original: Hab Collector \n
+*
+* @note: Data not read before the DMA writes over it is lost: the Rx buffer is flushed and counted as an
+* overrun in Rx_Overruns.
+*
+* @param Bus: The UART specific handler
+* @param DataBuffer: Receive Buffer - user must allocated as necessary
+* @param DataBufferSize: Size of the receive buffer
+* @param WaitOption: TX_NO_WAIT, TX_WAIT_FOREVER or a timeout in ticks
+*
+* @return The number of bytes received, 0 on timeout
+*
+* STEP 1: Wait for data
+* STEP 2: Check for an Rx buffer overflow
+* STEP 3: Copy the data from the tail of the Rx buffer
+********************************************************************************************************/
+uint32_t UART_Receive(UART *Bus, uint8_t *DataBuffer, uint32_t DataBufferSize, ULONG WaitOption)
+{
+    ULONG ActualFlags;
+    uint32_t DataLength = 0;
+
+    // STEP 1: Wait for data
+    while (Bus->Rx_Bytes == Bus->Rx_BytesRead)
     {
-        while(Bus->Rx_BufferTailPointer != (UART_RX_BUFFER_SIZE - Bus->Handle->hdmarx->Instance->CNDTR))
-        {
-            DataBuffer[(*DataBufferLength)++] = Bus->Rx_Buffer[Bus->Rx_BufferTailPointer++];
+        if (tx_event_flags_get(&Bus->Rx_Event, UART_RX_EVENT_DATA, TX_OR_CLEAR, &ActualFlags, WaitOption) != TX_SUCCESS)
+            return(0);
+    }
 
-            if(Bus->Rx_BufferTailPointer >= UART_RX_BUFFER_SIZE)
-                Bus->Rx_BufferTailPointer = 0;
-        }
-        return (int32_t)*DataBufferLength;
+    // STEP 2: Check for an Rx buffer overflow
+    uint32_t BytesReceived = Bus->Rx_Bytes;
+    uint32_t BytesAvailable = BytesReceived - Bus->Rx_BytesRead;
+    if (BytesAvailable >= UART_RX_BUFFER_SIZE)
+    {
+        Bus->Rx_Overruns++;
+        Bus->Rx_BytesRead = BytesReceived;
+        Bus->Rx_BufferTailPointer = Bus->Rx_BufferHeadPointer;
+        return(0);
     }
 
-    return(*DataBufferLength);
+    // STEP 3: Copy the data from the tail of the Rx buffer
+    while ((DataLength < BytesAvailable) && (DataLength < DataBufferSize))
+    {
+        DataBuffer[DataLength++] = Bus->Rx_Buffer[Bus->Rx_BufferTailPointer++];
+        if (Bus->Rx_BufferTailPointer >= UART_RX_BUFFER_SIZE)
+            Bus->Rx_BufferTailPointer = 0;
+    }
+    Bus->Rx_BytesRead += DataLength;
 
-} // END OF UART_DMA_Receive
+    return(DataLength);
+
+} // END OF UART_Receive
 
 
+
+/*******************************************************************************************************
+* @brief Start the circular DMA reception with the half transfer, transfer complete and idle line events.
+*
+* @author original: Hab Collector \n
+*
+* @param Bus: The UART specific handler
+*
+* @return void
+*
+* STEP 1: The DMA writes from the start of the Rx buffer, nothing is left to read
+* STEP 2: Start the reception
+********************************************************************************************************/
+static void uartRxStart(UART *Bus)
+{
+    // STEP 1: The DMA writes from the start of the Rx buffer, nothing is left to read
+    Bus->Rx_BufferHeadPointer = 0;
+    Bus->Rx_BufferTailPointer = 0;
+    Bus->Rx_BytesRead = Bus->Rx_Bytes;
+
+    // STEP 2: Start the reception
+    HAL_UARTEx_ReceiveToIdle_DMA(Bus->Handle, Bus->Rx_Buffer, UART_RX_BUFFER_SIZE);
+
+} // END OF uartRxStart
+
+
+/*******************************************************************************************************
+* @brief UART Transmit via DMA.  The data is queued in the Tx ring of the UART, see UART_Write.
+*
+* @author original: Hab Collector \n
+*
+* @param Bus: The UART specific handler
+* @param DataBuffer: Data to send, it may be reused as soon as the function returns
+* @param DataLength: Number of bytes to send
+*
+* @return The number of bytes queued
+********************************************************************************************************/
 uint16_t UART_DMA_Transmit(UART *Bus, uint8_t *DataBuffer, uint16_t DataLength)
 {
-	if (Bus->Is_Transmitting)
-	{
-	    return(0);
-	}
+    return((uint16_t)UART_Write(Bus, DataBuffer, DataLength));
+
+} // END OF UART_DMA_Transmit
 
-	uint16_t ReturnValueDataLength = 0;
-	HAL_StatusTypeDef Status = HAL_UART_Transmit_DMA(Bus->Handle, DataBuffer, DataLength);
-	if (Status == HAL_OK)
-	{
-		Bus->Is_Transmitting = true;
-		ReturnValueDataLength = DataLength;
-	}
 
-	return(ReturnValueDataLength);
-}
 
 uint16_t UART_Transmit_String(UART * Bus, const char * str)
 {
@@ -170,12 +254,151 @@ uint16_t UART_Transmit_String(UART * Bus, const char * str)
 
 
 
+/*******************************************************************************************************
+* @brief Queue data in the Tx ring of the UART.  The DMA is started if idle, else the data goes out with
+* the next DMA transfer chained from the Tx complete callback.  The function only waits when the ring is
+* full and the Tx policy of the UART is UART_TX_BLOCK.
+*
+* @author original: Hab Collector \n
+*
+* @note: Threads are serialized by the Tx lock.  Before the scheduler runs and from an ISR there is no
+* lock and no wait: what does not fit is dropped.  A thread also drops what does not fit when the DMA cannot
+* be started, the wait for space is retried every UART_TX_RETRY_TICKS so a failed start is not waited on forever.
+* The dropped bytes are counted in Tx_DroppedBytes.
+*
+* @param Bus: The UART specific handler
+* @param DataBuffer: Data to send, it may be reused as soon as the function returns
+* @param DataLength: Number of bytes to send
+*
+* @return The number of bytes queued
+*
+* STEP 1: Lock the ring when called from a thread
+* STEP 2: Copy the data in the ring as space allows, waiting or dropping when it is full
+* STEP 3: Start the DMA if idle
+* STEP 4: Unlock
+********************************************************************************************************/
+uint32_t UART_Write(UART *Bus, const uint8_t *DataBuffer, uint32_t DataLength)
+{
+    uint32_t BytesQueued = 0;
+
+    // STEP 1: Lock the ring when called from a thread
+    bool IsThread = (__get_IPSR() == 0) && (tx_thread_identify() != TX_NULL);
+    if (IsThread)
+        tx_mutex_get(&Bus->Tx_Lock, TX_WAIT_FOREVER);
+    else if (__get_IPSR() != 0)
+    {
+        // ISR: another writer may own the ring
+        Bus->Tx_DroppedBytes += DataLength;
+        return(0);
+    }
+
+    // STEP 2: Copy the data in the ring as space allows, waiting or dropping when it is full
+    while (DataLength)
+    {
+        uint32_t Head = Bus->Tx_BufferHead;
+        uint32_t Tail = Bus->Tx_BufferTail;
+        uint32_t FreeSpace = (Tail + UART_TX_BUFFER_SIZE - Head - 1) % UART_TX_BUFFER_SIZE;
+        if (FreeSpace == 0)
+        {
+            if (!IsThread || (Bus->Tx_Policy == UART_TX_DROP))
+            {
+                Bus->Tx_DroppedBytes += DataLength;
+                break;
+            }
+            // Only a running DMA frees space: restart it if a previous start failed, drop if it cannot start
+            if (!uartTxStart(Bus))
+            {
+                Bus->Tx_DroppedBytes += DataLength;
+                break;
+            }
+            tx_semaphore_get(&Bus->Tx_Space, UART_TX_RETRY_TICKS);
+            continue;
+        }
+
+        uint32_t CopySize = UART_TX_BUFFER_SIZE - Head;
+        CopySize = (CopySize > FreeSpace)? FreeSpace : CopySize;
+        CopySize = (CopySize > DataLength)? DataLength : CopySize;
+        memcpy(&Bus->Tx_Buffer[Head], DataBuffer, CopySize);
+        Bus->Tx_BufferHead = (Head + CopySize) % UART_TX_BUFFER_SIZE;
+        DataBuffer += CopySize;
+        DataLength -= CopySize;
+        BytesQueued += CopySize;
+
+        // STEP 3: Start the DMA if idle
+        uartTxStart(Bus);
+    }
+
+    // STEP 4: Unlock
+    if (IsThread)
+        tx_mutex_put(&Bus->Tx_Lock);
+
+    return(BytesQueued);
+
+} // END OF UART_Write
+
+
+
+/*******************************************************************************************************
+* @brief Start a DMA transfer of the contiguous data at the tail of the Tx ring if no transfer is in flight.
+*
+* @author original: Hab Collector \n
+*
+* @note: Called from UART_Write and from the Tx complete callback.  A failed start leaves the data in the
+* ring, the next call retries it.
+*
+* @param Bus: The UART specific handler
+*
+* @return True if a DMA transfer is in flight
+*
+* STEP 1: Claim the transmitter if idle and there is data
+* STEP 2: Start the DMA, release the transmitter if it could not start
+********************************************************************************************************/
+static bool uartTxStart(UART *Bus)
+{
+    // STEP 1: Claim the transmitter if idle and there is data
+    uint32_t PriMask = __get_PRIMASK();
+    __disable_irq();
+    uint32_t Head = Bus->Tx_BufferHead;
+    uint32_t Tail = Bus->Tx_BufferTail;
+    if (Bus->Is_Transmitting || (Head == Tail))
+    {
+        bool Is_Transmitting = Bus->Is_Transmitting;
+        __set_PRIMASK(PriMask);
+        return(Is_Transmitting);
+    }
+    Bus->Is_Transmitting = true;
+    Bus->Tx_DMA_Length = (Head > Tail)? (Head - Tail) : (UART_TX_BUFFER_SIZE - Tail);
+    __set_PRIMASK(PriMask);
+
+    // STEP 2: Start the DMA, release the transmitter if it could not start
+    if (HAL_UART_Transmit_DMA(Bus->Handle, &Bus->Tx_Buffer[Tail], (uint16_t)Bus->Tx_DMA_Length) != HAL_OK)
+    {
+        Bus->Tx_DMA_Length = 0;
+        Bus->Is_Transmitting = false;
+        return(false);
+    }
+    return(true);
+
+} // END OF uartTxStart
+
+
+
 // QUICK ACCESS FUNCTIONS:
 bool is_UART_Enable(UART *Bus)
 {
     return(Bus->Enable);
 }
 
+void UART_TxPolicySet(UART *Bus, Type_UART_TxPolicy Policy)
+{
+    Bus->Tx_Policy = Policy;
+}
+
+uint32_t UART_TxDroppedBytes(UART *Bus)
+{
+    return(Bus->Tx_DroppedBytes);
+}
+
 void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart)
 {
 	// Find the UART structure based on the handle
@@ -183,7 +406,30 @@ void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart)
 	{
 		if(Registerd_UARTs[i]->Handle == huart)
 		{
-			Registerd_UARTs[i]->Is_Transmitting = false;
+			// Release the sent data and chain the next transfer
+			UART *Bus = Registerd_UARTs[i];
+			Bus->Tx_BufferTail = (Bus->Tx_BufferTail + Bus->Tx_DMA_Length) % UART_TX_BUFFER_SIZE;
+			Bus->Tx_DMA_Length = 0;
+			Bus->Is_Transmitting = false;
+			uartTxStart(Bus);
+			tx_semaphore_ceiling_put(&Bus->Tx_Space, 1);
+		}
+	}
+}
+
+void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t Size)
+{
+	// Find the UART structure based on the handle
+	for(int i = 0; i < Number_of_UARTs; i++)
+	{
+		if(Registerd_UARTs[i]->Handle == huart)
+		{
+			// Size is the DMA write position in the Rx buffer, count what was written since the last event
+			UART *Bus = Registerd_UARTs[i];
+			uint32_t Head = (uint32_t)Size % UART_RX_BUFFER_SIZE;
+			Bus->Rx_Bytes += (Head + UART_RX_BUFFER_SIZE - Bus->Rx_BufferHeadPointer) % UART_RX_BUFFER_SIZE;
+			Bus->Rx_BufferHeadPointer = Head;
+			tx_event_flags_set(&Bus->Rx_Event, UART_RX_EVENT_DATA, TX_OR);
 		}
 	}
 }
@@ -196,11 +442,20 @@ void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart)
 		if(Registerd_UARTs[i]->Handle == huart)
 		{
 			// We have found the correct UART, reset the bus
-			Registerd_UARTs[i]->Rx_BufferTailPointer = 0;
-			Registerd_UARTs[i]->Is_Transmitting = false;
+			UART *Bus = Registerd_UARTs[i];
+			if (huart->ErrorCode & HAL_UART_ERROR_ORE)
+				Bus->Rx_Overruns++;
 			HAL_DMA_Abort_IT(huart->hdmarx);
 			HAL_UART_DMAStop(huart);
-			HAL_UART_Receive_DMA(huart, Registerd_UARTs[i]->Rx_Buffer, UART_RX_BUFFER_SIZE);
+			uartRxStart(Bus);
+
+			// The transfer in flight is lost, restart with the rest of the Tx ring
+			Bus->Tx_DroppedBytes += Bus->Tx_DMA_Length;
+			Bus->Tx_BufferTail = (Bus->Tx_BufferTail + Bus->Tx_DMA_Length) % UART_TX_BUFFER_SIZE;
+			Bus->Tx_DMA_Length = 0;
+			Bus->Is_Transmitting = false;
+			uartTxStart(Bus);
+			tx_semaphore_ceiling_put(&Bus->Tx_Space, 1);
 		}
 	}
 }
@@ -25,15 +25,26 @@ extern"C" {
 #endif
 
 #include "usart.h"
+#include "tx_api.h"
 #include <main.h>
 #include <stdint.h>
 #include <stdbool.h>
 
 // DEFINES
 #define UART_RX_BUFFER_SIZE     256U
+#define UART_TX_BUFFER_SIZE     2048U
+#define UART_RX_EVENT_DATA      0x00000001UL    // Rx event flag: the DMA has written new data
+#define UART_TX_POLICY          UART_TX_BLOCK   // What a write does when the Tx ring is full
+#define UART_TX_RETRY_TICKS     10U             // A blocked write retries the DMA start at this period
 
 
 // TYPEDEFS AND ENUMS
+typedef enum
+{
+    UART_TX_BLOCK = 0,      // Wait for the DMA to free space in the ring
+    UART_TX_DROP            // Drop what does not fit and count it
+}Type_UART_TxPolicy;
+
 typedef uint32_t (*Function_UART_Tx)(uint8_t *DataBuffer, uint32_t DataSize);
 typedef uint32_t (*Function_UART_Rx)(uint8_t *DataBuffer, uint32_t *DataSize);
 typedef struct
@@ -42,7 +53,20 @@ typedef struct
     bool                    Enable;
     uint8_t                 Rx_Buffer[UART_RX_BUFFER_SIZE];
     uint32_t                Rx_BufferTailPointer;
+    volatile uint32_t       Rx_BufferHeadPointer;   // DMA write position at the last Rx event
+    volatile uint32_t       Rx_Bytes;               // Bytes received
+    uint32_t                Rx_BytesRead;           // Bytes read by UART_Receive
+    volatile uint32_t       Rx_Overruns;            // UART overrun errors and Rx ring overflows
+    TX_EVENT_FLAGS_GROUP    Rx_Event;
     volatile bool					Is_Transmitting;
+    uint8_t                 Tx_Buffer[UART_TX_BUFFER_SIZE];
+    volatile uint32_t       Tx_BufferHead;          // Next byte written by UART_Write
+    volatile uint32_t       Tx_BufferTail;          // First byte not yet sent
+    volatile uint32_t       Tx_DMA_Length;          // Bytes of the DMA transfer in flight
+    Type_UART_TxPolicy      Tx_Policy;
+    volatile uint32_t       Tx_DroppedBytes;
+    TX_MUTEX                Tx_Lock;
+    TX_SEMAPHORE            Tx_Space;               // Put on each DMA complete
 //    Function_UART_Tx        UART_Tx;
 //    Function_UART_Rx        UART_Rx;
 }UART;
@@ -51,8 +75,12 @@ typedef struct
 // FUNCTION PROTOTYPES
 void Init_UART_DMA(UART * Bus, UART_HandleTypeDef *UART_Handle);
 uint32_t UART_DMA_Receive(UART *Bus, uint8_t *DataBuffer, uint32_t *DataLength);
+uint32_t UART_Receive(UART *Bus, uint8_t *DataBuffer, uint32_t DataBufferSize, ULONG WaitOption);
 uint16_t UART_DMA_Transmit(UART *Bus, uint8_t *DataBuffer, uint16_t DataLength);
 uint16_t UART_Transmit_String(UART * Bus, const char * str);
+uint32_t UART_Write(UART *Bus, const uint8_t *DataBuffer, uint32_t DataLength);
+void UART_TxPolicySet(UART *Bus, Type_UART_TxPolicy Policy);
+uint32_t UART_TxDroppedBytes(UART *Bus);
 
 #ifdef __cplusplus
 }
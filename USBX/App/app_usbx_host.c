@@ -26,6 +26,7 @@
 #include "TestApp_USB_MSC.h"
 #include "IO_Support.h"
 #include "usb_otg.h"
+#include "USB_Drive.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -35,7 +36,9 @@
 
 /* Private define ------------------------------------------------------------*/
 /* USER CODE BEGIN PD */
-
+#if (USB_DRIVE_MAX > USB_EVENT_MSC_MAX_DRIVES)
+#error "The USB event flags carry the drive index of up to USB_EVENT_MSC_MAX_DRIVES drives"
+#endif
 /* USER CODE END PD */
 
 /* Private macro -------------------------------------------------------------*/
@@ -49,15 +52,13 @@ static TX_THREAD ux_host_app_thread;
 
 /* USER CODE BEGIN PV */
 TX_THREAD                   msc_app_thread;
-UX_HOST_CLASS_STORAGE       *storage;
-UX_HOST_CLASS_STORAGE_MEDIA *storage_media;
-FX_MEDIA                    *USB_Media;
 TX_EVENT_FLAGS_GROUP        USB_EventFlag;
 
 UCHAR *USBX_AllocatedStackMemoryPtr;
 UCHAR *USBX_AllocatedHostAppTaskPtr;
 bool USB_EventFlagCreated = false;
 bool USB_OTG_FS_HCD_Init = false;
+static UCHAR USBX_CacheSafeMemory[USBX_HOST_CACHE_SAFE_MEMORY_SIZE] __attribute__((section(".ram3"), aligned(32)));
 
 extern HCD_HandleTypeDef hhcd_USB_OTG_FS;
 /* USER CODE END PV */
@@ -96,7 +97,7 @@ UINT MX_USBX_Host_Init(VOID *memory_ptr)
   USBX_AllocatedStackMemoryPtr = pointer;
 
   /* Initialize USBX Memory */
-  if (ux_system_initialize(pointer, USBX_HOST_MEMORY_STACK_SIZE, UX_NULL, 0) != UX_SUCCESS)
+  if (ux_system_initialize(pointer, USBX_HOST_MEMORY_STACK_SIZE, USBX_CacheSafeMemory, USBX_HOST_CACHE_SAFE_MEMORY_SIZE) != UX_SUCCESS)
   {
     /* USER CODE BEGIN USBX_SYSTEM_INITIALIZE_ERORR */
     return UX_ERROR;
@@ -114,6 +115,15 @@ UINT MX_USBX_Host_Init(VOID *memory_ptr)
   /* Register a callback error function */
   ux_utility_error_callback_register(&ux_host_error_callback);
 
+  /* Initialize the host hub class */
+  if (ux_host_stack_class_register(_ux_system_host_class_hub_name,
+                                   ux_host_class_hub_entry) != UX_SUCCESS)
+  {
+    /* USER CODE BEGIN USBX_HOST_HUB_REGISTER_ERORR */
+    return UX_ERROR;
+    /* USER CODE END USBX_HOST_HUB_REGISTER_ERORR */
+  }
+
   /* Initialize the host storage class */
   if (ux_host_stack_class_register(_ux_system_host_class_storage_name,
                                    ux_host_class_storage_entry) != UX_SUCCESS)
@@ -197,32 +207,31 @@ UINT ux_host_event_callback(ULONG event, UX_HOST_CLASS *current_class, VOID *cur
       /* Get current Storage Class */
       if (current_class -> ux_host_class_entry_function == ux_host_class_storage_entry)
       {
-        if (storage == UX_NULL)
-        {
-          /* Get current Storage Instance */
-          storage = (UX_HOST_CLASS_STORAGE *)current_instance;
+        ULONG EventFlags = USB_EVENT_MSC_INSERTED;
+        UX_HOST_CLASS_STORAGE *Storage;
+        UX_HOST_CLASS_STORAGE_MEDIA *StorageMedia;
 
-          /* Get the storage media */
-          storage_media = (UX_HOST_CLASS_STORAGE_MEDIA *)current_class -> ux_host_class_media;
+        /* Get current Storage Instance */
+        Storage = (UX_HOST_CLASS_STORAGE *)current_instance;
 
-          if (storage_media -> ux_host_class_storage_media_lun != 0)
-          {
-            storage_media = UX_NULL;
-          }
-          else
-          {
-            /* Get the media file */
-            USB_Media = &storage_media->ux_host_class_storage_media;
-          }
+        /* Add the storage media of each LUN mounted on this device to the drive registry */
+        StorageMedia = (UX_HOST_CLASS_STORAGE_MEDIA *)current_class -> ux_host_class_media;
+        for (UINT MediaIndex = 0; MediaIndex < UX_HOST_CLASS_STORAGE_MAX_MEDIA; MediaIndex++, StorageMedia++)
+        {
+          if (ux_media_driver_info_get(&StorageMedia -> ux_host_class_storage_media) != (VOID *)Storage)
+            continue;
+          uint8_t Drive = USB_DriveAdd(StorageMedia);
+          if (Drive != USB_DRIVE_NONE)
+            EventFlags |= USB_EVENT_MSC_DRIVE_INSERTED_FLAG(Drive);
+        }
 
-          /* Check the storage class state */
-          if (storage -> ux_host_class_storage_state ==  UX_HOST_CLASS_INSTANCE_LIVE)
+        /* Check the storage class state */
+        if (Storage -> ux_host_class_storage_state ==  UX_HOST_CLASS_INSTANCE_LIVE)
+        {
+          /* Set STORAGE_MEDIA flag */
+          if (tx_event_flags_set(&USB_EventFlag, EventFlags, TX_OR) != TX_SUCCESS)
           {
-            /* Set STORAGE_MEDIA flag */
-            if (tx_event_flags_set(&USB_EventFlag, USB_EVENT_MSC_INSERTED, TX_OR) != TX_SUCCESS)
-            {
-              Error_Handler();
-            }
+            Error_Handler();
           }
         }
       }
@@ -233,14 +242,19 @@ UINT ux_host_event_callback(ULONG event, UX_HOST_CLASS *current_class, VOID *cur
     case UX_DEVICE_REMOVAL:
 
       /* USER CODE BEGIN UX_DEVICE_REMOVAL */
-      if ((VOID*)storage == current_instance)
+      if (current_class -> ux_host_class_entry_function == ux_host_class_storage_entry)
       {
-        /* Clear storage media instance & media file */
-        storage = UX_NULL;
-        storage_media = UX_NULL;
-        USB_Media = UX_NULL;
+        ULONG EventFlags = USB_EVENT_MSC_REMOVED;
+
+        /* Remove the drives of this storage device from the drive registry */
+        uint32_t RemovedDrives = USB_DriveRemoveStorage((UX_HOST_CLASS_STORAGE *)current_instance);
+        for (uint8_t Drive = 0; Drive < USB_DRIVE_MAX; Drive++)
+        {
+          if (RemovedDrives & (1UL << Drive))
+            EventFlags |= USB_EVENT_MSC_DRIVE_REMOVED_FLAG(Drive);
+        }
 
-        if (tx_event_flags_set(&USB_EventFlag, USB_EVENT_MSC_REMOVED, TX_OR) != TX_SUCCESS)
+        if (tx_event_flags_set(&USB_EventFlag, EventFlags, TX_OR) != TX_SUCCESS)
         {
           Error_Handler();
         }
@@ -249,11 +263,20 @@ UINT ux_host_event_callback(ULONG event, UX_HOST_CLASS *current_class, VOID *cur
 
       break;
 
-#if defined (UX_HOST_CLASS_STORAGE_NO_FILEX)
+#if defined (UX_HOST_CLASS_STORAGE_NO_FILEX) || defined (UX_HOST_CLASS_STORAGE_ADAPTIVE_POLL_ENABLE)
     case UX_STORAGE_MEDIA_INSERTION:
 
       /* USER CODE BEGIN UX_STORAGE_MEDIA_INSERTION */
-
+#if defined (UX_HOST_CLASS_STORAGE_ADAPTIVE_POLL_ENABLE)
+      /* A media was mounted by the storage class thread, it is a new drive */
+      {
+        uint8_t Drive = USB_DriveAdd((UX_HOST_CLASS_STORAGE_MEDIA *)current_instance);
+        if ((Drive != USB_DRIVE_NONE) && (tx_event_flags_set(&USB_EventFlag, USB_EVENT_MSC_DRIVE_INSERTED_FLAG(Drive), TX_OR) != TX_SUCCESS))
+        {
+          Error_Handler();
+        }
+      }
+#endif
       /* USER CODE END UX_STORAGE_MEDIA_INSERTION */
 
       break;
@@ -261,7 +284,16 @@ UINT ux_host_event_callback(ULONG event, UX_HOST_CLASS *current_class, VOID *cur
     case UX_STORAGE_MEDIA_REMOVAL:
 
       /* USER CODE BEGIN UX_STORAGE_MEDIA_REMOVAL */
-
+#if defined (UX_HOST_CLASS_STORAGE_ADAPTIVE_POLL_ENABLE)
+      /* The media of a drive was unmounted, the device itself is still there */
+      {
+        uint8_t Drive = USB_DriveRemove((UX_HOST_CLASS_STORAGE_MEDIA *)current_instance);
+        if ((Drive != USB_DRIVE_NONE) && (tx_event_flags_set(&USB_EventFlag, USB_EVENT_MSC_DRIVE_REMOVED_FLAG(Drive), TX_OR) != TX_SUCCESS))
+        {
+          Error_Handler();
+        }
+      }
+#endif
       /* USER CODE END UX_STORAGE_MEDIA_REMOVAL */
 
       break;
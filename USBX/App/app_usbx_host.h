@@ -29,6 +29,7 @@ extern "C" {
 #include "ux_api.h"
 #include "main.h"
 #include "ux_host_msc.h"
+#include "ux_host_class_hub.h"
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
 #include "ux_hcd_stm32.h"
@@ -41,12 +42,15 @@ extern "C" {
 /* USER CODE END ET */
 
 /* Exported constants --------------------------------------------------------*/
-#define USBX_HOST_MEMORY_STACK_SIZE     22 * 1024
+#define USBX_HOST_MEMORY_STACK_SIZE     32 * 1024
 
 #define UX_HOST_APP_THREAD_STACK_SIZE   1024
 #define UX_HOST_APP_THREAD_PRIO         10
 
 /* USER CODE BEGIN EC */
+// USBX cache safe memory, all of RAM3: FileX sector cache, read-ahead and write buffers, cluster bitmap
+// (up to 256K) and directory index of each media
+#define USBX_HOST_CACHE_SAFE_MEMORY_SIZE    (384 * 1024)
 
 /* USER CODE END EC */
 
@@ -131,7 +131,7 @@
    class, then the UX_MAX_CLASSES value can be set to 3 regardless of the number of devices
    that belong to these classes.  */
 
-/* #define UX_MAX_CLASS_DRIVER    3 */
+#define UX_MAX_CLASS_DRIVER    2
 
 /* Defined, this value is the maximum number of classes in the device stack that can be loaded by
    USBX.  */
@@ -151,7 +151,9 @@
    scaled down to conserve memory. Note that this value represents the total number of devices
    regardless of the number of USB buses in the system.  */
 
-/* #define UX_MAX_DEVICES    127 */
+/* The hub and two storage devices on its ports.  */
+
+#define UX_MAX_DEVICES    3
 
 /* Defined, this value is the maximum number of interfaces in the device framework.  */
 
@@ -505,6 +507,159 @@
 
 /* USER CODE BEGIN 2 */
 
+/* Defined, the SCSI data phase of the bulk only transport is no longer split every
+   UX_HOST_CLASS_STORAGE_MAX_TRANSFER_SIZE bytes. A data phase goes out as one transfer request,
+   bounded only by the maximum transfer length of the bulk endpoint.
+   The limit can be changed at run time with ux_host_class_storage_max_transfer_size_set,
+   a size of 0 restores the bulk endpoint limit.
+*/
+
+#define UX_HOST_CLASS_STORAGE_LARGE_TRANSFER_ENABLE
+
+/* Defined, the FileX sector cache of each mounted media is UX_HOST_CLASS_STORAGE_MEDIA_CACHE_SIZE bytes
+   instead of UX_HOST_CLASS_STORAGE_MEMORY_BUFFER_SIZE bytes, so FileX can hash its logical sector cache.
+   The cache is taken from the USBX cache safe memory pool (RAM3) at mount time and halved when the
+   pool cannot give the whole size, down to UX_HOST_CLASS_STORAGE_MEMORY_BUFFER_SIZE.
+*/
+
+#define UX_HOST_CLASS_STORAGE_MEDIA_CACHE_ENABLE
+#define UX_HOST_CLASS_STORAGE_MEDIA_CACHE_SIZE              (1024 * 32)
+
+/* Defined, the storage FileX driver reads ahead on sequential access. A window of
+   UX_HOST_CLASS_STORAGE_READ_AHEAD_BUFFER_SIZE bytes is read in one command and the following
+   sequential FX_DRIVER_READ requests are served from it without a bulk only transport round trip.
+   The window is allocated from the USBX memory pool for each mounted media.
+*/
+
+#define UX_HOST_CLASS_STORAGE_READ_AHEAD_ENABLE
+#define UX_HOST_CLASS_STORAGE_READ_AHEAD_BUFFER_SIZE        (1024 * 4)
+
+/* Defined, the storage FileX driver merges contiguous and overlapping FX_DRIVER_WRITE requests
+   in a buffer of UX_HOST_CLASS_STORAGE_WRITE_COALESCE_BUFFER_SIZE bytes and writes them with a
+   single command. Pending sectors are written on FX_DRIVER_FLUSH (fx_media_flush, fx_media_close),
+   on FX_DRIVER_ABORT, before an overlapping read and when a write cannot be merged.
+*/
+
+#define UX_HOST_CLASS_STORAGE_WRITE_COALESCE_ENABLE
+#define UX_HOST_CLASS_STORAGE_WRITE_COALESCE_BUFFER_SIZE    (1024 * 4)
+
+/* Defined, a free cluster bitmap is allocated for each mounted media and supplied to FileX with
+   fx_media_cluster_bitmap_set before the open, so cluster allocation does not scan the FAT for free
+   entries. FileX fills it in the FAT pass that counts the free clusters at open, or on the first
+   allocation when the FAT32 information sector supplied the count.
+   It needs FX_ENABLE_CLUSTER_BITMAP and is skipped when the bitmap would be larger than
+   UX_HOST_CLASS_STORAGE_CLUSTER_BITMAP_SIZE_MAX bytes (1 bit per cluster). 256K covers 2M clusters:
+   a 32 GB FAT32 volume with the 16K clusters Windows formats it with, or 64 GB with 32K clusters.
+*/
+
+#define UX_HOST_CLASS_STORAGE_CLUSTER_BITMAP_ENABLE
+#define UX_HOST_CLASS_STORAGE_CLUSTER_BITMAP_SIZE_MAX       (1024 * 256)
+
+/* Defined, a UX_HOST_CLASS_STORAGE_DIRECTORY_INDEX_SIZE bytes buffer is allocated for each mounted
+   media and attached to FileX with fx_media_directory_index_enable, so a directory search reads
+   only the entries with the hash of the name (8 bytes per name in the indexed directories).
+   It needs FX_ENABLE_DIRECTORY_INDEX.
+*/
+
+#define UX_HOST_CLASS_STORAGE_DIRECTORY_INDEX_ENABLE
+#define UX_HOST_CLASS_STORAGE_DIRECTORY_INDEX_SIZE          (1024 * 16)
+
+/* Defined, the storage class thread polls the media presence adaptively instead of every
+   UX_HOST_CLASS_STORAGE_THREAD_SLEEP_TIME ms. It polls every UX_HOST_CLASS_STORAGE_THREAD_SLEEP_TIME_MIN ms
+   after a device is enumerated or a media changes and doubles the delay on each idle poll up to
+   UX_HOST_CLASS_STORAGE_THREAD_SLEEP_TIME_MAX ms. A transfer failing with a NOT READY or UNIT ATTENTION
+   sense wakes the thread at once. Each mounted media is time stamped from presence detected to mounted
+   and UX_STORAGE_MEDIA_INSERTION / UX_STORAGE_MEDIA_REMOVAL are reported with FileX too.
+*/
+
+#define UX_HOST_CLASS_STORAGE_ADAPTIVE_POLL_ENABLE
+#define UX_HOST_CLASS_STORAGE_THREAD_SLEEP_TIME_MIN         (100)
+#define UX_HOST_CLASS_STORAGE_THREAD_SLEEP_TIME_MAX         (2000)
+
+/* Multi slot card readers expose each slot as a logical unit. Up to UX_MAX_HOST_LUN logical units
+   are parsed and each one mounted is given its own media of the UX_HOST_CLASS_STORAGE_MAX_MEDIA
+   media: its own FX_MEDIA, read-ahead window and write-coalescing buffer. The buffers are taken from
+   the cache safe memory pool, it must hold them for every media.
+*/
+
+#define UX_MAX_HOST_LUN                                     2
+#define UX_HOST_CLASS_STORAGE_MAX_MEDIA                     (UX_MAX_DEVICES * UX_MAX_HOST_LUN)
+
+/* The media array holds an FX_MEDIA per media, too large for the regular memory pool once there is a
+   media per logical unit of every device: it is taken from the cache safe memory pool (RAM3).  */
+
+#define UX_HOST_CLASS_STORAGE_MEDIA_MEMORY                  UX_CACHE_SAFE_MEMORY
+
+/* Each mounted media is a drive of the application drive registry with its own worker thread. The hub
+   class is registered, so the drives are the logical units of the devices on the root port or on the
+   ports of a hub. The logical units of one device share its storage instance and serialize on its
+   ux_host_class_storage_semaphore: the workers of the drives run concurrently across devices.  */
+
+/* Defined, without DMA a bulk OUT transfer of several packets is submitted once to the OTG FS channel
+   and the non-periodic TX FIFO is refilled from its empty interrupt, instead of one submission and one
+   channel interrupt per 64 byte packet. One transfer at a time streams, others are sent packet by packet.
+*/
+
+#define UX_HCD_STM32_BULK_OUT_REFILL_ENABLE
+
+/* Defined, a control or bulk channel NAKed UX_HCD_STM32_NAK_BACKOFF_THRESHOLD times in a row without progress
+   is retried from the SOF instead of at once, waiting 1 frame and then twice as many frames on each NAK that
+   follows up to UX_HCD_STM32_NAK_BACKOFF_FRAMES_MAX frames. A flash drive busy erasing then no longer floods the
+   CPU with channel interrupts. NAKs and deferrals are counted per channel.
+*/
+
+#define UX_HCD_STM32_NAK_BACKOFF_ENABLE
+#define UX_HCD_STM32_NAK_BACKOFF_THRESHOLD                  8
+#define UX_HCD_STM32_NAK_BACKOFF_FRAMES_MAX                 8
+
+/* Defined, the OTG FS interrupt only records each URB state change (channel, state, transfer count) in a ring
+   of UX_HCD_STM32_URB_EVENT_RING_SIZE events and the HCD thread processes them: transfer lengths, retries,
+   request chaining and semaphore puts move out of OTG_FS_IRQHandler. The USB interrupt alone is masked while
+   an event is processed. The NAKs of a channel merge into one pending event, the ring must hold two events
+   per channel. The mode can be switched at run time to compare the interrupt times.
+*/
+
+#define UX_HCD_STM32_DEFERRED_URB_ENABLE
+#define UX_HCD_STM32_URB_EVENT_RING_SIZE                    32
+
+/* Defined, the host channels and the EDs are allocated from free bitmaps with a count leading zeros lookup and the
+   periodic load of each frame slot is kept up to date, endpoint create and destroy no longer parse the channel
+   table, the ED list or the periodic ED list while devices and hubs enumerate.
+*/
+
+#define UX_HCD_STM32_BITMAP_ALLOCATION_ENABLE
+
+/* Defined, the OTG FS SOF interrupt is masked while no interrupt or isochronous endpoint exists and no NAKed retry
+   waits for a frame. With only a flash drive attached the HCD thread is no longer woken up every 1 ms frame.
+*/
+
+#define UX_HCD_STM32_SOF_GATING_ENABLE
+
+/* Defined, each ED of the STM32 HCD counts transfers, bytes, NAKs, retries, errors, stalls and aborts and keeps
+   a log2 histogram of the submission to completion time in us. The console command USB ED Stats prints and
+   clears them. Takes the DWT cycle counter, enabled by the test application. Left undefined in the shipped
+   build, it adds work to every transfer completion in the OTG FS interrupt.
+*/
+
+/* #define UX_HCD_STM32_ED_STATISTICS_ENABLE */
+#define UX_HCD_STM32_LATENCY_BUCKETS                        20
+
+/* Defined, a disconnection of the root port completes the transfers pending on every endpoint at once with
+   UX_TRANSFER_DEVICE_REMOVED (UX_HCD_STM32_FAST_REMOVAL_ENABLE). The bulk only transport returns this code
+   without reset recovery and the removed device's media are released with fx_media_abort instead of
+   fx_media_close (UX_HOST_CLASS_STORAGE_FAST_REMOVAL_ENABLE). A FileX call in progress when a drive is pulled
+   fails within milliseconds instead of after UX_HOST_CLASS_STORAGE_TRANSFER_TIMEOUT.
+*/
+
+#define UX_HCD_STM32_FAST_REMOVAL_ENABLE
+#define UX_HOST_CLASS_STORAGE_FAST_REMOVAL_ENABLE
+
+/* Defined, the virtual MSC controller of usbx_virtual_host_controllers can use a disk image file opened with the
+   standard C library. Only for a build on a host with a file system, the target uses a RAM image if any.
+*/
+
+/* #define UX_HCD_VIRTUAL_MSC_FILE_IMAGE_ENABLE */
+
 /* USER CODE END 2 */
 
 #endif